@@ -0,0 +1,28 @@
+#include "MafLib/main/GlobalHeader.hpp"
+#include "MafLib/math/linalg/Autotune.hpp"
+
+/**
+ * @file Autotune.cpp
+ * @brief Fits the runtime tuning profile to this host and saves it.
+ *
+ * Usage: Autotune [profile_path]   (default: util::default_tuning_path())
+ *
+ * Run once per machine (with the thread count the applications use); every later
+ * MafLib process on the host loads the profile on its first kernel call.
+ */
+int main(int argc, char **argv) {
+  using namespace maf;
+  const std::filesystem::path path =
+      (argc > 1) ? std::filesystem::path(argv[1]) : util::default_tuning_path();
+
+  std::cout << "Tuning with " << exec::concurrency() << " threads..." << std::endl;
+  const util::TuningProfile profile = math::autotune(&std::cout);
+  try {
+    util::save_tuning(profile, path);
+  } catch (const std::runtime_error &e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  std::cout << "Saved " << path.string() << std::endl;
+  return 0;
+}
@@ -0,0 +1,67 @@
+#include "MafLib/main/GlobalHeader.hpp"
+#include "MafLib/math/linalg/Matrix.hpp"
+
+/**
+ * @file GemmBenchmark.cpp
+ * @brief Reports GFLOP/s of Matrix * Matrix on square and tall-skinny shapes.
+ *
+ * Usage: GemmBenchmark [max_size]   (default max_size = 8192)
+ */
+namespace {
+using namespace maf;
+
+template <typename T>
+math::Matrix<T> random_matrix(size_t rows, size_t cols, std::mt19937 &gen) {
+  std::uniform_real_distribution<double> dis(-1.0, 1.0);
+  math::Matrix<T> result(rows, cols);
+  for (size_t i = 0; i < result.size(); ++i) {
+    result.data()[i] = static_cast<T>(dis(gen));
+  }
+  return result;
+}
+
+template <typename TA, typename TB>
+void run(const char *label, size_t m, size_t k, size_t n, std::mt19937 &gen) {
+  auto A = random_matrix<TA>(m, k, gen);
+  auto B = random_matrix<TB>(k, n, gen);
+
+  // Warm up caches and the lazily computed blocking parameters.
+  volatile double sink = (A * B).data()[0];
+
+  auto start = std::chrono::high_resolution_clock::now();
+  auto C = A * B;
+  auto end = std::chrono::high_resolution_clock::now();
+  sink = sink + C.data()[0];
+
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  const double flops = 2.0 * static_cast<double>(m) * static_cast<double>(n) *
+                       static_cast<double>(k);
+  std::cout << std::left << std::setw(16) << label << std::setw(24)
+            << (std::to_string(m) + "x" + std::to_string(k) + " * " +
+                std::to_string(k) + "x" + std::to_string(n))
+            << std::fixed << std::setprecision(4) << seconds << " s  "
+            << std::setprecision(2) << (flops / seconds) / 1e9 << " GFLOP/s\n";
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  const size_t max_size = (argc > 1) ? std::stoul(argv[1]) : 8192;
+  std::mt19937 gen(42);
+
+  std::cout << "=== Square ===" << std::endl;
+  for (size_t n = 512; n <= max_size; n *= 2) {
+    run<float, float>("float", n, n, n, gen);
+    run<double, double>("double", n, n, n, gen);
+    run<float, double>("float*double", n, n, n, gen);
+  }
+
+  std::cout << "\n=== Tall-skinny ===" << std::endl;
+  for (size_t n = 512; n <= max_size; n *= 2) {
+    // Long dimension on the rows of A and C.
+    run<float, float>("float", 8 * n, 64, 64, gen);
+    run<double, double>("double", 8 * n, 64, 64, gen);
+    // Long dimension as the inner (reduction) dimension.
+    run<double, double>("double", 64, 8 * n, 64, gen);
+  }
+  return 0;
+}
@@ -0,0 +1,337 @@
+#ifndef EXEC_EXECUTION_H
+#define EXEC_EXECUTION_H
+#pragma once
+#include "MafLib/main/GlobalHeader.hpp"
+#include "ThreadPool.hpp"
+
+/**
+ * @file Execution.hpp
+ * @brief Execution contexts and the parallel loops every kernel runs through.
+ *
+ * A Context names a backend (serial, OpenMP or a ThreadPool) and an optional cap on
+ * the threads one parallel loop may use. Kernels do not take a context argument;
+ * they run on `exec::current()`, which is, in order of precedence:
+ *
+ * 1. the innermost ScopedContext of the calling thread,
+ * 2. the pool of the calling thread when it is a pool worker,
+ * 3. the process default (OpenMP with all its threads, see set_default()).
+ *
+ * @code
+ * exec::ThreadPool pool(7, {0, 1, 2, 3, 4, 5, 6});
+ * exec::ScopedContext scope(exec::Context::on(pool, 4));
+ * auto c = a * b;  // GEMM on at most 4 threads of the pool
+ * @endcode
+ *
+ * A parallel loop started inside the body of another runs serially, as nested
+ * OpenMP regions do by default, so the cap of the outer loop holds for the whole
+ * nest. Tasks of a TaskGroup may still start parallel loops.
+ */
+namespace maf::exec {
+#pragma mark context
+//=============================================================================
+// CONTEXT
+//=============================================================================
+enum class Backend : uint8 { Serial, OpenMP, Pool };
+
+class Context {
+ public:
+  /** @brief OpenMP with every thread of the OpenMP runtime. */
+  constexpr Context() noexcept = default;
+
+  /** @brief Runs every loop on the calling thread. */
+  [[nodiscard]] static constexpr Context serial() noexcept {
+    return Context(Backend::Serial, nullptr, 1);
+  }
+
+  /** @brief OpenMP parallel regions of at most max_concurrency threads (0: all). */
+  [[nodiscard]] static constexpr Context openmp(size_t max_concurrency = 0) noexcept {
+    return Context(Backend::OpenMP, nullptr, max_concurrency);
+  }
+
+  /**
+   * @brief Tasks on `pool`; the calling thread takes part in every loop.
+   * @param max_concurrency Threads per loop including the caller (0: pool size + 1).
+   */
+  [[nodiscard]] static constexpr Context on(ThreadPool &pool,
+                                            size_t max_concurrency = 0) noexcept {
+    return Context(Backend::Pool, &pool, max_concurrency);
+  }
+
+  [[nodiscard]] constexpr Backend backend() const noexcept { return _backend; }
+  /** @brief The pool of a Pool context, nullptr otherwise. */
+  [[nodiscard]] constexpr ThreadPool *thread_pool() const noexcept { return _pool; }
+  /** @brief The configured cap, 0 when uncapped. */
+  [[nodiscard]] constexpr size_t max_concurrency() const noexcept { return _max; }
+
+  /** @brief Threads a parallel loop may use, the calling thread included. */
+  [[nodiscard]] size_t concurrency() const noexcept {
+    size_t available = 1;
+    switch (_backend) {
+      case Backend::Serial:
+        break;
+      case Backend::OpenMP:
+        available = static_cast<size_t>(omp_get_max_threads());
+        break;
+      case Backend::Pool:
+        available = _pool->size() + 1;
+        break;
+    }
+    return (_max == 0) ? available : std::min(_max, available);
+  }
+
+ private:
+  Backend _backend = Backend::OpenMP;
+  ThreadPool *_pool = nullptr;
+  size_t _max = 0;
+
+  constexpr Context(Backend backend, ThreadPool *pool, size_t max) noexcept
+      : _backend(backend), _pool(pool), _max(max) {}
+};
+
+namespace detail {
+inline constinit Context default_context{};
+
+inline const Context *&scoped_context() noexcept {
+  thread_local const Context *context = nullptr;
+  return context;
+}
+
+/** @brief Set while the calling thread runs the body of a parallel loop. */
+inline bool &inside_loop() noexcept {
+  thread_local bool inside = false;
+  return inside;
+}
+
+class LoopBody {
+ public:
+  LoopBody() noexcept : _previous(std::exchange(inside_loop(), true)) {}
+  LoopBody(const LoopBody &) = delete;
+  LoopBody &operator=(const LoopBody &) = delete;
+  ~LoopBody() { inside_loop() = _previous; }
+
+ private:
+  bool _previous;
+};
+}  // namespace detail
+
+/** @brief The context kernels called on this thread run on (see the file comment). */
+[[nodiscard]] inline Context current() noexcept {
+  if (const Context *scoped = detail::scoped_context()) {
+    return *scoped;
+  }
+  if (ThreadPool *pool = detail::this_worker().pool) {
+    return Context::on(*pool);
+  }
+  return detail::default_context;
+}
+
+/**
+ * @brief Replaces the process default context.
+ * @attention Not synchronized; call it before kernels run on other threads.
+ */
+inline void set_default(const Context &context) noexcept {
+  detail::default_context = context;
+}
+
+/** @brief Makes a context current on this thread until the end of the scope. */
+class ScopedContext {
+ public:
+  explicit ScopedContext(const Context &context) noexcept
+      : _context(context),
+        _previous(std::exchange(detail::scoped_context(), &_context)) {}
+  ScopedContext(const ScopedContext &) = delete;
+  ScopedContext &operator=(const ScopedContext &) = delete;
+  ~ScopedContext() { detail::scoped_context() = _previous; }
+
+ private:
+  Context _context;
+  const Context *_previous;
+};
+
+#pragma mark loops
+//=============================================================================
+// PARALLEL LOOPS
+//=============================================================================
+/**
+ * @brief How a parallel loop divides its range.
+ * @details Ranges of at most `serial_limit` indices run on the calling thread. With
+ * `grain == 0` the range is cut into one contiguous piece per thread; otherwise the
+ * threads take chunks of `grain` indices dynamically, which balances uneven work.
+ */
+struct Split {
+  size_t serial_limit = 0;
+  size_t grain = 0;
+
+  /** @brief Serial unless `parallel`, for cutoffs measured in other units. */
+  [[nodiscard]] static constexpr Split only_if(bool parallel,
+                                               size_t grain = 0) noexcept {
+    return {parallel ? 0 : std::numeric_limits<size_t>::max(), grain};
+  }
+};
+
+/** @brief Loop body taking a half-open index range. */
+template <typename F>
+concept RangeBody = std::invocable<F &, size_t, size_t>;
+
+/** @brief Loop body that also takes the index of the thread running it. */
+template <typename F>
+concept WorkerRangeBody = std::invocable<F &, size_t, size_t, size_t>;
+
+namespace detail {
+template <typename F>
+void invoke_range(F &body, size_t worker, size_t lo, size_t hi) {
+  if constexpr (WorkerRangeBody<F>) {
+    body(worker, lo, hi);
+  } else {
+    body(lo, hi);
+  }
+}
+
+/** @brief Threads a loop over n indices uses on `context`. */
+[[nodiscard]] inline size_t plan_workers(const Context &context, size_t n,
+                                         const Split &split) noexcept {
+  if (n <= split.serial_limit || n < 2 || inside_loop() ||
+      (context.backend() == Backend::OpenMP && omp_in_parallel())) {
+    return 1;
+  }
+  const size_t pieces = (split.grain == 0) ? n : (n + split.grain - 1) / split.grain;
+  return std::min(context.concurrency(), pieces);
+}
+
+/** @brief Runs the share of worker `w` out of `workers`. */
+template <typename F>
+void run_share(F &body, size_t w, size_t workers, size_t begin, size_t n,
+               const Split &split, std::atomic<size_t> &next) {
+  const LoopBody guard;
+  if (split.grain == 0) {
+    invoke_range(body, w, begin + n * w / workers, begin + n * (w + 1) / workers);
+    return;
+  }
+  for (size_t lo = next.fetch_add(split.grain, std::memory_order_relaxed); lo < n;
+       lo = next.fetch_add(split.grain, std::memory_order_relaxed)) {
+    invoke_range(body, w, begin + lo, begin + std::min(n, lo + split.grain));
+  }
+}
+
+/** @brief Runs the loop on exactly `workers` threads (fewer if OpenMP caps them). */
+template <typename F>
+void run_loop(const Context &context, size_t workers, size_t begin, size_t end,
+              F &body, const Split &split) {
+  const size_t n = end - begin;
+  if (workers <= 1) {
+    const LoopBody guard;
+    invoke_range(body, 0, begin, end);
+    return;
+  }
+  std::atomic<size_t> next{0};
+
+  if (context.backend() == Backend::Pool) {
+    TaskGroup group(context.thread_pool());
+    for (size_t w = 1; w < workers; ++w) {
+      group.run([&, w] { run_share(body, w, workers, begin, n, split, next); });
+    }
+    run_share(body, 0, workers, begin, n, split, next);
+    group.wait();
+    return;
+  }
+
+  // Exceptions must not leave an OpenMP region; the first one is rethrown after it.
+  std::exception_ptr error;
+#pragma omp parallel num_threads(static_cast<int>(workers))
+  {
+    try {
+      run_share(body, static_cast<size_t>(omp_get_thread_num()),
+                static_cast<size_t>(omp_get_num_threads()), begin, n, split, next);
+    } catch (...) {
+#pragma omp critical(maf_exec_error)
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+}  // namespace detail
+
+/**
+ * @brief Calls body on disjoint subranges covering [begin, end).
+ * @details body is `body(lo, hi)` or `body(worker, lo, hi)`, where worker is below
+ * context.concurrency() and unique among the threads running at the same time, so it
+ * can index per-thread scratch space. The first exception a body throws is rethrown
+ * once every thread has finished.
+ */
+template <typename F>
+  requires RangeBody<F> || WorkerRangeBody<F>
+void parallel_for(const Context &context, size_t begin, size_t end, Split split,
+                  F &&body) {
+  if (begin >= end) {
+    return;
+  }
+  const size_t workers = detail::plan_workers(context, end - begin, split);
+  detail::run_loop(context, workers, begin, end, body, split);
+}
+
+template <typename F>
+  requires RangeBody<F> || WorkerRangeBody<F>
+void parallel_for(const Context &context, size_t begin, size_t end, F &&body) {
+  parallel_for(context, begin, end, Split{}, std::forward<F>(body));
+}
+
+/** @brief parallel_for on the current context. */
+template <typename F>
+  requires RangeBody<F> || WorkerRangeBody<F>
+void parallel_for(size_t begin, size_t end, Split split, F &&body) {
+  parallel_for(current(), begin, end, split, std::forward<F>(body));
+}
+
+template <typename F>
+  requires RangeBody<F> || WorkerRangeBody<F>
+void parallel_for(size_t begin, size_t end, F &&body) {
+  parallel_for(current(), begin, end, Split{}, std::forward<F>(body));
+}
+
+/**
+ * @brief Combines map(lo, hi) over subranges covering [begin, end).
+ * @details Every thread folds its subranges into a partial started from `identity`;
+ * the partials are then combined in thread order. With `split.grain == 0` the result
+ * only depends on the number of threads, not on their timing.
+ */
+template <typename T, std::invocable<size_t, size_t> Map, typename Combine>
+[[nodiscard]] T parallel_reduce(const Context &context, size_t begin, size_t end,
+                                Split split, T identity, Map &&map, Combine &&combine) {
+  if (begin >= end) {
+    return identity;
+  }
+  const size_t workers = detail::plan_workers(context, end - begin, split);
+  if (workers <= 1) {
+    const detail::LoopBody guard;
+    return combine(std::move(identity), map(begin, end));
+  }
+  std::vector<T> partials(workers, identity);
+  auto body = [&](size_t worker, size_t lo, size_t hi) {
+    partials[worker] = combine(std::move(partials[worker]), map(lo, hi));
+  };
+  detail::run_loop(context, workers, begin, end, body, split);
+  T result = std::move(partials[0]);
+  for (size_t w = 1; w < workers; ++w) {
+    result = combine(std::move(result), std::move(partials[w]));
+  }
+  return result;
+}
+
+/** @brief parallel_reduce on the current context. */
+template <typename T, std::invocable<size_t, size_t> Map, typename Combine>
+[[nodiscard]] T parallel_reduce(size_t begin, size_t end, Split split, T identity,
+                                Map &&map, Combine &&combine) {
+  return parallel_reduce(current(), begin, end, split, std::move(identity),
+                         std::forward<Map>(map), std::forward<Combine>(combine));
+}
+
+/** @brief Threads a loop on the current context may use; sizes per-worker scratch. */
+[[nodiscard]] inline size_t concurrency() noexcept { return current().concurrency(); }
+
+}  // namespace maf::exec
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef EXEC_TASK_GRAPH_H
+#define EXEC_TASK_GRAPH_H
+#pragma once
+#include <queue>
+
+#include "Execution.hpp"
+
+/**
+ * @file TaskGraph.hpp
+ * @brief Dependency graphs of tasks, run on an execution context.
+ *
+ * A TaskGraph is built once and run once. Every task names the earlier tasks it
+ * waits for, so the order of insertion is always a valid serial schedule and a
+ * graph can not contain cycles. When run, every participating thread repeatedly
+ * takes the earliest inserted task whose dependencies have finished. Algorithms
+ * that add their tasks in serial program order therefore prefer the critical path:
+ * the next panel of a factorization starts before the trailing updates of the
+ * previous one have drained.
+ *
+ * @code
+ * exec::TaskGraph graph;
+ * const auto a = graph.add([&] { factor(0); });
+ * const auto b = graph.add([&] { update(1); }, {a});
+ * graph.add([&] { update(2); }, {a});
+ * graph.add([&] { factor(1); }, {b});
+ * graph.run();
+ * @endcode
+ */
+namespace maf::exec {
+class TaskGraph {
+ public:
+  using Task = std::function<void()>;
+  using Id = size_t;
+
+  /**
+   * @brief Adds a task that starts once every task in `after` has finished.
+   * @throws std::invalid_argument if a dependency is not an earlier task.
+   */
+  Id add(Task task, std::span<const Id> after = {}) {
+    const Id id = _nodes.size();
+    std::vector<Id> dependencies(after.begin(), after.end());
+    std::ranges::sort(dependencies);
+    const auto repeated = std::ranges::unique(dependencies);
+    dependencies.erase(repeated.begin(), repeated.end());
+    if (!dependencies.empty() && dependencies.back() >= id) {
+      throw std::invalid_argument("TaskGraph dependencies must be earlier tasks!");
+    }
+    for (const Id dependency : dependencies) {
+      _nodes[dependency].successors.push_back(id);
+    }
+    _nodes.push_back({std::move(task), {}, dependencies.size()});
+    return id;
+  }
+
+  Id add(Task task, std::initializer_list<Id> after) {
+    return add(std::move(task), std::span(after.begin(), after.size()));
+  }
+
+  /** @brief Number of tasks. */
+  [[nodiscard]] size_t size() const noexcept { return _nodes.size(); }
+
+  /**
+   * @brief Runs every task on the threads of `context`.
+   * @details With a single thread the tasks run in insertion order. Otherwise
+   * parallel loops started by the tasks run serially, like nested loops. After a
+   * task throws, no further task starts and the first exception is rethrown once
+   * the running tasks have finished.
+   */
+  void run(const Context &context);
+
+  /** @brief Runs every task on the current context. */
+  void run() { run(current()); }
+
+ private:
+  struct Node {
+    Task task;
+    std::vector<Id> successors;
+    size_t dependencies = 0;
+  };
+
+  std::vector<Node> _nodes;
+};
+
+inline void TaskGraph::run(const Context &context) {
+  const size_t n = _nodes.size();
+  const size_t workers = detail::plan_workers(context, n, Split{});
+  if (workers <= 1) {
+    for (Node &node : _nodes) {
+      node.task();
+    }
+    return;
+  }
+
+  std::vector<size_t> pending(n);
+  std::priority_queue<Id, std::vector<Id>, std::greater<>> ready;
+  for (Id id = 0; id < n; ++id) {
+    pending[id] = _nodes[id].dependencies;
+    if (pending[id] == 0) {
+      ready.push(id);
+    }
+  }
+  std::mutex mutex;
+  std::condition_variable wake;
+  size_t unfinished = n;
+  bool failed = false;
+
+  // Every thread of the loop is one participant that takes ready tasks until the
+  // graph is done; the loop range only sizes the team.
+  auto participant = [&](size_t, size_t) {
+    std::unique_lock lock(mutex);
+    while (true) {
+      wake.wait(lock, [&] { return failed || unfinished == 0 || !ready.empty(); });
+      if (failed || unfinished == 0) {
+        return;
+      }
+      const Id id = ready.top();
+      ready.pop();
+      lock.unlock();
+      try {
+        _nodes[id].task();
+      } catch (...) {
+        lock.lock();
+        failed = true;
+        wake.notify_all();
+        throw;
+      }
+      lock.lock();
+      --unfinished;
+      size_t released = 0;
+      for (const Id successor : _nodes[id].successors) {
+        if (--pending[successor] == 0) {
+          ready.push(successor);
+          ++released;
+        }
+      }
+      // This thread takes one released task itself.
+      if (unfinished == 0 || released > 1) {
+        wake.notify_all();
+      }
+    }
+  };
+  detail::run_loop(context, workers, 0, workers, participant, Split{});
+}
+
+}  // namespace maf::exec
+
+#endif
@@ -0,0 +1,305 @@
+#ifndef EXEC_THREAD_POOL_H
+#define EXEC_THREAD_POOL_H
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "MafLib/main/GlobalHeader.hpp"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/**
+ * @file ThreadPool.hpp
+ * @brief Persistent work-stealing thread pool.
+ *
+ * Every worker owns a deque: it pushes and pops its own tasks at the back (newest
+ * first, so nested work stays cache-hot) and steals from the front of the other
+ * deques when its own is empty. Tasks submitted from outside the pool go to a shared
+ * injection queue. A thread that waits for a TaskGroup keeps running queued tasks
+ * instead of blocking, so nested parallel loops on the same pool can not deadlock.
+ */
+namespace maf::exec {
+class ThreadPool;
+
+namespace detail {
+/** @brief Pool and worker index of the calling thread (nullptr outside a pool). */
+struct WorkerIdentity {
+  ThreadPool *pool = nullptr;
+  size_t index = 0;
+};
+
+inline WorkerIdentity &this_worker() noexcept {
+  thread_local WorkerIdentity identity;
+  return identity;
+}
+}  // namespace detail
+
+#pragma mark task group
+//=============================================================================
+// TASK GROUP
+//=============================================================================
+/**
+ * @brief A set of tasks submitted to one pool that can be waited on together.
+ * @details wait() runs queued tasks of the pool while the group is unfinished and
+ * rethrows the first exception a task of the group threw. The destructor waits too,
+ * so tasks never outlive the references they capture. Without a pool, run() executes
+ * each task immediately on the calling thread.
+ */
+class TaskGroup {
+ public:
+  explicit TaskGroup(ThreadPool &pool) noexcept : _pool(&pool) {}
+  explicit TaskGroup(ThreadPool *pool) noexcept : _pool(pool) {}
+  TaskGroup(const TaskGroup &) = delete;
+  TaskGroup &operator=(const TaskGroup &) = delete;
+  ~TaskGroup() {
+    try {
+      wait();
+    } catch (...) {
+      // Task errors are reported by an explicit wait().
+    }
+  }
+
+  /** @brief Queues f on the pool. */
+  template <std::invocable F>
+  void run(F &&f);
+
+  /** @brief Runs queued work until every task of the group has finished. */
+  void wait();
+
+ private:
+  ThreadPool *_pool;
+  std::mutex _mutex;
+  std::condition_variable _done;
+  size_t _pending = 0;
+  std::exception_ptr _error;
+
+  /** @brief Counts one more unfinished task. */
+  void start() {
+    const std::scoped_lock lock(_mutex);
+    ++_pending;
+  }
+
+  /**
+   * @brief Records the end of one task.
+   * @details The count drops and the waiters are notified under _mutex. wait() needs
+   * the same mutex to see the count reach 0, so the group cannot be destroyed before
+   * the last finishing task has let go of it.
+   */
+  void finish(std::exception_ptr error) noexcept {
+    const std::scoped_lock lock(_mutex);
+    if (error && !_error) {
+      _error = std::move(error);
+    }
+    if (--_pending == 0) {
+      _done.notify_all();
+    }
+  }
+};
+
+#pragma mark pool
+//=============================================================================
+// THREAD POOL
+//=============================================================================
+class ThreadPool {
+ public:
+  using Task = std::function<void()>;
+
+  /**
+   * @brief Starts `workers` threads.
+   * @param workers Number of worker threads. Threads that wait on the pool also run
+   * its tasks, so a caller plus `hardware_concurrency() - 1` workers fill the host.
+   * @param cpus Optional CPU ids; worker i is pinned to cpus[i % cpus.size()]. Pinning
+   * is applied on Linux and ignored elsewhere.
+   */
+  explicit ThreadPool(size_t workers = default_workers(), std::vector<int> cpus = {})
+      : _queues(workers) {
+    _threads.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) {
+      _threads.emplace_back([this, i] { worker_loop(i); });
+#if defined(__linux__)
+      if (!cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpus[i % cpus.size()], &set);
+        pthread_setaffinity_np(_threads.back().native_handle(), sizeof(set), &set);
+      }
+#endif
+    }
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /** @brief Finishes queued tasks and joins the workers. */
+  ~ThreadPool() {
+    {
+      const std::scoped_lock lock(_sleep_mutex);
+      _stopping = true;
+    }
+    _wake.notify_all();
+    for (auto &thread : _threads) {
+      thread.join();
+    }
+  }
+
+  /** @brief Worker count that, with the calling thread, uses every hardware thread. */
+  [[nodiscard]] static size_t default_workers() noexcept {
+    const size_t hardware = std::thread::hardware_concurrency();
+    return (hardware > 1) ? hardware - 1 : 0;
+  }
+
+  /** @brief Number of worker threads. */
+  [[nodiscard]] size_t size() const noexcept { return _threads.size(); }
+
+  /** @brief Queues a task; workers push to their own deque, other threads share one. */
+  void submit(Task task) {
+    const detail::WorkerIdentity &self = detail::this_worker();
+    Queue &queue = (self.pool == this) ? _queues[self.index] : _injection;
+    // Counted before it is visible, so the count never drops below zero.
+    _queued.fetch_add(1, std::memory_order_release);
+    {
+      const std::scoped_lock lock(queue.mutex);
+      queue.tasks.push_back(std::move(task));
+    }
+    {
+      const std::scoped_lock lock(_sleep_mutex);
+    }
+    _wake.notify_one();
+  }
+
+  /**
+   * @brief Runs one queued task on the calling thread.
+   * @return False if no task was queued.
+   */
+  bool run_pending() {
+    Task task;
+    if (!take(task)) {
+      return false;
+    }
+    task();
+    return true;
+  }
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  std::vector<Queue> _queues;
+  Queue _injection;
+  std::vector<std::thread> _threads;
+  std::atomic<size_t> _queued{0};
+  std::mutex _sleep_mutex;
+  std::condition_variable _wake;
+  bool _stopping = false;
+
+  /** @brief Own deque from the back, then the injection queue, then steals. */
+  bool take(Task &task) {
+    if (_queued.load(std::memory_order_acquire) == 0) {
+      return false;
+    }
+    const detail::WorkerIdentity &self = detail::this_worker();
+    const bool worker = self.pool == this;
+    if (worker && pop(_queues[self.index], task, true)) {
+      return true;
+    }
+    if (pop(_injection, task, false)) {
+      return true;
+    }
+    const size_t n = _queues.size();
+    const size_t first = worker ? self.index + 1 : 0;
+    for (size_t k = 0; k < n; ++k) {
+      if (pop(_queues[(first + k) % n], task, false)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool pop(Queue &queue, Task &task, bool newest) {
+    const std::scoped_lock lock(queue.mutex);
+    if (queue.tasks.empty()) {
+      return false;
+    }
+    if (newest) {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    } else {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+    _queued.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  void worker_loop(size_t index) {
+    detail::this_worker() = {this, index};
+    while (true) {
+      if (run_pending()) {
+        continue;
+      }
+      std::unique_lock lock(_sleep_mutex);
+      _wake.wait(lock, [this] {
+        return _stopping || _queued.load(std::memory_order_acquire) != 0;
+      });
+      if (_stopping && _queued.load(std::memory_order_acquire) == 0) {
+        return;
+      }
+    }
+  }
+};
+
+template <std::invocable F>
+void TaskGroup::run(F &&f) {
+  if (_pool == nullptr) {
+    try {
+      f();
+    } catch (...) {
+      start();
+      finish(std::current_exception());
+    }
+    return;
+  }
+  start();
+  _pool->submit([this, task = std::forward<F>(f)]() mutable {
+    std::exception_ptr error;
+    try {
+      task();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    finish(std::move(error));
+  });
+}
+
+inline void TaskGroup::wait() {
+  while (true) {
+    {
+      const std::scoped_lock lock(_mutex);
+      if (_pending == 0) {
+        break;
+      }
+    }
+    // Unfinished tasks of the group are either running or queued; the queued ones
+    // are run here, so sleeping is only reached while others run the rest.
+    if (_pool == nullptr || !_pool->run_pending()) {
+      std::unique_lock lock(_mutex);
+      _done.wait(lock, [this] { return _pending == 0; });
+    }
+  }
+  const std::scoped_lock lock(_mutex);
+  if (_error) {
+    std::rethrow_exception(std::exchange(_error, nullptr));
+  }
+}
+
+}  // namespace maf::exec
+
+#endif
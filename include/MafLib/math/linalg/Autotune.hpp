@@ -0,0 +1,247 @@
+#ifndef AUTOTUNE_H
+#define AUTOTUNE_H
+#pragma once
+#include "Cholesky.hpp"
+#include "GemmKernels.hpp"
+#include "Matrix.hpp"
+#include "PLU.hpp"
+#include "Vector.hpp"
+
+/**
+ * @file Autotune.hpp
+ * @brief Micro-benchmarks that fit the runtime tuning profile to the host.
+ *
+ * `autotune()` times the built-in kernels of every complexity class serially and in
+ * parallel at increasing sizes and sets each parallel cutoff just below the size
+ * where the parallel run is at least 10% faster. The LU block size and the Cholesky
+ * tile order are each the fastest of a few candidates. Vendor BLAS/LAPACK are bypassed:
+ * the profile only steers the built-in kernels.
+ *
+ * Persist the result with `util::save_tuning(profile, util::default_tuning_path())`
+ * or run the `Autotune` benchmark executable once per host.
+ */
+namespace maf::math {
+namespace detail {
+/** @brief Limit value that keeps a kernel serial, with headroom for scaled limits. */
+inline constexpr size_t NEVER_PARALLEL = std::numeric_limits<size_t>::max() / 64;
+
+/** @brief Seconds per call of f: the best of three batches long enough to time. */
+template <typename F>
+[[nodiscard]] double seconds_per_call(F &f) {
+  using clock = std::chrono::steady_clock;
+  f();  // Warm up caches, pools and lazily computed blocking.
+  size_t reps = 1;
+  double best = std::numeric_limits<double>::infinity();
+  for (size_t batch = 0; batch < 3;) {
+    const auto start = clock::now();
+    for (size_t r = 0; r < reps; ++r) {
+      f();
+    }
+    const double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    if (elapsed < 1e-3 && reps < (1UL << 20)) {
+      reps *= 2;
+      continue;
+    }
+    best = std::min(best, elapsed / static_cast<double>(reps));
+    ++batch;
+  }
+  return best;
+}
+
+/**
+ * @brief Fits one parallel cutoff of `profile`.
+ * @param field The limit that gates the kernel.
+ * @param sizes Increasing problem sizes.
+ * @param make Returns a callable that runs the kernel once at a given size.
+ * @param work Maps a problem size to the units of the limit.
+ * @return A limit that keeps every size before the first of two consecutive 10%
+ * parallel wins serial, or the work of the largest size when parallel never wins.
+ */
+template <typename Make, typename Work>
+[[nodiscard]] size_t parallel_crossover(TuningProfile profile,
+                                        size_t TuningProfile::*field,
+                                        std::span<const size_t> sizes, Make &&make,
+                                        Work &&work) {
+  // A win only counts when the next size wins too, so one noisy timing does not
+  // move the cutoff.
+  constexpr size_t NONE = std::numeric_limits<size_t>::max();
+  size_t first_win = NONE;
+  for (size_t s = 0; s < sizes.size(); ++s) {
+    auto run = make(sizes[s]);
+    profile.*field = NEVER_PARALLEL;
+    util::set_tuning(profile);
+    const double serial = seconds_per_call(run);
+    profile.*field = 0;
+    util::set_tuning(profile);
+    const double parallel = seconds_per_call(run);
+    if (parallel >= 0.9 * serial) {
+      first_win = NONE;
+      continue;
+    }
+    if (first_win == NONE) {
+      first_win = s;
+    }
+    if (s > first_win || s + 1 == sizes.size()) {
+      break;
+    }
+  }
+  if (first_win == NONE) {
+    return work(sizes.back());
+  }
+  return (first_win == 0) ? work(sizes[0]) / 2 : work(sizes[first_win - 1]) + 1;
+}
+
+/** @brief Square matrix with entries uniform in [-1, 1]. */
+[[nodiscard]] inline Matrix<double> tuning_matrix(size_t n, std::mt19937 &gen) {
+  std::uniform_real_distribution<double> dis(-1.0, 1.0);
+  Matrix<double> result(n, n, util::uninitialized);
+  std::ranges::generate(std::span(result.data(), result.size()),
+                        [&] { return dis(gen); });
+  return result;
+}
+
+/** @brief Symmetric positive definite B * B^T + n * I. */
+[[nodiscard]] inline Matrix<double> tuning_spd_matrix(size_t n, std::mt19937 &gen) {
+  const Matrix<double> b = tuning_matrix(n, gen);
+  Matrix<double> result = b * b.transposed();
+  for (size_t i = 0; i < n; ++i) {
+    result.at(i, i) += static_cast<double>(n);
+  }
+  return result;
+}
+}  // namespace detail
+
+/**
+ * @brief Micro-benchmarks the host and returns a fitted tuning profile.
+ * @details Parallel cutoffs are only measured when the current execution context has
+ * more than one thread and keep their defaults otherwise. The active profile is
+ * restored before returning, also when a timed kernel throws; pass the result to
+ * util::set_tuning() or util::save_tuning(). Takes a few seconds.
+ * @param log Optional stream that receives one line per fitted value.
+ */
+[[nodiscard]] inline TuningProfile autotune(std::ostream *log = nullptr) {
+  // Every measurement installs a trial profile; put the active one back on exit.
+  struct Restore {
+    TuningProfile previous = util::tuning();
+    Restore() = default;
+    Restore(const Restore &) = delete;
+    Restore &operator=(const Restore &) = delete;
+    ~Restore() { util::set_tuning(previous); }
+  } restore;
+  TuningProfile profile;
+  std::mt19937 gen(42);
+  const auto report = [&](std::string_view key, size_t value) {
+    if (log != nullptr) {
+      *log << key << " = " << value << std::endl;
+    }
+  };
+
+  if (exec::concurrency() > 1) {
+    // Element-wise vector sum.
+    constexpr std::array<size_t, 6> linear_sizes{1UL << 12, 1UL << 14, 1UL << 16,
+                                                 1UL << 18, 1UL << 20, 1UL << 22};
+    profile.omp_linear_limit = detail::parallel_crossover(
+        profile, &TuningProfile::omp_linear_limit, linear_sizes,
+        [](size_t n) {
+          return [x = Vector<double>(n), y = Vector<double>(n)] {
+            volatile double sink = (x + y)[0];
+            (void)sink;
+          };
+        },
+        [](size_t n) { return n; });
+    report("omp_linear_limit", profile.omp_linear_limit);
+
+    // Matrix * Vector; the mixed types keep vendor BLAS out of the measurement.
+    constexpr std::array<size_t, 6> square_sizes{64, 128, 256, 512, 1024, 2048};
+    profile.omp_quadratic_limit = detail::parallel_crossover(
+        profile, &TuningProfile::omp_quadratic_limit, square_sizes,
+        [&](size_t n) {
+          return [a = detail::tuning_matrix(n, gen), x = Vector<float>(n)] {
+            volatile double sink = (a * x)[0];
+            (void)sink;
+          };
+        },
+        [](size_t n) { return n * n; });
+    report("omp_quadratic_limit", profile.omp_quadratic_limit);
+
+    // Packed GEMM, called directly so vendor BLAS is bypassed.
+    constexpr std::array<size_t, 7> cube_sizes{32, 48, 64, 96, 128, 192, 256};
+    profile.omp_cubic_limit = detail::parallel_crossover(
+        profile, &TuningProfile::omp_cubic_limit, cube_sizes,
+        [&](size_t n) {
+          auto a = detail::tuning_matrix(n, gen);
+          auto b = detail::tuning_matrix(n, gen);
+          return [n, a = std::move(a), b = std::move(b),
+                  c = Matrix<double>(n, n)]() mutable {
+            kernels::packed_gemm(n, n, n, 1.0, a.data(), n, 1, b.data(), n, 1, 0.0,
+                                 c.data(), n, 1);
+          };
+        },
+        [](size_t n) { return (n * n * n) / 50; });
+    report("omp_cubic_limit", profile.omp_cubic_limit);
+
+    constexpr std::array<size_t, 5> factor_sizes{64, 128, 256, 512, 1024};
+    profile.lu_parallel_limit = detail::parallel_crossover(
+        profile, &TuningProfile::lu_parallel_limit, factor_sizes,
+        [&](size_t n) {
+          return [a = detail::tuning_matrix(n, gen)] {
+            volatile double sink = detail::_plu(Matrix<double>(a)).packed().at(0, 0);
+            (void)sink;
+          };
+        },
+        [](size_t n) { return n; });
+    report("lu_parallel_limit", profile.lu_parallel_limit);
+
+    profile.cholesky_parallel_limit = detail::parallel_crossover(
+        profile, &TuningProfile::cholesky_parallel_limit, factor_sizes,
+        [&](size_t n) {
+          return [a = detail::tuning_spd_matrix(n, gen)] {
+            volatile double sink = detail::_cholesky(a).at(0, 0);
+            (void)sink;
+          };
+        },
+        [](size_t n) { return n; });
+    report("cholesky_parallel_limit", profile.cholesky_parallel_limit);
+  }
+
+  // Block size and tile order: the fastest candidates with the fitted cutoffs.
+  constexpr size_t FACTOR_ORDER = 512;
+  const Matrix<double> general = detail::tuning_matrix(FACTOR_ORDER, gen);
+  const Matrix<double> spd = detail::tuning_spd_matrix(FACTOR_ORDER, gen);
+  const auto fastest = [&](size_t TuningProfile::*field,
+                           std::initializer_list<size_t> candidates, auto factor) {
+    double best = std::numeric_limits<double>::infinity();
+    size_t best_value = profile.*field;
+    for (size_t value : candidates) {
+      profile.*field = value;
+      util::set_tuning(profile);
+      const double seconds = detail::seconds_per_call(factor);
+      if (seconds < best) {
+        best = seconds;
+        best_value = value;
+      }
+    }
+    profile.*field = best_value;
+  };
+  fastest(&TuningProfile::block_size, {8, 16, 32, 64, 128}, [&] {
+    volatile double sink = detail::_plu(Matrix<double>(general)).packed().at(0, 0);
+    (void)sink;
+  });
+  report("block_size", profile.block_size);
+  fastest(&TuningProfile::cholesky_tile, {32, 64, 128, 256}, [&] {
+    volatile double sink = detail::_cholesky(spd).at(0, 0);
+    (void)sink;
+  });
+  report("cholesky_tile", profile.cholesky_tile);
+  return profile;
+}
+
+namespace detail {
+/** @brief Lets the first kernel call autotune when MAF_AUTOTUNE is set. */
+inline const bool AUTOTUNER_REGISTERED =
+    (util::detail::autotuner = [] { return autotune(); }, true);
+}  // namespace detail
+
+}  // namespace maf::math
+
+#endif
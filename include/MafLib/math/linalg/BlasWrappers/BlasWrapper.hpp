@@ -0,0 +1,537 @@
+#ifndef BLAS_WRAPPER_H
+#define BLAS_WRAPPER_H
+
+#pragma once
+#include "MafLib/main/GlobalHeader.hpp"
+#include "MafLib/utility/Memory.hpp"
+
+/**
+ * @file BlasWrapper.hpp
+ * @brief Backend-neutral CBLAS/LAPACK dispatch layer.
+ *
+ * CMake binds the library to one vendor BLAS through `MAFLIB_BLAS_BACKEND` and
+ * defines exactly one of:
+ * - MAF_BLAS_ACCELERATE (also implied by ACCELERATE_AVAILABLE on Apple),
+ * - MAF_BLAS_OPENBLAS,
+ * - MAF_BLAS_BLIS,
+ * - MAF_BLAS_MKL,
+ * - MAF_BLAS_GENERIC (any other CBLAS implementation, `MAFLIB_BLAS_BACKEND=Generic`),
+ * plus MAF_LAPACK_AVAILABLE when LAPACK symbols are linked and MAF_BLAS_ILP64 for
+ * 64-bit integer interfaces.
+ *
+ * Every routine in `maf::math::blas` takes sizes as size_t, row-major leading
+ * dimensions for BLAS and column-major leading dimensions for LAPACK, exactly as
+ * the reference interfaces do. Call sites guard themselves with
+ * `#if defined(MAF_BLAS_AVAILABLE)` and `if constexpr (blas::supports<T>)`.
+ */
+
+#if defined(__APPLE__) && defined(ACCELERATE_AVAILABLE) &&                  \
+    !defined(MAF_BLAS_ACCELERATE) && !defined(MAF_BLAS_OPENBLAS) &&            \
+    !defined(MAF_BLAS_BLIS) && !defined(MAF_BLAS_MKL) && !defined(MAF_BLAS_GENERIC)
+#define MAF_BLAS_ACCELERATE
+#endif
+
+#if defined(MAF_BLAS_ACCELERATE)
+#include "../AccelerateWrappers/AccelerateWrapper.hpp"
+#define MAF_BLAS_AVAILABLE
+#ifndef MAF_LAPACK_AVAILABLE
+#define MAF_LAPACK_AVAILABLE
+#endif
+#elif defined(MAF_BLAS_MKL)
+#include <mkl.h>
+#define MAF_BLAS_AVAILABLE
+#ifndef MAF_LAPACK_AVAILABLE
+#define MAF_LAPACK_AVAILABLE
+#endif
+#elif defined(MAF_BLAS_OPENBLAS) || defined(MAF_BLAS_BLIS) || defined(MAF_BLAS_GENERIC)
+#include <cblas.h>
+#define MAF_BLAS_AVAILABLE
+#endif
+
+namespace maf::math::blas {
+#pragma mark types
+//=============================================================================
+// TYPES
+//=============================================================================
+#if defined(MAF_BLAS_ACCELERATE)
+using blas_int = __LAPACK_int;
+#elif defined(MAF_BLAS_MKL)
+using blas_int = MKL_INT;
+#elif defined(MAF_BLAS_ILP64)
+using blas_int = int64;
+#else
+using blas_int = int32;
+#endif
+
+#if defined(MAF_BLAS_AVAILABLE)
+/** @brief True if a vendor BLAS is linked. */
+inline static constexpr bool AVAILABLE = true;
+#else
+inline static constexpr bool AVAILABLE = false;
+#endif
+
+#if defined(MAF_LAPACK_AVAILABLE)
+/** @brief True if LAPACK routines are linked. */
+inline static constexpr bool LAPACK_AVAILABLE = true;
+#else
+inline static constexpr bool LAPACK_AVAILABLE = false;
+#endif
+
+#if defined(MAF_BLAS_ACCELERATE) || defined(MAF_BLAS_OPENBLAS) || defined(MAF_BLAS_MKL)
+/** @brief True if the backend provides an out-of-place transpose (omatcopy). */
+inline static constexpr bool HAS_OMATCOPY = true;
+#else
+inline static constexpr bool HAS_OMATCOPY = false;
+#endif
+
+/** @brief True if BLAS routines can be called with element type T. */
+template <typename T>
+inline constexpr bool supports =
+    AVAILABLE && (std::is_same_v<T, float> || std::is_same_v<T, double>);
+
+/** @brief True if LAPACK routines can be called with element type T. */
+template <typename T>
+inline constexpr bool lapack_supports = LAPACK_AVAILABLE && supports<T>;
+
+/** @brief Which operand of a routine is transposed. */
+enum class Trans : uint8 { NoTrans, Trans };
+
+/** @brief Which triangle of a symmetric or triangular matrix is referenced. */
+enum class Uplo : uint8 { Upper, Lower };
+
+/** @brief Whether a triangular matrix has an implicit unit diagonal. */
+enum class Diag : uint8 { NonUnit, Unit };
+
+/** @brief Whether a triangular matrix multiplies the other operand from the left. */
+enum class Side : uint8 { Left, Right };
+
+/** @brief Returns the smallest positive leading dimension BLAS accepts. */
+[[nodiscard]] inline blas_int ld(size_t value) {
+  return static_cast<blas_int>(std::max<size_t>(value, 1));
+}
+}  // namespace maf::math::blas
+
+#if defined(MAF_LAPACK_AVAILABLE) && !defined(MAF_BLAS_ACCELERATE) && \
+    !defined(MAF_BLAS_MKL)
+// Fortran LAPACK symbols, exported by OpenBLAS, reference LAPACK and libflame.
+extern "C" {
+void sgeqrf_(const maf::math::blas::blas_int *m, const maf::math::blas::blas_int *n,
+             float *a, const maf::math::blas::blas_int *lda, float *tau, float *work,
+             const maf::math::blas::blas_int *lwork, maf::math::blas::blas_int *info);
+void dgeqrf_(const maf::math::blas::blas_int *m, const maf::math::blas::blas_int *n,
+             double *a, const maf::math::blas::blas_int *lda, double *tau, double *work,
+             const maf::math::blas::blas_int *lwork, maf::math::blas::blas_int *info);
+void sorgqr_(const maf::math::blas::blas_int *m, const maf::math::blas::blas_int *n,
+             const maf::math::blas::blas_int *k, float *a,
+             const maf::math::blas::blas_int *lda, const float *tau, float *work,
+             const maf::math::blas::blas_int *lwork, maf::math::blas::blas_int *info);
+void dorgqr_(const maf::math::blas::blas_int *m, const maf::math::blas::blas_int *n,
+             const maf::math::blas::blas_int *k, double *a,
+             const maf::math::blas::blas_int *lda, const double *tau, double *work,
+             const maf::math::blas::blas_int *lwork, maf::math::blas::blas_int *info);
+void sgelqf_(const maf::math::blas::blas_int *m, const maf::math::blas::blas_int *n,
+             float *a, const maf::math::blas::blas_int *lda, float *tau, float *work,
+             const maf::math::blas::blas_int *lwork, maf::math::blas::blas_int *info);
+void dgelqf_(const maf::math::blas::blas_int *m, const maf::math::blas::blas_int *n,
+             double *a, const maf::math::blas::blas_int *lda, double *tau, double *work,
+             const maf::math::blas::blas_int *lwork, maf::math::blas::blas_int *info);
+void sorglq_(const maf::math::blas::blas_int *m, const maf::math::blas::blas_int *n,
+             const maf::math::blas::blas_int *k, float *a,
+             const maf::math::blas::blas_int *lda, const float *tau, float *work,
+             const maf::math::blas::blas_int *lwork, maf::math::blas::blas_int *info);
+void dorglq_(const maf::math::blas::blas_int *m, const maf::math::blas::blas_int *n,
+             const maf::math::blas::blas_int *k, double *a,
+             const maf::math::blas::blas_int *lda, const double *tau, double *work,
+             const maf::math::blas::blas_int *lwork, maf::math::blas::blas_int *info);
+}
+#endif
+
+#if defined(MAF_BLAS_AVAILABLE)
+namespace maf::math::blas {
+namespace detail {
+[[nodiscard]] inline CBLAS_TRANSPOSE to_cblas(Trans trans) {
+  return (trans == Trans::NoTrans) ? CblasNoTrans : CblasTrans;
+}
+
+[[nodiscard]] inline CBLAS_UPLO to_cblas(Uplo uplo) {
+  return (uplo == Uplo::Upper) ? CblasUpper : CblasLower;
+}
+
+[[nodiscard]] inline CBLAS_DIAG to_cblas(Diag diag) {
+  return (diag == Diag::NonUnit) ? CblasNonUnit : CblasUnit;
+}
+
+[[nodiscard]] inline CBLAS_SIDE to_cblas(Side side) {
+  return (side == Side::Left) ? CblasLeft : CblasRight;
+}
+}  // namespace detail
+
+#pragma mark level1
+//=============================================================================
+// BLAS LEVEL 1 ROUTINES
+//=============================================================================
+/** @brief Returns x^T * y. */
+[[nodiscard]] inline float dot(size_t n, const float *x, size_t incx, const float *y,
+                               size_t incy) {
+  return cblas_sdot(static_cast<blas_int>(n), x, static_cast<blas_int>(incx), y,
+                    static_cast<blas_int>(incy));
+}
+
+/** @brief Returns x^T * y. */
+[[nodiscard]] inline double dot(size_t n, const double *x, size_t incx,
+                                const double *y, size_t incy) {
+  return cblas_ddot(static_cast<blas_int>(n), x, static_cast<blas_int>(incx), y,
+                    static_cast<blas_int>(incy));
+}
+
+#pragma mark level2
+//=============================================================================
+// BLAS LEVEL 2 ROUTINES
+//=============================================================================
+/** @brief y = alpha * op(A) * x + beta * y, A is a row-major m x n matrix. */
+inline void gemv(Trans trans, size_t m, size_t n, float alpha, const float *a,
+                 size_t lda, const float *x, size_t incx, float beta, float *y,
+                 size_t incy) {
+  cblas_sgemv(CblasRowMajor, detail::to_cblas(trans), static_cast<blas_int>(m),
+              static_cast<blas_int>(n), alpha, a, ld(lda), x,
+              static_cast<blas_int>(incx), beta, y, static_cast<blas_int>(incy));
+}
+
+/** @brief y = alpha * op(A) * x + beta * y, A is a row-major m x n matrix. */
+inline void gemv(Trans trans, size_t m, size_t n, double alpha, const double *a,
+                 size_t lda, const double *x, size_t incx, double beta, double *y,
+                 size_t incy) {
+  cblas_dgemv(CblasRowMajor, detail::to_cblas(trans), static_cast<blas_int>(m),
+              static_cast<blas_int>(n), alpha, a, ld(lda), x,
+              static_cast<blas_int>(incx), beta, y, static_cast<blas_int>(incy));
+}
+
+/** @brief A = alpha * x * y^T + A, A is a row-major m x n matrix. */
+inline void ger(size_t m, size_t n, float alpha, const float *x, size_t incx,
+                const float *y, size_t incy, float *a, size_t lda) {
+  cblas_sger(CblasRowMajor, static_cast<blas_int>(m), static_cast<blas_int>(n), alpha,
+             x, static_cast<blas_int>(incx), y, static_cast<blas_int>(incy), a,
+             ld(lda));
+}
+
+/** @brief A = alpha * x * y^T + A, A is a row-major m x n matrix. */
+inline void ger(size_t m, size_t n, double alpha, const double *x, size_t incx,
+                const double *y, size_t incy, double *a, size_t lda) {
+  cblas_dger(CblasRowMajor, static_cast<blas_int>(m), static_cast<blas_int>(n), alpha,
+             x, static_cast<blas_int>(incx), y, static_cast<blas_int>(incy), a,
+             ld(lda));
+}
+
+/** @brief y = alpha * A * x + beta * y, A is a row-major symmetric n x n matrix. */
+inline void symv(Uplo uplo, size_t n, float alpha, const float *a, size_t lda,
+                 const float *x, size_t incx, float beta, float *y, size_t incy) {
+  cblas_ssymv(CblasRowMajor, detail::to_cblas(uplo), static_cast<blas_int>(n), alpha,
+              a, ld(lda), x, static_cast<blas_int>(incx), beta, y,
+              static_cast<blas_int>(incy));
+}
+
+/** @brief y = alpha * A * x + beta * y, A is a row-major symmetric n x n matrix. */
+inline void symv(Uplo uplo, size_t n, double alpha, const double *a, size_t lda,
+                 const double *x, size_t incx, double beta, double *y, size_t incy) {
+  cblas_dsymv(CblasRowMajor, detail::to_cblas(uplo), static_cast<blas_int>(n), alpha,
+              a, ld(lda), x, static_cast<blas_int>(incx), beta, y,
+              static_cast<blas_int>(incy));
+}
+
+/** @brief x = op(A)^-1 * x, A is a row-major triangular n x n matrix. */
+inline void trsv(Uplo uplo, Trans trans, Diag diag, size_t n, const float *a,
+                 size_t lda, float *x, size_t incx) {
+  cblas_strsv(CblasRowMajor, detail::to_cblas(uplo), detail::to_cblas(trans),
+              detail::to_cblas(diag), static_cast<blas_int>(n), a, ld(lda), x,
+              static_cast<blas_int>(incx));
+}
+
+/** @brief x = op(A)^-1 * x, A is a row-major triangular n x n matrix. */
+inline void trsv(Uplo uplo, Trans trans, Diag diag, size_t n, const double *a,
+                 size_t lda, double *x, size_t incx) {
+  cblas_dtrsv(CblasRowMajor, detail::to_cblas(uplo), detail::to_cblas(trans),
+              detail::to_cblas(diag), static_cast<blas_int>(n), a, ld(lda), x,
+              static_cast<blas_int>(incx));
+}
+
+#pragma mark level3
+//=============================================================================
+// BLAS LEVEL 3 ROUTINES
+//=============================================================================
+/** @brief C = alpha * op(A) * op(B) + beta * C, all matrices row-major. */
+inline void gemm(Trans trans_a, Trans trans_b, size_t m, size_t n, size_t k,
+                 float alpha, const float *a, size_t lda, const float *b, size_t ldb,
+                 float beta, float *c, size_t ldc) {
+  cblas_sgemm(CblasRowMajor, detail::to_cblas(trans_a), detail::to_cblas(trans_b),
+              static_cast<blas_int>(m), static_cast<blas_int>(n),
+              static_cast<blas_int>(k), alpha, a, ld(lda), b, ld(ldb), beta, c,
+              ld(ldc));
+}
+
+/** @brief C = alpha * op(A) * op(B) + beta * C, all matrices row-major. */
+inline void gemm(Trans trans_a, Trans trans_b, size_t m, size_t n, size_t k,
+                 double alpha, const double *a, size_t lda, const double *b,
+                 size_t ldb, double beta, double *c, size_t ldc) {
+  cblas_dgemm(CblasRowMajor, detail::to_cblas(trans_a), detail::to_cblas(trans_b),
+              static_cast<blas_int>(m), static_cast<blas_int>(n),
+              static_cast<blas_int>(k), alpha, a, ld(lda), b, ld(ldb), beta, c,
+              ld(ldc));
+}
+
+/**
+ * @brief B = alpha * op(A)^-1 * B (Left) or B = alpha * B * op(A)^-1 (Right), with a
+ * row-major triangular A and a row-major m x n matrix B.
+ */
+inline void trsm(Side side, Uplo uplo, Trans trans, Diag diag, size_t m, size_t n,
+                 float alpha, const float *a, size_t lda, float *b, size_t ldb) {
+  cblas_strsm(CblasRowMajor, detail::to_cblas(side), detail::to_cblas(uplo),
+              detail::to_cblas(trans), detail::to_cblas(diag), static_cast<blas_int>(m),
+              static_cast<blas_int>(n), alpha, a, ld(lda), b, ld(ldb));
+}
+
+/**
+ * @brief B = alpha * op(A)^-1 * B (Left) or B = alpha * B * op(A)^-1 (Right), with a
+ * row-major triangular A and a row-major m x n matrix B.
+ */
+inline void trsm(Side side, Uplo uplo, Trans trans, Diag diag, size_t m, size_t n,
+                 double alpha, const double *a, size_t lda, double *b, size_t ldb) {
+  cblas_dtrsm(CblasRowMajor, detail::to_cblas(side), detail::to_cblas(uplo),
+              detail::to_cblas(trans), detail::to_cblas(diag), static_cast<blas_int>(m),
+              static_cast<blas_int>(n), alpha, a, ld(lda), b, ld(ldb));
+}
+
+#pragma mark extensions
+//=============================================================================
+// BLAS EXTENSIONS
+//=============================================================================
+/**
+ * @brief B = A^T for a row-major rows x cols matrix A (omatcopy).
+ * @attention Only available when HAS_OMATCOPY is true. Accelerate's vDSP_mtrans
+ * requires both matrices to be contiguous (lda == cols, ldb == rows).
+ */
+template <typename T>
+  requires(std::is_same_v<T, float> || std::is_same_v<T, double>)
+inline void omatcopy_trans(size_t rows, size_t cols, const T *a, size_t lda, T *b,
+                           size_t ldb) {
+#if defined(MAF_BLAS_ACCELERATE)
+  assert(lda == cols && ldb == rows);
+  if constexpr (std::is_same_v<T, float>) {
+    vDSP_mtrans(a, 1, b, 1, cols, rows);
+  } else {
+    vDSP_mtransD(a, 1, b, 1, cols, rows);
+  }
+#elif defined(MAF_BLAS_OPENBLAS)
+  if constexpr (std::is_same_v<T, float>) {
+    cblas_somatcopy(CblasRowMajor, CblasTrans, static_cast<blas_int>(rows),
+                    static_cast<blas_int>(cols), 1.0F, a, ld(lda), b, ld(ldb));
+  } else {
+    cblas_domatcopy(CblasRowMajor, CblasTrans, static_cast<blas_int>(rows),
+                    static_cast<blas_int>(cols), 1.0, a, ld(lda), b, ld(ldb));
+  }
+#elif defined(MAF_BLAS_MKL)
+  if constexpr (std::is_same_v<T, float>) {
+    mkl_somatcopy('R', 'T', rows, cols, 1.0F, a, lda, b, ldb);
+  } else {
+    mkl_domatcopy('R', 'T', rows, cols, 1.0, a, lda, b, ldb);
+  }
+#else
+  static_assert(HAS_OMATCOPY, "Backend does not provide omatcopy!");
+#endif
+}
+
+/** @brief Panel width (rows of A or columns of B) converted at a time by gemm_mixed. */
+inline static constexpr size_t MIXED_GEMM_PANEL = 256;
+
+/**
+ * @brief C = alpha * A * B + beta * C for row-major operands where A or B is not R.
+ * @details The mismatched operand is converted to R one panel at a time (row panels
+ * of A, column panels of B) and every panel goes through the vendor gemm. The extra
+ * memory is one panel instead of a full copy of the operand.
+ */
+template <typename R, typename TA, typename TB>
+  requires(supports<R> && (std::is_same_v<TA, R> || std::is_same_v<TB, R>))
+void gemm_mixed(size_t m, size_t n, size_t k, R alpha, const TA *a, size_t lda,
+                const TB *b, size_t ldb, R beta, R *c, size_t ldc) {
+  if constexpr (std::is_same_v<TA, R> && std::is_same_v<TB, R>) {
+    gemm(Trans::NoTrans, Trans::NoTrans, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+  } else if constexpr (std::is_same_v<TB, R>) {
+    const size_t panel = std::min(m, MIXED_GEMM_PANEL);
+    util::AlignedVector<R> a_panel;
+    a_panel.resize(panel * k);
+    for (size_t i0 = 0; i0 < m; i0 += panel) {
+      const size_t rows = std::min(panel, m - i0);
+      for (size_t i = 0; i < rows; ++i) {
+        const TA *src = a + ((i0 + i) * lda);
+        R *dst = a_panel.data() + (i * k);
+#pragma omp simd
+        for (size_t p = 0; p < k; ++p) {
+          dst[p] = static_cast<R>(src[p]);
+        }
+      }
+      gemm(Trans::NoTrans, Trans::NoTrans, rows, n, k, alpha, a_panel.data(), k, b, ldb,
+           beta, c + (i0 * ldc), ldc);
+    }
+  } else {
+    const size_t panel = std::min(n, MIXED_GEMM_PANEL);
+    util::AlignedVector<R> b_panel;
+    b_panel.resize(k * panel);
+    for (size_t j0 = 0; j0 < n; j0 += panel) {
+      const size_t cols = std::min(panel, n - j0);
+      for (size_t p = 0; p < k; ++p) {
+        const TB *src = b + (p * ldb) + j0;
+        R *dst = b_panel.data() + (p * cols);
+#pragma omp simd
+        for (size_t j = 0; j < cols; ++j) {
+          dst[j] = static_cast<R>(src[j]);
+        }
+      }
+      gemm(Trans::NoTrans, Trans::NoTrans, m, cols, k, alpha, a, lda, b_panel.data(),
+           cols, beta, c + j0, ldc);
+    }
+  }
+}
+}  // namespace maf::math::blas
+#endif
+
+#if defined(MAF_LAPACK_AVAILABLE)
+namespace maf::math::blas {
+#pragma mark lapack
+//=============================================================================
+// LAPACK ROUTINES
+//=============================================================================
+/**
+ * @brief Householder QR of a column-major m x n matrix (geqrf).
+ * @details On exit the upper triangle of A holds R and the reflectors are stored
+ * below the diagonal. Workspace is queried and allocated internally.
+ * @throws std::runtime_error if LAPACK reports an error.
+ */
+template <typename T>
+  requires(std::is_same_v<T, float> || std::is_same_v<T, double>)
+void geqrf(size_t m, size_t n, T *a, size_t lda, T *tau) {
+  const auto mm = static_cast<blas_int>(m);
+  const auto nn = static_cast<blas_int>(n);
+  const blas_int lda_ = ld(lda);
+  blas_int info = 0;
+  blas_int lwork = -1;
+  T query = 0;
+
+  auto call = [&](T *work) {
+    if constexpr (std::is_same_v<T, float>) {
+      sgeqrf_(&mm, &nn, a, &lda_, tau, work, &lwork, &info);
+    } else {
+      dgeqrf_(&mm, &nn, a, &lda_, tau, work, &lwork, &info);
+    }
+  };
+
+  call(&query);
+  lwork = static_cast<blas_int>(std::max<double>(1.0, std::ceil(query)));
+  std::vector<T> work(static_cast<size_t>(lwork));
+  call(work.data());
+  if (info != 0) {
+    throw std::runtime_error("LAPACK geqrf failed");
+  }
+}
+
+/**
+ * @brief Forms the m x n matrix Q with orthonormal columns from k reflectors
+ * produced by geqrf (orgqr). A is column-major.
+ * @throws std::runtime_error if LAPACK reports an error.
+ */
+template <typename T>
+  requires(std::is_same_v<T, float> || std::is_same_v<T, double>)
+void orgqr(size_t m, size_t n, size_t k, T *a, size_t lda, const T *tau) {
+  const auto mm = static_cast<blas_int>(m);
+  const auto nn = static_cast<blas_int>(n);
+  const auto kk = static_cast<blas_int>(k);
+  const blas_int lda_ = ld(lda);
+  blas_int info = 0;
+  blas_int lwork = -1;
+  T query = 0;
+
+  auto call = [&](T *work) {
+    if constexpr (std::is_same_v<T, float>) {
+      sorgqr_(&mm, &nn, &kk, a, &lda_, tau, work, &lwork, &info);
+    } else {
+      dorgqr_(&mm, &nn, &kk, a, &lda_, tau, work, &lwork, &info);
+    }
+  };
+
+  call(&query);
+  lwork = static_cast<blas_int>(std::max<double>(1.0, std::ceil(query)));
+  std::vector<T> work(static_cast<size_t>(lwork));
+  call(work.data());
+  if (info != 0) {
+    throw std::runtime_error("LAPACK orgqr failed");
+  }
+}
+
+/**
+ * @brief Householder LQ of a column-major m x n matrix (gelqf).
+ * @details On exit the lower triangle of A holds L and the reflectors are stored
+ * right of the diagonal. The column-major storage of A^T is the row-major storage of
+ * A, so this is also the QR of a row-major matrix without a transposed copy.
+ * @throws std::runtime_error if LAPACK reports an error.
+ */
+template <typename T>
+  requires(std::is_same_v<T, float> || std::is_same_v<T, double>)
+void gelqf(size_t m, size_t n, T *a, size_t lda, T *tau) {
+  const auto mm = static_cast<blas_int>(m);
+  const auto nn = static_cast<blas_int>(n);
+  const blas_int lda_ = ld(lda);
+  blas_int info = 0;
+  blas_int lwork = -1;
+  T query = 0;
+
+  auto call = [&](T *work) {
+    if constexpr (std::is_same_v<T, float>) {
+      sgelqf_(&mm, &nn, a, &lda_, tau, work, &lwork, &info);
+    } else {
+      dgelqf_(&mm, &nn, a, &lda_, tau, work, &lwork, &info);
+    }
+  };
+
+  call(&query);
+  lwork = static_cast<blas_int>(std::max<double>(1.0, std::ceil(query)));
+  std::vector<T> work(static_cast<size_t>(lwork));
+  call(work.data());
+  if (info != 0) {
+    throw std::runtime_error("LAPACK gelqf failed");
+  }
+}
+
+/**
+ * @brief Forms the m x n matrix Q with orthonormal rows from k reflectors
+ * produced by gelqf (orglq). A is column-major.
+ * @throws std::runtime_error if LAPACK reports an error.
+ */
+template <typename T>
+  requires(std::is_same_v<T, float> || std::is_same_v<T, double>)
+void orglq(size_t m, size_t n, size_t k, T *a, size_t lda, const T *tau) {
+  const auto mm = static_cast<blas_int>(m);
+  const auto nn = static_cast<blas_int>(n);
+  const auto kk = static_cast<blas_int>(k);
+  const blas_int lda_ = ld(lda);
+  blas_int info = 0;
+  blas_int lwork = -1;
+  T query = 0;
+
+  auto call = [&](T *work) {
+    if constexpr (std::is_same_v<T, float>) {
+      sorglq_(&mm, &nn, &kk, a, &lda_, tau, work, &lwork, &info);
+    } else {
+      dorglq_(&mm, &nn, &kk, a, &lda_, tau, work, &lwork, &info);
+    }
+  };
+
+  call(&query);
+  lwork = static_cast<blas_int>(std::max<double>(1.0, std::ceil(query)));
+  std::vector<T> work(static_cast<size_t>(lwork));
+  call(work.data());
+  if (info != 0) {
+    throw std::runtime_error("LAPACK orglq failed");
+  }
+}
+}  // namespace maf::math::blas
+#endif
+
+#endif
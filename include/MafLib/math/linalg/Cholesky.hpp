@@ -1,7 +1,9 @@
 #ifndef CHOLESKY_H
 #define CHOLESKY_H
 #pragma once
+#include "MafLib/exec/TaskGraph.hpp"
 #include "Matrix.hpp"
+#include "ViewKernels.hpp"
 
 /**
  * @file Cholesky.hpp
@@ -10,8 +12,17 @@
  *
  * This header defines the `cholesky` function, which computes the Cholesky
  * decomposition of a given square, symmetric, positive definite matrix. The
- * implementation uses a blocked algorithm for improved cache performance and is
- * parallelized with OpenMP for multi-threading and SIMD vectorization.
+ * factorization runs in place on the lower triangle of one copy of the matrix,
+ * split into square tiles of order tuning().cholesky_tile. Every step of the tiled
+ * algorithm is a tile task:
+ *
+ * - POTRF factors a diagonal tile,
+ * - TRSM solves a tile below it against the factored diagonal tile,
+ * - SYRK / GEMM subtract the products of two solved tiles from a trailing tile.
+ *
+ * The tasks form a dependency graph (exec::TaskGraph) that runs on the current
+ * execution context, so the factorization of the next diagonal tile overlaps the
+ * trailing updates of the previous step instead of waiting for them.
  *
  * The function checks for symmetry and detects non-positive-definiteness during
  * the computation. It supports both single and double precision floating point
@@ -24,75 +35,254 @@
 namespace maf::math {
 namespace detail {
 /**
- * @brief Internal implementation of Cholesky decomposition.
- *
- * Computes L where A = LL^T for Hermitian symmetric positive definite matrix A.
- * Uses blocked algorithm with OpenMP parallelization.
+ * @brief POTRF: in-place Cholesky of the lower triangle of an n x n tile.
+ * @param a First element of the tile.
+ * @param ld Distance between consecutive rows of the tile.
  */
 template <std::floating_point T>
-[[nodiscard]] Matrix<T> _cholesky(const Matrix<T> &matrix) {
-  if (!matrix.is_symmetric()) {
-    throw std::invalid_argument(
-        "Matrix must be symmetric to try Cholesky decomposition!");
-  }
+void potrf_tile(T *a, size_t n, size_t ld) {
+  for (size_t j = 0; j < n; ++j) {
+    T *row_j = a + (j * ld);
+    T sum = 0;
+#pragma omp simd reduction(+ : sum)
+    for (size_t k = 0; k < j; ++k) {
+      sum += row_j[k] * row_j[k];
+    }
 
-  size_t n = matrix.row_count();
-  Matrix<T> L(n, n);
+    T diag_val = row_j[j] - sum;
+    if (diag_val <= 0) {
+      throw std::invalid_argument("Matrix is not positive definite!");
+    }
+    row_j[j] = std::sqrt(diag_val);
 
-  for (size_t jj = 0; jj < n; jj += BLOCK_SIZE) {
-    const size_t j_end = std::min(jj + BLOCK_SIZE, n);
-    for (size_t j = jj; j < j_end; ++j) {
-      T sum = 0;
-      auto L_row_j = L.row_span(j);
+    for (size_t i = j + 1; i < n; ++i) {
+      T *row_i = a + (i * ld);
+      T sum_i = 0;
+#pragma omp simd reduction(+ : sum_i)
+      for (size_t k = 0; k < j; ++k) {
+        sum_i += row_i[k] * row_j[k];
+      }
+      row_i[j] = (row_i[j] - sum_i) / row_j[j];
+    }
+  }
+}
 
-#pragma omp simd
+/**
+ * @brief TRSM: B = B * L^-T for an m x n tile B and the factored n x n tile L.
+ * @details Row x of B solves L * x^T = b^T by forward substitution.
+ */
+template <std::floating_point T>
+void trsm_tile(const T *l, T *b, size_t m, size_t n, size_t ld) {
+  for (size_t r = 0; r < m; ++r) {
+    T *x = b + (r * ld);
+    for (size_t j = 0; j < n; ++j) {
+      const T *row_j = l + (j * ld);
+      T sum = 0;
+#pragma omp simd reduction(+ : sum)
       for (size_t k = 0; k < j; ++k) {
-        sum += L_row_j[k] * L_row_j[k];
+        sum += row_j[k] * x[k];
       }
+      x[j] = (x[j] - sum) / row_j[j];
+    }
+  }
+}
 
-      T diag_val = matrix.at(j, j) - sum;
-      if (diag_val <= 0) {
-        throw std::invalid_argument("Matrix is not positive definite!");
+/**
+ * @brief Overwrites the lower triangle of the symmetric matrix in L with its Cholesky
+ * factor and zeroes the upper triangle.
+ * @details Uses the tiled task-graph algorithm of the file comment; a matrix of a
+ * single tile is factored directly.
+ */
+template <std::floating_point T>
+void cholesky_inplace(Matrix<T> &L) {
+  const size_t n = L.row_count();
+  T *a = L.data();
+  const size_t order = tuning().cholesky_tile;
+  const size_t tiles = (n + order - 1) / order;
+  auto first = [=](size_t t) { return t * order; };
+  auto extent = [&](size_t t) { return std::min(order, n - first(t)); };
+  auto tile = [&](size_t i, size_t j) { return a + (first(i) * n) + first(j); };
+  auto tile_view = [&](size_t i, size_t j) {
+    return L.view(first(i), first(j), extent(i), extent(j));
+  };
+
+  auto zero_upper = [&] {
+    exec::parallel_for(0, n, quadratic_split(n * n), [&](size_t lo, size_t hi) {
+      for (size_t i = lo; i < hi; ++i) {
+        std::fill(a + (i * n) + i + 1, a + ((i + 1) * n), T(0));
       }
-      L_row_j[j] = std::sqrt(diag_val);
+    });
+  };
+  if (tiles == 1) {
+    potrf_tile(a, n, n);
+    zero_upper();
+    return;
+  }
 
-      for (size_t i = j + 1; i < j_end; ++i) {
-        T sum_i = 0;
-        auto L_row_i = L.row_span(i);
+  // writer[i * tiles + j]: the last task that wrote tile (i, j) so far.
+  constexpr auto NONE = std::numeric_limits<exec::TaskGraph::Id>::max();
+  std::vector<exec::TaskGraph::Id> writer(tiles * tiles, NONE);
+  exec::TaskGraph graph;
+  auto add = [&](size_t i, size_t j, exec::TaskGraph::Task task,
+                 std::initializer_list<std::pair<size_t, size_t>> reads) {
+    std::vector<exec::TaskGraph::Id> after;
+    for (const auto &[ri, rj] : reads) {
+      after.push_back(writer[(ri * tiles) + rj]);
+    }
+    after.push_back(writer[(i * tiles) + j]);
+    std::erase(after, NONE);
+    writer[(i * tiles) + j] = graph.add(std::move(task), after);
+  };
 
-#pragma omp simd
-        for (size_t k = 0; k < j; ++k) {
-          sum_i += L_row_i[k] * L_row_j[k];
-        }
-        L_row_i[j] = (matrix.at(i, j) - sum_i) / L_row_j[j];
+  for (size_t k = 0; k < tiles; ++k) {
+    add(k, k, [&, k] { potrf_tile(tile(k, k), extent(k), n); }, {});
+    for (size_t i = k + 1; i < tiles; ++i) {
+      add(
+          i, k,
+          [&, i, k] { trsm_tile(tile(k, k), tile(i, k), extent(i), extent(k), n); },
+          {{k, k}});
+    }
+    for (size_t i = k + 1; i < tiles; ++i) {
+      for (size_t j = k + 1; j <= i; ++j) {
+        // SYRK on the diagonal (its upper half is scratch), GEMM below it.
+        add(i, j,
+            [&, i, j, k] {
+              kernels::gemm(kernels::OP::NoTrans, kernels::OP::Trans, -1.0,
+                            tile_view(i, k), tile_view(j, k), 1.0, tile_view(i, j));
+            },
+            {{i, k}, {j, k}});
       }
     }
+  }
+  // The GEMM tasks read exec::current(), so a serial run is scoped as well.
+  const bool parallel = n > tuning().cholesky_parallel_limit;
+  const exec::Context context = parallel ? exec::current() : exec::Context::serial();
+  const exec::ScopedContext scope(context);
+  graph.run(context);
+
+  // The upper triangle still holds A.
+  zero_upper();
+}
+
+/**
+ * @brief Internal implementation of Cholesky decomposition.
+ *
+ * Computes L where A = LL^T for Hermitian symmetric positive definite matrix A, in
+ * the layout of A.
+ */
+template <std::floating_point T, Layout LA>
+[[nodiscard]] Matrix<T, LA> _cholesky(const Matrix<T, LA> &matrix) {
+  if (!matrix.is_symmetric()) {
+    throw std::invalid_argument(
+        "Matrix must be symmetric to try Cholesky decomposition!");
+  }
+  // A symmetric matrix has the same storage in both layouts.
+  Matrix<T> L(matrix.row_count(), matrix.column_count(), util::uninitialized);
+  std::copy(matrix.data(), matrix.data() + matrix.size(), L.data());
+  cholesky_inplace(L);
+  if constexpr (LA == Layout::RowMajor) {
+    return L;
+  } else {
+    return Matrix<T, LA>(L);
+  }
+}
 
-#pragma omp parallel for if (n > 1000)
-    for (size_t ii = j_end; ii < n; ii += BLOCK_SIZE) {
-      const size_t i_end = std::min(ii + BLOCK_SIZE, n);
+}  // namespace detail
 
-      for (size_t i = ii; i < i_end; ++i) {
-        auto L_row_i = L.row_span(i);
+/**
+ * @brief A reusable Cholesky factorization A = LL^T that solves A X = B for any
+ * number of right-hand sides.
+ *
+ * Like LUFactorization, it owns its storage: factor() reuses it for a matrix of the
+ * same order and solve_inplace() allocates nothing. The two triangular solves with L
+ * and L^T run through kernels::trsm.
+ *
+ * @tparam T The floating point type of the factor.
+ */
+template <std::floating_point T>
+class CholeskyFactorization {
+ public:
+  CholeskyFactorization() = default;
 
-        for (size_t j = jj; j < j_end; ++j) {
-          T sum = 0;
-          auto L_row_j = L.row_span(j);
+  template <Numeric U, Layout LA>
+  explicit CholeskyFactorization(const Matrix<U, LA> &A) {
+    factor(A);
+  }
 
-#pragma omp simd
-          for (size_t k = 0; k < j; ++k) {
-            sum += L_row_i[k] * L_row_j[k];
-          }
-          L_row_i[j] = (matrix.at(i, j) - sum) / L_row_j[j];
-        }
-      }
+  /**
+   * @brief Factors A of either layout, reusing the storage of the previous
+   * factorization.
+   * @details A symmetric matrix has the same storage in both layouts, so A is copied
+   * as it is.
+   * @throws std::invalid_argument if A is not symmetric or not positive definite;
+   * the factorization is then unusable until the next successful factor().
+   */
+  template <Numeric U, Layout LA>
+  void factor(const Matrix<U, LA> &A) {
+    if (!A.is_symmetric()) {
+      throw std::invalid_argument(
+          "Matrix must be symmetric to try Cholesky decomposition!");
+    }
+    const size_t n = A.row_count();
+    if (_l.row_count() != n) {
+      _l = Matrix<T>(n, n, util::uninitialized);
     }
+    std::transform(A.data(), A.data() + A.size(), _l.data(),
+                   [](U x) { return static_cast<T>(x); });
+    detail::cholesky_inplace(_l);
   }
 
-  return L;
-}
+  /** @brief Order of the factored matrix. */
+  [[nodiscard]] size_t size() const noexcept { return _l.row_count(); }
 
-}  // namespace detail
+  /** @brief The lower triangular factor L. */
+  [[nodiscard]] const Matrix<T> &L() const noexcept { return _l; }
+
+  /**
+   * @brief B = A^-1 B in place, for the n x p right-hand sides in the columns of B.
+   * @throws std::invalid_argument if B does not have size() rows.
+   */
+  void solve_inplace(MatrixView<T> B) const {
+    _check_rows(B.row_count());
+    kernels::trsm(kernels::UPLO::Lower, kernels::OP::NoTrans, kernels::DIAG::NonUnit,
+                  _l.view(), B);
+    kernels::trsm(kernels::UPLO::Lower, kernels::OP::Trans, kernels::DIAG::NonUnit,
+                  _l.view(), B);
+  }
+
+  /** @brief b = A^-1 b in place. */
+  void solve_inplace(VectorView<T> b) const {
+    _check_rows(b.size());
+    kernels::trsv(kernels::UPLO::Lower, kernels::OP::NoTrans, kernels::DIAG::NonUnit,
+                  _l.view(), b);
+    kernels::trsv(kernels::UPLO::Lower, kernels::OP::Trans, kernels::DIAG::NonUnit,
+                  _l.view(), b);
+  }
+
+  /** @brief Solution of A x = b. */
+  [[nodiscard]] Vector<T> solve(const Vector<T> &b) const {
+    Vector<T> x(b);
+    solve_inplace(x.view(0, x.size()));
+    return x;
+  }
+
+  /** @brief Solution of A X = B, one column per right-hand side. */
+  template <Layout L>
+  [[nodiscard]] Matrix<T, L> solve(const Matrix<T, L> &B) const {
+    Matrix<T, L> X(B);
+    solve_inplace(X.view());
+    return X;
+  }
+
+ private:
+  Matrix<T> _l;
+
+  void _check_rows(size_t rows) const {
+    if (rows != size()) {
+      throw std::invalid_argument("Dimensions do not match for Cholesky solve!");
+    }
+  }
+};
 
 /**
  * @brief Computes the Cholesky decomposition of a symmetric positive
@@ -109,10 +299,9 @@ template <std::floating_point T>
  * and positive definite. This function checks for symmetry first. It
  * then detects non-positive-definiteness during the computation.
  *
- * The decomposition is computed using a blocked Cholesky-Crout algorithm
- * for improved cache performance. The implementation is parallelized
- * using OpenMP (for both multi-threading and SIMD vectorization)
- * for further performance gains.
+ * The decomposition is computed in place by a tiled algorithm whose tile
+ * tasks run as a dependency graph on the current execution context, with
+ * GEMM trailing updates and SIMD tile kernels.
  *
  * More information:
  * https://en.wikipedia.org/wiki/Cholesky_decomposition
@@ -120,17 +309,17 @@ template <std::floating_point T>
  * @tparam T The floating point type of the matrix elements (e.g., float,
  * double).
  * @param matrix The const reference to the square, symmetric, positive
- * definite input matrix (A) to decompose.
- * @return (Matrix<T>) The lower triangular matrix (L).
+ * definite input matrix (A) to decompose, in either layout.
+ * @return (Matrix<T, L>) The lower triangular matrix (L), in the layout of A.
  *
  * @throws std::invalid_argument if the input matrix is not symmetric,
  * or if it is not positive definite (detected during factorization).
  *
- * @version 1.0 (Blocked & Parallelized)
+ * @version 2.0 (Tiled Task Graph)
  * @since 2025
  */
-template <typename ResultType = void, Numeric T>
-[[nodiscard]] auto cholesky(const Matrix<T> &matrix) {
+template <typename ResultType = void, Numeric T, Layout L>
+[[nodiscard]] auto cholesky(const Matrix<T, L> &matrix) {
   using TargetType =
       std::conditional_t<std::is_same_v<ResultType, void>,
                          std::conditional_t<std::is_floating_point_v<T>, T, double>,
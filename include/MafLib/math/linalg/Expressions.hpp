@@ -0,0 +1,344 @@
+#ifndef EXPRESSIONS_H
+#define EXPRESSIONS_H
+#pragma once
+#include "LinAlg.hpp"
+#include "MafLib/main/GlobalHeader.hpp"
+#include "MafLib/utility/Math.hpp"
+
+/**
+ * @file Expressions.hpp
+ * @brief Lazily evaluated element-wise expressions over Matrix and Vector.
+ *
+ * `lazy(A)` wraps a Matrix or Vector in a lightweight terminal node. Combining it with
+ * other matrices, vectors, scalars or expressions through +, -, * (scalar), /
+ * (scalar) and unary - builds an expression tree without touching memory. The tree is
+ * evaluated in a single vectorized, OpenMP-parallel pass when it is assigned to a
+ * Matrix or Vector:
+ *
+ * @code
+ * Matrix<double> D = lazy(A) * 2.0 + B - lazy(C) / 3.0;  // one allocation, one pass
+ * D = lazy(D) * 0.5 + A;                                 // reuses D's buffer
+ * @endcode
+ *
+ * Type promotion follows the eager operators: std::common_type_t for +, - and *, and
+ * double for integer / integer.
+ *
+ * @attention Expressions reference their operands. Store them in `auto` variables only
+ * while every operand is alive.
+ *
+ * This file is intended to be included at the *end* of Matrix.hpp and Vector.hpp,
+ * before the member implementations that evaluate expressions.
+ */
+namespace maf::math {
+namespace expr {
+#pragma mark operations
+//=============================================================================
+// OPERATIONS
+//=============================================================================
+struct Add {
+  template <typename L, typename R>
+  using result = std::common_type_t<L, R>;
+
+  template <typename V>
+  [[nodiscard]] static constexpr V apply(V lhs, V rhs) noexcept {
+    return lhs + rhs;
+  }
+};
+
+struct Sub {
+  template <typename L, typename R>
+  using result = std::common_type_t<L, R>;
+
+  template <typename V>
+  [[nodiscard]] static constexpr V apply(V lhs, V rhs) noexcept {
+    return lhs - rhs;
+  }
+};
+
+struct Mul {
+  template <typename L, typename R>
+  using result = std::common_type_t<L, R>;
+
+  template <typename V>
+  [[nodiscard]] static constexpr V apply(V lhs, V rhs) noexcept {
+    return lhs * rhs;
+  }
+};
+
+struct Div {
+  // Forces double if both are ints, like the eager operator/.
+  template <typename L, typename R>
+  using result = std::conditional_t<std::is_integral_v<L> && std::is_integral_v<R>,
+                                    double, std::common_type_t<L, R>>;
+
+  template <typename V>
+  [[nodiscard]] static constexpr V apply(V lhs, V rhs) noexcept {
+    return lhs / rhs;
+  }
+};
+
+struct Negate {
+  template <typename V>
+  [[nodiscard]] static constexpr V apply(V value) noexcept {
+    return -value;
+  }
+};
+
+#pragma mark nodes
+//=============================================================================
+// NODES
+//=============================================================================
+/** @brief Leaf node referencing the contiguous storage of a Matrix or Vector. */
+template <Numeric T, typename Shape>
+class Terminal : public ExpressionBase {
+ public:
+  using value_type = T;
+  using shape_type = Shape;
+
+  Terminal(const T *data, Shape shape) noexcept : _data(data), _shape(shape) {}
+
+  [[nodiscard]] T operator[](size_t i) const noexcept { return _data[i]; }
+  [[nodiscard]] const Shape &shape() const noexcept { return _shape; }
+
+ private:
+  const T *_data;
+  Shape _shape;
+};
+
+/** @brief Leaf node broadcasting a scalar to every element. Has no shape. */
+template <Numeric T>
+class ScalarOperand {
+ public:
+  using value_type = T;
+  using shape_type = void;
+
+  explicit ScalarOperand(T value) noexcept : _value(value) {}
+
+  [[nodiscard]] T operator[](size_t /*i*/) const noexcept { return _value; }
+
+ private:
+  T _value;
+};
+
+/** @brief Element-wise binary node. At least one side is an expression. */
+template <typename Op, typename L, typename R>
+class Binary : public ExpressionBase {
+ public:
+  using value_type =
+      typename Op::template result<typename L::value_type, typename R::value_type>;
+  using shape_type = std::conditional_t<std::is_void_v<typename L::shape_type>,
+                                        typename R::shape_type, typename L::shape_type>;
+
+  Binary(L lhs, R rhs) : _lhs(std::move(lhs)), _rhs(std::move(rhs)) {
+    if constexpr (!std::is_void_v<typename L::shape_type> &&
+                  !std::is_void_v<typename R::shape_type>) {
+      if (!(_lhs.shape() == _rhs.shape())) {
+        throw std::invalid_argument("Expression operands must have the same shape!");
+      }
+    }
+  }
+
+  [[nodiscard]] value_type operator[](size_t i) const noexcept {
+    return Op::apply(static_cast<value_type>(_lhs[i]), static_cast<value_type>(_rhs[i]));
+  }
+
+  [[nodiscard]] const shape_type &shape() const noexcept {
+    if constexpr (std::is_void_v<typename L::shape_type>) {
+      return _rhs.shape();
+    } else {
+      return _lhs.shape();
+    }
+  }
+
+ private:
+  L _lhs;
+  R _rhs;
+};
+
+/** @brief Element-wise unary node. */
+template <typename Op, typename E>
+class Unary : public ExpressionBase {
+ public:
+  using value_type = typename E::value_type;
+  using shape_type = typename E::shape_type;
+
+  explicit Unary(E operand) noexcept : _operand(std::move(operand)) {}
+
+  [[nodiscard]] value_type operator[](size_t i) const noexcept {
+    return Op::apply(_operand[i]);
+  }
+
+  [[nodiscard]] const shape_type &shape() const noexcept { return _operand.shape(); }
+
+ private:
+  E _operand;
+};
+
+#pragma mark operands
+//=============================================================================
+// OPERANDS
+//=============================================================================
+namespace detail {
+template <typename X>
+struct operand;
+
+template <Expression X>
+struct operand<X> {
+  using type = std::remove_cvref_t<X>;
+  static type make(const type &x) { return x; }
+};
+
+template <MatrixType X>
+struct operand<X> {
+  using value_type = typename std::remove_cvref_t<X>::value_type;
+  using type = Terminal<value_type, MatrixShape>;
+  static type make(const Matrix<value_type> &m) {
+    return type(m.data(), MatrixShape{m.row_count(), m.column_count()});
+  }
+};
+
+template <VectorType X>
+struct operand<X> {
+  using value_type = typename std::remove_cvref_t<X>::value_type;
+  using type = Terminal<value_type, VectorShape>;
+  static type make(const Vector<value_type> &v) {
+    return type(v.data(), VectorShape{v.size(), v.orientation()});
+  }
+};
+
+template <Numeric X>
+struct operand<X> {
+  using type = ScalarOperand<X>;
+  static type make(X x) { return type(x); }
+};
+
+template <typename X>
+using operand_t = typename operand<std::remove_cvref_t<X>>::type;
+
+template <typename X>
+auto make_operand(const X &x) {
+  return operand<std::remove_cvref_t<X>>::make(x);
+}
+
+template <typename X>
+concept Operand = Expression<X> || MatrixType<X> || VectorType<X> ||
+                  Numeric<std::remove_cvref_t<X>>;
+
+template <typename X>
+concept ScalarLike = Numeric<std::remove_cvref_t<X>>;
+}  // namespace detail
+
+/**
+ * @brief True if L and R can be combined element-wise into an expression: at least
+ * one side is already an expression and both sides agree on the container kind.
+ */
+template <typename L, typename R>
+concept Combinable =
+    (Expression<L> || Expression<R>) && detail::Operand<L> && detail::Operand<R> &&
+    (std::is_void_v<typename detail::operand_t<L>::shape_type> ||
+     std::is_void_v<typename detail::operand_t<R>::shape_type> ||
+     std::same_as<typename detail::operand_t<L>::shape_type,
+                  typename detail::operand_t<R>::shape_type>);
+
+#pragma mark operators
+//=============================================================================
+// OPERATORS
+//=============================================================================
+template <typename L, typename R>
+  requires Combinable<L, R>
+[[nodiscard]] auto operator+(const L &lhs, const R &rhs) {
+  return Binary<Add, detail::operand_t<L>, detail::operand_t<R>>(
+      detail::make_operand(lhs), detail::make_operand(rhs));
+}
+
+template <typename L, typename R>
+  requires Combinable<L, R>
+[[nodiscard]] auto operator-(const L &lhs, const R &rhs) {
+  return Binary<Sub, detail::operand_t<L>, detail::operand_t<R>>(
+      detail::make_operand(lhs), detail::make_operand(rhs));
+}
+
+template <typename L, typename R>
+  requires Combinable<L, R> && (detail::ScalarLike<L> || detail::ScalarLike<R>)
+[[nodiscard]] auto operator*(const L &lhs, const R &rhs) {
+  return Binary<Mul, detail::operand_t<L>, detail::operand_t<R>>(
+      detail::make_operand(lhs), detail::make_operand(rhs));
+}
+
+template <typename L, typename R>
+  requires Combinable<L, R> && (detail::ScalarLike<L> || detail::ScalarLike<R>)
+[[nodiscard]] auto operator/(const L &lhs, const R &rhs) {
+  return Binary<Div, detail::operand_t<L>, detail::operand_t<R>>(
+      detail::make_operand(lhs), detail::make_operand(rhs));
+}
+
+template <Expression E>
+[[nodiscard]] auto operator-(const E &operand) {
+  return Unary<Negate, std::remove_cvref_t<E>>(operand);
+}
+
+#pragma mark evaluation
+//=============================================================================
+// EVALUATION
+//=============================================================================
+enum class AssignOp : uint8 { Assign, AddAssign, SubAssign };
+
+/**
+ * @brief Evaluates the expression into out[0, size) in one fused pass.
+ * @details Every element only reads the same index of its operands, so `out` may
+ * alias any operand.
+ */
+template <AssignOp Op, Numeric T, Expression E>
+void assign(T *out, const E &expression) {
+  const size_t n = expression.shape().size();
+  exec::parallel_for(0, n, linear_split(), [&](size_t lo, size_t hi) {
+#pragma omp simd
+    for (size_t i = lo; i < hi; ++i) {
+      if constexpr (Op == AssignOp::Assign) {
+        out[i] = static_cast<T>(expression[i]);
+      } else if constexpr (Op == AssignOp::AddAssign) {
+        out[i] += static_cast<T>(expression[i]);
+      } else {
+        out[i] -= static_cast<T>(expression[i]);
+      }
+    }
+  });
+}
+}  // namespace expr
+
+#pragma mark entry_points
+//=============================================================================
+// ENTRY POINTS
+//=============================================================================
+/** @brief Starts a lazily evaluated element-wise expression on a Matrix. */
+template <Numeric T>
+[[nodiscard]] auto lazy(const Matrix<T> &matrix) {
+  return expr::detail::make_operand(matrix);
+}
+
+/** @brief Starts a lazily evaluated element-wise expression on a Vector. */
+template <Numeric T>
+[[nodiscard]] auto lazy(const Vector<T> &vector) {
+  return expr::detail::make_operand(vector);
+}
+
+// A terminal over a temporary would dangle as soon as the statement ends.
+template <Numeric T>
+void lazy(const Matrix<T> &&) = delete;
+template <Numeric T>
+void lazy(const Vector<T> &&) = delete;
+
+/** @brief Materializes a matrix expression into a new Matrix. */
+template <MatrixExpression E>
+[[nodiscard]] auto eval(const E &expression) {
+  return Matrix<typename E::value_type>(expression);
+}
+
+/** @brief Materializes a vector expression into a new Vector. */
+template <VectorExpression E>
+[[nodiscard]] auto eval(const E &expression) {
+  return Vector<typename E::value_type>(expression);
+}
+}  // namespace maf::math
+
+#endif
@@ -0,0 +1,976 @@
+#ifndef FIXED_MATRIX_H
+#define FIXED_MATRIX_H
+#pragma once
+#include "MafLib/main/GlobalHeader.hpp"
+#include "MafLib/utility/Math.hpp"
+#include "Matrix.hpp"
+#include "MatrixView.hpp"
+#include "Vector.hpp"
+#include "VectorView.hpp"
+
+/**
+ * @file FixedMatrix.hpp
+ * @brief Stack-allocated matrices and vectors with compile-time dimensions.
+ *
+ * `FixedMatrix<T, R, C>` and `FixedVector<T, N>` store their elements in a
+ * `std::array`, so creating one never allocates, and every loop has a compile-time
+ * trip count. For small sizes the kernels are unrolled by `detail::static_for`, and
+ * no OpenMP threshold checks are made. They are intended for millions of 3x3, 4x4
+ * or 6x6 operations (rotations, covariance blocks, small Kalman states) where the
+ * heap allocation of a dynamic Matrix dominates the arithmetic.
+ *
+ * All arithmetic, determinant(), inverted(), cholesky() and solve() are constexpr:
+ *
+ * @code
+ * constexpr FixedMatrix<double, 2, 2> A(4.0, 2.0,
+ *                                       2.0, 3.0);
+ * static_assert(A.determinant() == 8.0);
+ * auto x = solve<true>(A, FixedVector<double, 2>(1.0, 2.0));
+ * @endcode
+ *
+ * Both types convert explicitly to and from Matrix/Vector and expose MatrixView /
+ * VectorView windows, so they can be passed to the view kernels.
+ */
+namespace maf::math {
+using namespace maf::util;
+
+template <Numeric T, size_t N>
+  requires(N > 0)
+class FixedVector;
+
+template <Numeric T, size_t R, size_t C>
+  requires(R > 0 && C > 0)
+class FixedMatrix;
+
+namespace detail {
+/** @brief Largest trip count static_for unrolls; longer loops stay loops. */
+inline static constexpr size_t FIXED_UNROLL_LIMIT = 16;
+
+/**
+ * @brief Calls f(i) for i in [0, N), unrolled at compile time when N is small.
+ * @details Unrolling is done with a fold expression rather than relying on the
+ * optimizer, so it also happens in constant evaluation and at -O0.
+ */
+template <size_t N, typename F>
+constexpr void static_for(F &&f) {
+  if constexpr (N <= FIXED_UNROLL_LIMIT) {
+    [&]<size_t... I>(std::index_sequence<I...>) {
+      (f(I), ...);
+    }(std::make_index_sequence<N>{});
+  } else {
+    for (size_t i = 0; i < N; ++i) {
+      f(i);
+    }
+  }
+}
+
+template <Numeric T>
+[[nodiscard]] constexpr T fixed_abs(T value) noexcept {
+  return value < T(0) ? -value : value;
+}
+
+/** @brief std::sqrt at run time, Newton iteration during constant evaluation. */
+template <std::floating_point T>
+[[nodiscard]] constexpr T fixed_sqrt(T value) noexcept {
+  if consteval {
+    if (value <= T(0)) {
+      return T(0);
+    }
+    T current = value < T(1) ? T(1) : value;
+    T previous = T(0);
+    while (current != previous) {
+      previous = current;
+      current = T(0.5) * (current + (value / current));
+      if (current >= previous) {
+        return previous;
+      }
+    }
+    return current;
+  } else {
+    return std::sqrt(value);
+  }
+}
+
+template <typename T, typename U>
+using fixed_div_t = std::conditional_t<std::is_integral_v<T> && std::is_integral_v<U>,
+                                       double, std::common_type_t<T, U>>;
+}  // namespace detail
+
+#pragma mark fixed_vector
+//=============================================================================
+// FIXED VECTOR
+//=============================================================================
+/**
+ * @brief A stack-allocated column vector with a compile-time length.
+ *
+ * @tparam T The numeric type of the vector elements (e.g., float, double, int).
+ * @tparam N Number of elements.
+ */
+template <Numeric T, size_t N>
+  requires(N > 0)
+class FixedVector {
+ public:
+  /** @brief The numeric type of the vector elements. */
+  using value_type = T;
+
+  /** @brief Constructs a zero-filled vector. */
+  constexpr FixedVector() noexcept = default;
+
+  /** @brief Constructs from exactly N values, e.g. `FixedVector<double, 3>(1, 2, 3)`. */
+  template <Numeric... Us>
+    requires(sizeof...(Us) == N)
+  constexpr FixedVector(Us... values) noexcept : _data{static_cast<T>(values)...} {}
+
+  /** @brief Constructs from a std::array of N elements. */
+  constexpr explicit FixedVector(const std::array<T, N> &data) noexcept : _data(data) {}
+
+  /**
+   * @brief Copies a dynamic Vector of the same length.
+   * @throws std::invalid_argument if the lengths do not match.
+   */
+  explicit FixedVector(const Vector<T> &vector) {
+    if (vector.size() != N) {
+      throw std::invalid_argument("Vector size does not match FixedVector size!");
+    }
+    std::copy_n(vector.data(), N, _data.data());
+  }
+
+  /** @brief Gets a mutable pointer to the underlying data. */
+  [[nodiscard]] constexpr T *data() noexcept { return _data.data(); }
+
+  /** @brief Gets a const pointer to the underlying data. */
+  [[nodiscard]] constexpr const T *data() const noexcept { return _data.data(); }
+
+  /** @brief Gets the number of elements. */
+  [[nodiscard]] static constexpr size_t size() noexcept { return N; }
+
+  /** @brief Accesses the element at index with no bounds check. */
+  [[nodiscard]] constexpr T &operator[](size_t index) noexcept { return _data[index]; }
+
+  /** @brief Accesses the element at index with no bounds check. */
+  [[nodiscard]] constexpr const T &operator[](size_t index) const noexcept {
+    return _data[index];
+  }
+
+  /**
+   * @brief Gets a reference to the element at index.
+   * @throws std::out_of_range if the index is invalid.
+   */
+  constexpr T &at(size_t index) {
+    if (index >= N) {
+      throw std::out_of_range("Index out of bounds.");
+    }
+    return _data[index];
+  }
+
+  /**
+   * @brief Gets a const reference to the element at index.
+   * @throws std::out_of_range if the index is invalid.
+   */
+  [[nodiscard]] constexpr const T &at(size_t index) const {
+    if (index >= N) {
+      throw std::out_of_range("Index out of bounds.");
+    }
+    return _data[index];
+  }
+
+  /** @brief Creates a column VectorView over the whole vector. */
+  [[nodiscard]] VectorView<T> view() noexcept {
+    return VectorView<T>(_data.data(), N, COLUMN);
+  }
+
+  /** @brief Creates a const column VectorView over the whole vector. */
+  [[nodiscard]] VectorView<const T> view() const noexcept {
+    return VectorView<const T>(_data.data(), N, COLUMN);
+  }
+
+  /** @brief Copies the elements into a heap-allocated Vector. */
+  [[nodiscard]] Vector<T> to_vector(Orientation orientation = COLUMN) const {
+    Vector<T> result(N, util::uninitialized, orientation);
+    std::copy_n(_data.data(), N, result.data());
+    return result;
+  }
+
+  /** @brief Fills the entire vector with a single value. */
+  constexpr void fill(T value) noexcept { _data.fill(value); }
+
+  /** @brief Dot product with another fixed vector of the same length. */
+  template <Numeric U>
+  [[nodiscard]] constexpr auto dot(const FixedVector<U, N> &other) const noexcept {
+    using R = std::common_type_t<T, U>;
+    R sum = 0;
+    detail::static_for<N>([&](size_t i) {
+      sum += static_cast<R>(_data[i]) * static_cast<R>(other[i]);
+    });
+    return sum;
+  }
+
+  /** @brief Euclidean norm. Integer vectors are promoted to double. */
+  [[nodiscard]] constexpr auto norm() const noexcept {
+    using F = detail::float_promote_t<T>;
+    return detail::fixed_sqrt(static_cast<F>(dot(*this)));
+  }
+
+  /** @brief Cross product, defined for 3-vectors only. */
+  template <Numeric U>
+    requires(N == 3)
+  [[nodiscard]] constexpr auto cross(const FixedVector<U, 3> &other) const noexcept {
+    using R = std::common_type_t<T, U>;
+    const auto a = [&](size_t i) { return static_cast<R>(_data[i]); };
+    const auto b = [&](size_t i) { return static_cast<R>(other[i]); };
+    return FixedVector<R, 3>((a(1) * b(2)) - (a(2) * b(1)), (a(2) * b(0)) - (a(0) * b(2)),
+                             (a(0) * b(1)) - (a(1) * b(0)));
+  }
+
+  /** @brief Checks for exact element-wise equality. */
+  [[nodiscard]] constexpr bool operator==(const FixedVector &other) const noexcept =
+      default;
+
+  /** @brief Unary minus. */
+  [[nodiscard]] constexpr FixedVector operator-() const noexcept {
+    FixedVector result;
+    detail::static_for<N>([&](size_t i) { result[i] = -_data[i]; });
+    return result;
+  }
+
+  /** @brief Element-wise addition. */
+  template <Numeric U>
+  [[nodiscard]] constexpr auto operator+(const FixedVector<U, N> &other) const noexcept {
+    using R = std::common_type_t<T, U>;
+    FixedVector<R, N> result;
+    detail::static_for<N>([&](size_t i) {
+      result[i] = static_cast<R>(_data[i]) + static_cast<R>(other[i]);
+    });
+    return result;
+  }
+
+  /** @brief Element-wise subtraction. */
+  template <Numeric U>
+  [[nodiscard]] constexpr auto operator-(const FixedVector<U, N> &other) const noexcept {
+    using R = std::common_type_t<T, U>;
+    FixedVector<R, N> result;
+    detail::static_for<N>([&](size_t i) {
+      result[i] = static_cast<R>(_data[i]) - static_cast<R>(other[i]);
+    });
+    return result;
+  }
+
+  /** @brief Scalar multiplication (FixedVector * scalar). */
+  template <Numeric U>
+  [[nodiscard]] constexpr auto operator*(const U &scalar) const noexcept {
+    using R = std::common_type_t<T, U>;
+    FixedVector<R, N> result;
+    detail::static_for<N>([&](size_t i) {
+      result[i] = static_cast<R>(_data[i]) * static_cast<R>(scalar);
+    });
+    return result;
+  }
+
+  /** @brief Scalar division. Forces double if both are integers. */
+  template <Numeric U>
+  [[nodiscard]] constexpr auto operator/(const U &scalar) const noexcept {
+    using R = detail::fixed_div_t<T, U>;
+    FixedVector<R, N> result;
+    detail::static_for<N>([&](size_t i) {
+      result[i] = static_cast<R>(_data[i]) / static_cast<R>(scalar);
+    });
+    return result;
+  }
+
+  /** @brief Element-wise addition assignment. Doesn't change T. */
+  template <Numeric U>
+  constexpr FixedVector &operator+=(const FixedVector<U, N> &other) noexcept {
+    detail::static_for<N>([&](size_t i) { _data[i] += static_cast<T>(other[i]); });
+    return *this;
+  }
+
+  /** @brief Element-wise subtraction assignment. Doesn't change T. */
+  template <Numeric U>
+  constexpr FixedVector &operator-=(const FixedVector<U, N> &other) noexcept {
+    detail::static_for<N>([&](size_t i) { _data[i] -= static_cast<T>(other[i]); });
+    return *this;
+  }
+
+  /** @brief Scalar multiplication assignment. Doesn't change T. */
+  template <Numeric U>
+  constexpr FixedVector &operator*=(const U &scalar) noexcept {
+    detail::static_for<N>([&](size_t i) { _data[i] *= scalar; });
+    return *this;
+  }
+
+ private:
+  std::array<T, N> _data{};
+};
+
+/** @brief Scalar multiplication (scalar * FixedVector). */
+template <Numeric U, Numeric T, size_t N>
+[[nodiscard]] constexpr auto operator*(const U &scalar,
+                                       const FixedVector<T, N> &vector) noexcept {
+  return vector * scalar;
+}
+
+#pragma mark fixed_matrix
+//=============================================================================
+// FIXED MATRIX
+//=============================================================================
+/**
+ * @brief A stack-allocated, row-major matrix with compile-time dimensions.
+ *
+ * @tparam T The numeric type of the matrix elements (e.g., float, double, int).
+ * @tparam R Number of rows.
+ * @tparam C Number of columns.
+ */
+template <Numeric T, size_t R, size_t C>
+  requires(R > 0 && C > 0)
+class FixedMatrix {
+ public:
+  /** @brief The numeric type of the matrix elements. */
+  using value_type = T;
+
+#pragma mark constructors
+  // ----------------------------------
+  // CONSTRUCTORS
+  // ----------------------------------
+
+  /** @brief Constructs a zero-filled matrix. */
+  constexpr FixedMatrix() noexcept = default;
+
+  /** @brief Constructs from exactly R * C values in row-major order. */
+  template <Numeric... Us>
+    requires(sizeof...(Us) == R * C)
+  constexpr FixedMatrix(Us... values) noexcept : _data{static_cast<T>(values)...} {}
+
+  /** @brief Constructs from a std::array of R * C elements in row-major order. */
+  constexpr explicit FixedMatrix(const std::array<T, R * C> &data) noexcept
+      : _data(data) {}
+
+  /**
+   * @brief Copies a dynamic Matrix of the same shape.
+   * @throws std::invalid_argument if the dimensions do not match.
+   */
+  explicit FixedMatrix(const Matrix<T> &matrix) {
+    if (matrix.row_count() != R || matrix.column_count() != C) {
+      throw std::invalid_argument("Matrix dimensions do not match FixedMatrix size!");
+    }
+    std::copy_n(matrix.data(), R * C, _data.data());
+  }
+
+  /**
+   * @brief Copies a MatrixView of the same shape.
+   * @throws std::invalid_argument if the dimensions do not match.
+   */
+  template <Numeric U>
+    requires std::same_as<std::remove_const_t<U>, T>
+  explicit FixedMatrix(const MatrixView<U> &view) {
+    if (view.row_count() != R || view.column_count() != C) {
+      throw std::invalid_argument("View dimensions do not match FixedMatrix size!");
+    }
+    for (size_t i = 0; i < R; ++i) {
+      for (size_t j = 0; j < C; ++j) {
+        _data[(i * C) + j] = view[i, j];
+      }
+    }
+  }
+
+  /** @brief Returns the identity matrix. */
+  [[nodiscard]] static constexpr FixedMatrix identity() noexcept
+    requires(R == C)
+  {
+    FixedMatrix result;
+    detail::static_for<R>([&](size_t i) { result[i, i] = T(1); });
+    return result;
+  }
+
+#pragma mark getters_setters
+  // ----------------------------------
+  // GETTERS & SETTERS
+  // ----------------------------------
+
+  /** @brief Gets a mutable pointer to the underlying data. */
+  [[nodiscard]] constexpr T *data() noexcept { return _data.data(); }
+
+  /** @brief Gets a const pointer to the underlying data. */
+  [[nodiscard]] constexpr const T *data() const noexcept { return _data.data(); }
+
+  /** @brief Gets the number of rows. */
+  [[nodiscard]] static constexpr size_t row_count() noexcept { return R; }
+
+  /** @brief Gets the number of columns. */
+  [[nodiscard]] static constexpr size_t column_count() noexcept { return C; }
+
+  /** @brief Gets the total number of elements (R * C). */
+  [[nodiscard]] static constexpr size_t size() noexcept { return R * C; }
+
+  /**
+   * @brief Accesses the element at [row][col] with no bounds check.
+   * @return pointer to the start of the specified row.
+   */
+  [[nodiscard]] constexpr T *operator[](size_t row) noexcept { return &_data[row * C]; }
+
+  /**
+   * @brief Accesses the element at [row][col] with no bounds check.
+   * @return const pointer to the start of the specified row.
+   */
+  [[nodiscard]] constexpr const T *operator[](size_t row) const noexcept {
+    return &_data[row * C];
+  }
+
+  /** @brief Accesses the element at [row, col] with no bounds check. */
+  [[nodiscard]] constexpr T &operator[](size_t row, size_t col) noexcept {
+    return _data[(row * C) + col];
+  }
+
+  /** @brief Accesses the element at [row, col] with no bounds check. */
+  [[nodiscard]] constexpr const T &operator[](size_t row, size_t col) const noexcept {
+    return _data[(row * C) + col];
+  }
+
+  /**
+   * @brief Gets a mutable reference to the element at (row, col).
+   * @throws std::out_of_range if the index is invalid.
+   */
+  constexpr T &at(size_t row, size_t col) {
+    if (row >= R || col >= C) {
+      throw std::out_of_range("Index out of bounds.");
+    }
+    return _data[(row * C) + col];
+  }
+
+  /**
+   * @brief Gets a const reference to the element at (row, col).
+   * @throws std::out_of_range if the index is invalid.
+   */
+  [[nodiscard]] constexpr const T &at(size_t row, size_t col) const {
+    if (row >= R || col >= C) {
+      throw std::out_of_range("Index out of bounds.");
+    }
+    return _data[(row * C) + col];
+  }
+
+  /** @brief Creates a MatrixView over the whole matrix. */
+  [[nodiscard]] MatrixView<T> view() noexcept {
+    return MatrixView<T>(_data.data(), R, C, C);
+  }
+
+  /** @brief Creates a const MatrixView over the whole matrix. */
+  [[nodiscard]] MatrixView<const T> view() const noexcept {
+    return MatrixView<const T>(_data.data(), R, C, C);
+  }
+
+  /** @brief Copies the elements into a heap-allocated Matrix. */
+  [[nodiscard]] Matrix<T> to_matrix() const {
+    Matrix<T> result(R, C, util::uninitialized);
+    std::copy_n(_data.data(), R * C, result.data());
+    return result;
+  }
+
+  /** @brief Returns a copy of the given row. */
+  [[nodiscard]] constexpr FixedVector<T, C> row(size_t row) const noexcept {
+    FixedVector<T, C> result;
+    detail::static_for<C>([&](size_t j) { result[j] = (*this)[row, j]; });
+    return result;
+  }
+
+  /** @brief Returns a copy of the given column. */
+  [[nodiscard]] constexpr FixedVector<T, R> column(size_t col) const noexcept {
+    FixedVector<T, R> result;
+    detail::static_for<R>([&](size_t i) { result[i] = (*this)[i, col]; });
+    return result;
+  }
+
+#pragma mark checkers
+  // ----------------------------------
+  // CHECKERS
+  // ----------------------------------
+
+  /** @brief Checks if the matrix is square (R == C). */
+  [[nodiscard]] static constexpr bool is_square() noexcept { return R == C; }
+
+  /** @brief Checks if the matrix is symmetric (A == A^T). */
+  [[nodiscard]] constexpr bool is_symmetric() const noexcept {
+    if constexpr (R != C) {
+      return false;
+    } else {
+      bool symmetric = true;
+      detail::static_for<R>([&](size_t i) {
+        for (size_t j = i + 1; j < C; ++j) {
+          symmetric = symmetric && (*this)[i, j] == (*this)[j, i];
+        }
+      });
+      return symmetric;
+    }
+  }
+
+#pragma mark methods
+  // ----------------------------------
+  // METHODS
+  // ----------------------------------
+
+  /** @brief Creates new matrix with same elements but different type. */
+  template <Numeric U>
+  [[nodiscard]] constexpr FixedMatrix<U, R, C> cast() const noexcept {
+    FixedMatrix<U, R, C> result;
+    detail::static_for<R * C>(
+        [&](size_t i) { result.data()[i] = static_cast<U>(_data[i]); });
+    return result;
+  }
+
+  /** @brief Fills the entire matrix with a single value. */
+  constexpr void fill(T value) noexcept { _data.fill(value); }
+
+  /** @brief Creates and returns the transpose of this matrix. */
+  [[nodiscard]] constexpr FixedMatrix<T, C, R> transposed() const noexcept {
+    FixedMatrix<T, C, R> result;
+    detail::static_for<R>([&](size_t i) {
+      detail::static_for<C>([&](size_t j) { result[j, i] = (*this)[i, j]; });
+    });
+    return result;
+  }
+
+  /** @brief Sum of the diagonal elements. */
+  [[nodiscard]] constexpr T trace() const noexcept
+    requires(R == C)
+  {
+    T sum = 0;
+    detail::static_for<R>([&](size_t i) { sum += (*this)[i, i]; });
+    return sum;
+  }
+
+  /**
+   * @brief Computes the determinant.
+   * @details Closed form up to 3x3, partial-pivoting LU (or Cholesky when is_spd)
+   * above. Integer matrices are promoted to double.
+   */
+  template <bool is_spd = false>
+  [[nodiscard]] constexpr auto determinant() const
+    requires(R == C);
+
+  /**
+   * @brief Computes the inverse.
+   * @details Adjugate formula up to 3x3, partial-pivoting LU solved against the unit
+   * vectors above. Integer matrices are promoted to double.
+   * @throws std::runtime_error if the matrix is singular.
+   */
+  [[nodiscard]] constexpr auto inverted() const
+    requires(R == C);
+
+#pragma mark operators
+  // ----------------------------------
+  // OPERATORS
+  // ----------------------------------
+
+  /**
+   * @brief Checks for exact element-wise equality.
+   * @details For floating-point, use `loosely_equal()`.
+   */
+  [[nodiscard]] constexpr bool operator==(const FixedMatrix &other) const noexcept =
+      default;
+
+  /** @brief Unary minus. */
+  [[nodiscard]] constexpr FixedMatrix operator-() const noexcept {
+    FixedMatrix result;
+    detail::static_for<R * C>([&](size_t i) { result.data()[i] = -_data[i]; });
+    return result;
+  }
+
+  /** @brief Element-wise matrix addition. */
+  template <Numeric U>
+  [[nodiscard]] constexpr auto operator+(
+      const FixedMatrix<U, R, C> &other) const noexcept {
+    using V = std::common_type_t<T, U>;
+    FixedMatrix<V, R, C> result;
+    detail::static_for<R * C>([&](size_t i) {
+      result.data()[i] = static_cast<V>(_data[i]) + static_cast<V>(other.data()[i]);
+    });
+    return result;
+  }
+
+  /** @brief Element-wise matrix subtraction. */
+  template <Numeric U>
+  [[nodiscard]] constexpr auto operator-(
+      const FixedMatrix<U, R, C> &other) const noexcept {
+    using V = std::common_type_t<T, U>;
+    FixedMatrix<V, R, C> result;
+    detail::static_for<R * C>([&](size_t i) {
+      result.data()[i] = static_cast<V>(_data[i]) - static_cast<V>(other.data()[i]);
+    });
+    return result;
+  }
+
+  /** @brief Element-wise scalar multiplication (FixedMatrix * scalar). */
+  template <Numeric U>
+  [[nodiscard]] constexpr auto operator*(const U &scalar) const noexcept {
+    using V = std::common_type_t<T, U>;
+    FixedMatrix<V, R, C> result;
+    detail::static_for<R * C>([&](size_t i) {
+      result.data()[i] = static_cast<V>(_data[i]) * static_cast<V>(scalar);
+    });
+    return result;
+  }
+
+  /** @brief Element-wise scalar division. Forces double if both are integers. */
+  template <Numeric U>
+  [[nodiscard]] constexpr auto operator/(const U &scalar) const noexcept {
+    using V = detail::fixed_div_t<T, U>;
+    FixedMatrix<V, R, C> result;
+    detail::static_for<R * C>([&](size_t i) {
+      result.data()[i] = static_cast<V>(_data[i]) / static_cast<V>(scalar);
+    });
+    return result;
+  }
+
+  /** @brief Element-wise matrix addition assignment. Doesn't change T. */
+  template <Numeric U>
+  constexpr FixedMatrix &operator+=(const FixedMatrix<U, R, C> &other) noexcept {
+    detail::static_for<R * C>(
+        [&](size_t i) { _data[i] += static_cast<T>(other.data()[i]); });
+    return *this;
+  }
+
+  /** @brief Element-wise matrix subtraction assignment. Doesn't change T. */
+  template <Numeric U>
+  constexpr FixedMatrix &operator-=(const FixedMatrix<U, R, C> &other) noexcept {
+    detail::static_for<R * C>(
+        [&](size_t i) { _data[i] -= static_cast<T>(other.data()[i]); });
+    return *this;
+  }
+
+  /** @brief Scalar multiplication assignment. Doesn't change T. */
+  template <Numeric U>
+  constexpr FixedMatrix &operator*=(const U &scalar) noexcept {
+    detail::static_for<R * C>([&](size_t i) { _data[i] *= scalar; });
+    return *this;
+  }
+
+  /**
+   * @brief Matrix multiplication, fully unrolled for small sizes.
+   * @return FixedMatrix of the common, promoted type and size R x K.
+   */
+  template <Numeric U, size_t K>
+  [[nodiscard]] constexpr auto operator*(
+      const FixedMatrix<U, C, K> &other) const noexcept {
+    using V = std::common_type_t<T, U>;
+    FixedMatrix<V, R, K> result;
+    detail::static_for<R>([&](size_t i) {
+      detail::static_for<K>([&](size_t j) {
+        V sum = 0;
+        detail::static_for<C>([&](size_t k) {
+          sum += static_cast<V>((*this)[i, k]) * static_cast<V>(other[k, j]);
+        });
+        result[i, j] = sum;
+      });
+    });
+    return result;
+  }
+
+  /** @brief Matrix-vector multiplication (FixedMatrix * column FixedVector). */
+  template <Numeric U>
+  [[nodiscard]] constexpr auto operator*(const FixedVector<U, C> &other) const noexcept {
+    using V = std::common_type_t<T, U>;
+    FixedVector<V, R> result;
+    detail::static_for<R>([&](size_t i) {
+      V sum = 0;
+      detail::static_for<C>([&](size_t k) {
+        sum += static_cast<V>((*this)[i, k]) * static_cast<V>(other[k]);
+      });
+      result[i] = sum;
+    });
+    return result;
+  }
+
+  // --- Debugging and printing ---
+
+  /**
+   * @brief Prints the matrix contents to std::cout.
+   * @details Sets floating point precision for readability.
+   */
+  void print() const {
+    if constexpr (std::is_floating_point_v<T>) {
+      std::cout << std::fixed << std::setprecision(FLOAT_PRECISION);
+    }
+    for (size_t i = 0; i < R; ++i) {
+      for (size_t j = 0; j < C; ++j) {
+        std::cout << (*this)[i, j] << ' ';
+      }
+      std::cout << std::endl;
+    }
+  }
+
+ private:
+  std::array<T, R * C> _data{};
+};
+
+/** @brief Element-wise scalar multiplication (scalar * FixedMatrix). */
+template <Numeric U, Numeric T, size_t R, size_t C>
+[[nodiscard]] constexpr auto operator*(const U &scalar,
+                                       const FixedMatrix<T, R, C> &matrix) noexcept {
+  return matrix * scalar;
+}
+
+/** @brief Checks if two fixed matrices are equal within EPSILON. */
+template <Numeric T, Numeric U, size_t R, size_t C>
+[[nodiscard]] bool loosely_equal(const FixedMatrix<T, R, C> &lhs,
+                                 const FixedMatrix<U, R, C> &rhs,
+                                 double epsilon = EPSILON) {
+  for (size_t i = 0; i < R * C; ++i) {
+    if (!is_close(lhs.data()[i], rhs.data()[i], epsilon)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#pragma mark decompositions
+//=============================================================================
+// DECOMPOSITIONS
+//=============================================================================
+namespace detail {
+/**
+ * @brief In-place LU with partial pivoting of a small square matrix.
+ * @param perm Receives the row permutation (row i of U comes from row perm[i]).
+ * @return The sign of the permutation, or 0 if a pivot vanished.
+ */
+template <std::floating_point F, size_t N>
+[[nodiscard]] constexpr int fixed_lu(FixedMatrix<F, N, N> &A,
+                                     std::array<size_t, N> &perm) noexcept {
+  F scale = 0;
+  for (size_t i = 0; i < N * N; ++i) {
+    scale = std::max(scale, fixed_abs(A.data()[i]));
+  }
+  const F tolerance = static_cast<F>(N) * std::numeric_limits<F>::epsilon() * scale;
+
+  int sign = 1;
+  for (size_t i = 0; i < N; ++i) {
+    perm[i] = i;
+  }
+  for (size_t k = 0; k < N; ++k) {
+    size_t pivot = k;
+    for (size_t i = k + 1; i < N; ++i) {
+      if (fixed_abs(A[i, k]) > fixed_abs(A[pivot, k])) {
+        pivot = i;
+      }
+    }
+    if (fixed_abs(A[pivot, k]) <= tolerance) {
+      return 0;
+    }
+    if (pivot != k) {
+      static_for<N>([&](size_t j) { std::swap(A[k, j], A[pivot, j]); });
+      std::swap(perm[k], perm[pivot]);
+      sign = -sign;
+    }
+    const F inv_pivot = F(1) / A[k, k];
+    for (size_t i = k + 1; i < N; ++i) {
+      A[i, k] *= inv_pivot;
+      const F l_ik = A[i, k];
+      for (size_t j = k + 1; j < N; ++j) {
+        A[i, j] -= l_ik * A[k, j];
+      }
+    }
+  }
+  return sign;
+}
+
+/** @brief Solves LU x = P b in place, with L and U packed as fixed_lu leaves them. */
+template <std::floating_point F, size_t N>
+[[nodiscard]] constexpr FixedVector<F, N> fixed_lu_solve(
+    const FixedMatrix<F, N, N> &LU, const std::array<size_t, N> &perm,
+    const FixedVector<F, N> &b) noexcept {
+  FixedVector<F, N> x;
+  for (size_t i = 0; i < N; ++i) {
+    F sum = b[perm[i]];
+    for (size_t j = 0; j < i; ++j) {
+      sum -= LU[i, j] * x[j];
+    }
+    x[i] = sum;
+  }
+  for (size_t t = 0; t < N; ++t) {
+    const size_t i = N - 1 - t;
+    F sum = x[i];
+    for (size_t j = i + 1; j < N; ++j) {
+      sum -= LU[i, j] * x[j];
+    }
+    x[i] = sum / LU[i, i];
+  }
+  return x;
+}
+
+/** @brief Solves L L^T x = b for a lower-triangular Cholesky factor L. */
+template <std::floating_point F, size_t N>
+[[nodiscard]] constexpr FixedVector<F, N> fixed_cholesky_solve(
+    const FixedMatrix<F, N, N> &L, const FixedVector<F, N> &b) noexcept {
+  FixedVector<F, N> x;
+  for (size_t i = 0; i < N; ++i) {
+    F sum = b[i];
+    for (size_t j = 0; j < i; ++j) {
+      sum -= L[i, j] * x[j];
+    }
+    x[i] = sum / L[i, i];
+  }
+  for (size_t t = 0; t < N; ++t) {
+    const size_t i = N - 1 - t;
+    F sum = x[i];
+    for (size_t j = i + 1; j < N; ++j) {
+      sum -= L[j, i] * x[j];
+    }
+    x[i] = sum / L[i, i];
+  }
+  return x;
+}
+}  // namespace detail
+
+/**
+ * @brief Computes the Cholesky factor L (A = LL^T) of a small symmetric positive
+ * definite matrix.
+ * @return Lower triangular FixedMatrix, promoted to double for integer input.
+ * @throws std::invalid_argument if the matrix is not symmetric or not positive
+ * definite.
+ */
+template <Numeric T, size_t N>
+[[nodiscard]] constexpr auto cholesky(const FixedMatrix<T, N, N> &matrix) {
+  using F = detail::float_promote_t<T>;
+  if (!matrix.is_symmetric()) {
+    throw std::invalid_argument(
+        "Matrix must be symmetric to try Cholesky decomposition!");
+  }
+
+  FixedMatrix<F, N, N> L;
+  for (size_t j = 0; j < N; ++j) {
+    F sum = 0;
+    for (size_t k = 0; k < j; ++k) {
+      sum += L[j, k] * L[j, k];
+    }
+    const F diag_val = static_cast<F>(matrix[j, j]) - sum;
+    if (diag_val <= F(0)) {
+      throw std::invalid_argument("Matrix is not positive definite!");
+    }
+    L[j, j] = detail::fixed_sqrt(diag_val);
+
+    for (size_t i = j + 1; i < N; ++i) {
+      F sum_i = 0;
+      for (size_t k = 0; k < j; ++k) {
+        sum_i += L[i, k] * L[j, k];
+      }
+      L[i, j] = (static_cast<F>(matrix[i, j]) - sum_i) / L[j, j];
+    }
+  }
+  return L;
+}
+
+/**
+ * @brief Solves A x = b for a small square system.
+ * @tparam is_spd Use Cholesky instead of partial-pivoting LU when A is known to be
+ * symmetric positive definite.
+ * @return Solution vector, promoted to double for integer input.
+ * @throws std::runtime_error if A is singular (LU path).
+ * @throws std::invalid_argument if A is not positive definite (Cholesky path).
+ */
+template <bool is_spd = false, Numeric T, Numeric U, size_t N>
+[[nodiscard]] constexpr auto solve(const FixedMatrix<T, N, N> &A,
+                                   const FixedVector<U, N> &b) {
+  using F = detail::float_promote_t<std::common_type_t<T, U>>;
+  FixedVector<F, N> rhs;
+  detail::static_for<N>([&](size_t i) { rhs[i] = static_cast<F>(b[i]); });
+
+  if constexpr (is_spd) {
+    return detail::fixed_cholesky_solve(cholesky(A.template cast<F>()), rhs);
+  } else {
+    FixedMatrix<F, N, N> LU = A.template cast<F>();
+    std::array<size_t, N> perm{};
+    if (detail::fixed_lu(LU, perm) == 0) {
+      throw std::runtime_error("Matrix is singular; pivot is near zero.");
+    }
+    return detail::fixed_lu_solve(LU, perm, rhs);
+  }
+}
+
+#pragma mark out_of_class
+//=============================================================================
+// OUT-OF-CLASS MEMBER DEFINITIONS
+//=============================================================================
+template <Numeric T, size_t R, size_t C>
+  requires(R > 0 && C > 0)
+template <bool is_spd>
+constexpr auto FixedMatrix<T, R, C>::determinant() const
+  requires(R == C)
+{
+  using F = detail::float_promote_t<T>;
+  const auto a = [&](size_t i, size_t j) { return static_cast<F>((*this)[i, j]); };
+
+  if constexpr (R == 1) {
+    return a(0, 0);
+  } else if constexpr (R == 2) {
+    return (a(0, 0) * a(1, 1)) - (a(0, 1) * a(1, 0));
+  } else if constexpr (R == 3) {
+    return (a(0, 0) * ((a(1, 1) * a(2, 2)) - (a(1, 2) * a(2, 1)))) -
+           (a(0, 1) * ((a(1, 0) * a(2, 2)) - (a(1, 2) * a(2, 0)))) +
+           (a(0, 2) * ((a(1, 0) * a(2, 1)) - (a(1, 1) * a(2, 0))));
+  } else if constexpr (is_spd) {
+    // res = det(L)^2
+    const auto L = cholesky(*this);
+    F det = 1;
+    detail::static_for<R>([&](size_t i) { det *= L[i, i]; });
+    return det * det;
+  } else {
+    // res = det(U) * det(P), det(L) = 1
+    FixedMatrix<F, R, R> LU = cast<F>();
+    std::array<size_t, R> perm{};
+    const int sign = detail::fixed_lu(LU, perm);
+    if (sign == 0) {
+      return F(0);
+    }
+    auto det = static_cast<F>(sign);
+    detail::static_for<R>([&](size_t i) { det *= LU[i, i]; });
+    return det;
+  }
+}
+
+template <Numeric T, size_t R, size_t C>
+  requires(R > 0 && C > 0)
+constexpr auto FixedMatrix<T, R, C>::inverted() const
+  requires(R == C)
+{
+  using F = detail::float_promote_t<T>;
+  const auto a = [&](size_t i, size_t j) { return static_cast<F>((*this)[i, j]); };
+  FixedMatrix<F, R, R> result;
+
+  if constexpr (R <= 3) {
+    const F det = determinant();
+    if (det == F(0)) {
+      throw std::runtime_error("Matrix is singular; pivot is near zero.");
+    }
+    const F inv_det = F(1) / det;
+    if constexpr (R == 1) {
+      result[0, 0] = inv_det;
+    } else if constexpr (R == 2) {
+      result = FixedMatrix<F, 2, 2>(a(1, 1), -a(0, 1), -a(1, 0), a(0, 0)) * inv_det;
+    } else {
+      // Adjugate: cofactor (j, i) divided by det.
+      detail::static_for<3>([&](size_t i) {
+        detail::static_for<3>([&](size_t j) {
+          const size_t r0 = (j + 1) % 3;
+          const size_t r1 = (j + 2) % 3;
+          const size_t c0 = (i + 1) % 3;
+          const size_t c1 = (i + 2) % 3;
+          result[i, j] = ((a(r0, c0) * a(r1, c1)) - (a(r0, c1) * a(r1, c0))) * inv_det;
+        });
+      });
+    }
+  } else {
+    FixedMatrix<F, R, R> LU = cast<F>();
+    std::array<size_t, R> perm{};
+    if (detail::fixed_lu(LU, perm) == 0) {
+      throw std::runtime_error("Matrix is singular; pivot is near zero.");
+    }
+    // Solve for one unit vector at a time; column j of the inverse.
+    for (size_t j = 0; j < R; ++j) {
+      FixedVector<F, R> e;
+      e[j] = F(1);
+      const auto column = detail::fixed_lu_solve(LU, perm, e);
+      detail::static_for<R>([&](size_t i) { result[i, j] = column[i]; });
+    }
+  }
+  return result;
+}
+
+}  // namespace maf::math
+#endif
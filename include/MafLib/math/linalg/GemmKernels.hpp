@@ -0,0 +1,834 @@
+#ifndef GEMM_KERNELS_H
+#define GEMM_KERNELS_H
+#pragma once
+#include "MafLib/main/GlobalHeader.hpp"
+#include "MafLib/utility/Hardware.hpp"
+#include "MafLib/utility/Math.hpp"
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @file GemmKernels.hpp
+ * @brief Packed, register-blocked general matrix multiplication engine.
+ *
+ * This header implements C = alpha * A * B + beta * C in the style of Goto/BLIS:
+ * - The loop over columns of C is split into NC wide blocks (sized to L3),
+ * - the inner dimension is split into KC deep blocks (sized to L1),
+ * - the rows of C are split into MC tall blocks (sized to L2).
+ *
+ * Each KC x NC block of B and each MC x KC block of A is copied ("packed") into a
+ * contiguous, aligned buffer laid out in the exact order the micro-kernel reads it.
+ * The micro-kernel then keeps an MR x NR tile of C in vector registers for the
+ * whole KC loop. Packing is also where element types are converted, so mixed-type
+ * products never materialize converted copies of their operands.
+ *
+ * All operands are described by a pointer and a (row stride, column stride) pair,
+ * so row-major, column-major, transposed and strided sub-blocks are all supported
+ * without copies.
+ *
+ * More information:
+ * https://www.cs.utexas.edu/~flame/pubs/GotoTOMS_final.pdf
+ */
+namespace maf::math::kernels {
+using namespace maf::util;
+
+namespace detail {
+#pragma mark simd
+//=============================================================================
+// SIMD REGISTER WRAPPERS
+//=============================================================================
+/** @brief Thin wrapper over vector registers used by the micro-kernel. */
+template <typename R>
+struct simd {
+  static constexpr bool available = false;
+};
+
+#if defined(__AVX512F__)
+template <>
+struct simd<double> {
+  static constexpr bool available = true;
+  static constexpr size_t width = 8;
+  using reg = __m512d;
+  static reg zero() { return _mm512_setzero_pd(); }
+  static reg load(const double *p) { return _mm512_loadu_pd(p); }
+  static void store(double *p, reg v) { _mm512_storeu_pd(p, v); }
+  static reg broadcast(const double *p) { return _mm512_set1_pd(*p); }
+  static reg fmadd(reg a, reg b, reg c) { return _mm512_fmadd_pd(a, b, c); }
+};
+
+template <>
+struct simd<float> {
+  static constexpr bool available = true;
+  static constexpr size_t width = 16;
+  using reg = __m512;
+  static reg zero() { return _mm512_setzero_ps(); }
+  static reg load(const float *p) { return _mm512_loadu_ps(p); }
+  static void store(float *p, reg v) { _mm512_storeu_ps(p, v); }
+  static reg broadcast(const float *p) { return _mm512_set1_ps(*p); }
+  static reg fmadd(reg a, reg b, reg c) { return _mm512_fmadd_ps(a, b, c); }
+};
+#elif defined(__AVX2__) && defined(__FMA__)
+template <>
+struct simd<double> {
+  static constexpr bool available = true;
+  static constexpr size_t width = 4;
+  using reg = __m256d;
+  static reg zero() { return _mm256_setzero_pd(); }
+  static reg load(const double *p) { return _mm256_loadu_pd(p); }
+  static void store(double *p, reg v) { _mm256_storeu_pd(p, v); }
+  static reg broadcast(const double *p) { return _mm256_broadcast_sd(p); }
+  static reg fmadd(reg a, reg b, reg c) { return _mm256_fmadd_pd(a, b, c); }
+};
+
+template <>
+struct simd<float> {
+  static constexpr bool available = true;
+  static constexpr size_t width = 8;
+  using reg = __m256;
+  static reg zero() { return _mm256_setzero_ps(); }
+  static reg load(const float *p) { return _mm256_loadu_ps(p); }
+  static void store(float *p, reg v) { _mm256_storeu_ps(p, v); }
+  static reg broadcast(const float *p) { return _mm256_broadcast_ss(p); }
+  static reg fmadd(reg a, reg b, reg c) { return _mm256_fmadd_ps(a, b, c); }
+};
+#endif
+
+#pragma mark blocking
+//=============================================================================
+// BLOCKING PARAMETERS
+//=============================================================================
+/**
+ * @brief Register tile (MR x NR) of the micro-kernel for accumulation type R.
+ * @details With AVX-512 the tile uses 28 of the 32 zmm registers for accumulators,
+ * with AVX2 12 of the 16 ymm registers. Other types and targets use a portable
+ * kernel that relies on the compiler to vectorize the NR loop.
+ */
+template <typename R>
+struct gemm_tile {
+  static constexpr size_t MR = 4;
+  static constexpr size_t NR = 8;
+};
+
+template <typename R>
+  requires(simd<R>::available)
+struct gemm_tile<R> {
+#if defined(__AVX512F__)
+  static constexpr size_t MR = 14;
+#else
+  static constexpr size_t MR = 6;
+#endif
+  static constexpr size_t NR = 2 * simd<R>::width;
+};
+
+/** @brief Cache blocking sizes of the packed GEMM. */
+struct GemmBlocking {
+  size_t mc;  // Rows of the packed A block (L2 resident)
+  size_t kc;  // Depth of packed A and B blocks (L1 resident micro-panels)
+  size_t nc;  // Columns of the packed B block (L3 resident)
+};
+
+/**
+ * @brief Derives cache blocking sizes for accumulation type R from the host caches.
+ * @details KC is chosen so that one KC x NR micro-panel of B fills half of L1, MC so
+ * that the packed A block fills half of L2 and NC so that the packed B block fills
+ * half of L3. All sizes are multiples of the register tile.
+ */
+template <typename R>
+[[nodiscard]] inline GemmBlocking make_gemm_blocking() {
+  constexpr size_t MR = gemm_tile<R>::MR;
+  constexpr size_t NR = gemm_tile<R>::NR;
+  const CacheSizes &cache = cache_sizes();
+
+  size_t kc = cache.l1d / (2 * NR * sizeof(R));
+  kc = std::clamp<size_t>(kc - (kc % 8), 64, 1024);
+
+  // Clamp before rounding down: the packing loops fill whole MR x kc and kc x NR
+  // micro-panels, so mc and nc must stay multiples of the tile.
+  size_t mc = cache.l2 / (2 * kc * sizeof(R));
+  mc = std::max(MR, std::min<size_t>(mc, 4096) / MR * MR);
+
+  const size_t l3 = (cache.l3 != 0) ? cache.l3 : 4 * cache.l2;
+  size_t nc = l3 / (2 * kc * sizeof(R));
+  nc = std::max(NR, std::min<size_t>(nc, 8192) / NR * NR);
+
+  return {mc, kc, nc};
+}
+
+/** @brief Cached blocking sizes for accumulation type R. */
+template <typename R>
+[[nodiscard]] inline const GemmBlocking &gemm_blocking() {
+  static const GemmBlocking blocking = make_gemm_blocking<R>();
+  return blocking;
+}
+
+/** @brief Products with fewer multiply-adds than this skip packing entirely. */
+inline static constexpr size_t GEMM_SMALL_LIMIT = 32UL * 32UL * 32UL;
+
+#pragma mark buffers
+//=============================================================================
+// PACKING BUFFERS
+//=============================================================================
+/** @brief Minimal owning, cache-line aligned and uninitialized buffer. */
+template <typename R>
+class PackBuffer {
+ public:
+  static constexpr std::align_val_t ALIGNMENT{64};
+
+  PackBuffer() = default;
+  explicit PackBuffer(size_t count)
+      : _data(static_cast<R *>(::operator new(count * sizeof(R), ALIGNMENT))) {}
+  PackBuffer(const PackBuffer &) = delete;
+  PackBuffer &operator=(const PackBuffer &) = delete;
+  ~PackBuffer() { ::operator delete(_data, ALIGNMENT); }
+
+  [[nodiscard]] R *data() noexcept { return _data; }
+
+ private:
+  R *_data = nullptr;
+};
+
+#pragma mark packing
+//=============================================================================
+// PACKING ROUTINES
+//=============================================================================
+/**
+ * @brief Packs an mc x kc block of A into MR tall micro-panels.
+ * @details Panel p holds rows [p * MR, p * MR + MR) stored k-major, so the
+ * micro-kernel reads MR consecutive values per step of k. Rows past mc are zero
+ * padded. Elements are converted to R on the fly.
+ */
+template <typename R, size_t MR, typename TA>
+void pack_a(size_t mc, size_t kc, const TA *a, size_t rsa, size_t csa, R *buffer) {
+  for (size_t ir = 0; ir < mc; ir += MR) {
+    const size_t mr = std::min(MR, mc - ir);
+    const TA *a_panel = a + (ir * rsa);
+    R *out = buffer + (ir * kc);
+    for (size_t p = 0; p < kc; ++p) {
+      const TA *a_col = a_panel + (p * csa);
+      for (size_t i = 0; i < mr; ++i) {
+        out[i] = static_cast<R>(a_col[i * rsa]);
+      }
+      for (size_t i = mr; i < MR; ++i) {
+        out[i] = R(0);
+      }
+      out += MR;
+    }
+  }
+}
+
+/**
+ * @brief Packs a kc x nc block of B into NR wide micro-panels.
+ * @details Panel p holds columns [p * NR, p * NR + NR) stored k-major, so the
+ * micro-kernel reads NR consecutive values per step of k. Columns past nc are zero
+ * padded. Elements are converted to R on the fly.
+ */
+template <typename R, size_t NR, typename TB>
+void pack_b_panel(size_t kc, size_t nr, const TB *b, size_t rsb, size_t csb,
+                  R *out) {
+  if (csb == 1 && nr == NR) {
+    for (size_t p = 0; p < kc; ++p) {
+      const TB *b_row = b + (p * rsb);
+      if constexpr (ReducedFloat<TB> && std::is_same_v<R, float>) {
+        util::convert_n(b_row, NR, out);
+      } else {
+#pragma omp simd
+        for (size_t j = 0; j < NR; ++j) {
+          out[j] = static_cast<R>(b_row[j]);
+        }
+      }
+      out += NR;
+    }
+    return;
+  }
+  for (size_t p = 0; p < kc; ++p) {
+    const TB *b_row = b + (p * rsb);
+    for (size_t j = 0; j < nr; ++j) {
+      out[j] = static_cast<R>(b_row[j * csb]);
+    }
+    for (size_t j = nr; j < NR; ++j) {
+      out[j] = R(0);
+    }
+    out += NR;
+  }
+}
+
+#pragma mark micro_kernels
+//=============================================================================
+// MICRO-KERNELS
+//=============================================================================
+/**
+ * @brief Portable micro-kernel: tile = A_panel * B_panel over kc steps.
+ * @details tile is an MR x NR row-major scratch array.
+ */
+template <typename R, size_t MR, size_t NR>
+inline void micro_kernel(size_t kc, const R *a, const R *b, R *tile) {
+  if constexpr (simd<R>::available) {
+    using S = simd<R>;
+    constexpr size_t NV = NR / S::width;
+    typename S::reg acc[MR][NV];
+    for (size_t i = 0; i < MR; ++i) {
+      for (size_t v = 0; v < NV; ++v) {
+        acc[i][v] = S::zero();
+      }
+    }
+    for (size_t p = 0; p < kc; ++p) {
+      typename S::reg b_reg[NV];
+      for (size_t v = 0; v < NV; ++v) {
+        b_reg[v] = S::load(b + (v * S::width));
+      }
+      for (size_t i = 0; i < MR; ++i) {
+        const typename S::reg a_reg = S::broadcast(a + i);
+        for (size_t v = 0; v < NV; ++v) {
+          acc[i][v] = S::fmadd(a_reg, b_reg[v], acc[i][v]);
+        }
+      }
+      a += MR;
+      b += NR;
+    }
+    for (size_t i = 0; i < MR; ++i) {
+      for (size_t v = 0; v < NV; ++v) {
+        S::store(tile + (i * NR) + (v * S::width), acc[i][v]);
+      }
+    }
+  } else {
+    R acc[MR * NR] = {};
+    for (size_t p = 0; p < kc; ++p) {
+      for (size_t i = 0; i < MR; ++i) {
+        const R a_i = a[i];
+#pragma omp simd
+        for (size_t j = 0; j < NR; ++j) {
+          acc[(i * NR) + j] += a_i * b[j];
+        }
+      }
+      a += MR;
+      b += NR;
+    }
+    std::copy_n(acc, MR * NR, tile);
+  }
+}
+
+/**
+ * @brief Writes an accumulated tile back: C = alpha * tile + beta * C.
+ * @details ldt is the row stride of the tile. When beta is zero C is never read,
+ * so uninitialized or NaN-filled outputs are handled correctly.
+ */
+template <typename R, typename TC>
+inline void store_tile(size_t mr, size_t nr, const R *tile, size_t ldt, R alpha,
+                       R beta, TC *c, size_t rsc, size_t csc) {
+  for (size_t i = 0; i < mr; ++i) {
+    const R *t_row = tile + (i * ldt);
+    TC *c_row = c + (i * rsc);
+    if (csc == 1) {
+      if (beta == R(0)) {
+#pragma omp simd
+        for (size_t j = 0; j < nr; ++j) {
+          c_row[j] = static_cast<TC>(alpha * t_row[j]);
+        }
+      } else {
+#pragma omp simd
+        for (size_t j = 0; j < nr; ++j) {
+          c_row[j] =
+              static_cast<TC>((alpha * t_row[j]) + (beta * static_cast<R>(c_row[j])));
+        }
+      }
+    } else if (beta == R(0)) {
+      for (size_t j = 0; j < nr; ++j) {
+        c_row[j * csc] = static_cast<TC>(alpha * t_row[j]);
+      }
+    } else {
+      for (size_t j = 0; j < nr; ++j) {
+        TC &value = c_row[j * csc];
+        value = static_cast<TC>((alpha * t_row[j]) + (beta * static_cast<R>(value)));
+      }
+    }
+  }
+}
+
+#pragma mark drivers
+//=============================================================================
+// DRIVERS
+//=============================================================================
+/** @brief C = beta * C, used when the product term vanishes. */
+template <typename R, typename TC>
+void scale_c(size_t m, size_t n, R beta, TC *c, size_t rsc, size_t csc) {
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      TC &value = c[(i * rsc) + (j * csc)];
+      value = (beta == R(0)) ? TC(0) : static_cast<TC>(beta * static_cast<R>(value));
+    }
+  }
+}
+
+/** @brief Unpacked i-k-j product for operands too small to amortize packing. */
+template <typename R, typename TA, typename TB, typename TC>
+void small_gemm(size_t m, size_t n, size_t k, R alpha, const TA *a, size_t rsa,
+                size_t csa, const TB *b, size_t rsb, size_t csb, R beta, TC *c,
+                size_t rsc, size_t csc) {
+  std::vector<R> row(n);
+  for (size_t i = 0; i < m; ++i) {
+    std::fill(row.begin(), row.end(), R(0));
+    for (size_t p = 0; p < k; ++p) {
+      const R a_ip = static_cast<R>(a[(i * rsa) + (p * csa)]);
+      const TB *b_row = b + (p * rsb);
+      for (size_t j = 0; j < n; ++j) {
+        row[j] += a_ip * static_cast<R>(b_row[j * csb]);
+      }
+    }
+    store_tile(1, n, row.data(), n, alpha, beta, c + (i * rsc), rsc, csc);
+  }
+}
+}  // namespace detail
+
+/**
+ * @brief Packed general matrix multiplication: C = alpha * A * B + beta * C.
+ *
+ * A is m x k, B is k x n and C is m x n. Every operand is addressed as
+ * `ptr[i * row_stride + j * column_stride]`, so any combination of row-major,
+ * column-major, transposed and strided views can be passed without copies.
+ *
+ * The computation is carried out in the accumulation type R (by default the
+ * common type of the inputs, float for 16-bit floats); A and B are converted to R
+ * while being packed and C is rounded to its own type only when a tile is stored.
+ * Large products are parallelized with OpenMP over tiles of C, each thread packing
+ * its own block of A while sharing the packed block of B.
+ *
+ * @tparam R Accumulation type.
+ * @param m Rows of A and C.
+ * @param n Columns of B and C.
+ * @param k Columns of A and rows of B.
+ * @param alpha Scalar multiplier of A * B.
+ * @param a Pointer to A(0, 0).
+ * @param rsa, csa Row and column strides of A.
+ * @param b Pointer to B(0, 0).
+ * @param rsb, csb Row and column strides of B.
+ * @param beta Scalar multiplier of C. When zero, C is not read.
+ * @param c Pointer to C(0, 0).
+ * @param rsc, csc Row and column strides of C.
+ */
+template <typename TA, typename TB, typename TC,
+          typename R = accumulation_t<std::common_type_t<TA, TB>>>
+void packed_gemm(size_t m, size_t n, size_t k, std::type_identity_t<R> alpha,
+                 const TA *a, size_t rsa, size_t csa, const TB *b, size_t rsb,
+                 size_t csb, std::type_identity_t<R> beta, TC *c, size_t rsc,
+                 size_t csc) {
+  if (m == 0 || n == 0) {
+    return;
+  }
+  if (k == 0 || alpha == R(0)) {
+    detail::scale_c(m, n, beta, c, rsc, csc);
+    return;
+  }
+  if (m * n * k <= detail::GEMM_SMALL_LIMIT) {
+    detail::small_gemm(m, n, k, alpha, a, rsa, csa, b, rsb, csb, beta, c, rsc, csc);
+    return;
+  }
+
+  constexpr size_t MR = detail::gemm_tile<R>::MR;
+  constexpr size_t NR = detail::gemm_tile<R>::NR;
+  const detail::GemmBlocking &blocking = detail::gemm_blocking<R>();
+
+  // Shrink blocks to the problem so small operands do not allocate full buffers.
+  const size_t kc_max = std::min(blocking.kc, k);
+  const size_t mc_max = std::min(blocking.mc, ((m + MR - 1) / MR) * MR);
+  const size_t nc_max = std::min(blocking.nc, ((n + NR - 1) / NR) * NR);
+
+  detail::PackBuffer<R> b_buffer(kc_max * nc_max);
+  R *b_packed = b_buffer.data();
+
+  // 50 * omp_cubic_limit multiply-adds: 50^3 with the default profile.
+  const bool parallel = m * n * k >= tuning().omp_cubic_limit * 50UL;
+  const size_t threads = parallel ? exec::concurrency() : 1;
+  const exec::Split split = exec::Split::only_if(parallel);
+
+  // One A block per thread, indexed by the worker number of the parallel loops.
+  const size_t a_size = mc_max * kc_max;
+  detail::PackBuffer<R> a_buffer(threads * a_size);
+  const size_t a_blocks = (m + mc_max - 1) / mc_max;
+
+  for (size_t jc = 0; jc < n; jc += nc_max) {
+    const size_t nc = std::min(nc_max, n - jc);
+    const size_t b_panels = (nc + NR - 1) / NR;
+
+    for (size_t pc = 0; pc < k; pc += kc_max) {
+      const size_t kc = std::min(kc_max, k - pc);
+      // First pass over k scales C, later passes accumulate into it.
+      const R beta_eff = (pc == 0) ? beta : R(1);
+
+      exec::parallel_for(0, b_panels, split, [&](size_t lo, size_t hi) {
+        for (size_t jp = lo; jp < hi; ++jp) {
+          const size_t jr = jp * NR;
+          detail::pack_b_panel<R, NR>(kc, std::min(NR, nc - jr),
+                                      b + (pc * rsb) + ((jc + jr) * csb), rsb, csb,
+                                      b_packed + (jr * kc));
+        }
+      });
+
+      // Work items are (A block, column chunk of B) pairs. Every thread runs one
+      // contiguous range of items, in which consecutive items share an A block, so
+      // it repacks A only when its block changes.
+      const size_t chunk_panels =
+          std::max<size_t>(1, (b_panels * a_blocks) / (4 * threads));
+      const size_t chunks = (b_panels + chunk_panels - 1) / chunk_panels;
+
+      exec::parallel_for(0, a_blocks * chunks, split, [&](size_t worker, size_t lo,
+                                                          size_t hi) {
+        R *a_packed = a_buffer.data() + (worker * a_size);
+        alignas(64) R tile[MR * NR];
+        size_t packed_block = std::numeric_limits<size_t>::max();
+
+        for (size_t item = lo; item < hi; ++item) {
+          const size_t block = item / chunks;
+          const size_t chunk = item % chunks;
+          const size_t ic = block * mc_max;
+          const size_t mc = std::min(mc_max, m - ic);
+
+          if (block != packed_block) {
+            detail::pack_a<R, MR>(mc, kc, a + (ic * rsa) + (pc * csa), rsa, csa,
+                                  a_packed);
+            packed_block = block;
+          }
+
+          const size_t jp_end = std::min(b_panels, (chunk + 1) * chunk_panels);
+          for (size_t jp = chunk * chunk_panels; jp < jp_end; ++jp) {
+            const size_t jr = jp * NR;
+            const size_t nr = std::min(NR, nc - jr);
+            for (size_t ir = 0; ir < mc; ir += MR) {
+              const size_t mr = std::min(MR, mc - ir);
+              detail::micro_kernel<R, MR, NR>(kc, a_packed + (ir * kc),
+                                              b_packed + (jr * kc), tile);
+              detail::store_tile(mr, nr, tile, NR, alpha, beta_eff,
+                                 c + ((ic + ir) * rsc) + ((jc + jr) * csc), rsc, csc);
+            }
+          }
+        }
+      });
+    }
+  }
+}
+
+#pragma mark integer
+//=============================================================================
+// WIDENING INTEGER GEMM
+//=============================================================================
+/**
+ * @brief Accumulation type of an integer product that cannot overflow in practice.
+ * @details 8-bit operands accumulate in int32 and 16-bit operands in int64. Wider and
+ * floating-point operands keep their common type. The int32 sum of k 8-bit products
+ * is exact while k * max|a * b| stays below 2^31: k <= 33025 (about 2^15) for
+ * u8 x u8 (65025 per product), k <= 65793 (about 2^16) for u8 x s8 (32640) and
+ * k <= 131071 (about 2^17) for s8 x s8 (16384).
+ */
+template <typename TA, typename TB>
+struct widened_product {
+  using type = std::common_type_t<TA, TB>;
+};
+
+template <std::integral TA, std::integral TB>
+  requires(!std::is_same_v<TA, bool> && !std::is_same_v<TB, bool> &&
+           std::max(sizeof(TA), sizeof(TB)) <= 2)
+struct widened_product<TA, TB> {
+  using type = std::conditional_t<std::max(sizeof(TA), sizeof(TB)) == 1, int32, int64>;
+};
+
+template <typename TA, typename TB>
+using widened_product_t = typename widened_product<TA, TB>::type;
+
+/** @brief True when both operands are 8-bit integers and use the pairwise kernel. */
+template <typename TA, typename TB>
+inline constexpr bool is_byte_gemm =
+    std::integral<TA> && std::integral<TB> && sizeof(TA) == 1 && sizeof(TB) == 1 &&
+    !std::is_same_v<TA, bool> && !std::is_same_v<TB, bool>;
+
+namespace detail {
+/**
+ * @brief Vector registers of int32 lanes, each fed by a pair of int16 values.
+ * @details dot_add(acc, a, b) adds a[2l] * b[2l] + a[2l + 1] * b[2l + 1] to lane l,
+ * which is one VNNI vpdpwssd or a pmaddwd followed by an add.
+ */
+struct pair_simd {
+  static constexpr bool available = false;
+};
+
+#if defined(__AVX512BW__)
+struct pair_simd_avx512 {
+  static constexpr bool available = true;
+  static constexpr size_t width = 16;
+  using reg = __m512i;
+  static reg zero() { return _mm512_setzero_si512(); }
+  static reg load(const int16 *p) { return _mm512_loadu_si512(p); }
+  static void store(int32 *p, reg v) { _mm512_storeu_si512(p, v); }
+  static reg broadcast(const int16 *p) {
+    int32 pair;
+    std::memcpy(&pair, p, sizeof(pair));
+    return _mm512_set1_epi32(pair);
+  }
+  static reg dot_add(reg acc, reg a, reg b) {
+#if defined(__AVX512VNNI__)
+    return _mm512_dpwssd_epi32(acc, a, b);
+#else
+    return _mm512_add_epi32(acc, _mm512_madd_epi16(a, b));
+#endif
+  }
+};
+using byte_simd = pair_simd_avx512;
+#elif defined(__AVX2__)
+struct pair_simd_avx2 {
+  static constexpr bool available = true;
+  static constexpr size_t width = 8;
+  using reg = __m256i;
+  static reg zero() { return _mm256_setzero_si256(); }
+  static reg load(const int16 *p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  static void store(int32 *p, reg v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v);
+  }
+  static reg broadcast(const int16 *p) {
+    int32 pair;
+    std::memcpy(&pair, p, sizeof(pair));
+    return _mm256_set1_epi32(pair);
+  }
+  static reg dot_add(reg acc, reg a, reg b) {
+#if defined(__AVXVNNI__)
+    return _mm256_dpwssd_avx_epi32(acc, a, b);
+#else
+    return _mm256_add_epi32(acc, _mm256_madd_epi16(a, b));
+#endif
+  }
+};
+using byte_simd = pair_simd_avx2;
+#else
+using byte_simd = pair_simd;
+#endif
+
+/** @brief Register tile of the pairwise 8-bit kernel, sized like gemm_tile. */
+struct byte_tile {
+#if defined(__AVX512BW__)
+  static constexpr size_t MR = 14;
+  static constexpr size_t NR = 32;
+#elif defined(__AVX2__)
+  static constexpr size_t MR = 6;
+  static constexpr size_t NR = 16;
+#else
+  static constexpr size_t MR = 4;
+  static constexpr size_t NR = 8;
+#endif
+};
+
+/**
+ * @brief Packs an mc x kc block of A into MR tall micro-panels of k pairs.
+ * @details For pair q, row i of a panel holds (A[i][2q], A[i][2q + 1]) as two
+ * adjacent int16 values; an odd kc is padded with a zero.
+ */
+template <size_t MR, typename TA>
+void pack_a_pairs(size_t mc, size_t kc, const TA *a, size_t rsa, size_t csa,
+                  int16 *buffer) {
+  const size_t kp = (kc + 1) / 2;
+  for (size_t ir = 0; ir < mc; ir += MR) {
+    const size_t mr = std::min(MR, mc - ir);
+    int16 *out = buffer + (ir * 2 * kp);
+    for (size_t q = 0; q < kp; ++q) {
+      const size_t p = 2 * q;
+      for (size_t i = 0; i < MR; ++i) {
+        const TA *a_row = a + ((ir + i) * rsa);
+        const bool row = i < mr;
+        out[2 * i] = row ? static_cast<int16>(a_row[p * csa]) : int16(0);
+        out[(2 * i) + 1] =
+            (row && p + 1 < kc) ? static_cast<int16>(a_row[(p + 1) * csa]) : int16(0);
+      }
+      out += 2 * MR;
+    }
+  }
+}
+
+/**
+ * @brief Packs a kc x nr panel of B into NR wide rows of k pairs.
+ * @details For pair q, column j holds (B[2q][j], B[2q + 1][j]) as two adjacent
+ * int16 values; missing rows and columns are zero padded.
+ */
+template <size_t NR, typename TB>
+void pack_b_pairs(size_t kc, size_t nr, const TB *b, size_t rsb, size_t csb,
+                  int16 *out) {
+  const size_t kp = (kc + 1) / 2;
+  for (size_t q = 0; q < kp; ++q) {
+    const TB *b_even = b + (2 * q * rsb);
+    const TB *b_odd = b_even + rsb;
+    const bool odd = (2 * q) + 1 < kc;
+    for (size_t j = 0; j < NR; ++j) {
+      const bool column = j < nr;
+      out[2 * j] = column ? static_cast<int16>(b_even[j * csb]) : int16(0);
+      out[(2 * j) + 1] = (column && odd) ? static_cast<int16>(b_odd[j * csb]) : int16(0);
+    }
+    out += 2 * NR;
+  }
+}
+
+/** @brief Pairwise micro-kernel: tile = A_panel * B_panel over kp pairs of k. */
+template <size_t MR, size_t NR, typename S = byte_simd>
+inline void byte_micro_kernel(size_t kp, const int16 *a, const int16 *b, int32 *tile) {
+  if constexpr (S::available) {
+    constexpr size_t NV = NR / S::width;
+    typename S::reg acc[MR][NV];
+    for (size_t i = 0; i < MR; ++i) {
+      for (size_t v = 0; v < NV; ++v) {
+        acc[i][v] = S::zero();
+      }
+    }
+    for (size_t q = 0; q < kp; ++q) {
+      typename S::reg b_reg[NV];
+      for (size_t v = 0; v < NV; ++v) {
+        b_reg[v] = S::load(b + (2 * v * S::width));
+      }
+      for (size_t i = 0; i < MR; ++i) {
+        const typename S::reg a_reg = S::broadcast(a + (2 * i));
+        for (size_t v = 0; v < NV; ++v) {
+          acc[i][v] = S::dot_add(acc[i][v], a_reg, b_reg[v]);
+        }
+      }
+      a += 2 * MR;
+      b += 2 * NR;
+    }
+    for (size_t i = 0; i < MR; ++i) {
+      for (size_t v = 0; v < NV; ++v) {
+        S::store(tile + (i * NR) + (v * S::width), acc[i][v]);
+      }
+    }
+  } else {
+    int32 acc[MR * NR] = {};
+    for (size_t q = 0; q < kp; ++q) {
+      for (size_t i = 0; i < MR; ++i) {
+        const int32 a0 = a[2 * i];
+        const int32 a1 = a[(2 * i) + 1];
+#pragma omp simd
+        for (size_t j = 0; j < NR; ++j) {
+          acc[(i * NR) + j] += (a0 * b[2 * j]) + (a1 * b[(2 * j) + 1]);
+        }
+      }
+      a += 2 * MR;
+      b += 2 * NR;
+    }
+    std::copy_n(acc, MR * NR, tile);
+  }
+}
+
+/**
+ * @brief C = A * B for 8-bit integer operands with int32 accumulation.
+ * @details Same blocking as packed_gemm, but operands are packed as int16 pairs
+ * along k so that each instruction of the micro-kernel performs two multiply-adds
+ * per lane.
+ */
+template <typename TA, typename TB>
+void byte_gemm(size_t m, size_t n, size_t k, const TA *a, size_t rsa, size_t csa,
+               const TB *b, size_t rsb, size_t csb, int32 *c, size_t rsc, size_t csc) {
+  constexpr size_t MR = byte_tile::MR;
+  constexpr size_t NR = byte_tile::NR;
+  // An int16 pair occupies the bytes of one int32, so reuse the int32 blocking with
+  // twice the depth.
+  const GemmBlocking &blocking = gemm_blocking<int32>();
+  const size_t kc_max = std::min(2 * blocking.kc, k + (k % 2));
+  const size_t mc_max =
+      std::min(std::max(MR, blocking.mc - (blocking.mc % MR)), ((m + MR - 1) / MR) * MR);
+  const size_t nc_max =
+      std::min(std::max(NR, blocking.nc - (blocking.nc % NR)), ((n + NR - 1) / NR) * NR);
+
+  PackBuffer<int16> b_buffer(kc_max * nc_max);
+  int16 *b_packed = b_buffer.data();
+  const bool parallel = m * n * k >= tuning().omp_cubic_limit * 50UL;
+  const size_t threads = parallel ? exec::concurrency() : 1;
+  const exec::Split split = exec::Split::only_if(parallel);
+
+  const size_t a_size = mc_max * kc_max;
+  PackBuffer<int16> a_buffer(threads * a_size);
+  const size_t a_blocks = (m + mc_max - 1) / mc_max;
+
+  for (size_t jc = 0; jc < n; jc += nc_max) {
+    const size_t nc = std::min(nc_max, n - jc);
+    const size_t b_panels = (nc + NR - 1) / NR;
+
+    for (size_t pc = 0; pc < k; pc += kc_max) {
+      const size_t kc = std::min(kc_max, k - pc);
+      const size_t kp = (kc + 1) / 2;
+      const bool first = pc == 0;
+
+      exec::parallel_for(0, b_panels, split, [&](size_t lo, size_t hi) {
+        for (size_t jp = lo; jp < hi; ++jp) {
+          const size_t jr = jp * NR;
+          pack_b_pairs<NR>(kc, std::min(NR, nc - jr),
+                           b + (pc * rsb) + ((jc + jr) * csb), rsb, csb,
+                           b_packed + (jr * 2 * kp));
+        }
+      });
+
+      // Same (A block, column chunk of B) work split as packed_gemm.
+      const size_t chunk_panels =
+          std::max<size_t>(1, (b_panels * a_blocks) / (4 * threads));
+      const size_t chunks = (b_panels + chunk_panels - 1) / chunk_panels;
+
+      exec::parallel_for(0, a_blocks * chunks, split, [&](size_t worker, size_t lo,
+                                                          size_t hi) {
+        int16 *a_packed = a_buffer.data() + (worker * a_size);
+        alignas(64) int32 tile[MR * NR];
+        size_t packed_block = std::numeric_limits<size_t>::max();
+
+        for (size_t item = lo; item < hi; ++item) {
+          const size_t block = item / chunks;
+          const size_t chunk = item % chunks;
+          const size_t ic = block * mc_max;
+          const size_t mc = std::min(mc_max, m - ic);
+
+          if (block != packed_block) {
+            pack_a_pairs<MR>(mc, kc, a + (ic * rsa) + (pc * csa), rsa, csa, a_packed);
+            packed_block = block;
+          }
+
+          const size_t jp_end = std::min(b_panels, (chunk + 1) * chunk_panels);
+          for (size_t jp = chunk * chunk_panels; jp < jp_end; ++jp) {
+            const size_t jr = jp * NR;
+            const size_t nr = std::min(NR, nc - jr);
+            for (size_t ir = 0; ir < mc; ir += MR) {
+              const size_t mr = std::min(MR, mc - ir);
+              byte_micro_kernel<MR, NR>(kp, a_packed + (ir * 2 * kp),
+                                        b_packed + (jr * 2 * kp), tile);
+              store_tile(mr, nr, tile, NR, int32(1), first ? int32(0) : int32(1),
+                         c + ((ic + ir) * rsc) + ((jc + jr) * csc), rsc, csc);
+            }
+          }
+        }
+      });
+    }
+  }
+}
+}  // namespace detail
+
+/**
+ * @brief Integer matrix multiplication C = A * B with widened accumulation.
+ * @details C has the widened_product_t of the operands. 16-bit products accumulate
+ * exactly in int64; 8-bit products accumulate exactly in int32 up to the k bound
+ * that widened_product gives for their signedness (about 2^15 for u8 x u8). Two
+ * 8-bit operands (signed or unsigned, in any combination) run on a pairwise kernel
+ * using AVX-512 VNNI, AVX-VNNI or pmaddwd where available; other operands use
+ * packed_gemm in the widened type.
+ * @param m, n, k Dimensions of A (m x k), B (k x n) and C (m x n).
+ * @param a, rsa, csa Pointer to A(0, 0) and its row and column strides.
+ * @param b, rsb, csb Pointer to B(0, 0) and its row and column strides.
+ * @param c, rsc, csc Pointer to C(0, 0) and its row and column strides.
+ */
+template <typename TA, typename TB>
+void widening_gemm(size_t m, size_t n, size_t k, const TA *a, size_t rsa, size_t csa,
+                   const TB *b, size_t rsb, size_t csb, widened_product_t<TA, TB> *c,
+                   size_t rsc, size_t csc) {
+  using W = widened_product_t<TA, TB>;
+  if constexpr (is_byte_gemm<TA, TB>) {
+    if (m != 0 && n != 0 && m * n * k > detail::GEMM_SMALL_LIMIT) {
+      detail::byte_gemm(m, n, k, a, rsa, csa, b, rsb, csb, c, rsc, csc);
+      return;
+    }
+  }
+  packed_gemm<TA, TB, W, W>(m, n, k, W(1), a, rsa, csa, b, rsb, csb, W(0), c, rsc, csc);
+}
+
+}  // namespace maf::math::kernels
+
+#endif
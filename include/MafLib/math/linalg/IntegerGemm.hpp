@@ -0,0 +1,103 @@
+#ifndef INTEGER_GEMM_H
+#define INTEGER_GEMM_H
+#pragma once
+#include "GemmKernels.hpp"
+#include "Matrix.hpp"
+#include "Vector.hpp"
+
+/**
+ * @file IntegerGemm.hpp
+ * @brief Integer and quantized matrix multiplication with widened accumulation.
+ *
+ * `Matrix::operator*` keeps the common type of its operands, so a product of two
+ * `int8` matrices is an `int8` matrix whose entries wrap around. The functions here
+ * return the exact product instead, accumulated in `kernels::widened_product_t`
+ * (int32 for 8-bit, int64 for 16-bit operands).
+ *
+ * For quantized float workloads the integer product can be rescaled on the fly with
+ * per-row scales of A and per-column scales of B (symmetric quantization, no zero
+ * points), so the integer accumulator matrix is never materialized by the caller.
+ */
+namespace maf::math {
+/**
+ * @brief Exact integer matrix product, C = A * B in the widened type.
+ * @details 8-bit operands run on the pairwise VNNI/pmaddwd kernel, other integer
+ * types on the packed GEMM engine in the widened type.
+ * @tparam T Integer type of A.
+ * @tparam U Integer type of B.
+ * @return Matrix of kernels::widened_product_t<T, U>.
+ * @throws std::invalid_argument if inner dimensions do not match.
+ */
+template <std::integral T, std::integral U>
+[[nodiscard]] auto widening_multiply(const Matrix<T> &A, const Matrix<U> &B) {
+  if (A.column_count() != B.row_count()) {
+    throw std::invalid_argument(
+        "Matrix inner dimensions do not match for multiplication!");
+  }
+  using W = kernels::widened_product_t<T, U>;
+
+  const size_t n = B.column_count();
+  Matrix<W> result(A.row_count(), n, util::uninitialized);
+  kernels::widening_gemm(A.row_count(), n, A.column_count(), A.data(),
+                         A.column_count(), 1, B.data(), n, 1, result.data(), n, 1);
+  return result;
+}
+
+/**
+ * @brief Quantized matrix product, C[i][j] = row_scales[i] * col_scales[j] * (A * B)[i][j].
+ * @details A holds rows quantized with one scale each, B columns quantized with one
+ * scale each. The integer product is accumulated exactly and rescaled in S, one
+ * output row block at a time.
+ * @tparam T Integer type of A.
+ * @tparam U Integer type of B.
+ * @tparam S Floating-point type of the scales and of the result.
+ * @param A Quantized left operand (m x k).
+ * @param B Quantized right operand (k x n).
+ * @param row_scales Scale of every row of A (size m).
+ * @param col_scales Scale of every column of B (size n).
+ * @return Dequantized m x n Matrix<S>.
+ * @throws std::invalid_argument if inner dimensions or scale sizes do not match.
+ */
+template <std::integral T, std::integral U, std::floating_point S>
+[[nodiscard]] Matrix<S> quantized_multiply(const Matrix<T> &A, const Matrix<U> &B,
+                                           const Vector<S> &row_scales,
+                                           const Vector<S> &col_scales) {
+  if (A.column_count() != B.row_count()) {
+    throw std::invalid_argument(
+        "Matrix inner dimensions do not match for multiplication!");
+  }
+  if (row_scales.size() != A.row_count() || col_scales.size() != B.column_count()) {
+    throw std::invalid_argument("Scale sizes do not match the quantized operands!");
+  }
+  using W = kernels::widened_product_t<T, U>;
+
+  const size_t m = A.row_count();
+  const size_t n = B.column_count();
+  const size_t k = A.column_count();
+  Matrix<S> result(m, n, util::uninitialized);
+
+  // Rows are processed in blocks so the int accumulator stays small and cache hot.
+  constexpr size_t ROW_BLOCK = 256;
+  util::AlignedVector<W> acc(std::min(m, ROW_BLOCK) * n);
+  for (size_t i0 = 0; i0 < m; i0 += ROW_BLOCK) {
+    const size_t rows = std::min(ROW_BLOCK, m - i0);
+    kernels::widening_gemm(rows, n, k, A.data() + (i0 * k), k, 1, B.data(), n, 1,
+                           acc.data(), n, 1);
+
+    exec::parallel_for(0, rows, quadratic_split(rows * n), [&](size_t lo, size_t hi) {
+      for (size_t i = lo; i < hi; ++i) {
+        const S row_scale = row_scales[i0 + i];
+        const W *acc_row = acc.data() + (i * n);
+        S *out = result.row_span(i0 + i).data();
+#pragma omp simd
+        for (size_t j = 0; j < n; ++j) {
+          out[j] = row_scale * col_scales[j] * static_cast<S>(acc_row[j]);
+        }
+      }
+    });
+  }
+  return result;
+}
+
+}  // namespace maf::math
+#endif
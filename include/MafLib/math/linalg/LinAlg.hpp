@@ -11,7 +11,7 @@ using namespace maf::util;
 template <Numeric T>
 class Vector;
 
-template <Numeric T>
+template <Numeric T, Layout L = Layout::RowMajor>
 class Matrix;
 
 template <Numeric T>
@@ -31,14 +31,17 @@ concept VectorType = requires { typename std::remove_cvref_t<T>::value_type; } &
                                   Vector<typename std::remove_cvref_t<T>::value_type>>;
 
 /** @brief Clean VectorViewType concept.
- * Removes qualifiers and checks the value type of the MatrixView is Numeric concept.
+ * Removes qualifiers and checks the value type of the VectorView is Numeric concept.
+ * Read-only views (VectorView<const T>) qualify as well.
  */
 template <typename T>
 concept VectorViewType =
     requires { typename std::remove_cvref_t<T>::value_type; } &&
     Numeric<typename std::remove_cvref_t<T>::value_type> &&
-    std::same_as<std::remove_cvref_t<T>,
-                 VectorView<typename std::remove_cvref_t<T>::value_type>>;
+    (std::same_as<std::remove_cvref_t<T>,
+                  VectorView<typename std::remove_cvref_t<T>::value_type>> ||
+     std::same_as<std::remove_cvref_t<T>,
+                  VectorView<const typename std::remove_cvref_t<T>::value_type>>);
 
 /** @brief Clean concept compatible with VectorView.
  * MatrixViewCompatible is either a VectorView or a Vector that can be made into a view.
@@ -48,6 +51,7 @@ concept VectorViewCompatible = VectorViewType<T> || VectorType<T>;
 
 /** @brief Clean Matrix concept.
  * Removes qualifiers and checks the value type of the Matrix is Numeric concept.
+ * Only the default row-major layout qualifies, as views and expressions read rows.
  */
 template <typename T>
 concept MatrixType = requires { typename std::remove_cvref_t<T>::value_type; } &&
@@ -57,19 +61,62 @@ concept MatrixType = requires { typename std::remove_cvref_t<T>::value_type; } &
 
 /** @brief Clean MatrixViewType concept.
  * Removes qualifiers and checks the value type of the MatrixView is Numeric concept.
+ * Read-only views (MatrixView<const T>) qualify as well.
  */
 template <typename T>
 concept MatrixViewType =
     requires { typename std::remove_cvref_t<T>::value_type; } &&
     Numeric<typename std::remove_cvref_t<T>::value_type> &&
-    std::same_as<std::remove_cvref_t<T>,
-                 MatrixView<typename std::remove_cvref_t<T>::value_type>>;
+    (std::same_as<std::remove_cvref_t<T>,
+                  MatrixView<typename std::remove_cvref_t<T>::value_type>> ||
+     std::same_as<std::remove_cvref_t<T>,
+                  MatrixView<const typename std::remove_cvref_t<T>::value_type>>);
 
 /** @brief Clean concept compatible with MatrixView.
  * MatrixViewCompatible is either a MatrixView or a Matrix that can be made into a view.
  */
 template <typename T>
 concept MatrixViewCompatible = MatrixViewType<T> || MatrixType<T>;
+
+// Element-wise expressions (implemented in Expressions.hpp)
+namespace expr {
+/** @brief Shape of a matrix expression. */
+struct MatrixShape {
+  size_t rows;
+  size_t cols;
+
+  [[nodiscard]] constexpr size_t size() const noexcept { return rows * cols; }
+  [[nodiscard]] constexpr bool operator==(const MatrixShape &) const noexcept = default;
+};
+
+/** @brief Shape of a vector expression. */
+struct VectorShape {
+  size_t length;
+  Orientation orientation;
+
+  [[nodiscard]] constexpr size_t size() const noexcept { return length; }
+  [[nodiscard]] constexpr bool operator==(const VectorShape &) const noexcept = default;
+};
+
+/** @brief Empty base every expression node derives from. */
+struct ExpressionBase {};
+}  // namespace expr
+
+/** @brief Any lazily evaluated element-wise expression. */
+template <typename E>
+concept Expression = std::derived_from<std::remove_cvref_t<E>, expr::ExpressionBase>;
+
+/** @brief Expression that evaluates into a Matrix. */
+template <typename E>
+concept MatrixExpression =
+    Expression<E> &&
+    std::same_as<typename std::remove_cvref_t<E>::shape_type, expr::MatrixShape>;
+
+/** @brief Expression that evaluates into a Vector. */
+template <typename E>
+concept VectorExpression =
+    Expression<E> &&
+    std::same_as<typename std::remove_cvref_t<E>::shape_type, expr::VectorShape>;
 }  // namespace maf::math
 #include "Matrix.hpp"
 #include "Vector.hpp"
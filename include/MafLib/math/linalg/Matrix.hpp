@@ -1,21 +1,31 @@
 #ifndef MATRIX_H
 #define MATRIX_H
 #pragma once
-#include "AccelerateWrappers/AccelerateWrapper.hpp"
+#include "BlasWrappers/BlasWrapper.hpp"
+#include "GemmKernels.hpp"
 #include "LinAlg.hpp"
 #include "MafLib/main/GlobalHeader.hpp"
+#include "MafLib/utility/Conversions.hpp"
 #include "MafLib/utility/Math.hpp"
+#include "MafLib/utility/Memory.hpp"
+#include "TransposeKernels.hpp"
+#include "VectorizedMath.hpp"
 
 namespace maf::math {
 
 using namespace maf::util;
 /**
- * @brief A general-purpose, row-major, dense matrix class.
+ * @brief A general-purpose dense matrix class.
  *
- * This class implements a matrix with contiguous row-major storage.
+ * This class implements a matrix with contiguous storage, row-major by default.
  * It supports a wide range of arithmetic operations, constructors, and
  * utility methods.
  *
+ * `Matrix<T, Layout::ColMajor>` stores columns contiguously, exactly as LAPACK and
+ * Fortran code expect, so its buffer can be handed to them without a transposed copy.
+ * Element access, arithmetic, multiplication and views work for both layouts; row
+ * pointers and row spans exist only for the row-major layout.
+ *
  * The implementation is templated to support various numeric types (T).
  * Many operations (like multiplication and addition) are parallelized
  * using OpenMP and employ blocking strategies for cache efficiency.
@@ -25,15 +35,27 @@ using namespace maf::util;
  *
  * @tparam T The numeric type of the matrix elements (e.g., float,
  * double, int).
+ * @tparam L The storage order, Layout::RowMajor by default.
  *
  * @version 1.0
  * @since 2025
  */
-template <Numeric T>
+template <Numeric T, Layout L>
 class Matrix {
  public:
   /** @brief The numeric type of the matrix elements. */
   using value_type = T;
+  /**
+   * @brief Allocator of the 64-byte aligned element storage.
+   * @details Fixed rather than a template parameter: the operators, decompositions
+   * and views take `Matrix<T, L>`, so a matrix with another allocator could be passed
+   * to none of them. util::PoolScope changes where temporaries come from instead.
+   */
+  using allocator_type = util::AlignedAllocator<T>;
+  /** @brief Contiguous element storage in the order given by the layout. */
+  using storage_type = std::vector<T, allocator_type>;
+  /** @brief The storage order of this matrix. */
+  static constexpr Layout layout = L;
 
 #pragma mark constructors
   // ----------------------------------
@@ -46,63 +68,76 @@ class Matrix {
   Matrix() : _rows(0), _cols(0) {}
 
   /**
-   * @brief Constructs an uninitialized matrix of size rows x cols.
+   * @brief Constructs a zero-filled matrix of size rows x cols.
    * @param rows Number of rows.
    * @param cols Number of columns.
    * @throws std::invalid_argument if dimensions are zero.
    */
   Matrix(size_t rows, size_t cols);
 
+  /**
+   * @brief Constructs a matrix of size rows x cols without initializing elements.
+   * @details For results that are fully overwritten, e.g.
+   * `Matrix<double> C(m, n, util::uninitialized)`.
+   * @throws std::invalid_argument if dimensions are zero.
+   */
+  Matrix(size_t rows, size_t cols, util::uninitialized_t);
+
   /**
    * @brief Constructs a matrix from a raw data pointer.
+   * @details Flat sources (pointer, std::vector, std::array, initializer list) are
+   * read in storage order: by rows for RowMajor, by columns for ColMajor.
    * @param rows Number of rows.
    * @param cols Number of columns.
    * @param data Pointer to a C-style array of size (rows * cols) in
-   * row-major order. The data is COPIED into the matrix.
+   * storage order. The data is COPIED into the matrix.
    * @throws std::invalid_argument if dimensions are zero or data is
    * nullptr.
    */
   Matrix(size_t rows, size_t cols, T *data);
 
   /**
-   * @brief Constructs from a std::vector, filled by rows.
+   * @brief Constructs from a std::vector in storage order.
+   * @details The elements are copied into aligned storage, also from an rvalue; pass
+   * a storage_type to adopt a buffer without copying.
    * @param rows Number of rows.
    * @param cols Number of columns.
-   * @param data A std::vector of size (rows * cols) in row-major order.
+   * @param data A std::vector of size (rows * cols), by rows for RowMajor and by
+   * columns for ColMajor.
    * @throws std::invalid_argument if dimensions are zero or data size
    * does not match.
    */
   Matrix(size_t rows, size_t cols, const std::vector<T> &data);
 
   /**
-   * @brief Constructs from a std::vector, filled by rows (move
-   * constructor).
+   * @brief Adopts aligned storage in storage order without copying it.
    * @param rows Number of rows.
    * @param cols Number of columns.
-   * @param data A std::vector of size (rows * cols) in row-major order.
+   * @param data Storage of size (rows * cols), e.g. a buffer filled by LAPACK.
    * @throws std::invalid_argument if dimensions are zero or data size
    * does not match.
    */
-  Matrix(size_t rows, size_t cols, std::vector<T> &&data);
+  Matrix(size_t rows, size_t cols, storage_type &&data);
 
   /**
    * @brief Constructs from a nested std::vector (vector of vectors).
    * @param rows Number of rows.
    * @param cols Number of columns.
-   * @param data A std::vector<std::vector<T>>. data.size() must equal
-   * rows, and data[0].size() must equal cols.
+   * @param data A std::vector<std::vector<T>> of rows, in every layout.
+   * data.size() must equal rows, and data[0].size() must equal cols.
    * @throws std::invalid_argument if dimensions are zero or data shape
    * does not match.
    */
   Matrix(size_t rows, size_t cols, const std::vector<std::vector<T>> &data);
 
   /**
-   * @brief Constructs from a std::array, filled by rows.
+   * @brief Constructs from a std::array in storage order.
    * @tparam U Type in the array (allows implicit conversion).
    * @tparam N Size of the array.
    * @param rows Number of rows.
    * @param cols Number of columns.
-   * @param data A std::array<U, N> where N must equal (rows * cols).
+   * @param data A std::array<U, N> in storage order, where N must equal
+   * (rows * cols).
    * @throws std::invalid_argument if dimensions are zero or array size
    * does not match.
    */
@@ -110,17 +145,35 @@ class Matrix {
   Matrix(size_t rows, size_t cols, const std::array<T, N> &data);
 
   /**
-   * @brief Constructs from a std::initializer_list, filled by rows.
+   * @brief Constructs from a std::initializer_list in storage order.
    * @tparam U Type in the list (allows implicit conversion).
    * @param rows Number of rows.
    * @param cols Number of columns.
-   * @param list A std::initializer_list<U> of size (rows * cols).
+   * @param list A std::initializer_list<U> of size (rows * cols), by rows for
+   * RowMajor and by columns for ColMajor.
    * @throws std::invalid_argument if dimensions are zero or list size
    * does not match.
    */
   template <Numeric U>
   Matrix(size_t rows, size_t cols, std::initializer_list<U> list);
 
+  /**
+   * @brief Evaluates an element-wise expression (see Expressions.hpp) in one pass.
+   * @tparam E A matrix expression, e.g. `lazy(A) * 2.0 + B`.
+   */
+  template <MatrixExpression E>
+    requires(L == Layout::RowMajor)
+  Matrix(const E &expression);
+
+  /**
+   * @brief Copies a matrix stored in the other layout.
+   * @details The storage is converted with one cache-oblivious transpose; element
+   * (i, j) of the result equals element (i, j) of the source.
+   */
+  template <Layout LO>
+    requires(LO != L)
+  explicit Matrix(const Matrix<T, LO> &other);
+
 #pragma mark getters_setters
   // ----------------------------------
   // GETTERS & SETTERS
@@ -139,18 +192,18 @@ class Matrix {
   [[nodiscard]] const T *data() const noexcept { return _data.data(); }
 
   /**
-   * @brief Gets a mutable reference to the underlying std::vector
+   * @brief Gets a mutable reference to the underlying aligned std::vector
    * data store.
-   * @return std::vector<T>&
+   * @return storage_type&
    */
-  [[nodiscard]] std::vector<T> &data_vector() noexcept { return _data; }
+  [[nodiscard]] storage_type &data_vector() noexcept { return _data; }
 
   /**
-   * @brief Gets a const reference to the underlying std::vector data
+   * @brief Gets a const reference to the underlying aligned std::vector data
    * store.
-   * @return const std::vector<T>&
+   * @return const storage_type&
    */
-  [[nodiscard]] const std::vector<T> &data_vector() const noexcept { return _data; }
+  [[nodiscard]] const storage_type &data_vector() const noexcept { return _data; }
 
   /** @brief Gets the number of rows. */
   [[nodiscard]] size_t row_count() const noexcept { return _rows; }
@@ -161,11 +214,31 @@ class Matrix {
   /** @brief Gets the total number of elements (rows * cols). */
   [[nodiscard]] size_t size() const noexcept { return _data.size(); }
 
+  /**
+   * @brief Gets the distance between consecutive rows (RowMajor) or columns
+   * (ColMajor) in the storage, i.e. the `lda` of BLAS and LAPACK.
+   */
+  [[nodiscard]] size_t leading_dimension() const noexcept {
+    return (L == Layout::RowMajor) ? _cols : _rows;
+  }
+
+  /** @brief Gets the storage distance between elements (i, j) and (i + 1, j). */
+  [[nodiscard]] size_t row_stride() const noexcept {
+    return (L == Layout::RowMajor) ? _cols : 1;
+  }
+
+  /** @brief Gets the storage distance between elements (i, j) and (i, j + 1). */
+  [[nodiscard]] size_t column_stride() const noexcept {
+    return (L == Layout::RowMajor) ? 1 : _rows;
+  }
+
   /**
    * @brief Accesses the element at [row][col] with no bounds check.
    * @return pointer to the start of the specified row.
    */
-  [[nodiscard]] T *operator[](size_t ind) noexcept {
+  [[nodiscard]] T *operator[](size_t ind) noexcept
+    requires(L == Layout::RowMajor)
+  {
     // TODO: add tests
     return &_data[ind * _cols];
   }
@@ -174,7 +247,9 @@ class Matrix {
    * @brief Accesses the element at [row][col] with no bounds check.
    * @return const pointer to the start of the specified row.
    */
-  [[nodiscard]] const T *operator[](size_t ind) const noexcept {
+  [[nodiscard]] const T *operator[](size_t ind) const noexcept
+    requires(L == Layout::RowMajor)
+  {
     // TODO: add tests
     return &_data[ind * _cols];
   }
@@ -184,8 +259,7 @@ class Matrix {
    * @return reference to the element at (row, col).
    */
   [[nodiscard]] T &operator[](size_t row, size_t col) noexcept {
-    // TODO: add tests
-    return _data[(row * _cols) + col];
+    return _data[_offset(row, col)];
   }
 
   /**
@@ -193,8 +267,7 @@ class Matrix {
    * @return const reference to the element at (row, col).
    */
   [[nodiscard]] const T &operator[](size_t row, size_t col) const noexcept {
-    // TODO: add tests
-    return _data[(row * _cols) + col];
+    return _data[_offset(row, col)];
   }
 
   /**
@@ -213,7 +286,9 @@ class Matrix {
    * @brief Gets a mutable std::span of a single row.
    * @throws std::out_of_range if the row is invalid.
    */
-  [[nodiscard]] std::span<T> row_span(size_t row) {
+  [[nodiscard]] std::span<T> row_span(size_t row)
+    requires(L == Layout::RowMajor)
+  {
     return std::span<T>(&_data.at(_get_index(row, 0)), _cols);
   }
 
@@ -221,10 +296,32 @@ class Matrix {
    * @brief Gets a const std::span of a single row.
    * @throws std::out_of_range if the row is invalid.
    */
-  [[nodiscard]] std::span<const T> row_span(size_t row) const {
+  [[nodiscard]] std::span<const T> row_span(size_t row) const
+    requires(L == Layout::RowMajor)
+  {
     return std::span<const T>(&_data.at(_get_index(row, 0)), _cols);
   }
 
+  /**
+   * @brief Gets a mutable std::span of a single column of a column-major matrix.
+   * @throws std::out_of_range if the column is invalid.
+   */
+  [[nodiscard]] std::span<T> column_span(size_t col)
+    requires(L == Layout::ColMajor)
+  {
+    return std::span<T>(&_data.at(_get_index(0, col)), _rows);
+  }
+
+  /**
+   * @brief Gets a const std::span of a single column of a column-major matrix.
+   * @throws std::out_of_range if the column is invalid.
+   */
+  [[nodiscard]] std::span<const T> column_span(size_t col) const
+    requires(L == Layout::ColMajor)
+  {
+    return std::span<const T>(&_data.at(_get_index(0, col)), _rows);
+  }
+
   /**
    * @brief Creates a view (sub-matrix) into this matrix.
    * @param row Starting row index of the view.
@@ -238,13 +335,84 @@ class Matrix {
    */
   [[nodiscard]] MatrixView<T> view(size_t row, size_t col, size_t height,
                                    size_t width) {
-    if (height == 0 || width == 0) {
-      throw std::invalid_argument("View dimensions must be greater than zero.");
-    }
-    if (row + height > _rows || col + width > _cols) {
-      throw std::out_of_range("Requested view exceeds matrix dimensions.");
-    }
-    return MatrixView<T>(&_data[(row * _cols) + col], height, width, _cols);
+    _check_view(row, col, height, width);
+    return MatrixView<T>(_data.data() + _offset(row, col), height, width, row_stride(),
+                         column_stride());
+  }
+
+  /**
+   * @brief Creates a read-only view (sub-matrix) into this matrix.
+   * @return MatrixView<const T> representing the specified sub-matrix.
+   * @throws std::invalid_argument if height or width is zero.
+   * @throws std::out_of_range if the requested view exceeds matrix
+   * dimensions.
+   */
+  [[nodiscard]] MatrixView<const T> view(size_t row, size_t col, size_t height,
+                                         size_t width) const {
+    _check_view(row, col, height, width);
+    return MatrixView<const T>(_data.data() + _offset(row, col), height, width,
+                               row_stride(), column_stride());
+  }
+
+  /** @brief Creates a view of the whole matrix. */
+  [[nodiscard]] MatrixView<T> view() noexcept {
+    return MatrixView<T>(_data.data(), _rows, _cols, row_stride(), column_stride());
+  }
+
+  /** @brief Creates a read-only view of the whole matrix. */
+  [[nodiscard]] MatrixView<const T> view() const noexcept {
+    return MatrixView<const T>(_data.data(), _rows, _cols, row_stride(),
+                               column_stride());
+  }
+
+  /** @brief Views the transpose of this matrix without copying it. */
+  [[nodiscard]] MatrixView<T> transposed_view() noexcept {
+    return view().transposed_view();
+  }
+
+  /** @brief Views the transpose of this matrix without copying it (read-only). */
+  [[nodiscard]] MatrixView<const T> transposed_view() const noexcept {
+    return view().transposed_view();
+  }
+
+  /**
+   * @brief Views a single row as a ROW VectorView.
+   * @throws std::out_of_range if the row is invalid.
+   */
+  [[nodiscard]] VectorView<T> row_view(size_t row) { return view().row_view(row); }
+
+  /**
+   * @brief Views a single row as a read-only ROW VectorView.
+   * @throws std::out_of_range if the row is invalid.
+   */
+  [[nodiscard]] VectorView<const T> row_view(size_t row) const {
+    return view().row_view(row);
+  }
+
+  /**
+   * @brief Views a single column as a COLUMN VectorView.
+   * @throws std::out_of_range if the column is invalid.
+   */
+  [[nodiscard]] VectorView<T> column_view(size_t col) {
+    return view().column_view(col);
+  }
+
+  /**
+   * @brief Views a single column as a read-only COLUMN VectorView.
+   * @throws std::out_of_range if the column is invalid.
+   */
+  [[nodiscard]] VectorView<const T> column_view(size_t col) const {
+    return view().column_view(col);
+  }
+
+  /** @brief Views the main diagonal as a COLUMN VectorView. */
+  [[nodiscard]] VectorView<T> diagonal_view() noexcept {
+    return view().diagonal_view();
+  }
+
+  /** @brief Views the main diagonal as a read-only COLUMN VectorView. */
+  [[nodiscard]] VectorView<const T> diagonal_view() const noexcept {
+    return view().diagonal_view();
   }
 
 #pragma mark checkers
@@ -290,14 +458,63 @@ class Matrix {
   /** @brief Creates new matrix with same elements but different type.
    */
   template <Numeric U>
-  [[nodiscard]] Matrix<U> cast() const {
+  [[nodiscard]] Matrix<U, L> cast() const {
     // Replace this with explicit constructor casting when implemented
-    Matrix<U> result(_rows, _cols);
-    omp_loop(_data.size(),
-             [&](size_t i) { result.data()[i] = static_cast<U>(_data[i]); });
+    Matrix<U, L> result(_rows, _cols, util::uninitialized);
+    if constexpr (ReducedFloat<T> || ReducedFloat<U>) {
+      // 16-bit conversions go through the F16C / AVX512-BF16 bulk converters.
+      constexpr size_t CHUNK = 4096;
+      const size_t n = _data.size();
+      exec::parallel_for(0, n, linear_split(), [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; i += CHUNK) {
+          util::convert_n(_data.data() + i, std::min(CHUNK, hi - i), result.data() + i);
+        }
+      });
+    } else {
+      omp_loop(_data.size(),
+               [&](size_t i) { result.data()[i] = static_cast<U>(_data[i]); });
+    }
+    return result;
+  }
+
+  /**
+   * @brief Applies f to every element and returns the results as a new matrix.
+   * @details The function objects from maf::math::vmath (exp, log, tanh, ...) and
+   * pure callables wrapped in vmath::vectorized() run SIMD-vectorized and parallelized
+   * above tuning().omp_linear_limit. Any other f is called in storage order on the
+   * calling thread, so it may keep state.
+   * @return `Matrix<R, L>` where R is the type returned by f.
+   */
+  template <std::invocable<const T &> F>
+  [[nodiscard]] auto map(F f) const {
+    Matrix<map_result_t<F, T>, L> result(_rows, _cols, util::uninitialized);
+    kernels::map_n(_data.size(), _data.data(), 1, result.data(), 1, f);
     return result;
   }
 
+  /**
+   * @brief Combines this matrix with another element by element: f(a[i, j], b[i, j]).
+   * @return `Matrix<R, L>` where R is the type returned by f.
+   * @throws std::invalid_argument if the dimensions do not match.
+   */
+  template <Numeric U, std::invocable<const T &, const U &> F>
+  [[nodiscard]] auto zip_map(const Matrix<U, L> &other, F f) const {
+    if (_rows != other.row_count() || _cols != other.column_count()) {
+      throw std::invalid_argument("Matrices have to be of same dimensions for zip_map!");
+    }
+    Matrix<map_result_t<F, T, U>, L> result(_rows, _cols, util::uninitialized);
+    kernels::zip_map_n(_data.size(), _data.data(), 1, other.data(), 1, result.data(), 1,
+                       f);
+    return result;
+  }
+
+  /** @brief Replaces every element x with f(x); the result is converted back to T. */
+  template <std::invocable<const T &> F>
+  Matrix &apply_inplace(F f) {
+    kernels::map_n(_data.size(), _data.data(), 1, _data.data(), 1, f);
+    return *this;
+  }
+
   /** @brief Fills the entire matrix with a single value.*/
   void fill(T value) {
     omp_loop(_data.size(), [&](size_t i) { _data[i] = value; });
@@ -320,75 +537,40 @@ class Matrix {
 
   /**
    * @brief Performs an in-place transpose of the matrix.
-   * @details Calls `transposed()` and moves the result back into this matrix.
-   * @throws std::invalid_argument if the matrix is not square.
+   * @details Square matrices swap mirrored tiles through SIMD register transposes.
+   * Rectangular matrices are permuted by cycle-following, which needs one bit of
+   * scratch per element instead of a second copy, so very tall or wide matrices can
+   * be flipped without doubling memory.
    */
   void transpose() {
-    if (!is_square()) {
-      throw std::invalid_argument("Matrix must be square to transpose in-place.");
-    }
-#if defined(__APPLE__) && defined(ACCELERATE_AVAILABLE)
-    if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
-      Matrix<T> temp = this->transposed();
-      *this = std::move(temp);
-      return;
-    }
-#endif
-#pragma omp parallel for schedule(static) default(none)
-    for (size_t i = 0; i < _rows; i += BLOCK_SIZE) {
-      for (size_t j = i; j < _cols; j += BLOCK_SIZE) {
-        const size_t n = std::min(i + BLOCK_SIZE, _rows);
-        const size_t m = std::min(j + BLOCK_SIZE, _cols);
-        for (size_t k = i; k < n; ++k) {
-          for (size_t l = (i == j) ? k + 1 : j; l < m; ++l) {
-            std::swap(this->at(k, l), this->at(l, k));
-          }
-        }
-      }
-    }
+    kernels::transpose_in_place(_lines(), leading_dimension(), _data.data());
+    std::swap(_rows, _cols);
   }
 
   /**
    * @brief Creates and returns a new matrix that is the transpose of
    * this one.
-   * @return A new Matrix<T> of size (cols x rows).
+   * @details Uses the cache-oblivious transpose from TransposeKernels.hpp, with
+   * non-temporal stores for outputs larger than the last level cache.
+   * @return A new Matrix<T, L> of size (cols x rows).
    */
-  [[nodiscard]] Matrix<T> transposed() const {
-    Matrix<T> result(_cols, _rows);
-#if defined(__APPLE__) && defined(ACCELERATE_AVAILABLE)
-    if constexpr (std::is_same_v<T, float>) {
-      vDSP_mtrans(_data.data(), 1, result.data(), 1, _cols, _rows);
-      return result;
-    } else if constexpr (std::is_same_v<T, double>) {
-      vDSP_mtransD(_data.data(), 1, result.data(), 1, _cols, _rows);
-      return result;
-    }
-#elif defined(__OPENBLAS_AVAILABLE)
-    if constexpr (std::is_same_v<T, float>) {
-      cblas_somatcopy(CblasRowMajor, CblasTrans, _rows, _cols, 1.0f, _data.data(),
-                      _cols, result.data(), _rows);
-      return result;
-    } else if constexpr (std::is_same_v<T, double>) {
-      cblas_domatcopy(CblasRowMajor, CblasTrans, _rows, _cols, 1.0, _data.data(), _cols,
-                      result.data(), _rows);
-      return result;
-    }
+  [[nodiscard]] Matrix transposed() const {
+    Matrix result(_cols, _rows, util::uninitialized);
+    _transpose_storage(_lines(), leading_dimension(), _data.data(), result.data());
+    return result;
   }
-#endif
-    // Generic implementation
-#pragma omp parallel for collapse(2) schedule(static) default(none) shared(result)
-    for (size_t i = 0; i < _rows; i += BLOCK_SIZE) {
-      for (size_t j = 0; j < _cols; j += BLOCK_SIZE) {
-        size_t i_max = std::min(i + BLOCK_SIZE, _rows);
-        size_t j_max = std::min(j + BLOCK_SIZE, _cols);
-
-        for (size_t k = i; k < i_max; ++k) {
-          for (size_t l = j; l < j_max; ++l) {
-            result[l, k] = (*this)[k, l];
-          }
-        }
-      }
-    }
+
+  /**
+   * @brief Reinterprets this matrix as its transpose in the opposite layout.
+   * @details A row-major A and a column-major A^T share the same storage, so the
+   * buffer is moved over without touching a single element. This matrix is left
+   * empty.
+   * @return A Matrix<T, transposed_layout(L)> of size (cols x rows).
+   */
+  [[nodiscard]] Matrix<T, transposed_layout(L)> reinterpret_transposed() && {
+    Matrix<T, transposed_layout(L)> result(_cols, _rows, std::move(_data));
+    _rows = 0;
+    _cols = 0;
     return result;
   }
 
@@ -400,32 +582,32 @@ class Matrix {
 
     if constexpr (is_spd) {
       // res = det(L)^2
-      auto L = cholesky(*this);
+      auto lower = cholesky(*this);
       using AccumType =
-          typename std::decay_t<decltype(L)>::value_type;  // Get the promoted type
+          typename std::decay_t<decltype(lower)>::value_type;  // Get the promoted type
       AccumType det = 1;
 
       for (size_t i = 0; i < _rows; ++i) {
-        det *= L.at(i, i);
+        det *= lower.at(i, i);
       }
       return det * det;
     } else {
       // res = det(U) * det(P), det(L) = 1
       auto plu_res = plu(*this);
+      const auto &lu = plu_res.packed();
       using AccumType =
-          typename std::decay_t<decltype(plu_res.U)>::value_type;  // Get the promoted
-                                                                   // type
+          typename std::decay_t<decltype(lu)>::value_type;  // Get the promoted type
       auto det = static_cast<AccumType>(plu_res.sign);
 
       for (size_t i = 0; i < _rows; ++i) {
-        det *= plu_res.U.at(i, i);
+        det *= lu.at(i, i);
       }
       return det;
     }
   }
 
   // TODO: Implement
-  [[nodiscard]] Matrix<T> inverted() const;
+  [[nodiscard]] Matrix inverted() const;
 
 #pragma mark operators
   // ----------------------------------
@@ -451,7 +633,7 @@ class Matrix {
    * @throws std::invalid_argument if dimensions do not match.
    */
   template <Numeric U>
-  [[nodiscard]] auto operator+(const Matrix<U> &other) const;
+  [[nodiscard]] auto operator+(const Matrix<U, L> &other) const;
 
   /**
    * @brief Element-wise scalar addition (Matrix + scalar).
@@ -468,7 +650,7 @@ class Matrix {
    * @throws std::invalid_argument if dimensions do not match.
    */
   template <Numeric U>
-  Matrix<T> &operator+=(const Matrix<U> &other);
+  Matrix &operator+=(const Matrix<U, L> &other);
 
   /**
    * @brief Element-wise scalar addition assignment (Matrix + scalar).
@@ -477,7 +659,7 @@ class Matrix {
    * @return Matrix of the original matrix type.
    */
   template <Numeric U>
-  Matrix<T> &operator+=(const U &scalar) noexcept;
+  Matrix &operator+=(const U &scalar) noexcept;
 
   /**
    * @brief Element-wise matrix subtraction.
@@ -486,7 +668,7 @@ class Matrix {
    * @throws std::invalid_argument if dimensions do not match.
    */
   template <Numeric U>
-  [[nodiscard]] auto operator-(const Matrix<U> &other) const;
+  [[nodiscard]] auto operator-(const Matrix<U, L> &other) const;
 
   /**
    * @brief Element-wise scalar subtraction (Matrix - scalar).
@@ -503,7 +685,7 @@ class Matrix {
    * @throws std::invalid_argument if dimensions do not match.
    */
   template <Numeric U>
-  Matrix<T> &operator-=(const Matrix<U> &other);
+  Matrix &operator-=(const Matrix<U, L> &other);
 
   /**
    * @brief Element-wise scalar subtraction assignment (Matrix - scalar).
@@ -512,19 +694,53 @@ class Matrix {
    * @return Matrix of the original matrix type.
    */
   template <Numeric U>
-  Matrix<T> &operator-=(const U &scalar) noexcept;
+  Matrix &operator-=(const U &scalar) noexcept;
+
+  /**
+   * @brief Evaluates an element-wise expression into this matrix.
+   * @details Reuses the existing buffer when the shape matches. The expression may
+   * reference this matrix.
+   */
+  template <MatrixExpression E>
+    requires(L == Layout::RowMajor)
+  Matrix &operator=(const E &expression);
+
+  /**
+   * @brief Adds an element-wise expression to this matrix in one pass.
+   * @throws std::invalid_argument if dimensions do not match.
+   */
+  template <MatrixExpression E>
+    requires(L == Layout::RowMajor)
+  Matrix &operator+=(const E &expression);
+
+  /**
+   * @brief Subtracts an element-wise expression from this matrix in one pass.
+   * @throws std::invalid_argument if dimensions do not match.
+   */
+  template <MatrixExpression E>
+    requires(L == Layout::RowMajor)
+  Matrix &operator-=(const E &expression);
 
   /**
    * @brief Standard algebraic matrix multiplication (A * B).
-   * @details Implemented with a parallelized, cache-blocked algorithm.
-   * @details Uses BLAS gemm where available.
+   * @details Implemented with the packed, register-blocked GEMM engine from
+   * GemmKernels.hpp, parallelized with OpenMP.
+   * @details Dispatches to the vendor BLAS gemm for float/double results when a
+   * backend is configured (see BlasWrapper.hpp). A mixed-type operand is then
+   * converted panel by panel instead of being copied whole.
+   * @details 8-bit integer operands run on the VNNI/pmaddwd kernel. The result keeps
+   * the common type and therefore wraps; use widening_multiply (IntegerGemm.hpp) for
+   * the exact product.
+   * @details Operands may have different layouts; every kernel reads them through
+   * their row and column strides, and the result takes the layout of this matrix.
    * @tparam U Numeric type of the other matrix.
+   * @tparam LB Layout of the other matrix.
    * @return Matrix of the common, promoted type.
    * @throws std::invalid_argument if inner dimensions do not match
    * (A.cols != B.rows).
    */
-  template <Numeric U>
-  [[nodiscard]] auto operator*(const Matrix<U> &other) const {
+  template <Numeric U, Layout LB>
+  [[nodiscard]] auto operator*(const Matrix<U, LB> &other) const {
     if (_cols != other.row_count()) {
       throw std::invalid_argument(
           "Matrix inner dimensions do not match for multiplication!");
@@ -534,82 +750,65 @@ class Matrix {
     const size_t a_rows = _rows;
     const size_t b_cols = other.column_count();
     const size_t a_cols = _cols;
-    Matrix<R> result(a_rows, b_cols);
+    Matrix<R, L> result(a_rows, b_cols, util::uninitialized);
 
     const T *a_data = this->_data.data();
     const U *b_data = other.data();
     R *c_data = result.data();
-
-    result.fill(R(0));
-
-#if defined(__APPLE__) && defined(ACCELERATE_AVAILABLE)
-    // Handle all floating-point combinations with proper conversion
-    if constexpr (std::is_floating_point_v<R>) {
-      if constexpr (std::is_same_v<R, float>) {
-        // Both matrices are float or can be safely converted to float
-        std::vector<float> a_converted, b_converted;
-        const float *a_ptr = a_data;
-        const float *b_ptr = b_data;
-
-        // Convert matrix A if needed
-        if constexpr (!std::is_same_v<T, float>) {
-          a_converted.resize(_data.size());
-          std::transform(_data.begin(), _data.end(), a_converted.begin(),
-                         [](T val) { return static_cast<float>(val); });
-          a_ptr = a_converted.data();
-        } else {
-          a_ptr = a_data;
-        }
-
-        // Convert matrix B if needed
-        if constexpr (!std::is_same_v<U, float>) {
-          b_converted.resize(other.data().size());
-          std::transform(other.data().begin(), other.data().end(), b_converted.begin(),
-                         [](U val) { return static_cast<float>(val); });
-          b_ptr = b_converted.data();
-        } else {
-          b_ptr = b_data;
-        }
-
-        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, a_rows, b_cols, a_cols,
-                    1.0F, a_ptr, a_cols, b_ptr, b_cols, 0.0F, c_data, b_cols);
-      } else if constexpr (std::is_same_v<R, double>) {
-        // Both matrices are double or can be safely converted to double
-        std::vector<double> a_converted, b_converted;
-        const double *a_ptr;
-        const double *b_ptr;
-
-        // Convert matrix A if needed
-        if constexpr (!std::is_same_v<T, double>) {
-          a_converted.resize(_data.size());
-          std::transform(_data.begin(), _data.end(), a_converted.begin(),
-                         [](T val) { return static_cast<double>(val); });
-          a_ptr = a_converted.data();
-        } else {
-          a_ptr = a_data;
-        }
-
-        // Convert matrix B if needed
-        if constexpr (!std::is_same_v<U, double>) {
-          b_converted.resize(other.data().size());
-          std::transform(other.data().begin(), other.data().end(), b_converted.begin(),
-                         [](U val) { return static_cast<double>(val); });
-          b_ptr = b_converted.data();
-        } else {
-          b_ptr = b_data;
+    const size_t rsa = row_stride();
+    const size_t csa = column_stride();
+    const size_t rsb = other.row_stride();
+    const size_t csb = other.column_stride();
+    const size_t rsc = result.row_stride();
+    const size_t csc = result.column_stride();
+
+    if constexpr (kernels::is_byte_gemm<T, U>) {
+      // Exact int32 accumulation on the pairwise kernel; a narrower R wraps once, on
+      // the final store, exactly as the generic path would.
+      if constexpr (std::is_same_v<R, int32>) {
+        kernels::widening_gemm(a_rows, b_cols, a_cols, a_data, rsa, csa, b_data, rsb,
+                               csb, c_data, rsc, csc);
+      } else {
+        util::AlignedVector<int32> wide(result.size());
+        kernels::widening_gemm(a_rows, b_cols, a_cols, a_data, rsa, csa, b_data, rsb,
+                               csb, wide.data(), rsc, csc);
+#pragma omp simd
+        for (size_t i = 0; i < wide.size(); ++i) {
+          c_data[i] = static_cast<R>(wide[i]);
         }
+      }
+      return result;
+    }
 
-        cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, a_rows, b_cols, a_cols,
-                    1.0, a_ptr, a_cols, b_ptr, b_cols, 0.0, c_data, b_cols);
+#if defined(MAF_BLAS_AVAILABLE)
+    if constexpr (blas::supports<R> && std::is_same_v<T, R> && std::is_same_v<U, R>) {
+      // A column-major operand is the row-major storage of its transpose, and a
+      // column-major C is computed as C^T = B^T * A^T.
+      constexpr auto trans = [](Layout operand, Layout target) {
+        return (operand == target) ? blas::Trans::NoTrans : blas::Trans::Trans;
+      };
+      if constexpr (L == Layout::RowMajor) {
+        blas::gemm(trans(L, Layout::RowMajor), trans(LB, Layout::RowMajor), a_rows,
+                   b_cols, a_cols, R(1), a_data, leading_dimension(), b_data,
+                   other.leading_dimension(), R(0), c_data, b_cols);
+      } else {
+        blas::gemm(trans(LB, Layout::ColMajor), trans(L, Layout::ColMajor), b_cols,
+                   a_rows, a_cols, R(1), b_data, other.leading_dimension(), a_data,
+                   leading_dimension(), R(0), c_data, a_rows);
       }
-    } else {
-      // Integer types - use fallback
-      _fallback_matrix_multiply(a_data, b_data, c_data, a_rows, a_cols, b_cols);
+      return result;
+    } else if constexpr (blas::supports<R> && L == Layout::RowMajor &&
+                         LB == Layout::RowMajor &&
+                         (std::is_same_v<T, R> || std::is_same_v<U, R>)) {
+      // Mixed operands are converted one panel at a time, never as a whole copy.
+      blas::gemm_mixed(a_rows, b_cols, a_cols, R(1), a_data, a_cols, b_data, b_cols,
+                       R(0), c_data, b_cols);
+      return result;
     }
-#else
-  // Default non-Apple implementation
-  _fallback_matrix_multiply(a_data, b_data, c_data, a_rows, a_cols, b_cols);
 #endif
+    // Mixed types are converted to R while packing, never as whole-operand copies.
+    kernels::packed_gemm(a_rows, b_cols, a_cols, R(1), a_data, rsa, csa, b_data, rsb,
+                         csb, R(0), c_data, rsc, csc);
     return result;
   }
 
@@ -628,7 +827,7 @@ class Matrix {
    * @return Matrix of the original matrix type.
    */
   template <Numeric U>
-  Matrix<T> &operator*=(const U &scalar) noexcept;
+  Matrix &operator*=(const U &scalar) noexcept;
 
   /**
    * @brief Matrix-Vector multiplication (Matrix * column_vector).
@@ -655,7 +854,7 @@ class Matrix {
    * @return Matrix of the original matrix type.
    */
   template <Numeric U>
-  Matrix<T> &operator/=(const U &scalar) noexcept;
+  Matrix &operator/=(const U &scalar) noexcept;
 
   // --- Debugging and printing ---
 
@@ -678,7 +877,7 @@ class Matrix {
  private:
   size_t _rows;
   size_t _cols;
-  std::vector<T> _data;
+  storage_type _data;
 
   /**
    * @brief Internal check if a row/column index is within bounds.
@@ -697,64 +896,75 @@ class Matrix {
     if (!_is_valid_index(row, col)) {
       throw std::out_of_range("Index out of bounds.");
     }
-    return (row * _cols) + col;
+    return _offset(row, col);
   }
 
-  /**
-   * @brief Internal helper to invert the sign of all elements in-place.
-   */
-  void _invert_sign() {
-    if (_data.size() > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-      for (size_t i = 0; i < _data.size(); ++i) {
-        _data[i] = -_data[i];
-      }
+  /** @brief Validates the window requested by view(). */
+  void _check_view(size_t row, size_t col, size_t height, size_t width) const {
+    if (height == 0 || width == 0) {
+      throw std::invalid_argument("View dimensions must be greater than zero.");
+    }
+    if (row + height > _rows || col + width > _cols) {
+      throw std::out_of_range("Requested view exceeds matrix dimensions.");
+    }
+  }
+
+  /** @brief Position of element (row, col) in _data, without a bounds check. */
+  [[nodiscard]] constexpr size_t _offset(size_t row, size_t col) const noexcept {
+    if constexpr (L == Layout::RowMajor) {
+      return (row * _cols) + col;
     } else {
-      for (size_t i = 0; i < _data.size(); ++i) {
-        _data[i] = -_data[i];
-      }
+      return (col * _rows) + row;
     }
   }
 
-  // Fallback matrix multiplication implementation
-  template <typename A, typename B, typename C>
-  void _fallback_matrix_multiply(const A *a_data, const B *b_data, C *c_data,
-                                 size_t a_rows, size_t a_cols, size_t b_cols) const {
-#pragma omp parallel for collapse(2) if (a_rows * b_cols > 10000)
-    for (size_t ii = 0; ii < a_rows; ii += BLOCK_SIZE) {
-      for (size_t jj = 0; jj < b_cols; jj += BLOCK_SIZE) {
-        for (size_t kk = 0; kk < a_cols; kk += BLOCK_SIZE) {
-          // Process block (your existing blocked implementation)
-          const size_t i_end = std::min(ii + BLOCK_SIZE, a_rows);
-          const size_t j_end = std::min(jj + BLOCK_SIZE, b_cols);
-          const size_t k_end = std::min(kk + BLOCK_SIZE, a_cols);
-
-          for (size_t i = ii; i < i_end; ++i) {
-            for (size_t k = kk; k < k_end; ++k) {
-              const C a_ik = static_cast<C>(a_data[(i * a_cols) + k]);
-              const size_t b_offset = k * b_cols;
-              const size_t c_offset = i * b_cols;
+  /** @brief Number of contiguous lines (rows or columns) in the storage. */
+  [[nodiscard]] constexpr size_t _lines() const noexcept {
+    return (L == Layout::RowMajor) ? _rows : _cols;
+  }
 
+  /**
+   * @brief dst = src^T for a contiguous row-major lines x length array.
+   * @details Transposing the storage of either layout transposes the matrix, and
+   * also converts it between layouts without changing its elements.
+   */
+  static void _transpose_storage(size_t lines, size_t length, const T *src, T *dst) {
+#if defined(MAF_BLAS_AVAILABLE)
+    if constexpr (blas::HAS_OMATCOPY && blas::supports<T>) {
+      blas::omatcopy_trans(lines, length, src, length, dst, lines);
+      return;
+    }
+#endif
+    kernels::transpose(lines, length, src, length, dst, lines);
+  }
+
+  /**
+   * @brief Internal helper to invert the sign of all elements in-place.
+   */
+  void _invert_sign() {
+    exec::parallel_for(0, _data.size(), linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-              for (size_t j = jj; j < j_end; ++j) {
-                c_data[c_offset + j] += a_ik * static_cast<C>(b_data[b_offset + j]);
-              }
-            }
-          }
-        }
+      for (size_t i = lo; i < hi; ++i) {
+        _data[i] = -_data[i];
       }
-    }
+    });
   }
 };
 
 }  // namespace maf::math
 
 #include "Cholesky.hpp"
+#include "Expressions.hpp"
+#include "IntegerGemm.hpp"
 #include "MatrixCheckers.hpp"
 #include "MatrixConstructors.hpp"
 #include "MatrixFactories.hpp"
 #include "MatrixOperators.hpp"
 #include "PLU.hpp"
 #include "QR.hpp"
+#include "Reductions.hpp"
+#include "Strassen.hpp"
+// Instantiates the kernels above to register the first-use autotuner.
+#include "Autotune.hpp"
 
 #endif
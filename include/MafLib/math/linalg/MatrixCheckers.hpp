@@ -12,13 +12,13 @@
  * should not be included directly anywhere else.
  */
 namespace maf::math {
-template <Numeric T>
-[[nodiscard]] constexpr bool Matrix<T>::is_square() const {
+template <Numeric T, Layout L>
+[[nodiscard]] constexpr bool Matrix<T, L>::is_square() const {
   return _rows == _cols;
 }
 
-template <Numeric T>
-[[nodiscard]] constexpr bool Matrix<T>::is_symmetric() const {
+template <Numeric T, Layout L>
+[[nodiscard]] constexpr bool Matrix<T, L>::is_symmetric() const {
   if (!is_square()) {
     return false;
   }
@@ -32,8 +32,8 @@ template <Numeric T>
   return true;
 }
 
-template <Numeric T>
-[[nodiscard]] constexpr bool Matrix<T>::is_upper_triangular() const {
+template <Numeric T, Layout L>
+[[nodiscard]] constexpr bool Matrix<T, L>::is_upper_triangular() const {
   if (!is_square()) {
     return false;
   }
@@ -49,8 +49,8 @@ template <Numeric T>
   return true;
 }
 
-template <Numeric T>
-[[nodiscard]] constexpr bool Matrix<T>::is_lower_triangular() const {
+template <Numeric T, Layout L>
+[[nodiscard]] constexpr bool Matrix<T, L>::is_lower_triangular() const {
   if (!is_square()) {
     return false;
   }
@@ -67,8 +67,8 @@ template <Numeric T>
   return true;
 }
 
-template <Numeric T>
-[[nodiscard]] constexpr bool Matrix<T>::is_diagonal() const {
+template <Numeric T, Layout L>
+[[nodiscard]] constexpr bool Matrix<T, L>::is_diagonal() const {
   if (!is_square()) {
     return false;
   }
@@ -76,8 +76,8 @@ template <Numeric T>
   return is_upper_triangular() && is_lower_triangular();
 }
 
-template <Numeric T>
-[[nodiscard]] constexpr bool Matrix<T>::is_singular() const {
+template <Numeric T, Layout L>
+[[nodiscard]] constexpr bool Matrix<T, L>::is_singular() const {
   if (!is_square()) {
     return true;
   }
@@ -89,8 +89,8 @@ template <Numeric T>
   }
 }
 
-template <Numeric T>
-[[nodiscard]] constexpr bool Matrix<T>::is_positive_definite() const {
+template <Numeric T, Layout L>
+[[nodiscard]] constexpr bool Matrix<T, L>::is_positive_definite() const {
   try {
     cholesky(*this);
     return true;
@@ -103,12 +103,14 @@ template <Numeric T>
  * @brief Checks if two matrices are element-wise equal within a tolerance.
  * @tparam T Numeric type of the first matrix.
  * @tparam U Numeric type of the second matrix.
+ * @details The matrices may have different layouts.
  * @param eps The absolute tolerance for equality.
  * @return true if dimensions match and all elements are "close".
  */
-template <Numeric T, Numeric U>
-[[nodiscard]] constexpr bool loosely_equal(const Matrix<T> &first,
-                                           const Matrix<U> &second, double eps = 1e-6) {
+template <Numeric T, Layout LT, Numeric U, Layout LU>
+[[nodiscard]] constexpr bool loosely_equal(const Matrix<T, LT> &first,
+                                           const Matrix<U, LU> &second,
+                                           double eps = 1e-6) {
   size_t n = first.row_count();
   size_t m = first.column_count();
   if (n != second.row_count() || m != second.column_count()) {
@@ -11,19 +11,33 @@
  * should not be included directly anywhere else.
  */
 namespace maf::math {
-// Constructs an uninitialized matrix of size rows x cols.
-template <Numeric T>
-Matrix<T>::Matrix(size_t rows, size_t cols) : _rows(rows), _cols(cols) {
+// Constructs a zero-filled matrix of size rows x cols.
+template <Numeric T, Layout L>
+Matrix<T, L>::Matrix(size_t rows, size_t cols) : _rows(rows), _cols(cols) {
     if (rows == 0 || cols == 0) {
         throw std::invalid_argument("Matrix dimensions must be greater than zero.");
     }
 
+    // Zeroed in parallel so large buffers are first touched by the threads that
+    // later process them.
     _data.resize(rows * cols);
+    util::parallel_fill(_data.data(), _data.size(), T(0));
+}
+
+// Constructs a matrix of size rows x cols without initializing elements.
+template <Numeric T, Layout L>
+Matrix<T, L>::Matrix(size_t rows, size_t cols, util::uninitialized_t)
+    : _rows(rows), _cols(cols) {
+    if (rows == 0 || cols == 0) {
+        throw std::invalid_argument("Matrix dimensions must be greater than zero.");
+    }
+
+    _data.resize(rows * cols);  // Default-initialized by the allocator
 }
 
 // Constructs a matrix from a raw data pointer.
-template <Numeric T>
-Matrix<T>::Matrix(size_t rows, size_t cols, T *data) : _rows(rows), _cols(cols) {
+template <Numeric T, Layout L>
+Matrix<T, L>::Matrix(size_t rows, size_t cols, T *data) : _rows(rows), _cols(cols) {
     if (rows == 0 || cols == 0) {
         throw std::invalid_argument("Matrix dimensions must be greater than zero!");
     }
@@ -34,9 +48,9 @@ Matrix<T>::Matrix(size_t rows, size_t cols, T *data) : _rows(rows), _cols(cols)
     _data.assign(data, data + (rows * cols));
 }
 
-// Constructs from a std::vector, filled by rows.
-template <Numeric T>
-Matrix<T>::Matrix(size_t rows, size_t cols, const std::vector<T> &data)
+// Constructs from a std::vector in storage order.
+template <Numeric T, Layout L>
+Matrix<T, L>::Matrix(size_t rows, size_t cols, const std::vector<T> &data)
     : _rows(rows), _cols(cols) {
     if (rows == 0 || cols == 0) {
         throw std::invalid_argument("Matrix dimensions must be greater than zero.");
@@ -49,9 +63,9 @@ Matrix<T>::Matrix(size_t rows, size_t cols, const std::vector<T> &data)
     _data.assign(data.begin(), data.end());
 }
 
-// Constructs from a std::vector, move constructor.
-template <Numeric T>
-Matrix<T>::Matrix(size_t rows, size_t cols, std::vector<T> &&data)
+// Adopts aligned storage without copying it.
+template <Numeric T, Layout L>
+Matrix<T, L>::Matrix(size_t rows, size_t cols, storage_type &&data)
     : _rows(rows), _cols(cols) {
     if (rows == 0 || cols == 0) {
         throw std::invalid_argument("Matrix dimensions must be greater than zero.");
@@ -63,8 +77,8 @@ Matrix<T>::Matrix(size_t rows, size_t cols, std::vector<T> &&data)
 }
 
 // Constructs from a nested std::vector (vector of vectors).
-template <Numeric T>
-Matrix<T>::Matrix(size_t rows, size_t cols, const std::vector<std::vector<T>> &data)
+template <Numeric T, Layout L>
+Matrix<T, L>::Matrix(size_t rows, size_t cols, const std::vector<std::vector<T>> &data)
     : _rows(rows), _cols(cols) {
     if (rows == 0 || cols == 0) {
         throw std::invalid_argument("Matrix dimensions must be greater than zero.");
@@ -74,7 +88,7 @@ Matrix<T>::Matrix(size_t rows, size_t cols, const std::vector<std::vector<T>> &d
         throw std::invalid_argument("Data size does not match matrix size.");
     }
 
-    _data.resize(rows * cols);
+    _data.resize(rows * cols);  // Every element is written below
     for (size_t i = 0; i < rows; ++i) {
         for (size_t j = 0; j < cols; ++j) {
             _data.at(_get_index(i, j)) = static_cast<T>(data.at(i).at(j));
@@ -82,10 +96,10 @@ Matrix<T>::Matrix(size_t rows, size_t cols, const std::vector<std::vector<T>> &d
     }
 }
 
-// Constructs from a std::array, filled by rows.
-template <Numeric T>
+// Constructs from a std::array in storage order.
+template <Numeric T, Layout L>
 template <size_t N>
-Matrix<T>::Matrix(size_t rows, size_t cols, const std::array<T, N> &data)
+Matrix<T, L>::Matrix(size_t rows, size_t cols, const std::array<T, N> &data)
     : _rows(rows), _cols(cols) {
     if (rows == 0 || cols == 0) {
         throw std::invalid_argument("Matrix dimensions must be greater than zero.");
@@ -97,10 +111,10 @@ Matrix<T>::Matrix(size_t rows, size_t cols, const std::array<T, N> &data)
     _data.assign(data.begin(), data.end());
 }
 
-// Constructs from a std::initializer_list, filled by rows.
-template <Numeric T>
+// Constructs from a std::initializer_list in storage order.
+template <Numeric T, Layout L>
 template <Numeric U>
-Matrix<T>::Matrix(size_t rows, size_t cols, std::initializer_list<U> list)
+Matrix<T, L>::Matrix(size_t rows, size_t cols, std::initializer_list<U> list)
     : _rows(rows), _cols(cols) {
     if (rows == 0 || cols == 0) {
         throw std::invalid_argument("Matrix dimensions must be greater than zero.");
@@ -111,6 +125,29 @@ Matrix<T>::Matrix(size_t rows, size_t cols, std::initializer_list<U> list)
     _data.assign(list.begin(), list.end());
 }
 
+// Evaluates an element-wise expression in one pass.
+template <Numeric T, Layout L>
+template <MatrixExpression E>
+  requires(L == Layout::RowMajor)
+Matrix<T, L>::Matrix(const E& expression)
+    : _rows(expression.shape().rows), _cols(expression.shape().cols) {
+    _data.resize(_rows * _cols);
+    expr::assign<expr::AssignOp::Assign>(_data.data(), expression);
+}
+
+// Copies a matrix stored in the other layout.
+template <Numeric T, Layout L>
+template <Layout LO>
+  requires(LO != L)
+Matrix<T, L>::Matrix(const Matrix<T, LO> &other)
+    : _rows(other.row_count()), _cols(other.column_count()) {
+    _data.resize(other.size());
+    if (!_data.empty()) {
+        // The source storage is a row-major array of our columns (or rows).
+        _transpose_storage(leading_dimension(), _lines(), other.data(), _data.data());
+    }
+}
+
 }  // namespace maf::math
 
 #endif
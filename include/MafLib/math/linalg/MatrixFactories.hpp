@@ -33,7 +33,7 @@ template <Numeric T>
  */
 template <Numeric U>
 [[nodiscard]] inline Matrix<U> ones(size_t rows, size_t cols) {
-  Matrix<U> result(rows, cols);
+  Matrix<U> result(rows, cols, util::uninitialized);
   result.fill(U(1));
   return result;
 }
@@ -49,11 +49,12 @@ template <Numeric T>
 [[nodiscard]] Matrix<T> inline permutation_matrix(const std::vector<uint32> &perm) {
   size_t n = perm.size();
   Matrix<T> result(n, n);  // Initializes to zero
-#pragma omp parallel for if (n > 256)
-  for (size_t i = 0; i < n; ++i) {
-    const size_t j = perm.at(i);
-    result[i][j] = static_cast<T>(1);
-  }
+  exec::parallel_for(0, n, {.serial_limit = 256}, [&](size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; ++i) {
+      const size_t j = perm.at(i);
+      result[i][j] = static_cast<T>(1);
+    }
+  });
   return result;
 }
 
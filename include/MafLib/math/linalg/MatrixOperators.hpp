@@ -7,8 +7,8 @@
 
 namespace maf::math {
 // Checks if elements are exactly equal
-template <Numeric T>
-[[nodiscard]] constexpr bool Matrix<T>::operator==(const Matrix &other) const noexcept {
+template <Numeric T, Layout L>
+[[nodiscard]] constexpr bool Matrix<T, L>::operator==(const Matrix &other) const noexcept {
   if (_rows != other._rows || _cols != other._cols) {
     return false;
   }
@@ -16,159 +16,129 @@ template <Numeric T>
 }
 
 // Unary minus sign, creates a copy
-template <Numeric T>
-[[nodiscard]] auto Matrix<T>::operator-() const noexcept {
-  Matrix<T> result(*this);
+template <Numeric T, Layout L>
+[[nodiscard]] auto Matrix<T, L>::operator-() const noexcept {
+  Matrix result(*this);
   result._invert_sign();
   return result;
 }
 
 // Add 2 matrices element-wise
-template <Numeric T>
+template <Numeric T, Layout L>
 template <Numeric U>
-[[nodiscard]] auto Matrix<T>::operator+(const Matrix<U> &other) const {
+[[nodiscard]] auto Matrix<T, L>::operator+(const Matrix<U, L> &other) const {
   if (_rows != other.row_count() || _cols != other.column_count()) {
     throw std::invalid_argument("Matrices have to be of same dimensions for addition!");
   }
   using R = std::common_type_t<T, U>;
 
-  Matrix<R> result(_rows, _cols);
+  Matrix<R, L> result(_rows, _cols, util::uninitialized);
 
-  if (_data.size() > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < _data.size(); ++i) {
-      result.data()[i] = static_cast<R>(_data[i]) + static_cast<R>(other.data()[i]);
-    }
-  } else {
+  exec::parallel_for(0, _data.size(), linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < _data.size(); ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       result.data()[i] = static_cast<R>(_data[i]) + static_cast<R>(other.data()[i]);
     }
-  }
+  });
   return result;
 }
 
 // Add a scalar to each element of matrix
-template <Numeric T>
+template <Numeric T, Layout L>
 template <Numeric U>
-[[nodiscard]] auto Matrix<T>::operator+(const U &scalar) const noexcept {
+[[nodiscard]] auto Matrix<T, L>::operator+(const U &scalar) const noexcept {
   using R = std::common_type_t<T, U>;
 
-  Matrix<R> result(_rows, _cols);
+  Matrix<R, L> result(_rows, _cols, util::uninitialized);
   R r_scalar = static_cast<R>(scalar);
 
-  if (_data.size() > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < _data.size(); ++i) {
-      result.data()[i] = static_cast<R>(_data[i]) + r_scalar;
-    }
-  } else {
+  exec::parallel_for(0, _data.size(), linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < _data.size(); ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       result.data()[i] = static_cast<R>(_data[i]) + r_scalar;
     }
-  }
+  });
   return result;
 }
 
 /**
  * @brief Element-wise scalar addition (scalar + Matrix).
  */
-template <Numeric T, Numeric U>
-[[nodiscard]] auto operator+(const U &scalar, const Matrix<T> &matrix) noexcept {
+template <Numeric T, Layout L, Numeric U>
+[[nodiscard]] auto operator+(const U &scalar, const Matrix<T, L> &matrix) noexcept {
   return matrix + scalar;
 }
 
 // Add 2 matrices element-wise
-template <Numeric T>
+template <Numeric T, Layout L>
 template <Numeric U>
-Matrix<T> &Matrix<T>::operator+=(const Matrix<U> &other) {
+Matrix<T, L> &Matrix<T, L>::operator+=(const Matrix<U, L> &other) {
   if (_rows != other.row_count() || _cols != other.column_count()) {
     throw std::invalid_argument("Matrices have to be of same dimensions for addition!");
   }
 
-  if (_data.size() > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < _data.size(); ++i) {
-      _data[i] += static_cast<T>(other.data()[i]);
-    }
-  } else {
+  exec::parallel_for(0, _data.size(), linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < _data.size(); ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       _data[i] += static_cast<T>(other.data()[i]);
     }
-  }
+  });
 
   return *this;
 }
 
 // Add a scalar to each element of matrix
-template <Numeric T>
+template <Numeric T, Layout L>
 template <Numeric U>
-Matrix<T> &Matrix<T>::operator+=(const U &scalar) noexcept {
+Matrix<T, L> &Matrix<T, L>::operator+=(const U &scalar) noexcept {
   using R = std::common_type_t<T, U>;
 
   R r_scalar = static_cast<R>(scalar);
 
-  if (_data.size() > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < _data.size(); ++i) {
-      _data[i] += r_scalar;
-    }
-  } else {
+  exec::parallel_for(0, _data.size(), linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < _data.size(); ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       _data[i] += r_scalar;
     }
-  }
+  });
   return *this;
 }
 
 // Subtract 2 matrices element-wise
-template <Numeric T>
+template <Numeric T, Layout L>
 template <Numeric U>
-[[nodiscard]] auto Matrix<T>::operator-(const Matrix<U> &other) const {
+[[nodiscard]] auto Matrix<T, L>::operator-(const Matrix<U, L> &other) const {
   if (_rows != other.row_count() || _cols != other.column_count()) {
     throw std::invalid_argument(
         "Matrices have to be of same dimensions for subtraction!");
   }
   using R = std::common_type_t<T, U>;
 
-  Matrix<R> result(_rows, _cols);
-  if (_data.size() > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < _data.size(); ++i) {
-      result.data()[i] = static_cast<R>(_data[i]) - static_cast<R>(other.data()[i]);
-    }
-  } else {
+  Matrix<R, L> result(_rows, _cols, util::uninitialized);
+  exec::parallel_for(0, _data.size(), linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < _data.size(); ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       result.data()[i] = static_cast<R>(_data[i]) - static_cast<R>(other.data()[i]);
     }
-  }
+  });
   return result;
 }
 
 // Subtract a scalar from each element of matrix
-template <Numeric T>
+template <Numeric T, Layout L>
 template <Numeric U>
-[[nodiscard]] auto Matrix<T>::operator-(const U &scalar) const noexcept {
+[[nodiscard]] auto Matrix<T, L>::operator-(const U &scalar) const noexcept {
   using R = std::common_type_t<T, U>;
 
-  Matrix<R> result(_rows, _cols);
+  Matrix<R, L> result(_rows, _cols, util::uninitialized);
   R r_scalar = static_cast<R>(scalar);
 
-  if (_data.size() > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < _data.size(); ++i) {
-      result.data()[i] = static_cast<R>(_data[i]) - r_scalar;
-    }
-  } else {
+  exec::parallel_for(0, _data.size(), linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < _data.size(); ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       result.data()[i] = static_cast<R>(_data[i]) - r_scalar;
     }
-  }
+  });
   return result;
 }
 
@@ -177,129 +147,149 @@ template <Numeric U>
  * @tparam U An arithmetic scalar type.
  * @return Matrix of the common, promoted type.
  */
-template <Numeric T, Numeric U>
-[[nodiscard]] auto operator-(const U &scalar, const Matrix<T> &matrix) {
+template <Numeric T, Layout L, Numeric U>
+[[nodiscard]] auto operator-(const U &scalar, const Matrix<T, L> &matrix) {
   using R = std::common_type_t<T, U>;
 
-  Matrix<R> result(matrix.row_count(), matrix.column_count());
+  Matrix<R, L> result(matrix.row_count(), matrix.column_count(), util::uninitialized);
   R r_scalar = static_cast<R>(scalar);
 
-  if (matrix.size() > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < matrix.size(); ++i) {
-      result.data()[i] = r_scalar - static_cast<R>(matrix.data()[i]);
-    }
-  } else {
+  exec::parallel_for(0, matrix.size(), linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < matrix.size(); ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       result.data()[i] = r_scalar - static_cast<R>(matrix.data()[i]);
     }
-  }
+  });
   return result;
 }
 
 // Subtract 2 matrices element-wise
-template <Numeric T>
+template <Numeric T, Layout L>
 template <Numeric U>
-Matrix<T> &Matrix<T>::operator-=(const Matrix<U> &other) {
+Matrix<T, L> &Matrix<T, L>::operator-=(const Matrix<U, L> &other) {
   if (_rows != other.row_count() || _cols != other.column_count()) {
     throw std::invalid_argument("Matrices have to be of same dimensions for addition!");
   }
 
-  if (_data.size() > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < _data.size(); ++i) {
-      _data[i] -= static_cast<T>(other.data()[i]);
-    }
-  } else {
+  exec::parallel_for(0, _data.size(), linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < _data.size(); ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       _data[i] -= static_cast<T>(other.data()[i]);
     }
-  }
+  });
 
   return *this;
 }
 
 // Subtract a scalar from each element of matrix
-template <Numeric T>
+template <Numeric T, Layout L>
 template <Numeric U>
-Matrix<T> &Matrix<T>::operator-=(const U &scalar) noexcept {
+Matrix<T, L> &Matrix<T, L>::operator-=(const U &scalar) noexcept {
   using R = std::common_type_t<T, U>;
 
   R r_scalar = static_cast<R>(scalar);
 
-  if (_data.size() > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < _data.size(); ++i) {
-      _data[i] -= r_scalar;
-    }
-  } else {
+  exec::parallel_for(0, _data.size(), linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < _data.size(); ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       _data[i] -= r_scalar;
     }
+  });
+  return *this;
+}
+
+// Evaluate an element-wise expression into this matrix
+template <Numeric T, Layout L>
+template <MatrixExpression E>
+  requires(L == Layout::RowMajor)
+Matrix<T, L> &Matrix<T, L>::operator=(const E &expression) {
+  const expr::MatrixShape shape = expression.shape();
+  if (shape.size() != _data.size()) {
+    // Operands are still alive, only this buffer is replaced.
+    storage_type data;
+    data.resize(shape.size());
+    expr::assign<expr::AssignOp::Assign>(data.data(), expression);
+    _data = std::move(data);
+  } else {
+    expr::assign<expr::AssignOp::Assign>(_data.data(), expression);
   }
+  _rows = shape.rows;
+  _cols = shape.cols;
+  return *this;
+}
+
+// Add an element-wise expression to this matrix
+template <Numeric T, Layout L>
+template <MatrixExpression E>
+  requires(L == Layout::RowMajor)
+Matrix<T, L> &Matrix<T, L>::operator+=(const E &expression) {
+  if (_rows != expression.shape().rows || _cols != expression.shape().cols) {
+    throw std::invalid_argument("Matrices have to be of same dimensions for addition!");
+  }
+  expr::assign<expr::AssignOp::AddAssign>(_data.data(), expression);
+  return *this;
+}
+
+// Subtract an element-wise expression from this matrix
+template <Numeric T, Layout L>
+template <MatrixExpression E>
+  requires(L == Layout::RowMajor)
+Matrix<T, L> &Matrix<T, L>::operator-=(const E &expression) {
+  if (_rows != expression.shape().rows || _cols != expression.shape().cols) {
+    throw std::invalid_argument(
+        "Matrices have to be of same dimensions for subtraction!");
+  }
+  expr::assign<expr::AssignOp::SubAssign>(_data.data(), expression);
   return *this;
 }
 
 // Multiply each element of matrix by a scalar
-template <Numeric T>
+template <Numeric T, Layout L>
 template <Numeric U>
-[[nodiscard]] auto Matrix<T>::operator*(const U &scalar) const noexcept {
+[[nodiscard]] auto Matrix<T, L>::operator*(const U &scalar) const noexcept {
   using R = std::common_type_t<T, U>;
 
-  Matrix<R> result(_rows, _cols);
+  Matrix<R, L> result(_rows, _cols, util::uninitialized);
   R r_scalar = static_cast<R>(scalar);
 
-  if (_data.size() > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < _data.size(); ++i) {
-      result.data()[i] = static_cast<R>(_data[i]) * r_scalar;
-    }
-  } else {
+  exec::parallel_for(0, _data.size(), linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < _data.size(); ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       result.data()[i] = static_cast<R>(_data[i]) * r_scalar;
     }
-  }
+  });
   return result;
 }
 
 /**
  * @brief Element-wise scalar multiplication (scalar * Matrix).
  */
-template <Numeric T, Numeric U>
-[[nodiscard]] auto operator*(const U &scalar, const Matrix<T> &matrix) noexcept {
+template <Numeric T, Layout L, Numeric U>
+[[nodiscard]] auto operator*(const U &scalar, const Matrix<T, L> &matrix) noexcept {
   return matrix * scalar;
 }
 
 // Multiply each element of matrix by a scalar
-template <Numeric T>
+template <Numeric T, Layout L>
 template <Numeric U>
-Matrix<T> &Matrix<T>::operator*=(const U &scalar) noexcept {
+Matrix<T, L> &Matrix<T, L>::operator*=(const U &scalar) noexcept {
   using R = std::common_type_t<T, U>;
 
   R r_scalar = static_cast<R>(scalar);
 
-  if (_data.size() > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < _data.size(); ++i) {
-      _data[i] *= r_scalar;
-    }
-  } else {
+  exec::parallel_for(0, _data.size(), linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < _data.size(); ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       _data[i] *= r_scalar;
     }
-  }
+  });
   return *this;
 }
 
 // Matrix-Vector multiplication (Matrix * column_vector)
-template <Numeric T>
+template <Numeric T, Layout L>
 template <Numeric U>
-[[nodiscard]] auto Matrix<T>::operator*(const Vector<U> &other) const {
+[[nodiscard]] auto Matrix<T, L>::operator*(const Vector<U> &other) const {
   using R = std::common_type_t<T, U>;
 
   if (other.orientation() == Orientation::ROW) {
@@ -313,65 +303,84 @@ template <Numeric U>
         "Dimension mismatch in Matrix * Vector multiplication.");
   }
 
-#if defined(__APPLE__) && defined(ACCELERATE_AVAILABLE)
-  if constexpr (std::is_same_v<R, float>) {
-    return Vector<R>(_rows,
-                     acc::sgemvm(_rows, _cols, util::convert_if_needed<R>(_data),
-                                 util::convert_if_needed<R>(other.data_vector())),
-                     COLUMN);
-
-  } else if constexpr (std::is_same_v<R, double>) {
-    return Vector<R>(_rows,
-                     acc::dgemvm(_rows, _cols, util::convert_if_needed<R>(_data),
-                                 util::convert_if_needed<R>(other.data_vector())),
-                     COLUMN);
+#if defined(MAF_BLAS_AVAILABLE)
+  if constexpr (std::is_same_v<T, R> && std::is_same_v<U, R> && blas::supports<R>) {
+    Vector<R> result(_rows, util::uninitialized, COLUMN);
+    if constexpr (L == Layout::RowMajor) {
+      blas::gemv(blas::Trans::NoTrans, _rows, _cols, R(1), _data.data(), _cols,
+                 other.data(), 1, R(0), result.data(), 1);
+    } else {
+      // Column-major A is the row-major storage of A^T.
+      blas::gemv(blas::Trans::Trans, _cols, _rows, R(1), _data.data(), _rows,
+                 other.data(), 1, R(0), result.data(), 1);
+    }
+    return result;
   }
 #endif
 
-  Vector<R> result(_rows, std::vector<R>(_rows, R(0)), COLUMN);
-  if (_rows * _cols >= OMP_QUADRATIC_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < _rows; ++i) {
-      auto L_row_i = row_span(i);
+  // 16-bit floats accumulate in float and are rounded once, on the final store.
+  using A = accumulation_t<R>;
+  Vector<R> result(_rows, util::uninitialized, COLUMN);
+  const U *x = other.data();
+  if constexpr (L == Layout::ColMajor) {
+    // y = sum_j x[j] * A(:, j), one contiguous column at a time. Each thread owns a
+    // block of rows so the updates stay unit-stride and race free.
+    constexpr size_t ROW_BLOCK = 512;
+    const size_t blocks = (_rows + ROW_BLOCK - 1) / ROW_BLOCK;
+    const exec::Split split = quadratic_split(_rows * _cols);
+    exec::parallel_for(0, blocks, split, [&](size_t b0, size_t b1) {
+      for (size_t b = b0; b < b1; ++b) {
+        const size_t i0 = b * ROW_BLOCK;
+        const size_t len = std::min(ROW_BLOCK, _rows - i0);
+        alignas(64) A y[ROW_BLOCK];
+        std::fill_n(y, len, A(0));
+        for (size_t j = 0; j < _cols; ++j) {
+          const T *col = &_data[(j * _rows) + i0];
+          const A xj = static_cast<A>(x[j]);
 #pragma omp simd
-      for (size_t j = 0; j < _cols; ++j) {
-        result[i] += static_cast<R>(L_row_i[j]) * static_cast<R>(other[j]);
+          for (size_t i = 0; i < len; ++i) {
+            y[i] += static_cast<A>(col[i]) * xj;
+          }
+        }
+        util::convert_n(y, len, result.data() + i0);
       }
-    }
-  } else {
-    for (size_t i = 0; i < _rows; ++i) {
-      auto L_row_i = row_span(i);
-#pragma omp simd
+    });
+    return result;
+  }
+
+  // Mixed types are converted element by element inside the dot products.
+  const exec::Split split = quadratic_split(_rows * _cols);
+  exec::parallel_for(0, _rows, split, [&](size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; ++i) {
+      const T *row = &_data[i * _cols];
+      A sum = 0;
+#pragma omp simd reduction(+ : sum)
       for (size_t j = 0; j < _cols; ++j) {
-        result[i] += static_cast<R>(L_row_i[j]) * static_cast<R>(other[j]);
+        sum += static_cast<A>(row[j]) * static_cast<A>(x[j]);
       }
+      result[i] = static_cast<R>(sum);
     }
-  }
+  });
   return result;
 }
 
 // Divide each element of matrix by a scalar
-template <Numeric T>
+template <Numeric T, Layout L>
 template <Numeric U>
-[[nodiscard]] auto Matrix<T>::operator/(const U &scalar) const noexcept {
+[[nodiscard]] auto Matrix<T, L>::operator/(const U &scalar) const noexcept {
   using R =
       std::conditional_t<std::is_integral_v<T> && std::is_integral_v<U>, double,
                          std::common_type_t<T, U>>;  // Forces double if both are ints
 
-  Matrix<R> result(_rows, _cols);
+  Matrix<R, L> result(_rows, _cols, util::uninitialized);
   R r_scalar_inv = R(1) / static_cast<R>(scalar);
 
-  if (_data.size() > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < _data.size(); ++i) {
-      result.data()[i] = static_cast<R>(_data[i]) * r_scalar_inv;
-    }
-  } else {
+  exec::parallel_for(0, _data.size(), linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < _data.size(); ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       result.data()[i] = static_cast<R>(_data[i]) * r_scalar_inv;
     }
-  }
+  });
   return result;
 }
 
@@ -380,63 +389,48 @@ template <Numeric U>
  * @tparam U An arithmetic scalar type.
  * @return Matrix of the common, promoted type.
  */
-template <Numeric T, Numeric U>
-[[nodiscard]] auto operator/(const U &scalar, const Matrix<T> &matrix) noexcept {
+template <Numeric T, Layout L, Numeric U>
+[[nodiscard]] auto operator/(const U &scalar, const Matrix<T, L> &matrix) noexcept {
   using R =
       std::conditional_t<std::is_integral_v<T> && std::is_integral_v<U>, double,
                          std::common_type_t<T, U>>;  // Forces double if both are ints
 
-  Matrix<R> result(matrix.row_count(), matrix.column_count());
+  Matrix<R, L> result(matrix.row_count(), matrix.column_count(), util::uninitialized);
   R r_scalar = static_cast<R>(scalar);
 
-  if (matrix.size() > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < matrix.size(); ++i) {
-      result.data()[i] = r_scalar / static_cast<R>(matrix.data()[i]);
-    }
-  } else {
+  exec::parallel_for(0, matrix.size(), linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < matrix.size(); ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       result.data()[i] = r_scalar / static_cast<R>(matrix.data()[i]);
     }
-  }
+  });
   return result;
 }
 
 // Divide each element of matrix by a scalar
-template <Numeric T>
+template <Numeric T, Layout L>
 template <Numeric U>
-Matrix<T> &Matrix<T>::operator/=(const U &scalar) noexcept {
+Matrix<T, L> &Matrix<T, L>::operator/=(const U &scalar) noexcept {
   using R = std::common_type_t<T, U>;
 
   if constexpr (std::is_floating_point_v<R>) {
     R r_scalar_inv = R(1) / static_cast<R>(scalar);
 
-    if (_data.size() > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-      for (size_t i = 0; i < _data.size(); ++i) {
-        _data[i] *= r_scalar_inv;
-      }
-    } else {
+    exec::parallel_for(0, _data.size(), linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-      for (size_t i = 0; i < _data.size(); ++i) {
+      for (size_t i = lo; i < hi; ++i) {
         _data[i] *= r_scalar_inv;
       }
-    }
+    });
   } else {
     R r_scalar = static_cast<R>(scalar);
 
-    if (_data.size() > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-      for (size_t i = 0; i < _data.size(); ++i) {
-        _data[i] /= r_scalar;
-      }
-    } else {
+    exec::parallel_for(0, _data.size(), linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-      for (size_t i = 0; i < _data.size(); ++i) {
+      for (size_t i = lo; i < hi; ++i) {
         _data[i] /= r_scalar;
       }
-    }
+    });
   }
   return *this;
 }
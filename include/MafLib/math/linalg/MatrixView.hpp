@@ -2,6 +2,7 @@
 #define MATRIX_VIEW_H
 #pragma once
 #include "MafLib/utility/Math.hpp"
+#include "VectorView.hpp"
 
 namespace maf::math {
 using namespace maf::util;
@@ -10,7 +11,12 @@ using namespace maf::util;
  * This class does not own the data; it provides a window into
  * the data of another Matrix.
  *
- * @tparam T The numeric type of the matrix elements (e.g., float, double).
+ * Element (i, j) lives at data()[i * row_stride() + j * column_stride()], so the same
+ * class describes row-major blocks, column-major blocks, transposes and strided
+ * slices without copying. `MatrixView<const T>` is a read-only view.
+ *
+ * @tparam T The numeric type of the matrix elements (e.g., float, double), const
+ * qualified for read-only views.
  *
  * @version 1.0
  * @since 2025
@@ -25,14 +31,31 @@ class MatrixView {
   /** @brief Default constructor creating an empty MatrixView. */
   explicit MatrixView() = default;
 
-  /** @brief Constructs a MatrixView.
+  /** @brief Constructs a MatrixView over rows with unit column stride.
    * @param data Pointer to the starting element of the submatrix.
    * @param r The logical number of rows in the submatrix.
    * @param c The logical number of columns in the submatrix.
    * @param s The stride (parent Matrix width) between rows.
    */
   explicit MatrixView(T *data, size_t r, size_t c, size_t s)
-      : _data(data), _rows(r), _cols(c), _stride(s) {}
+      : _data(data), _rows(r), _cols(c), _stride(s), _col_stride(1) {}
+
+  /** @brief Constructs a MatrixView with arbitrary strides.
+   * @param data Pointer to the starting element of the submatrix.
+   * @param r The logical number of rows in the submatrix.
+   * @param c The logical number of columns in the submatrix.
+   * @param rs The distance between elements (i, j) and (i + 1, j).
+   * @param cs The distance between elements (i, j) and (i, j + 1).
+   */
+  explicit MatrixView(T *data, size_t r, size_t c, size_t rs, size_t cs)
+      : _data(data), _rows(r), _cols(c), _stride(rs), _col_stride(cs) {}
+
+  /** @brief Converts a mutable view into a read-only view of the same elements. */
+  template <Numeric U>
+    requires(std::is_const_v<T> && std::is_same_v<const U, T>)
+  MatrixView(const MatrixView<U> &other)
+      : MatrixView(other.data(), other.row_count(), other.column_count(),
+                   other.row_stride(), other.column_stride()) {}
 
   /** @brief Returns a pointer to the underlying data (mutable). */
   [[nodiscard]] T *data() noexcept { return _data; }
@@ -40,16 +63,31 @@ class MatrixView {
   [[nodiscard]] const value_type *data() const noexcept { return _data; }
 
   /** @brief Provides unchecked access to row r.
+   * @attention Only valid for views with unit column stride.
    * @return A pointer to the first element of row r (use as view[r][c]).
    */
-  [[nodiscard]] T *operator[](size_t r) noexcept { return _data + (r * _stride); }
+  [[nodiscard]] T *operator[](size_t r) noexcept {
+    assert(_col_stride == 1);
+    return _data + (r * _stride);
+  }
   /** @brief Provides unchecked access to row r.
+   * @attention Only valid for views with unit column stride.
    * @return A pointer to the first element of row r (use as view[r][c]).
    */
   [[nodiscard]] const value_type *operator[](size_t r) const noexcept {
+    assert(_col_stride == 1);
     return _data + (r * _stride);
   }
 
+  /** @brief Provides unchecked access to the element at (row, col), any strides. */
+  [[nodiscard]] T &operator[](size_t row, size_t col) noexcept {
+    return _data[(row * _stride) + (col * _col_stride)];
+  }
+  /** @brief Provides unchecked access to the element at (row, col), any strides. */
+  [[nodiscard]] const value_type &operator[](size_t row, size_t col) const noexcept {
+    return _data[(row * _stride) + (col * _col_stride)];
+  }
+
   /**
    * @brief Gets a mutable reference to the element at (row, col).
    * @throws std::out_of_range if the index is invalid.
@@ -58,7 +96,7 @@ class MatrixView {
     if (row >= _rows || col >= _cols) {
       throw std::out_of_range("View index out of bounds");
     }
-    return _data[(row * _stride) + col];
+    return _data[(row * _stride) + (col * _col_stride)];
   }
 
   /**
@@ -69,28 +107,75 @@ class MatrixView {
     if (row >= _rows || col >= _cols) {
       throw std::out_of_range("View index out of bounds");
     }
-    return _data[(row * _stride) + col];
+    return _data[(row * _stride) + (col * _col_stride)];
   }
 
   /**
    * @brief Gets a std::span of a single row.
    * @throws std::out_of_range if the row is invalid.
+   * @throws std::logic_error if the rows of the view are not contiguous.
    */
   [[nodiscard]] std::span<T> row_span(size_t r) {
-    if (r >= _rows) {
-      throw std::out_of_range("Row index out of bounds");
-    }
+    _check_row_span(r);
     return std::span<T>(_data + (r * _stride), _cols);
   }
 
   /** @brief Returns a const span of a single row.
    * @throws std::out_of_range if the row is invalid.
+   * @throws std::logic_error if the rows of the view are not contiguous.
    */
   [[nodiscard]] std::span<const value_type> row_span(size_t r) const {
+    _check_row_span(r);
+    return std::span<const value_type>(_data + (r * _stride), _cols);
+  }
+
+  /**
+   * @brief Creates a view (sub-matrix) into this view.
+   * @throws std::invalid_argument if height or width is zero.
+   * @throws std::out_of_range if the requested view exceeds the view dimensions.
+   */
+  [[nodiscard]] MatrixView view(size_t row, size_t col, size_t height,
+                                size_t width) const {
+    if (height == 0 || width == 0) {
+      throw std::invalid_argument("View dimensions must be greater than zero.");
+    }
+    if (row + height > _rows || col + width > _cols) {
+      throw std::out_of_range("Requested view exceeds matrix dimensions.");
+    }
+    return MatrixView(_data + (row * _stride) + (col * _col_stride), height, width,
+                      _stride, _col_stride);
+  }
+
+  /** @brief Returns the transpose of this view; no element is copied. */
+  [[nodiscard]] MatrixView transposed_view() const noexcept {
+    return MatrixView(_data, _cols, _rows, _col_stride, _stride);
+  }
+
+  /**
+   * @brief Returns row r as a ROW VectorView.
+   * @throws std::out_of_range if the row is invalid.
+   */
+  [[nodiscard]] VectorView<T> row_view(size_t r) const {
     if (r >= _rows) {
       throw std::out_of_range("Row index out of bounds");
     }
-    return std::span<const T>(_data + (r * _stride), _cols);
+    return VectorView<T>(_data + (r * _stride), _cols, ROW, _col_stride);
+  }
+
+  /**
+   * @brief Returns column c as a COLUMN VectorView.
+   * @throws std::out_of_range if the column is invalid.
+   */
+  [[nodiscard]] VectorView<T> column_view(size_t c) const {
+    if (c >= _cols) {
+      throw std::out_of_range("Column index out of bounds");
+    }
+    return VectorView<T>(_data + (c * _col_stride), _rows, COLUMN, _stride);
+  }
+
+  /** @brief Returns the main diagonal as a COLUMN VectorView. */
+  [[nodiscard]] VectorView<T> diagonal_view() const noexcept {
+    return VectorView<T>(_data, std::min(_rows, _cols), COLUMN, _stride + _col_stride);
   }
 
   /** @brief Gets the number of rows. */
@@ -99,9 +184,21 @@ class MatrixView {
   /** @brief Gets the number of columns. */
   [[nodiscard]] size_t column_count() const noexcept { return _cols; }
 
-  /** @brief Gets the stride of parent Matrix. */
+  /** @brief Gets the stride between rows (parent Matrix width for row-major views). */
   [[nodiscard]] size_t get_stride() const noexcept { return _stride; }
 
+  /** @brief Gets the distance between elements (i, j) and (i + 1, j). */
+  [[nodiscard]] size_t row_stride() const noexcept { return _stride; }
+
+  /** @brief Gets the distance between elements (i, j) and (i, j + 1). */
+  [[nodiscard]] size_t column_stride() const noexcept { return _col_stride; }
+
+  /** @brief True if every row is contiguous, i.e. the column stride is one. */
+  [[nodiscard]] bool is_row_major() const noexcept { return _col_stride == 1; }
+
+  /** @brief True if every column is contiguous, i.e. the row stride is one. */
+  [[nodiscard]] bool is_column_major() const noexcept { return _stride == 1; }
+
   /**
    * @brief Prints the MatrixView contents to std::cout.
    * @details Sets floating point precision for readability.
@@ -119,10 +216,20 @@ class MatrixView {
   }
 
  private:
-  T *_data;        // Pointer to the start of the submatrix (top-left)
-  size_t _rows;    // Logical height
-  size_t _cols;    // Logical width
-  size_t _stride;  // Parent Matrix width
+  T *_data;            // Pointer to the start of the submatrix (top-left)
+  size_t _rows;        // Logical height
+  size_t _cols;        // Logical width
+  size_t _stride;      // Distance between rows (parent Matrix width)
+  size_t _col_stride;  // Distance between columns (1 = contiguous rows)
+
+  void _check_row_span(size_t r) const {
+    if (r >= _rows) {
+      throw std::out_of_range("Row index out of bounds");
+    }
+    if (_col_stride != 1 && _cols > 1) {
+      throw std::logic_error("Rows of this view are not contiguous");
+    }
+  }
 };
 }  // namespace maf::math
 
@@ -34,17 +34,16 @@ auto operator*(const T &A, const V &x) {
   }
 
   using T_type = typename T::value_type;
-  using V_type = typename V::value_type;
 
-  MatrixView<T_type> A_view;
-  if constexpr (std::is_same_v<T, MatrixView<T_type>>) {
+  MatrixView<const T_type> A_view;
+  if constexpr (MatrixViewType<T>) {
     A_view = A;
   } else {
-    A_view = A.view(0, 0, A.row_count(), A.column_count());
+    A_view = A.view();
   }
 
   // GEMV does the conversion of types internally(naively)
-  if constexpr (std::is_same_v<V, VectorView<V_type>>) {
+  if constexpr (VectorViewType<V>) {
     return kernels::gemv(kernels::OP::NoTrans, A_view, x);
   } else {
     return kernels::gemv(kernels::OP::NoTrans, A_view, x.view(0, x.size()));
@@ -2,15 +2,23 @@
 #define PLU_H
 #pragma once
 #include "Matrix.hpp"
+#include "ViewKernels.hpp"
 
 /**
  * @file PLU.hpp
  * @brief High-performance PLU decomposition for square matrices.
  *
  * This header defines the `plu` function, which computes the PLU decomposition
- * of a given square matrix A, where PA = LU. The implementation uses a
- * blocked right-looking algorithm for improved cache performance and is
- * parallelized with OpenMP for multi-threading and SIMD vectorization.
+ * of a given square matrix A, where PA = LU. The factorization runs in place on one
+ * copy of A and stores L and U packed in it, like LAPACK's getrf: the strictly lower
+ * triangle holds L (whose unit diagonal is implied) and the upper triangle holds U.
+ *
+ * The columns are factored recursively: the left half is factored, its row swaps
+ * are applied to whole rows, the top right block is solved against the unit lower
+ * triangle and the bottom right block is updated by one GEMM before the right half
+ * is factored. Most of the work therefore runs in large packed GEMM calls (or the
+ * vendor BLAS); only panels of at most tuning().block_size columns are factored
+ * element by element.
  *
  * The function checks for squareness and detects singularity during the
  * computation. It supports both single and double precision floating point
@@ -22,161 +30,338 @@
  */
 namespace maf::math {
 /**
- * @brief Struct to hold the result of a PLU decomposition.
+ * @brief Result of a PLU decomposition, with L and U packed in one matrix.
  *
- * This struct contains the permutation vector P, the lower triangular
- * matrix L, the upper triangular matrix U, and the sign of the permutation.
+ * L and U are materialised on request by L() and U(); the packed storage is
+ * available through packed(). Structured bindings still unpack the four parts:
+ * `auto [P, L, U, sign] = plu(A);`.
  *
  * @tparam T The floating point type of the matrix elements (e.g., float,
  * double).
  */
 template <std::floating_point T>
-struct PLUResult {
-  std::vector<uint32> P;  // Permutation vector
-  Matrix<T> L;            // Lower triangular matrix
-  Matrix<T> U;            // Upper triangular matrix
+class PLUResult {
+ public:
+  std::vector<uint32> P;  // Permutation vector: row i of PA is row P[i] of A
   int8 sign = 1;          // Sign of the permutation (+1 or -1)
+
+  PLUResult() = default;
+  PLUResult(Matrix<T> &&lu, std::vector<uint32> &&permutation, int8 sign) noexcept
+      : P(std::move(permutation)), sign(sign), _lu(std::move(lu)) {}
+
+  /** @brief Order of the factored matrix. */
+  [[nodiscard]] size_t size() const noexcept { return _lu.row_count(); }
+
+  /** @brief L strictly below the diagonal (unit diagonal implied), U on and above. */
+  [[nodiscard]] const Matrix<T> &packed() const noexcept { return _lu; }
+
+  /** @brief Copies the unit lower triangular factor out of the packed storage. */
+  [[nodiscard]] Matrix<T> L() const {
+    const size_t n = size();
+    Matrix<T> result(n, n);
+    exec::parallel_for(0, n, quadratic_split(n * n), [&](size_t lo, size_t hi) {
+      for (size_t i = lo; i < hi; ++i) {
+        std::copy_n(_lu.row_span(i).data(), i, result.row_span(i).data());
+        result.at(i, i) = T(1);
+      }
+    });
+    return result;
+  }
+
+  /** @brief Copies the upper triangular factor out of the packed storage. */
+  [[nodiscard]] Matrix<T> U() const {
+    const size_t n = size();
+    Matrix<T> result(n, n);
+    exec::parallel_for(0, n, quadratic_split(n * n), [&](size_t lo, size_t hi) {
+      for (size_t i = lo; i < hi; ++i) {
+        std::copy_n(_lu.row_span(i).data() + i, n - i, result.row_span(i).data() + i);
+      }
+    });
+    return result;
+  }
+
+  /** @brief Element I of (P, L, U, sign); lets structured bindings unpack a result. */
+  template <size_t I>
+  [[nodiscard]] auto get() const {
+    static_assert(I < 4, "PLUResult has four parts: P, L, U and sign.");
+    if constexpr (I == 0) {
+      return P;
+    } else if constexpr (I == 1) {
+      return L();
+    } else if constexpr (I == 2) {
+      return U();
+    } else {
+      return sign;
+    }
+  }
+
+ private:
+  Matrix<T> _lu;
 };
 
 namespace detail {
+/** @brief Factorization state shared by the recursive LU kernels. */
+template <std::floating_point T>
+struct LUState {
+  Matrix<T> &A;
+  std::vector<uint32> &P;
+  int8 &sign;
+  size_t block;
+  size_t parallel_rows;
+  uint32 *swaps = nullptr;  // If set, swaps[j] is the row swapped with row j
+};
+
+/**
+ * @brief Unblocked LU of columns [c, c + w) from row c down.
+ * @details Pivot rows are swapped across the whole matrix, so the swaps reach the
+ * already factored columns on the left and the unfactored ones on the right.
+ */
+template <std::floating_point T>
+void lu_unblocked(LUState<T> &state, size_t c, size_t w) {
+  const size_t n = state.A.row_count();
+  T *a = state.A.data();
+  const exec::Split rows{.serial_limit = state.parallel_rows};
+  for (size_t j = c; j < c + w; ++j) {
+    // Find Pivot
+    size_t pivot_row = j;
+    T max_val = std::abs(a[(j * n) + j]);
+    for (size_t i = j + 1; i < n; ++i) {
+      const T curr_val = std::abs(a[(i * n) + j]);
+      if (curr_val > max_val) {
+        max_val = curr_val;
+        pivot_row = i;
+      }
+    }
+    if (is_close(max_val, static_cast<T>(0), 1e-9)) {
+      throw std::runtime_error("Matrix is singular; pivot is near zero.");
+    }
+    if (state.swaps != nullptr) {
+      state.swaps[j] = static_cast<uint32>(pivot_row);
+    }
+    if (pivot_row != j) {
+      std::swap_ranges(a + (j * n), a + ((j + 1) * n), a + (pivot_row * n));
+      std::swap(state.P[j], state.P[pivot_row]);
+      state.sign = static_cast<int8>(-state.sign);
+    }
+
+    // Multipliers and rank-1 update of the rest of the panel
+    const T *pivot = a + (j * n);
+    const T inv_pivot = T(1) / pivot[j];
+    exec::parallel_for(j + 1, n, rows, [&](size_t lo, size_t hi) {
+      for (size_t i = lo; i < hi; ++i) {
+        T *row = a + (i * n);
+        const T mult = row[j] * inv_pivot;
+        row[j] = mult;
+#pragma omp simd
+        for (size_t k = j + 1; k < c + w; ++k) {
+          row[k] -= mult * pivot[k];
+        }
+      }
+    });
+  }
+}
+
+/** @brief Recursive LU of columns [c, c + w) from row c down. */
+template <std::floating_point T>
+void lu_recursive(LUState<T> &state, size_t c, size_t w) {
+  if (w <= state.block) {
+    lu_unblocked(state, c, w);
+    return;
+  }
+  // Conceptual block matrix of the columns:
+  // [A_11, A_12]
+  // [A_21, A_22]
+  Matrix<T> &A = state.A;
+  const size_t w1 = w / 2;
+  const size_t c2 = c + w1;
+  const size_t below = A.row_count() - c2;
+  lu_recursive(state, c, w1);
+  // A_12 = L_11^-1 * A_12, then A_22 -= L_21 * U_12
+  kernels::trsm(kernels::UPLO::Lower, kernels::OP::NoTrans, kernels::DIAG::Unit,
+                A.view(c, c, w1, w1), A.view(c, c2, w1, w - w1));
+  kernels::gemm(kernels::OP::NoTrans, kernels::OP::NoTrans, -1.0,
+                A.view(c2, c, below, w1), A.view(c, c2, w1, w - w1), 1.0,
+                A.view(c2, c2, below, w - w1));
+  lu_recursive(state, c2, w - w1);
+}
+
 /**
  * @brief Internal implementation of PLU decomposition.
  *
- * Computes L and U where P * A = L * U for square matrix A.
- * Uses blocked algorithm with OpenMP parallelization.
+ * Overwrites A with L and U where P * A = L * U, see the file comment.
  */
 template <std::floating_point T>
-[[nodiscard]] PLUResult<T> _plu(Matrix<T> &&_U) {
-  if (!_U.is_square()) {
+[[nodiscard]] PLUResult<T> _plu(Matrix<T> &&A) {
+  if (!A.is_square()) {
     throw std::invalid_argument("Matrix must be square for PLU decomposition!");
   }
 
-  const size_t n = _U.row_count();
-  if (n == 0) {
-    return {std::vector<uint32>(), Matrix<T>(), Matrix<T>()};
-  }
-
+  const size_t n = A.row_count();
   std::vector<uint32> P(n);
   // TODO: Change this to ranges::iota when Apple Clang fully supports c++23
   // std::ranges::iota(P, 0);
   std::iota(P.begin(), P.end(), 0);
-  Matrix<T> L = identity_matrix<T>(n);
   int8 sign = 1;
+  LUState<T> state{A, P, sign, tuning().block_size, tuning().lu_parallel_limit};
+  lu_recursive(state, 0, n);
+  return PLUResult<T>(std::move(A), std::move(P), sign);
+}
 
-  // Conceptual block matrix:
-  // A = [A_11, A_12]
-  //     [A_21, A_22]
-
-  for (size_t ib = 0; ib < n; ib += BLOCK_SIZE) {
-    const size_t block_end = std::min(ib + BLOCK_SIZE, n);
-    // Panel Factorization
-    // This computes L_11, L_21, U_11 and updates P
-    for (size_t i = ib; i < block_end && i < n - 1; ++i) {
-      // Find Pivot
-      size_t pivot_row = i;
-      T max_val = std::abs(_U.at(i, i));
-
-      for (size_t j = i + 1; j < n; ++j) {
-        T curr_val = std::abs(_U.at(j, i));
-        if (curr_val > max_val) {
-          max_val = curr_val;
-          pivot_row = j;
-        }
-      }
+}  // namespace detail
 
-      if (is_close(max_val, static_cast<T>(0), 1e-9)) {
-        throw std::runtime_error("Matrix is singular; pivot is near zero.");
-      }
+/**
+ * @brief A reusable PLU factorization that solves A X = B for any number of
+ * right-hand sides.
+ *
+ * The factorization owns its storage. Refactoring a matrix of the same order with
+ * factor() reuses it, and solve_inplace() allocates nothing, so a system that is
+ * refitted and solved over and over reaches a steady state without allocations.
+ * The row swaps are kept in the order pivoting made them (LAPACK's ipiv), so they
+ * are applied to the right-hand sides in place. Both triangular solves run through
+ * kernels::trsm.
+ *
+ * @code
+ * LUFactorization<double> lu(A);
+ * auto X = lu.solve(B);
+ * lu.factor(A2);  // same order: no allocation
+ * lu.solve_inplace(B2.view());
+ * @endcode
+ *
+ * @tparam T The floating point type of the factors.
+ */
+template <std::floating_point T>
+class LUFactorization {
+ public:
+  LUFactorization() = default;
+
+  template <Numeric U, Layout LA>
+  explicit LUFactorization(const Matrix<U, LA> &A) {
+    factor(A);
+  }
 
-      if (pivot_row != i) {
-        // Swap permutation vector
-        std::swap(P[i], P[pivot_row]);
-        sign *= -1;
-
-        // Swap entire rows in our working matrix
-        auto row_i = _U.row_span(i);
-        auto row_p = _U.row_span(pivot_row);
-        std::ranges::swap_ranges(row_i, row_p);
-
-        // Swap the already computed part of L
-        if (i > 0) {
-          auto l_row_i = L.row_span(i).subspan(0, i);
-          auto l_row_p = L.row_span(pivot_row).subspan(0, i);
-          std::ranges::swap_ranges(l_row_i, l_row_p);
+  /**
+   * @brief Factors A of either layout, reusing the storage of the previous
+   * factorization.
+   * @details The factors are always stored row-major; a column-major A is
+   * transposed into that storage while it is copied.
+   * @throws std::invalid_argument if A is not square.
+   * @throws std::runtime_error if A is singular; the factorization is then unusable
+   * until the next successful factor().
+   */
+  template <Numeric U, Layout LA>
+  void factor(const Matrix<U, LA> &A) {
+    if (!A.is_square()) {
+      throw std::invalid_argument("Matrix must be square for PLU decomposition!");
+    }
+    const size_t n = A.row_count();
+    if (_lu.row_count() != n) {
+      _lu = Matrix<T>(n, n, util::uninitialized);
+    }
+    if constexpr (LA == Layout::RowMajor) {
+      std::transform(A.data(), A.data() + A.size(), _lu.data(),
+                     [](U x) { return static_cast<T>(x); });
+    } else {
+      for (size_t j = 0; j < n; ++j) {
+        const U *column = A.data() + (j * n);
+        for (size_t i = 0; i < n; ++i) {
+          _lu[i, j] = static_cast<T>(column[i]);
         }
       }
+    }
+    _P.resize(n);
+    std::iota(_P.begin(), _P.end(), 0);
+    _swaps.resize(n);
+    _sign = 1;
+    detail::LUState<T> state{_lu,
+                             _P,
+                             _sign,
+                             tuning().block_size,
+                             tuning().lu_parallel_limit,
+                             _swaps.data()};
+    detail::lu_recursive(state, 0, n);
+  }
 
-      // Elimination within panel
-      const T pivot = _U.at(i, i);
-      const T inv_pivot = T(1) / pivot;
+  /** @brief Order of the factored matrix. */
+  [[nodiscard]] size_t size() const noexcept { return _lu.row_count(); }
 
-#pragma omp parallel for if (n - (i + 1) > 256)
-      for (size_t j = i + 1; j < n; ++j) {
-        T mult = _U.at(j, i) * inv_pivot;
-        L.at(j, i) = mult;
+  /** @brief L strictly below the diagonal (unit diagonal implied), U on and above. */
+  [[nodiscard]] const Matrix<T> &packed() const noexcept { return _lu; }
 
-#pragma omp simd
-        for (size_t k = i + 1; k < block_end; ++k) {
-          _U.at(j, k) -= mult * _U.at(i, k);
-        }
-      }
-    }
+  /** @brief Row i of PA is row P[i] of A. */
+  [[nodiscard]] const std::vector<uint32> &permutation() const noexcept { return _P; }
 
-    // Update Trailing Matrix
-    if (block_end < n) {
-// Triangular Solve for U_12
-// We must solve L_11 * U_12 = A_12
-#pragma omp parallel for if (n - block_end > 128)
-      for (size_t j = block_end; j < n; ++j) {
-        for (size_t i = ib; i < block_end; ++i) {
-          T sum = _U.at(i, j);
-
-          // Can't be SIMD because of column fetching
-          for (size_t k = ib; k < i; ++k) {
-            sum -= L.at(i, k) * _U.at(k, j);
-          }
-          _U.at(i, j) = sum;
-        }
-      }
+  /** @brief Sign of the permutation (+1 or -1). */
+  [[nodiscard]] int8 sign() const noexcept { return _sign; }
 
-// Now we can apply all the elimination effects on the next block
-#pragma omp parallel for if (n - block_end > 128)
-      for (size_t i = block_end; i < n; ++i) {
-        auto target_row = _U.row_span(i).subspan(block_end);
-        const size_t len = target_row.size();
-        for (size_t k = ib; k < block_end; ++k) {
-          const T mult = L.at(i, k);
-          if (is_close(mult, static_cast<T>(0), static_cast<T>(1e-9))) {
-            continue;
-          }
-          auto pivot_row = _U.row_span(k).subspan(block_end);
+  /** @brief det(A) = sign * det(U). */
+  [[nodiscard]] T determinant() const noexcept {
+    T det = static_cast<T>(_sign);
+    for (size_t i = 0; i < size(); ++i) {
+      det *= _lu[i, i];
+    }
+    return det;
+  }
 
-#pragma omp simd
-          for (size_t j = 0; j < len; ++j) {
-            target_row[j] -= mult * pivot_row[j];
-          }
+  /**
+   * @brief B = A^-1 B in place, for the n x p right-hand sides in the columns of B.
+   * @throws std::invalid_argument if B does not have size() rows.
+   */
+  void solve_inplace(MatrixView<T> B) const {
+    _check_rows(B.row_count());
+    const size_t p = B.column_count();
+    for (size_t j = 0; j < size(); ++j) {
+      if (_swaps[j] != j) {
+        for (size_t c = 0; c < p; ++c) {
+          std::swap(B[j, c], B[_swaps[j], c]);
         }
       }
     }
+    kernels::trsm(kernels::UPLO::Lower, kernels::OP::NoTrans, kernels::DIAG::Unit,
+                  _lu.view(), B);
+    kernels::trsm(kernels::UPLO::Upper, kernels::OP::NoTrans, kernels::DIAG::NonUnit,
+                  _lu.view(), B);
+  }
+
+  /** @brief b = A^-1 b in place. */
+  void solve_inplace(VectorView<T> b) const {
+    _check_rows(b.size());
+    for (size_t j = 0; j < size(); ++j) {
+      std::swap(b[j], b[_swaps[j]]);
+    }
+    kernels::trsv(kernels::UPLO::Lower, kernels::OP::NoTrans, kernels::DIAG::Unit,
+                  _lu.view(), b);
+    kernels::trsv(kernels::UPLO::Upper, kernels::OP::NoTrans, kernels::DIAG::NonUnit,
+                  _lu.view(), b);
   }
-  if (is_close(_U.at(n - 1, n - 1), static_cast<T>(0), 1e-9)) {
-    throw std::runtime_error("Matrix is singular; pivot is near zero.");
+
+  /** @brief Solution of A x = b. */
+  [[nodiscard]] Vector<T> solve(const Vector<T> &b) const {
+    Vector<T> x(b);
+    solve_inplace(x.view(0, x.size()));
+    return x;
   }
 
-  // Extract U
-  Matrix<T> U(n, n);
-#pragma omp parallel for schedule(static) if (n > 256)
-  for (size_t i = 0; i < n; ++i) {
-    T *u_row = &U.at(i, i);
-    const T *a_row = &_U.at(i, i);
-    const size_t len = n - i;
-    std::copy_n(a_row, len, u_row);
+  /** @brief Solution of A X = B, one column per right-hand side. */
+  template <Layout L>
+  [[nodiscard]] Matrix<T, L> solve(const Matrix<T, L> &B) const {
+    Matrix<T, L> X(B);
+    solve_inplace(X.view());
+    return X;
   }
 
-  return PLUResult<T>{std::move(P), std::move(L), std::move(U), sign};
-}
+ private:
+  Matrix<T> _lu;
+  std::vector<uint32> _P;
+  std::vector<uint32> _swaps;  // Row j was swapped with row _swaps[j], in order of j
+  int8 _sign = 1;
+
+  void _check_rows(size_t rows) const {
+    if (rows != size()) {
+      throw std::invalid_argument("Dimensions do not match for LU solve!");
+    }
+  }
+};
 
-}  // namespace detail
 /**
  * @brief Performs a blocked PLU decomposition on a square matrix.
  *
@@ -186,8 +371,8 @@ template <std::floating_point T>
  * - L is a unit lower triangular matrix
  * - U is an upper triangular matrix
  *
- * The decomposition is computed using a right-looking blocked algorithm for
- * improved cache performance. It employs partial pivoting (row swapping) to
+ * The decomposition is computed in place by a recursive algorithm whose updates
+ * are GEMM calls. It employs partial pivoting (row swapping) to
  * ensure numerical stability. The implementation is parallelized using OpenMP
  * for further performance gains on multi-core systems.
  *
@@ -197,20 +382,24 @@ template <std::floating_point T>
  * @tparam T The floating point type of the matrix elements (e.g., float,
  * double).
  * @param matrix The const reference to the square input matrix (A) to
- * decompose.
- * @return A std::tuple containing:
+ * decompose, in either layout. A column-major A is transposed once into the
+ * row-major storage of the factors.
+ * @return A PLUResult that unpacks to:
  * 1. (std::vector<uint32>) The final permutaion of rows.
  * 2. (Matrix<T>) The unit lower triangular matrix (L).
  * 3. (Matrix<T>) The upper triangular matrix (U).
+ * 4. (int8) The sign of the permutation.
  *
  * @throws std::invalid_argument if the input matrix is not square.
  *
- * @version 1.0 (Blocked & Parallelized)
+ * @see LUFactorization to solve systems with the factors.
+ *
+ * @version 2.0 (Recursive & In-Place)
  * @since 2025
  */
 
-template <typename ResultType = void, Numeric T>
-[[nodiscard]] auto plu(const Matrix<T> &matrix) {
+template <typename ResultType = void, Numeric T, Layout L>
+[[nodiscard]] auto plu(const Matrix<T, L> &matrix) {
   using TargetType =
       std::conditional_t<std::is_same_v<ResultType, void>,
                          std::conditional_t<std::is_floating_point_v<T>, T, double>,
@@ -221,11 +410,22 @@ template <typename ResultType = void, Numeric T>
 
   if constexpr (std::is_same_v<TargetType, T>) {
     return detail::_plu(Matrix<TargetType>(matrix));
-  } else {
+  } else if constexpr (L == Layout::RowMajor) {
     return detail::_plu(matrix.template cast<TargetType>());
+  } else {
+    return detail::_plu(Matrix<TargetType>(matrix.template cast<TargetType>()));
   }
 }
 
 }  // namespace maf::math
 
+template <std::floating_point T>
+struct std::tuple_size<maf::math::PLUResult<T>> : std::integral_constant<size_t, 4> {};
+
+template <size_t I, std::floating_point T>
+struct std::tuple_element<I, maf::math::PLUResult<T>> {
+  using type =
+      decltype(std::declval<const maf::math::PLUResult<T> &>().template get<I>());
+};
+
 #endif  // PLU_H
@@ -2,7 +2,7 @@
 #define QR_HPP
 
 #pragma once
-#include "AccelerateWrappers/AccelerateWrapper.hpp"
+#include "BlasWrappers/BlasWrapper.hpp"
 #include "MafLib/main/GlobalHeader.hpp"
 #include "Matrix.hpp"
 #include "MatrixView.hpp"
@@ -14,12 +14,18 @@
  * @file QR.hpp
  * @brief High-performance QR decomposition using Householder reflections.
  *
- * This header defines the `QR_decomposition` function, which computes the QR
- * decomposition of a given matrix A using Householder reflections. The
- * implementation is designed for performance and numerical stability, and it
- * supports both single and double precision floating point types. The function
- * allows users to choose between returning full or thin versions of the Q and R
- * matrices based on their needs.
+ * This header defines the `qr` function, which factors a matrix A = QR with blocked
+ * Householder reflections, and `QR_decomposition`, which returns Q and R explicitly.
+ * The columns are factored in panels of QR_BLOCK reflectors. The reflectors of a
+ * panel are accumulated in the compact WY form H_1 ... H_b = I - V T V^T (LAPACK's
+ * larft), so the trailing matrix is updated by three GEMM calls per panel instead of
+ * a gemv and a ger per column (LAPACK's larfb). The factorization keeps the
+ * reflectors below the diagonal of R, like geqrf, and the T factors of its panels.
+ * Q is never formed unless asked for: QRFactorization applies Q or Q^T to vectors and
+ * matrices panel by panel, which is all a least-squares solve needs.
+ *
+ * For tall, skinny matrices `tsqr` splits the rows into one block per thread,
+ * factors the blocks independently and combines their R factors in a binary tree.
  *
  * More information:
  * https://en.wikipedia.org/wiki/QR_decomposition
@@ -28,19 +34,23 @@ namespace maf::math {
 /**
  * @brief Struct to hold the results of QR decomposition.
  * @tparam T The floating point type of the matrix elements (e.g., float, double).
+ * @tparam L The layout of Q and R, the layout of the decomposed matrix.
  * @details This struct contains the orthogonal matrix Q and the upper triangular
  * matrix R resulting from the QR decomposition. The types of Q and R are both
- * Matrix<T>, where T is a floating point type. The user can choose to return
+ * Matrix<T, L>, where T is a floating point type. The user can choose to return
  * either the full or thin versions of Q and R based on their needs when calling
  * the QR_decomposition function.
  */
-template <std::floating_point T>
+template <std::floating_point T, Layout L = Layout::RowMajor>
 struct QRResult {
-  Matrix<T> Q;
-  Matrix<T> R;
+  Matrix<T, L> Q;
+  Matrix<T, L> R;
 };
 
 namespace detail {
+/** @brief Reflectors accumulated into one compact WY panel. */
+inline constexpr size_t QR_BLOCK = 32;
+
 /**
  * @brief Computes the Householder reflector for a column of A_work.
  * @param A_work The matrix containing the column to reflect. Modified in-place to store
@@ -93,230 +103,853 @@ template <std::floating_point T>
 }
 
 /**
- * @brief Loads the Householder reflector vector from A_work for column j.
- * @param A_work The matrix containing the reflector. The reflector is stored in a
- * compact form: the first element (the "beta" value) is stored in A_work(j,j), and the
- * rest of the reflector vector (the "v" tail) is stored in A_work(j+1..m-1, j).
- * @param j The index of the column for which to load the reflector (0-based).
- * @return A Vector<T> containing the full Householder reflector vector v, where v[0]
- * = 1.0 and v[1..len-1] are loaded from A_work(j+1..m-1, j).
- * @details This function reconstructs the full Householder reflector vector v from its
- * compact storage in A_work. The first element of v is set to 1.0, and the remaining
- * elements are copied from the corresponding entries in A_work. The length of the
- * returned vector is m - j, where m is the number of rows in A_work.
- * @attention The input matrix A_work should have been modified by householder_column()
- * to store the reflector. The caller should ensure that j is a valid column index and
- * that A_work has enough space to store the reflector.
+ * @brief The reflectors V = [V1; V2] of the panel [j0, j0 + ib) and its T factor.
+ * @details V1 is the unit lower triangle of the panel's top ib rows, which shares its
+ * storage with R and is therefore copied into v1 (ib * ib elements). V2 is a view
+ * of the packed storage below it and may have no rows.
  */
 template <std::floating_point T>
-[[nodiscard]] static inline Vector<T> load_reflector(const Matrix<T> &A_work,
-                                                     size_t j) {
-  const size_t m = A_work.row_count();
-  const size_t len = m - j;
-  Vector<T> v_out(len, COLUMN);
-  v_out[0] = 1.0;
-  for (size_t i = 1; i < len; ++i) {
-    v_out[i] = A_work[i + j][j];
+struct WYPanel {
+  MatrixView<const T> V1;
+  MatrixView<const T> V2;
+  MatrixView<const T> T_factor;
+};
+
+template <std::floating_point T>
+[[nodiscard]] WYPanel<T> wy_panel(const Matrix<T> &packed, const Matrix<T> &t_factors,
+                                  size_t j0, size_t ib, T *v1) {
+  const size_t m = packed.row_count();
+  const size_t n = packed.column_count();
+  const T *a = packed.data();
+  for (size_t i = 0; i < ib; ++i) {
+    for (size_t c = 0; c < ib; ++c) {
+      v1[(i * ib) + c] = (c < i) ? a[((j0 + i) * n) + j0 + c] : T(c == i);
+    }
+  }
+  return {MatrixView<const T>(v1, ib, ib, ib),
+          MatrixView<const T>(a + ((j0 + ib) * n) + j0, m - j0 - ib, ib, n),
+          t_factors.view(0, j0, ib, ib)};
+}
+
+/**
+ * @brief C = (I - V op(T) V^T) C, a block reflector applied with GEMM (larfb).
+ * @details op == Trans applies the transposed block reflector, as Q^T does.
+ * @param work Scratch for 2 * ib * C.column_count() elements.
+ */
+template <std::floating_point T>
+void apply_wy(kernels::OP op, const WYPanel<T> &panel, MatrixView<T> C, T *work) {
+  using kernels::OP;
+  const size_t ib = panel.V1.row_count();
+  const size_t rest = panel.V2.row_count();
+  const size_t p = C.column_count();
+  MatrixView<T> W(work, ib, p, p);
+  MatrixView<T> TW(work + (ib * p), ib, p, p);
+  auto C1 = C.view(0, 0, ib, p);
+
+  // W = V^T C
+  kernels::gemm(OP::Trans, OP::NoTrans, 1.0, panel.V1, C1, 0.0, W);
+  if (rest > 0) {
+    kernels::gemm(OP::Trans, OP::NoTrans, 1.0, panel.V2, C.view(ib, 0, rest, p), 1.0,
+                  W);
+  }
+  // C -= V op(T) W
+  kernels::gemm(op, OP::NoTrans, 1.0, panel.T_factor, W, 0.0, TW);
+  kernels::gemm(OP::NoTrans, OP::NoTrans, -1.0, panel.V1, TW, 1.0, C1);
+  if (rest > 0) {
+    kernels::gemm(OP::NoTrans, OP::NoTrans, -1.0, panel.V2, TW, 1.0,
+                  C.view(ib, 0, rest, p));
   }
-  return v_out;
 }
 
 template <typename T>
 using float_promote_t = std::conditional_t<std::is_floating_point_v<T>, T, double>;
 
-}  // namespace detail
-
-template <Numeric T>
-using QRResultType = QRResult<detail::float_promote_t<T>>;
-
 /**
- * @brief Computes the QR decomposition of a matrix A using Householder reflections.
- * @param A The input matrix to decompose.
- * @param full_Q If true, returns the full m x m orthogonal matrix Q. If false, returns
- * the thin m x k matrix Q (where k = min(m, n)).
- * @param full_R If true, returns the full m x n upper triangular matrix R. If false,
- * returns the thin k x n matrix R (where k = min(m, n)).
- * @return A QRResultType<T> containing the matrices Q and R of the decomposition.
- * @details This function performs QR decomposition using Householder reflections. It
- * iteratively computes Householder reflectors to zero out sub-diagonal elements of A,
- * storing the reflectors in-place. After processing all columns, it extracts the upper
- * triangular matrix R and constructs the orthogonal matrix Q from the stored
- * reflectors. The user can choose to return either the full or thin versions of Q and R
- * based on their needs.
- * @throws std::invalid_argument if A is empty or if dimensions are incompatible for
- * decomposition.
+ * @brief Unblocked QR of the panel [j0, j0 + ib) from row j0 down.
+ * @details Every reflector is applied to the remaining columns of the panel only.
+ * The rows are contiguous, so w = v^T A and A -= tau v w^T both sweep the panel row
+ * by row.
+ * @param w Scratch for ib elements.
  */
-template <Numeric T>
-[[nodiscard]] QRResultType<T> QR_decompostion(const Matrix<T> &A, bool full_Q = false,
-                                              bool full_R = false) {
-  using DataType = detail::float_promote_t<T>;
+template <std::floating_point T>
+void factor_panel(Matrix<T> &A, size_t j0, size_t ib, T *tau, T *w) {
   const size_t m = A.row_count();
   const size_t n = A.column_count();
-  if (m == 0 || n == 0) {
-    throw std::invalid_argument("Cannot perform QR decomposition on empty matrix!");
+  T *a = A.data();
+  for (size_t j = j0; j < j0 + ib; ++j) {
+    tau[j] = householder_column(A.view(), j);
+    const size_t c0 = j + 1;
+    const size_t width = j0 + ib - c0;
+    if (tau[j] == T(0) || width == 0) {
+      continue;
+    }
+    std::copy_n(a + (j * n) + c0, width, w);
+    for (size_t i = j + 1; i < m; ++i) {
+      const T vi = a[(i * n) + j];
+      const T *row = a + (i * n) + c0;
+#pragma omp simd
+      for (size_t c = 0; c < width; ++c) {
+        w[c] += vi * row[c];
+      }
+    }
+    for (size_t c = 0; c < width; ++c) {
+      w[c] *= tau[j];
+      a[(j * n) + c0 + c] -= w[c];
+    }
+    for (size_t i = j + 1; i < m; ++i) {
+      const T vi = a[(i * n) + j];
+      T *row = a + (i * n) + c0;
+#pragma omp simd
+      for (size_t c = 0; c < width; ++c) {
+        row[c] -= vi * w[c];
+      }
+    }
   }
+}
 
-  // Smaller dimension determines number of reflectors
-  const size_t k = std::min(m, n);
-
-  Matrix<DataType> A_work = A.template cast<DataType>();
-  std::vector<DataType> tau(k, 0.0);
+/**
+ * @brief Forms the upper triangular T of H_1 ... H_ib = I - V T V^T (larft).
+ * @details T(j, j) = tau_j and T(0:j, j) = -tau_j T(0:j, 0:j) V(:, 0:j)^T v_j, with
+ * the inner products taken from the Gram matrix G = V^T V, which is one GEMM.
+ * @param gram Scratch for ib * ib elements.
+ */
+template <std::floating_point T>
+void form_t_factor(const WYPanel<T> &panel, const T *tau, MatrixView<T> T_factor,
+                   T *gram) {
+  using kernels::OP;
+  const size_t ib = panel.V1.row_count();
+  MatrixView<T> G(gram, ib, ib, ib);
+  kernels::gemm(OP::Trans, OP::NoTrans, 1.0, panel.V1, panel.V1, 0.0, G);
+  if (panel.V2.row_count() > 0) {
+    kernels::gemm(OP::Trans, OP::NoTrans, 1.0, panel.V2, panel.V2, 1.0, G);
+  }
+  for (size_t j = 0; j < ib; ++j) {
+    T_factor[j, j] = tau[j];
+    for (size_t i = 0; i < j; ++i) {
+      T s = 0;
+      for (size_t l = i; l < j; ++l) {
+        s += T_factor[i, l] * G[l, j];
+      }
+      T_factor[i, j] = -tau[j] * s;
+    }
+  }
+}
 
-#if defined(__APPLE__) && defined(ACCELERATE_AVAILABLE)
-  Matrix<DataType> A_lap = A_work.transposed();  // Column-major order for LAPACK
-  auto *a = A_lap.data();
+}  // namespace detail
 
-  auto mm = (__LAPACK_int)m;
-  auto nn = (__LAPACK_int)n;
-  auto kk = (__LAPACK_int)k;
-  auto lda = (__LAPACK_int)m;
+/**
+ * @brief A Householder QR factorization A = QR with Q kept as its reflectors.
+ * @details packed() holds R on and above the diagonal and the tails of the
+ * reflectors below it, like LAPACK's geqrf; the unit leading entries are implied.
+ * The T factor of every panel of QR_BLOCK reflectors is kept as well, so applying Q
+ * or Q^T costs four GEMM calls per panel.
+ *
+ * The factorization owns its storage and scratch: factor() reuses them for a matrix
+ * of the same shape. Applying Q needs workspace_size(p) elements of scratch for p
+ * columns; a caller that passes them in `work` makes apply_q(), apply_qt() and
+ * solve_inplace() allocation free.
+ *
+ * @code
+ * auto f = qr(A);       // m x n, m >= n
+ * auto x = f.solve(b);  // least-squares solution of A x = b
+ * f.apply_qt(C);        // C = Q^T C in place
+ * @endcode
+ *
+ * @tparam T The floating point type of the matrix elements (e.g., float, double).
+ */
+template <std::floating_point T>
+class QRFactorization {
+ public:
+  QRFactorization() = default;
 
-  std::vector<DataType> tau_lap(k);
+  /** @brief Factors A in its own storage. */
+  explicit QRFactorization(Matrix<T> &&A) : _qr(std::move(A)) { _factor(); }
 
-  __LAPACK_int info = 0;
-  __LAPACK_int lwork = -1;
-  DataType wq = 0;
-  if constexpr (std::is_same_v<DataType, float>) {
-    sgeqrf_(&mm, &nn, (float *)a, &lda, (float *)tau_lap.data(), (float *)&wq, &lwork,
-            &info);
-  } else {
-    dgeqrf_(&mm, &nn, (double *)a, &lda, (double *)tau_lap.data(), (double *)&wq,
-            &lwork, &info);
+  template <Numeric U, Layout L>
+  explicit QRFactorization(const Matrix<U, L> &A) {
+    factor(A);
   }
-  lwork = (__LAPACK_int)std::max<double>(1.0, std::ceil((double)wq));
-  std::vector<DataType> work((size_t)lwork);
 
-  if constexpr (std::is_same_v<DataType, float>) {
-    sgeqrf_(&mm, &nn, (float *)a, &lda, (float *)tau_lap.data(), (float *)work.data(),
-            &lwork, &info);
-  } else {
-    dgeqrf_(&mm, &nn, (double *)a, &lda, (double *)tau_lap.data(),
-            (double *)work.data(), &lwork, &info);
+  /**
+   * @brief Factors A, reusing the storage of the previous factorization.
+   * @throws std::invalid_argument if A is empty.
+   */
+  template <Numeric U, Layout L>
+  void factor(const Matrix<U, L> &A) {
+    const size_t m = A.row_count();
+    const size_t n = A.column_count();
+    if (m == 0 || n == 0) {
+      throw std::invalid_argument("Cannot perform QR decomposition on empty matrix!");
+    }
+    if (_qr.row_count() != m || _qr.column_count() != n) {
+      _qr = Matrix<T>(m, n, util::uninitialized);
+    }
+    if constexpr (L == Layout::RowMajor) {
+      std::transform(A.data(), A.data() + A.size(), _qr.data(),
+                     [](U x) { return static_cast<T>(x); });
+    } else {
+      for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+          _qr[i, j] = static_cast<T>(A[i, j]);
+        }
+      }
+    }
+    _factor();
   }
-  if (info != 0) {
-    throw std::runtime_error("Accelerate/LAPACK geqrf failed");
+
+  /** @brief Rows of the factored matrix, the order of Q. */
+  [[nodiscard]] size_t row_count() const noexcept { return _qr.row_count(); }
+
+  /** @brief Columns of the factored matrix. */
+  [[nodiscard]] size_t column_count() const noexcept { return _qr.column_count(); }
+
+  /** @brief R on and above the diagonal, reflector tails below it. */
+  [[nodiscard]] const Matrix<T> &packed() const noexcept { return _qr; }
+
+  /** @brief Scalar factors of the reflectors H_j = I - tau_j v_j v_j^T. */
+  [[nodiscard]] const std::vector<T> &tau() const noexcept { return _tau; }
+
+  /** @brief Scratch elements that applying Q to p columns needs. */
+  [[nodiscard]] size_t workspace_size(size_t p) const noexcept {
+    const size_t block = _t.row_count();
+    return block * (block + (2 * p));
   }
 
-  // Get R
-  Matrix<DataType> R(full_R ? m : k, n);
-  R.fill(0.0);
-  for (size_t i = 0; i < R.row_count(); ++i) {
-    for (size_t j = i; j < n; ++j) {
-      R[i][j] = A_lap[j][i];
+  /**
+   * @brief Copies R out of the packed storage.
+   * @param full If true, R is m x n; otherwise it is the thin k x n factor.
+   */
+  [[nodiscard]] Matrix<T> R(bool full = false) const {
+    const size_t n = column_count();
+    Matrix<T> result(full ? row_count() : _tau.size(), n);
+    for (size_t i = 0; i < std::min(result.row_count(), n); ++i) {
+      std::copy_n(_qr.row_span(i).data() + i, n - i, result.row_span(i).data() + i);
     }
+    return result;
   }
 
-  // Get Q
-  if (full_Q && m > n) {
-    Matrix<DataType> A_big(m, m);
-    A_big.fill(0.0);
-    for (size_t r = 0; r < n; ++r) {
-      for (size_t c = 0; c < m; ++c) {
-        A_big[r][c] = A_lap[r][c];
-      }
+  /**
+   * @brief Forms Q explicitly by applying the reflectors to the leading columns of I.
+   * @param full If true, Q is m x m; otherwise it is the thin m x k factor.
+   */
+  [[nodiscard]] Matrix<T> Q(bool full = false) const {
+    const size_t m = row_count();
+    const size_t cols = full ? m : _tau.size();
+    Matrix<T> result(m, cols);
+    for (size_t i = 0; i < cols; ++i) {
+      result.at(i, i) = T(1);
     }
-    A_lap = std::move(A_big);
-    a = A_lap.data();
-    nn = (__LAPACK_int)m;
-  }
-  const size_t qcols_sz = full_Q ? m : k;
-  auto qcols = (__LAPACK_int)qcols_sz;
-  lwork = -1;
-  wq = 0;
-  if constexpr (std::is_same_v<DataType, float>) {
-    sorgqr_(&mm, &qcols, &kk, (float *)a, &lda, (const float *)tau_lap.data(),
-            (float *)&wq, &lwork, &info);
-  } else {
-    dorgqr_(&mm, &qcols, &kk, (double *)a, &lda, (const double *)tau_lap.data(),
-            (double *)&wq, &lwork, &info);
+    // Panel j0 leaves the first j0 rows and columns of H_{j0+1} ... H_k I alone.
+    const size_t block = _t.row_count();
+    util::AlignedVector<T> work(workspace_size(cols));
+    for (size_t s = _panel_count(); s-- > 0;) {
+      const size_t j0 = s * block;
+      _apply_panel(kernels::OP::NoTrans, j0,
+                   result.view(j0, j0, m - j0, cols - j0), work.data());
+    }
+    return result;
   }
-  lwork = (__LAPACK_int)std::max<double>(1.0, std::ceil((double)wq));
-  work.assign((size_t)lwork, DataType(0));
 
-  if constexpr (std::is_same_v<DataType, float>) {
-    sorgqr_(&mm, &qcols, &kk, (float *)a, &lda, (const float *)tau_lap.data(),
-            (float *)work.data(), &lwork, &info);
-  } else {
-    dorgqr_(&mm, &qcols, &kk, (double *)a, &lda, (const double *)tau_lap.data(),
-            (double *)work.data(), &lwork, &info);
+  /**
+   * @brief C = Q^T C in place; C must have row_count() rows.
+   * @param work Scratch of at least workspace_size(C.column_count()) elements, or
+   * empty to allocate it.
+   */
+  void apply_qt(MatrixView<T> C, std::span<T> work = {}) const {
+    _apply(kernels::OP::Trans, C, work);
+  }
+
+  /** @brief C = Q C in place; C must have row_count() rows. */
+  void apply_q(MatrixView<T> C, std::span<T> work = {}) const {
+    _apply(kernels::OP::NoTrans, C, work);
+  }
+
+  /** @brief x = Q^T x in place. */
+  void apply_qt(VectorView<T> x, std::span<T> work = {}) const {
+    apply_qt(_as_column(x), work);
+  }
+
+  /** @brief x = Q x in place. */
+  void apply_q(VectorView<T> x, std::span<T> work = {}) const {
+    apply_q(_as_column(x), work);
+  }
+
+  template <Layout L>
+  void apply_qt(Matrix<T, L> &C) const {
+    apply_qt(C.view());
   }
-  if (info != 0) {
-    throw std::runtime_error("Accelerate/LAPACK orgqr failed");
+
+  template <Layout L>
+  void apply_q(Matrix<T, L> &C) const {
+    apply_q(C.view());
   }
 
-  Matrix<DataType> Q(m, qcols_sz);
-  for (size_t i = 0; i < m; ++i) {
-    for (size_t j = 0; j < qcols_sz; ++j) {
-      Q[i][j] = A_lap[j][i];
+  void apply_qt(Vector<T> &x) const { apply_qt(x.view(0, x.size())); }
+
+  void apply_q(Vector<T> &x) const { apply_q(x.view(0, x.size())); }
+
+  /**
+   * @brief Least-squares solutions of A X = B in place: the first n rows of the
+   * m x p matrix B are overwritten by X, the rest by the residuals in the Q basis.
+   * @param work Scratch of at least workspace_size(B.column_count()) elements, or
+   * empty to allocate it.
+   * @throws std::invalid_argument if A has fewer rows than columns or B has the wrong
+   * number of rows.
+   * @throws std::runtime_error if R has a zero on its diagonal.
+   */
+  void solve_inplace(MatrixView<T> B, std::span<T> work = {}) const {
+    const size_t n = column_count();
+    if (row_count() < n) {
+      throw std::invalid_argument("Least squares needs at least as many rows as "
+                                  "columns!");
     }
+    if (B.row_count() != row_count()) {
+      throw std::invalid_argument("Dimensions do not match for QR solve!");
+    }
+    for (size_t i = 0; i < n; ++i) {
+      if (_qr[i, i] == T(0)) {
+        throw std::runtime_error("Matrix is rank deficient!");
+      }
+    }
+    apply_qt(B, work);
+    kernels::trsm(kernels::UPLO::Upper, kernels::OP::NoTrans, kernels::DIAG::NonUnit,
+                  _qr.view(0, 0, n, n), B.view(0, 0, n, B.column_count()));
   }
 
-  return {std::move(Q), std::move(R)};
-#else
+  /** @brief solve_inplace() for a single right-hand side. */
+  void solve_inplace(VectorView<T> b, std::span<T> work = {}) const {
+    solve_inplace(_as_column(b), work);
+  }
 
-  for (size_t j = 0; j < k; ++j) {
-    auto Aw_view = A_work.view(0, 0, m, n);
+  /** @brief Least-squares solution of A x = b: R x = (Q^T b)[0, n). */
+  [[nodiscard]] Vector<T> solve(const Vector<T> &b) const {
+    Vector<T> y(b);
+    solve_inplace(y.view(0, y.size()));
+    return Vector<T>(column_count(), y.data(), COLUMN);
+  }
 
-    tau[j] = detail::householder_column(Aw_view, j);
-    if (tau[j] == 0.0) {
-      continue;
+  /** @brief Least-squares solutions of A X = B, one column per right-hand side. */
+  template <Layout L>
+  [[nodiscard]] Matrix<T, L> solve(const Matrix<T, L> &B) const {
+    Matrix<T, L> Y(B);
+    solve_inplace(Y.view());
+    const size_t n = column_count();
+    Matrix<T, L> X(n, B.column_count(), util::uninitialized);
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = 0; j < B.column_count(); ++j) {
+        X[i, j] = Y[i, j];
+      }
     }
+    return X;
+  }
 
-    Vector<DataType> v = detail::load_reflector(A_work, j);
-    auto v_view = v.view(0, v.size());
+ private:
+  Matrix<T> _qr;
+  std::vector<T> _tau;
+  Matrix<T> _t;  // T factor of the panel starting at column j0 in columns [j0, j0+ib)
+  util::AlignedVector<T> _work;  // Scratch of the factorization
 
-    if (j + 1 < n) {
-      auto A_block = A_work.view(j, j + 1, m - j, n - (j + 1));
+  [[nodiscard]] size_t _panel_count() const noexcept {
+    const size_t block = _t.row_count();
+    return (_tau.size() + block - 1) / block;
+  }
 
-      // w = A_block^T * v
-      Vector<DataType> w = kernels::gemv(kernels::OP::Trans, A_block, v_view);
-      auto w_view = w.view(0, w.size());
+  static MatrixView<T> _as_column(VectorView<T> x) noexcept {
+    return MatrixView<T>(x.data(), x.size(), 1, x.get_increment(), 1);
+  }
 
-      // A_block = A_block - (v_view * w_view) * tau[j];
-      kernels::ger(A_block, v_view, w_view, -tau[j]);
+  /**
+   * @brief Blocked Householder QR of _qr, in place.
+   * @details Each panel of QR_BLOCK columns is factored unblocked, its reflectors are
+   * accumulated into a T factor and the trailing columns are updated with GEMM.
+   */
+  void _factor() {
+    const size_t m = _qr.row_count();
+    const size_t n = _qr.column_count();
+    const size_t k = std::min(m, n);
+    const size_t block = std::min(detail::QR_BLOCK, k);
+    _tau.assign(k, T(0));
+    // Only the upper triangles of the T factors are written, so a reused _t keeps
+    // its zero lower triangles.
+    if (_t.row_count() != block || _t.column_count() != k) {
+      _t = Matrix<T>(block, k);
+    }
+    _work.resize(block * ((2 * block) + (2 * n)));
+    T *v1 = _work.data();
+    T *gram = v1 + (block * block);
+    T *scratch = gram + (block * block);
+
+    for (size_t j0 = 0; j0 < k; j0 += block) {
+      const size_t ib = std::min(block, k - j0);
+      detail::factor_panel(_qr, j0, ib, _tau.data(), scratch);
+      const auto panel = detail::wy_panel(_qr, _t, j0, ib, v1);
+      detail::form_t_factor(panel, _tau.data() + j0, _t.view(0, j0, ib, ib), gram);
+      if (j0 + ib < n) {
+        detail::apply_wy(kernels::OP::Trans, panel,
+                         _qr.view(j0, j0 + ib, m - j0, n - j0 - ib), scratch);
+      }
     }
   }
 
-  // Get R
-  Matrix<DataType> R(full_R ? m : k, n);
-  R.fill(0.0);
+  /** @brief Applies the block reflector of panel j0 to C, whose rows start at j0. */
+  void _apply_panel(kernels::OP op, size_t j0, MatrixView<T> C, T *work) const {
+    const size_t block = _t.row_count();
+    const size_t ib = std::min(block, _tau.size() - j0);
+    const auto panel = detail::wy_panel(_qr, _t, j0, ib, work);
+    detail::apply_wy(op, panel, C, work + (block * block));
+  }
+
+  /** @brief Q^T C (op == Trans) or Q C: the panels in forward or reverse order. */
+  void _apply(kernels::OP op, MatrixView<T> C, std::span<T> work) const {
+    const size_t m = row_count();
+    if (C.row_count() != m) {
+      throw std::invalid_argument("Dimensions do not match for applying Q!");
+    }
+    if (_tau.empty() || C.column_count() == 0) {
+      return;
+    }
+    const size_t block = _t.row_count();
+    const size_t p = C.column_count();
+    const size_t panels = _panel_count();
+    util::AlignedVector<T> owned;
+    if (work.size() < workspace_size(p)) {
+      owned.resize(workspace_size(p));
+      work = owned;
+    }
+    for (size_t s = 0; s < panels; ++s) {
+      const size_t j0 = ((op == kernels::OP::Trans) ? s : panels - 1 - s) * block;
+      _apply_panel(op, j0, C.view(j0, 0, m - j0, p), work.data());
+    }
+  }
+};
+
+namespace detail {
+#if defined(MAF_LAPACK_AVAILABLE)
+/**
+ * @brief LAPACK QR that works on the storage of A in place, in either layout.
+ * @details A column-major A goes through geqrf/orgqr and Q is formed in the very
+ * buffer that held A. A row-major A is the column-major storage of A^T, so its LQ
+ * factorization A^T = L * Q1 (gelqf/orglq) is read back as A = Q1^T * L^T: R is the
+ * upper triangle of the buffer and Q1 comes out as row-major Q. Only R needs a
+ * buffer of its own.
+ * @param A The matrix to decompose; its storage is reused for Q. A row-major A must
+ * not have more rows than columns.
+ */
+template <std::floating_point T, Layout L>
+[[nodiscard]] QRResult<T, L> lapack_qr(Matrix<T, L> &&A, bool full_Q, bool full_R) {
+  const size_t m = A.row_count();
+  const size_t n = A.column_count();
+  const size_t k = std::min(m, n);
+  const size_t qcols = full_Q ? m : k;
+  std::vector<T> tau(k, 0.0);
+  typename Matrix<T, L>::storage_type storage = std::move(A.data_vector());
+  T *a = storage.data();
+
+  if constexpr (L == Layout::RowMajor) {
+    assert(m <= n);
+    blas::gelqf(n, m, a, n, tau.data());
+  } else {
+    blas::geqrf(m, n, a, m, tau.data());
+  }
+
+  // Get R, the upper triangle of the factored storage in both layouts
+  Matrix<T, L> R(full_R ? m : k, n);
   for (size_t i = 0; i < R.row_count(); ++i) {
     for (size_t j = i; j < n; ++j) {
-      R[i][j] = A_work[i][j];
+      R[i, j] = a[(L == Layout::RowMajor) ? (i * n) + j : (j * m) + i];
     }
   }
 
   // Get Q
-  auto Q_full = identity_matrix<DataType>(m);
+  if constexpr (L == Layout::ColMajor) {
+    // Columns are appended or dropped at the end of column-major storage, and
+    // orgqr sets the appended ones itself.
+    storage.resize(m * qcols);
+    blas::orgqr(m, qcols, k, storage.data(), m, tau.data());
+  } else {
+    blas::orglq(k, m, k, a, n, tau.data());
+    if (n != k) {
+      // Q occupies the first k entries of every row; close the gaps in place.
+      for (size_t i = 1; i < m; ++i) {
+        std::copy_n(a + (i * n), k, a + (i * k));
+      }
+    }
+    storage.resize(m * k);
+  }
 
-  for (size_t t = 0; t < k; ++t) {
-    const size_t j = (k - 1) - t;
-    if (tau[j] == 0.0) {
-      continue;
+  return {Matrix<T, L>(m, qcols, std::move(storage)), std::move(R)};
+}
+#endif
+
+}  // namespace detail
+
+#pragma mark tsqr
+//=============================================================================
+// TALL-SKINNY QR
+//=============================================================================
+namespace detail {
+/** @brief Rows per column a TSQR leaf needs before splitting the rows pays off. */
+inline constexpr size_t TSQR_ROWS_PER_COLUMN = 16;
+
+/** @brief Fewest rows of a TSQR leaf. */
+inline constexpr size_t TSQR_MIN_ROWS = 1024;
+
+/** @brief Leaves tsqr() splits an m x n matrix into on the current context. */
+[[nodiscard]] inline size_t tsqr_leaf_count(size_t m, size_t n) noexcept {
+  const size_t rows = std::max(TSQR_ROWS_PER_COLUMN * n, TSQR_MIN_ROWS);
+  return std::max<size_t>(1, std::min(exec::concurrency(), m / rows));
+}
+}  // namespace detail
+
+/**
+ * @brief A tall-skinny QR factorization (TSQR) of an m x n matrix with m >= n.
+ * @details The rows are split into leaves that are factored independently, one per
+ * thread. The n x n R factors of the leaves are then combined pairwise in a binary
+ * tree: every node factors the 2n x n stack of its children's R factors. Q is the
+ * product of the block-diagonal leaf Q and the node Qs; it is kept implicit like in
+ * QRFactorization. Q^T A = [R; 0] with R in the first n rows, as in a Householder QR,
+ * although R may differ from the one of qr() in the signs of its rows.
+ *
+ * The leaves and every level of the tree run in parallel, and every factorization in
+ * them runs serially on its thread, so the long dimension scales with the cores
+ * instead of serializing on the panels of a single factorization.
+ *
+ * @tparam T The floating point type of the matrix elements (e.g., float, double).
+ */
+template <std::floating_point T>
+class TSQRFactorization {
+ public:
+  TSQRFactorization() = default;
+
+  /** @brief Factors the rows [offsets[b], offsets[b + 1]) of A as leaf b. */
+  template <Numeric U, Layout L>
+  TSQRFactorization(const Matrix<U, L> &A, std::vector<size_t> &&offsets)
+      : _rows(A.row_count()), _offsets(std::move(offsets)) {
+    const size_t n = A.column_count();
+    const size_t leaves = _offsets.size() - 1;
+    _leaves.resize(leaves);
+    std::vector<Matrix<T>> items(leaves);
+    _for_each(leaves, [&](size_t b) {
+      const size_t r0 = _offsets[b];
+      Matrix<T> block(_offsets[b + 1] - r0, n, util::uninitialized);
+      for (size_t i = 0; i < block.row_count(); ++i) {
+        for (size_t j = 0; j < n; ++j) {
+          block[i, j] = static_cast<T>(A[r0 + i, j]);
+        }
+      }
+      _leaves[b] = QRFactorization<T>(std::move(block));
+      items[b] = _leaves[b].R();
+    });
+
+    while (items.size() > 1) {
+      const size_t pairs = items.size() / 2;
+      std::vector<QRFactorization<T>> &level = _levels.emplace_back(pairs);
+      std::vector<Matrix<T>> next((items.size() + 1) / 2);
+      _for_each(pairs, [&](size_t i) {
+        Matrix<T> stack(2 * n, n, util::uninitialized);
+        std::copy_n(items[2 * i].data(), n * n, stack.data());
+        std::copy_n(items[(2 * i) + 1].data(), n * n, stack.data() + (n * n));
+        level[i] = QRFactorization<T>(std::move(stack));
+        next[i] = level[i].R();
+      });
+      if (items.size() % 2 != 0) {
+        next.back() = std::move(items.back());
+      }
+      items = std::move(next);
+    }
+    _r = std::move(items.front());
+  }
+
+  /** @brief Rows of the factored matrix, the order of Q. */
+  [[nodiscard]] size_t row_count() const noexcept { return _rows; }
+
+  /** @brief Columns of the factored matrix. */
+  [[nodiscard]] size_t column_count() const noexcept { return _r.column_count(); }
+
+  /** @brief Number of row blocks factored independently. */
+  [[nodiscard]] size_t leaf_count() const noexcept { return _leaves.size(); }
+
+  /**
+   * @brief Copies R out of the factorization.
+   * @param full If true, R is m x n; otherwise it is the thin n x n factor.
+   */
+  [[nodiscard]] Matrix<T> R(bool full = false) const {
+    const size_t n = column_count();
+    Matrix<T> result(full ? row_count() : n, n);
+    std::copy_n(_r.data(), n * n, result.data());
+    return result;
+  }
+
+  /**
+   * @brief Forms Q explicitly by applying it to the leading columns of I.
+   * @param full If true, Q is m x m; otherwise it is the thin m x n factor.
+   */
+  [[nodiscard]] Matrix<T> Q(bool full = false) const {
+    const size_t cols = full ? row_count() : column_count();
+    Matrix<T> result(row_count(), cols);
+    for (size_t i = 0; i < cols; ++i) {
+      result.at(i, i) = T(1);
     }
+    apply_q(result.view());
+    return result;
+  }
 
-    Vector<DataType> v = detail::load_reflector(A_work, j);
-    auto v_view = v.view(0, v.size());
+  /** @brief C = Q^T C in place; C must have row_count() rows. */
+  void apply_qt(MatrixView<T> C) const { _apply(kernels::OP::Trans, C); }
 
-    auto Qblock = Q_full.view(j, j, m - j, m - j);
+  /** @brief C = Q C in place; C must have row_count() rows. */
+  void apply_q(MatrixView<T> C) const { _apply(kernels::OP::NoTrans, C); }
 
-    Vector<DataType> w = kernels::gemv(kernels::OP::Trans, Qblock, v_view);
+  /** @brief x = Q^T x in place. */
+  void apply_qt(VectorView<T> x) const {
+    apply_qt(MatrixView<T>(x.data(), x.size(), 1, x.get_increment(), 1));
+  }
+
+  /** @brief x = Q x in place. */
+  void apply_q(VectorView<T> x) const {
+    apply_q(MatrixView<T>(x.data(), x.size(), 1, x.get_increment(), 1));
+  }
 
-    kernels::ger(Qblock, v_view, w.view(0, w.size()), -tau[j]);
+  template <Layout L>
+  void apply_qt(Matrix<T, L> &C) const {
+    apply_qt(C.view());
   }
 
-  // Thin or full Q
-  Matrix<DataType> Q = full_Q ? std::move(Q_full) : Matrix<DataType>(m, k);
-  if (!full_Q) {
-    for (size_t i = 0; i < m; ++i) {
-      for (size_t j = 0; j < k; ++j) {
-        Q[i][j] = Q_full[i][j];
+  template <Layout L>
+  void apply_q(Matrix<T, L> &C) const {
+    apply_q(C.view());
+  }
+
+  void apply_qt(Vector<T> &x) const { apply_qt(x.view(0, x.size())); }
+
+  void apply_q(Vector<T> &x) const { apply_q(x.view(0, x.size())); }
+
+  /**
+   * @brief Least-squares solution of A x = b: R x = (Q^T b)[0, n).
+   * @throws std::invalid_argument if b has the wrong size.
+   * @throws std::runtime_error if R has a zero on its diagonal.
+   */
+  [[nodiscard]] Vector<T> solve(const Vector<T> &b) const {
+    const size_t n = column_count();
+    if (b.size() != row_count()) {
+      throw std::invalid_argument("Dimensions do not match for QR solve!");
+    }
+    for (size_t i = 0; i < n; ++i) {
+      if (_r.at(i, i) == T(0)) {
+        throw std::runtime_error("Matrix is rank deficient!");
       }
     }
+    Vector<T> y(b);
+    apply_qt(y);
+    Vector<T> x(n, y.data(), COLUMN);
+    kernels::trsv(kernels::UPLO::Upper, kernels::OP::NoTrans, kernels::DIAG::NonUnit,
+                  _r.view(), x.view(0, n));
+    return x;
   }
 
-  return {std::move(Q), std::move(R)};
+ private:
+  size_t _rows = 0;
+  std::vector<size_t> _offsets;  // Leaf b holds rows [_offsets[b], _offsets[b + 1])
+  std::vector<QRFactorization<T>> _leaves;
+  // _levels[l][i] factors the R factors of items 2i and 2i + 1 of the level below,
+  // which are the leaves for l == 0. An unpaired last item moves up unchanged.
+  std::vector<std::vector<QRFactorization<T>>> _levels;
+  Matrix<T> _r;
+
+  /**
+   * @brief Applies node i of level l to C.
+   * @details The R rows of an item of level l live in the first n rows of its
+   * leftmost leaf, so a node reads the first n rows of leaves 2i * 2^l and
+   * (2i + 1) * 2^l and leaves its own R rows in the first of them.
+   */
+  void _apply_node(kernels::OP op, size_t l, size_t i, MatrixView<T> C) const {
+    const size_t n = column_count();
+    const size_t p = C.column_count();
+    const size_t top = _offsets[(2 * i) << l];
+    const size_t bottom = _offsets[((2 * i) + 1) << l];
+    Matrix<T> stack(2 * n, p, util::uninitialized);
+    for (size_t r = 0; r < n; ++r) {
+      for (size_t j = 0; j < p; ++j) {
+        stack[r, j] = C[top + r, j];
+        stack[n + r, j] = C[bottom + r, j];
+      }
+    }
+    if (op == kernels::OP::Trans) {
+      _levels[l][i].apply_qt(stack);
+    } else {
+      _levels[l][i].apply_q(stack);
+    }
+    for (size_t r = 0; r < n; ++r) {
+      for (size_t j = 0; j < p; ++j) {
+        C[top + r, j] = stack[r, j];
+        C[bottom + r, j] = stack[n + r, j];
+      }
+    }
+  }
+
+  /**
+   * @brief Runs body(i) for every i in [0, count) in parallel.
+   * @details A single index runs outside a parallel loop, so the loops of its
+   * factorization or update keep their threads.
+   */
+  template <typename F>
+  static void _for_each(size_t count, F &&body) {
+    if (count == 1) {
+      body(0);
+      return;
+    }
+    exec::parallel_for(0, count, exec::Split{.grain = 1}, [&](size_t lo, size_t hi) {
+      for (size_t i = lo; i < hi; ++i) {
+        body(i);
+      }
+    });
+  }
+
+  void _apply_level(kernels::OP op, size_t l, MatrixView<T> C) const {
+    _for_each(_levels[l].size(), [&](size_t i) { _apply_node(op, l, i, C); });
+  }
+
+  void _apply_leaves(kernels::OP op, MatrixView<T> C) const {
+    _for_each(_leaves.size(), [&](size_t b) {
+      const size_t height = _offsets[b + 1] - _offsets[b];
+      auto rows = C.view(_offsets[b], 0, height, C.column_count());
+      if (op == kernels::OP::Trans) {
+        _leaves[b].apply_qt(rows);
+      } else {
+        _leaves[b].apply_q(rows);
+      }
+    });
+  }
+
+  /** @brief Q^T C: the leaves, then the tree bottom-up. Q C runs in reverse. */
+  void _apply(kernels::OP op, MatrixView<T> C) const {
+    if (C.row_count() != row_count()) {
+      throw std::invalid_argument("Dimensions do not match for applying Q!");
+    }
+    if (C.column_count() == 0) {
+      return;
+    }
+    if (op == kernels::OP::Trans) {
+      _apply_leaves(op, C);
+      for (size_t l = 0; l < _levels.size(); ++l) {
+        _apply_level(op, l, C);
+      }
+    } else {
+      for (size_t l = _levels.size(); l-- > 0;) {
+        _apply_level(op, l, C);
+      }
+      _apply_leaves(op, C);
+    }
+  }
+};
+
+/**
+ * @brief Factors a tall matrix A = QR with the TSQR algorithm.
+ * @param A The input matrix, in either layout, with at least as many rows as columns.
+ * Integer matrices are factored in double precision.
+ * @param leaves Row blocks to split A into; 0 picks one per thread, as long as every
+ * block keeps enough rows for the split to pay off. Leaves never get fewer rows than
+ * columns.
+ * @return The factorization, with Q kept implicitly.
+ * @throws std::invalid_argument if A is empty or wider than tall.
+ */
+template <Numeric T, Layout L>
+[[nodiscard]] TSQRFactorization<detail::float_promote_t<T>> tsqr(const Matrix<T, L> &A,
+                                                                 size_t leaves = 0) {
+  const size_t m = A.row_count();
+  const size_t n = A.column_count();
+  if (m == 0 || n == 0) {
+    throw std::invalid_argument("Cannot perform QR decomposition on empty matrix!");
+  }
+  if (m < n) {
+    throw std::invalid_argument("TSQR needs at least as many rows as columns!");
+  }
+  leaves = std::min((leaves == 0) ? detail::tsqr_leaf_count(m, n) : leaves, m / n);
+  std::vector<size_t> offsets(leaves + 1);
+  for (size_t b = 0; b <= leaves; ++b) {
+    offsets[b] = m * b / leaves;
+  }
+  return TSQRFactorization<detail::float_promote_t<T>>(A, std::move(offsets));
+}
+
+template <Numeric T, Layout L = Layout::RowMajor>
+using QRResultType = QRResult<detail::float_promote_t<T>, L>;
+
+/**
+ * @brief Factors A = QR with blocked Householder reflections.
+ * @param A The input matrix, in either layout. Integer matrices are factored in
+ * double precision.
+ * @return The factorization, with Q kept implicitly as its reflectors.
+ * @throws std::invalid_argument if A is empty.
+ */
+template <Numeric T, Layout L>
+[[nodiscard]] QRFactorization<detail::float_promote_t<T>> qr(const Matrix<T, L> &A) {
+  return QRFactorization<detail::float_promote_t<T>>(A);
+}
+
+/**
+ * @brief Computes the QR decomposition of a matrix A using Householder reflections.
+ * @param A The input matrix to decompose, in either layout.
+ * @param full_Q If true, returns the full m x m orthogonal matrix Q. If false, returns
+ * the thin m x k matrix Q (where k = min(m, n)).
+ * @param full_R If true, returns the full m x n upper triangular matrix R. If false,
+ * returns the thin k x n matrix R (where k = min(m, n)).
+ * @return A QRResultType<T, L> containing the matrices Q and R of the decomposition,
+ * in the layout of A.
+ * @details This function factors A with qr() and forms Q and R from the
+ * factorization. A thin Q is built from the first k columns of the identity, so no
+ * m x m matrix is formed unless full_Q is set. Callers that only apply Q, such as
+ * least-squares solves, should keep the QRFactorization of qr() instead. A matrix
+ * tall enough to give every thread a TSQR leaf goes through tsqr().
+ * @details With LAPACK the factorization runs directly on a copy of A in its own
+ * layout (see detail::lapack_qr). Only a tall row-major A is transposed into
+ * column-major storage, because geqrf outruns the LQ route there.
+ * @throws std::invalid_argument if A is empty or if dimensions are incompatible for
+ * decomposition.
+ */
+template <Numeric T, Layout L>
+[[nodiscard]] QRResultType<T, L> QR_decompostion(const Matrix<T, L> &A,
+                                                 bool full_Q = false,
+                                                 bool full_R = false) {
+  using DataType = detail::float_promote_t<T>;
+  if (A.row_count() == 0 || A.column_count() == 0) {
+    throw std::invalid_argument("Cannot perform QR decomposition on empty matrix!");
+  }
+
+#if defined(MAF_LAPACK_AVAILABLE)
+  if constexpr (blas::lapack_supports<DataType>) {
+    if constexpr (L == Layout::RowMajor) {
+      if (A.row_count() > A.column_count()) {
+        // LAPACK's LQ of a wide A^T is far slower than geqrf on a tall column-major
+        // copy, which is worth the two transposes.
+        using ColMatrix = Matrix<DataType, Layout::ColMajor>;
+        ColMatrix A_col = [&] {
+          if constexpr (std::is_same_v<T, DataType>) {
+            return ColMatrix(A);
+          } else {
+            return ColMatrix(A.template cast<DataType>());
+          }
+        }();
+        auto [Q, R] = detail::lapack_qr(std::move(A_col), full_Q, full_R);
+        return {Matrix<DataType>(Q), Matrix<DataType>(R)};
+      }
+    }
+    return detail::lapack_qr(A.template cast<DataType>(), full_Q, full_R);
+  }
 #endif
+
+  const auto explicit_factors = [&](const auto &factorization) -> QRResultType<T, L> {
+    if constexpr (L == Layout::RowMajor) {
+      return {factorization.Q(full_Q), factorization.R(full_R)};
+    } else {
+      return {Matrix<DataType, L>(factorization.Q(full_Q)),
+              Matrix<DataType, L>(factorization.R(full_R))};
+    }
+  };
+  if (detail::tsqr_leaf_count(A.row_count(), A.column_count()) > 1) {
+    return explicit_factors(tsqr(A));
+  }
+  return explicit_factors(qr(A));
 }
 
 }  // namespace maf::math
@@ -0,0 +1,519 @@
+#ifndef REDUCTIONS_H
+#define REDUCTIONS_H
+#pragma once
+#include "Matrix.hpp"
+#include "MatrixView.hpp"
+#include "Vector.hpp"
+
+/**
+ * @file Reductions.hpp
+ * @brief Row/column reductions and broadcasting of row/column vectors over matrices.
+ *
+ * Every reduction takes an Axis. `Axis::Rows` collapses each row to one value and
+ * returns a COLUMN vector with one entry per row; `Axis::Columns` collapses each
+ * column and returns a ROW vector. Matrices of either layout and views of any strides
+ * are accepted.
+ *
+ * The data is walked as lines along its unit-stride dimension. Reducing along the
+ * lines (row sums of a row-major matrix) is one pairwise summation per line (see
+ * Summation.hpp), with lines split across threads. Reducing across the lines
+ * (column sums of a row-major matrix) streams whole lines into a panel of
+ * accumulators that stays in L1; every thread owns a range of lines and the partial
+ * panels are merged at the end, so no column is walked with a large stride.
+ *
+ * Broadcasting combines every row of a matrix with a ROW vector, or every column with
+ * a COLUMN vector: `A - mean(A, Axis::Columns)` centers the columns. `Matrix *
+ * Vector` stays the matrix-vector product; scale rows or columns with
+ * `broadcast(A, v, std::multiplies<>())`.
+ */
+namespace maf::math {
+/** @brief Floating-point type of mean and norm reductions of T (double for integers). */
+template <Numeric T>
+using reduction_float_t = vmath::detail::evaluation_t<T>;
+
+namespace detail {
+/** @brief Accumulators updated per streamed line in cross-line reductions. */
+inline constexpr size_t REDUCTION_PANEL = 512;
+
+enum class Reduce : uint8 { Sum, SumSquares, Min, Max };
+
+/** @brief A matrix walked as `count` lines of `length` elements: element k of line l
+ * lives at data[l * ld + k * inc]. `rows` is true if a line is a matrix row. */
+template <typename T>
+struct Lines {
+  const T *data;
+  size_t count;
+  size_t length;
+  size_t ld;
+  size_t inc;
+  bool rows;
+};
+
+/** @brief Lines along the smaller of the two strides of the view. */
+template <Numeric T>
+Lines<std::remove_const_t<T>> lines_of(const MatrixView<T> &A) noexcept {
+  if (A.column_stride() <= A.row_stride()) {
+    return {A.data(), A.row_count(), A.column_count(), A.row_stride(),
+            A.column_stride(), true};
+  }
+  return {A.data(), A.column_count(), A.row_count(), A.column_stride(), A.row_stride(),
+          false};
+}
+
+template <Reduce Op, typename A>
+[[nodiscard]] constexpr A reduce_identity() noexcept {
+  using limits = std::numeric_limits<A>;
+  if constexpr (Op == Reduce::Min) {
+    return limits::has_infinity ? limits::infinity() : limits::max();
+  } else if constexpr (Op == Reduce::Max) {
+    return limits::has_infinity ? -limits::infinity() : limits::lowest();
+  } else {
+    return A(0);
+  }
+}
+
+/** @brief Folds one element into an accumulator. */
+template <Reduce Op, typename A>
+[[nodiscard]] inline A reduce_step(A acc, A x) noexcept {
+  if constexpr (Op == Reduce::Sum) {
+    return acc + x;
+  } else if constexpr (Op == Reduce::SumSquares) {
+    return acc + (x * x);
+  } else if constexpr (Op == Reduce::Min) {
+    return (x < acc) ? x : acc;
+  } else {
+    return (x > acc) ? x : acc;
+  }
+}
+
+/** @brief Merges two accumulators. */
+template <Reduce Op, typename A>
+[[nodiscard]] inline A reduce_merge(A a, A b) noexcept {
+  if constexpr (Op == Reduce::Sum || Op == Reduce::SumSquares) {
+    return a + b;
+  } else {
+    return reduce_step<Op>(a, b);
+  }
+}
+
+/**
+ * @brief Reduces n elements x[0], x[inc], ... to one value.
+ * @details Sums run on the pairwise summation kernels; Min and Max are exact in any
+ * order and use a single SIMD reduction.
+ */
+template <Reduce Op, typename A, typename T>
+[[nodiscard]] A reduce_line(const T *x, size_t n, size_t inc) noexcept {
+  if constexpr (Op == Reduce::Sum) {
+    return kernels::sum_n<A>(n, x, inc);
+  } else if constexpr (Op == Reduce::SumSquares) {
+    return kernels::sum_squares_n<A>(n, x, inc);
+  } else {
+    A acc = reduce_identity<Op, A>();
+    if (inc != 1) {
+      for (size_t k = 0; k < n; ++k) {
+        acc = reduce_step<Op>(acc, static_cast<A>(x[k * inc]));
+      }
+    } else if constexpr (Op == Reduce::Min) {
+#pragma omp simd reduction(min : acc)
+      for (size_t k = 0; k < n; ++k) {
+        acc = std::min(acc, static_cast<A>(x[k]));
+      }
+    } else {
+#pragma omp simd reduction(max : acc)
+      for (size_t k = 0; k < n; ++k) {
+        acc = std::max(acc, static_cast<A>(x[k]));
+      }
+    }
+    return acc;
+  }
+}
+
+/** @brief out[l] = reduction of line l. */
+template <Reduce Op, typename A, typename T>
+void reduce_along(const Lines<T> &X, A *out) {
+  const exec::Split split = linear_split(X.count * X.length);
+  exec::parallel_for(0, X.count, split, [&](size_t lo, size_t hi) {
+    for (size_t l = lo; l < hi; ++l) {
+      out[l] = reduce_line<Op, A>(X.data + (l * X.ld), X.length, X.inc);
+    }
+  });
+}
+
+/** @brief Number of threads that split the lines of a cross-line reduction. */
+template <typename T>
+[[nodiscard]] size_t across_threads(const Lines<T> &X) {
+  if (X.count * X.length <= tuning().omp_linear_limit) {
+    return 1;
+  }
+  return std::min(exec::concurrency(), X.count);
+}
+
+/** @brief out[k] = reduction of element k over all lines. */
+template <Reduce Op, typename A, typename T>
+void reduce_across(const Lines<T> &X, A *out) {
+  const size_t n = X.length;
+  const size_t threads = across_threads(X);
+  util::AlignedVector<A> partial(threads * n, reduce_identity<Op, A>());
+
+  // One contiguous range of lines per thread; unused partials stay at the identity.
+  const exec::Split split = exec::Split::only_if(threads > 1);
+  exec::parallel_for(0, X.count, split, [&](size_t t, size_t first, size_t last) {
+    A *acc = partial.data() + (t * n);
+    for (size_t p = 0; p < n; p += REDUCTION_PANEL) {
+      const size_t width = std::min(REDUCTION_PANEL, n - p);
+      A *panel = acc + p;
+      for (size_t l = first; l < last; ++l) {
+        const T *line = X.data + (l * X.ld) + (p * X.inc);
+        if (X.inc == 1) {
+#pragma omp simd
+          for (size_t k = 0; k < width; ++k) {
+            panel[k] = reduce_step<Op>(panel[k], static_cast<A>(line[k]));
+          }
+        } else {
+          for (size_t k = 0; k < width; ++k) {
+            panel[k] = reduce_step<Op>(panel[k], static_cast<A>(line[k * X.inc]));
+          }
+        }
+      }
+    }
+  });
+
+  std::copy_n(partial.data(), n, out);
+  for (size_t t = 1; t < threads; ++t) {
+    const A *acc = partial.data() + (t * n);
+#pragma omp simd
+    for (size_t k = 0; k < n; ++k) {
+      out[k] = reduce_merge<Op>(out[k], acc[k]);
+    }
+  }
+}
+
+/** @brief Reduces every row or every column of X into a vector of A. */
+template <Reduce Op, typename A, typename T>
+[[nodiscard]] Vector<A> reduce(const Lines<T> &X, Axis axis) {
+  if constexpr (ReducedFloat<A>) {
+    // 16-bit results are accumulated in float and rounded once.
+    const Vector<float> wide = reduce<Op, float>(X, axis);
+    Vector<A> result(wide.size(), util::uninitialized, wide.orientation());
+    util::convert_n(wide.data(), wide.size(), result.data());
+    return result;
+  } else {
+    const bool per_row = (axis == Axis::Rows);
+    const size_t rows = X.rows ? X.count : X.length;
+    const size_t cols = X.rows ? X.length : X.count;
+    Vector<A> result(per_row ? rows : cols, util::uninitialized,
+                     per_row ? COLUMN : ROW);
+    if (per_row == X.rows) {
+      reduce_along<Op>(X, result.data());
+    } else {
+      reduce_across<Op>(X, result.data());
+    }
+    return result;
+  }
+}
+
+/** @brief Index of the first minimum (Op = Min) or maximum (Op = Max) of every row or
+ * every column of X. */
+template <Reduce Op, typename T>
+[[nodiscard]] Vector<size_t> arg_reduce(const Lines<T> &X, Axis axis) {
+  using A = accumulation_t<T>;
+  const bool per_row = (axis == Axis::Rows);
+  const size_t rows = X.rows ? X.count : X.length;
+  const size_t cols = X.rows ? X.length : X.count;
+  Vector<size_t> result(per_row ? rows : cols, util::uninitialized,
+                        per_row ? COLUMN : ROW);
+  size_t *out = result.data();
+
+  if (per_row == X.rows) {
+    // The extreme value is a SIMD reduction; its first position is a short search.
+    const exec::Split split = linear_split(X.count * X.length);
+    exec::parallel_for(0, X.count, split, [&](size_t lo, size_t hi) {
+      for (size_t l = lo; l < hi; ++l) {
+        const T *line = X.data + (l * X.ld);
+        const A best = reduce_line<Op, A>(line, X.length, X.inc);
+        size_t k = 0;
+        while (k + 1 < X.length && line[k * X.inc] != best) {
+          ++k;
+        }
+        out[l] = k;
+      }
+    });
+    return result;
+  }
+
+  const size_t n = X.length;
+  const size_t threads = across_threads(X);
+  util::AlignedVector<A> values(threads * n, reduce_identity<Op, A>());
+  util::AlignedVector<size_t> indices(threads * n, 0);
+
+  const exec::Split split = exec::Split::only_if(threads > 1);
+  exec::parallel_for(0, X.count, split, [&](size_t t, size_t first, size_t last) {
+    for (size_t p = 0; p < n; p += REDUCTION_PANEL) {
+      const size_t width = std::min(REDUCTION_PANEL, n - p);
+      A *value = values.data() + (t * n) + p;
+      size_t *index = indices.data() + (t * n) + p;
+      for (size_t l = first; l < last; ++l) {
+        const T *line = X.data + (l * X.ld) + (p * X.inc);
+#pragma omp simd
+        for (size_t k = 0; k < width; ++k) {
+          const A x = static_cast<A>(line[k * X.inc]);
+          const bool better = (Op == Reduce::Min) ? (x < value[k]) : (x > value[k]);
+          value[k] = better ? x : value[k];
+          index[k] = better ? l : index[k];
+        }
+      }
+    }
+  });
+
+  // Threads own increasing line ranges, so strict comparison keeps the first index.
+  for (size_t k = 0; k < n; ++k) {
+    A best = values[k];
+    out[k] = indices[k];
+    for (size_t t = 1; t < threads; ++t) {
+      const A x = values[(t * n) + k];
+      if ((Op == Reduce::Min) ? (x < best) : (x > best)) {
+        best = x;
+        out[k] = indices[(t * n) + k];
+      }
+    }
+  }
+  return result;
+}
+}  // namespace detail
+
+#pragma mark reductions
+//=============================================================================
+// REDUCTIONS
+//=============================================================================
+/**
+ * @brief Sum of every row (Axis::Rows) or every column (Axis::Columns).
+ * @return A COLUMN vector of row sums or a ROW vector of column sums.
+ */
+template <Numeric T>
+[[nodiscard]] Vector<std::remove_const_t<T>> sum(const MatrixView<T> &A, Axis axis) {
+  return detail::reduce<detail::Reduce::Sum, std::remove_const_t<T>>(
+      detail::lines_of(A), axis);
+}
+
+/** @brief Sum of every row or every column of a matrix of either layout. */
+template <Numeric T, Layout L>
+[[nodiscard]] Vector<T> sum(const Matrix<T, L> &A, Axis axis) {
+  return sum(A.view(), axis);
+}
+
+/**
+ * @brief Arithmetic mean of every row or every column.
+ * @return Vector of reduction_float_t<T>, oriented as for sum().
+ */
+template <Numeric T>
+[[nodiscard]] auto mean(const MatrixView<T> &A, Axis axis) {
+  using R = reduction_float_t<std::remove_const_t<T>>;
+  auto result = detail::reduce<detail::Reduce::Sum, R>(detail::lines_of(A), axis);
+  const size_t count = (axis == Axis::Rows) ? A.column_count() : A.row_count();
+  result /= static_cast<R>(count);
+  return result;
+}
+
+/** @brief Arithmetic mean of every row or every column of a matrix. */
+template <Numeric T, Layout L>
+[[nodiscard]] auto mean(const Matrix<T, L> &A, Axis axis) {
+  return mean(A.view(), axis);
+}
+
+/** @brief Smallest element of every row or every column. */
+template <Numeric T>
+[[nodiscard]] Vector<std::remove_const_t<T>> min(const MatrixView<T> &A, Axis axis) {
+  return detail::reduce<detail::Reduce::Min, std::remove_const_t<T>>(
+      detail::lines_of(A), axis);
+}
+
+/** @brief Smallest element of every row or every column of a matrix. */
+template <Numeric T, Layout L>
+[[nodiscard]] Vector<T> min(const Matrix<T, L> &A, Axis axis) {
+  return min(A.view(), axis);
+}
+
+/** @brief Largest element of every row or every column. */
+template <Numeric T>
+[[nodiscard]] Vector<std::remove_const_t<T>> max(const MatrixView<T> &A, Axis axis) {
+  return detail::reduce<detail::Reduce::Max, std::remove_const_t<T>>(
+      detail::lines_of(A), axis);
+}
+
+/** @brief Largest element of every row or every column of a matrix. */
+template <Numeric T, Layout L>
+[[nodiscard]] Vector<T> max(const Matrix<T, L> &A, Axis axis) {
+  return max(A.view(), axis);
+}
+
+/** @brief Index of the first smallest element of every row or every column. */
+template <Numeric T>
+[[nodiscard]] Vector<size_t> argmin(const MatrixView<T> &A, Axis axis) {
+  return detail::arg_reduce<detail::Reduce::Min>(detail::lines_of(A), axis);
+}
+
+/** @brief Index of the first smallest element of every row or every column. */
+template <Numeric T, Layout L>
+[[nodiscard]] Vector<size_t> argmin(const Matrix<T, L> &A, Axis axis) {
+  return argmin(A.view(), axis);
+}
+
+/**
+ * @brief Index of the first largest element of every row or every column.
+ * @return Column indices for Axis::Rows, row indices for Axis::Columns.
+ */
+template <Numeric T>
+[[nodiscard]] Vector<size_t> argmax(const MatrixView<T> &A, Axis axis) {
+  return detail::arg_reduce<detail::Reduce::Max>(detail::lines_of(A), axis);
+}
+
+/** @brief Index of the first largest element of every row or every column. */
+template <Numeric T, Layout L>
+[[nodiscard]] Vector<size_t> argmax(const Matrix<T, L> &A, Axis axis) {
+  return argmax(A.view(), axis);
+}
+
+/**
+ * @brief Euclidean (L2) norm of every row or every column.
+ * @return Vector of reduction_float_t<T>, oriented as for sum().
+ */
+template <Numeric T>
+[[nodiscard]] auto norm(const MatrixView<T> &A, Axis axis) {
+  using R = reduction_float_t<std::remove_const_t<T>>;
+  auto result =
+      detail::reduce<detail::Reduce::SumSquares, R>(detail::lines_of(A), axis);
+  kernels::map_n(result.size(), result.data(), 1, result.data(), 1, vmath::sqrt);
+  return result;
+}
+
+/** @brief Euclidean (L2) norm of every row or every column of a matrix. */
+template <Numeric T, Layout L>
+[[nodiscard]] auto norm(const Matrix<T, L> &A, Axis axis) {
+  return norm(A.view(), axis);
+}
+
+#pragma mark broadcasting
+//=============================================================================
+// BROADCASTING
+//=============================================================================
+namespace detail {
+/** @brief Length a broadcast vector must have: columns for ROW, rows for COLUMN. */
+template <Numeric T, Layout L, Numeric U>
+void check_broadcast(const Matrix<T, L> &A, const Vector<U> &v) {
+  const size_t expected = (v.orientation() == ROW) ? A.column_count() : A.row_count();
+  if (v.size() != expected) {
+    throw std::invalid_argument(
+        "Broadcast vector must match the number of columns (ROW vector) or rows "
+        "(COLUMN vector)!");
+  }
+}
+
+/**
+ * @brief out(l, k) = f(a(l, k), v[k] or v[l]) over the storage lines of A.
+ * @details The vector runs along the lines when it has the orientation of a storage
+ * line (a ROW vector over a row-major matrix) and is one scalar per line otherwise.
+ */
+template <Numeric T, Layout L, Numeric U, typename R, typename F>
+void broadcast_lines(const Matrix<T, L> &A, const Vector<U> &v, R *out, F &f) {
+  const bool line_rows = (L == Layout::RowMajor);
+  const size_t count = line_rows ? A.row_count() : A.column_count();
+  const size_t length = line_rows ? A.column_count() : A.row_count();
+  const bool along = (v.orientation() == ROW) == line_rows;
+  const T *a = A.data();
+  const U *x = v.data();
+
+  exec::parallel_for(0, count, linear_split(count * length), [&](size_t lo, size_t hi) {
+    for (size_t l = lo; l < hi; ++l) {
+      const T *a_line = a + (l * length);
+      R *out_line = out + (l * length);
+      if (along) {
+#pragma omp simd
+        for (size_t k = 0; k < length; ++k) {
+          out_line[k] = static_cast<R>(f(a_line[k], x[k]));
+        }
+      } else {
+        const U s = x[l];
+#pragma omp simd
+        for (size_t k = 0; k < length; ++k) {
+          out_line[k] = static_cast<R>(f(a_line[k], s));
+        }
+      }
+    }
+  });
+}
+}  // namespace detail
+
+/**
+ * @brief Combines every row of A with a ROW vector, or every column of A with a
+ * COLUMN vector: result(i, j) = f(A(i, j), v[j]) or f(A(i, j), v[i]).
+ * @return `Matrix<R, L>` where R is the type returned by f.
+ * @throws std::invalid_argument if the vector length does not match.
+ */
+template <Numeric T, Layout L, Numeric U, std::invocable<const T &, const U &> F>
+[[nodiscard]] auto broadcast(const Matrix<T, L> &A, const Vector<U> &v, F f) {
+  detail::check_broadcast(A, v);
+  Matrix<map_result_t<F, T, U>, L> result(A.row_count(), A.column_count(),
+                                          util::uninitialized);
+  detail::broadcast_lines(A, v, result.data(), f);
+  return result;
+}
+
+/**
+ * @brief In-place broadcast: A(i, j) = f(A(i, j), v[j] or v[i]).
+ * @throws std::invalid_argument if the vector length does not match.
+ */
+template <Numeric T, Layout L, Numeric U, std::invocable<const T &, const U &> F>
+Matrix<T, L> &broadcast_inplace(Matrix<T, L> &A, const Vector<U> &v, F f) {
+  detail::check_broadcast(A, v);
+  detail::broadcast_lines(A, v, A.data(), f);
+  return A;
+}
+
+/**
+ * @brief Adds a ROW vector to every row or a COLUMN vector to every column.
+ * @return Matrix of the common type.
+ * @throws std::invalid_argument if the vector length does not match.
+ */
+template <Numeric T, Layout L, Numeric U>
+[[nodiscard]] auto operator+(const Matrix<T, L> &A, const Vector<U> &v) {
+  using R = std::common_type_t<T, U>;
+  return broadcast(A, v, [](T a, U b) { return static_cast<R>(a) + static_cast<R>(b); });
+}
+
+/** @brief Broadcast addition with the vector on the left. */
+template <Numeric T, Layout L, Numeric U>
+[[nodiscard]] auto operator+(const Vector<U> &v, const Matrix<T, L> &A) {
+  return A + v;
+}
+
+/**
+ * @brief Subtracts a ROW vector from every row or a COLUMN vector from every column.
+ * @return Matrix of the common type.
+ * @throws std::invalid_argument if the vector length does not match.
+ */
+template <Numeric T, Layout L, Numeric U>
+[[nodiscard]] auto operator-(const Matrix<T, L> &A, const Vector<U> &v) {
+  using R = std::common_type_t<T, U>;
+  return broadcast(A, v, [](T a, U b) { return static_cast<R>(a) - static_cast<R>(b); });
+}
+
+/**
+ * @brief In-place broadcast addition.
+ * @attention This method doesn't cast the matrix if U is a broader type.
+ */
+template <Numeric T, Layout L, Numeric U>
+Matrix<T, L> &operator+=(Matrix<T, L> &A, const Vector<U> &v) {
+  return broadcast_inplace(A, v, [](T a, U b) { return static_cast<T>(a + b); });
+}
+
+/**
+ * @brief In-place broadcast subtraction.
+ * @attention This method doesn't cast the matrix if U is a broader type.
+ */
+template <Numeric T, Layout L, Numeric U>
+Matrix<T, L> &operator-=(Matrix<T, L> &A, const Vector<U> &v) {
+  return broadcast_inplace(A, v, [](T a, U b) { return static_cast<T>(a - b); });
+}
+}  // namespace maf::math
+
+#endif
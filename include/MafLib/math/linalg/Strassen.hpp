@@ -0,0 +1,197 @@
+#ifndef STRASSEN_H
+#define STRASSEN_H
+#pragma once
+#include "BlasWrappers/BlasWrapper.hpp"
+#include "GemmKernels.hpp"
+#include "Matrix.hpp"
+
+/**
+ * @file Strassen.hpp
+ * @brief Strassen-Winograd fast multiplication for very large matrix products.
+ *
+ * This header defines the `strassen_multiply` function, an opt-in alternative to
+ * `Matrix::operator*`. Every recursion level replaces eight half-size products with
+ * seven, giving O(n^2.81) work, until a sub-product is small enough for the blocked
+ * GEMM engine (or the vendor BLAS) to take over. Odd dimensions are peeled off and
+ * finished with GEMM, so any shape is accepted.
+ *
+ * The price is a weaker error bound: it holds norm-wise rather than element-wise and
+ * grows with the recursion depth. It is well suited to large, well-scaled dense
+ * products such as covariance matrices; integer products stay exact.
+ *
+ * More information:
+ * https://en.wikipedia.org/wiki/Strassen_algorithm#Winograd_form
+ */
+namespace maf::math {
+/** @brief Default size at or below which Strassen recursion hands over to GEMM. */
+inline static constexpr size_t STRASSEN_CROSSOVER = 512;
+
+namespace detail {
+/** @brief Workspace elements needed by strassen_recurse for an m x k by k x n product.
+ * The seven sub-products of a level run one after another and share the workspace of
+ * the level below. */
+[[nodiscard]] inline size_t strassen_workspace(size_t m, size_t k, size_t n,
+                                               size_t crossover) {
+  if (std::min({m, k, n}) <= crossover) {
+    return 0;
+  }
+  const size_t m2 = m / 2;
+  const size_t k2 = k / 2;
+  const size_t n2 = n / 2;
+  return (m2 * std::max(k2, n2)) + (k2 * n2) +
+         strassen_workspace(m2, k2, n2, crossover);
+}
+
+/** @brief z = x + sign * y over m x n row-major blocks; z may alias x or y. */
+template <typename R, typename TX, typename TY>
+void strassen_combine(size_t m, size_t n, const TX *x, size_t ldx, const TY *y,
+                      size_t ldy, R sign, R *z, size_t ldz) {
+  exec::parallel_for(0, m, quadratic_split(m * n), [&](size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; ++i) {
+      const TX *x_row = x + (i * ldx);
+      const TY *y_row = y + (i * ldy);
+      R *z_row = z + (i * ldz);
+#pragma omp simd
+      for (size_t j = 0; j < n; ++j) {
+        z_row[j] = static_cast<R>(x_row[j]) + (sign * static_cast<R>(y_row[j]));
+      }
+    }
+  });
+}
+
+/** @brief C = A * B with the blocked GEMM, used below the crossover and for peeling. */
+template <typename R, typename TA, typename TB>
+void strassen_base(size_t m, size_t k, size_t n, const TA *a, size_t lda, const TB *b,
+                   size_t ldb, R beta, R *c, size_t ldc) {
+#if defined(MAF_BLAS_AVAILABLE)
+  if constexpr (blas::supports<R> && (std::is_same_v<TA, R> || std::is_same_v<TB, R>)) {
+    if (m != 0 && n != 0) {
+      blas::gemm_mixed(m, n, k, R(1), a, lda, b, ldb, beta, c, ldc);
+    }
+    return;
+  }
+#endif
+  kernels::packed_gemm<TA, TB, R, R>(m, n, k, R(1), a, lda, 1, b, ldb, 1, beta, c, ldc,
+                                     1);
+}
+
+/**
+ * @brief C = A * B for row-major A (m x k), B (k x n) and C (m x n).
+ * @details Winograd's variant with the two-temporary schedule of Boyer, Dumas, Pernet
+ * and Zhou: the sums of A quadrants live in X, the sums of B quadrants in Y, and the
+ * seven products are accumulated directly in the quadrants of C. Operands keep their
+ * own types; only the quadrant sums are formed in R.
+ */
+template <typename R, typename TA, typename TB>
+void strassen_recurse(size_t m, size_t k, size_t n, const TA *a, size_t lda,
+                      const TB *b, size_t ldb, R *c, size_t ldc, R *work,
+                      size_t crossover) {
+  if (std::min({m, k, n}) <= crossover) {
+    strassen_base(m, k, n, a, lda, b, ldb, R(0), c, ldc);
+    return;
+  }
+
+  const size_t m2 = m / 2;
+  const size_t k2 = k / 2;
+  const size_t n2 = n / 2;
+
+  const TA *a11 = a;
+  const TA *a12 = a + k2;
+  const TA *a21 = a + (m2 * lda);
+  const TA *a22 = a21 + k2;
+  const TB *b11 = b;
+  const TB *b12 = b + n2;
+  const TB *b21 = b + (k2 * ldb);
+  const TB *b22 = b21 + n2;
+  R *c11 = c;
+  R *c12 = c + n2;
+  R *c21 = c + (m2 * ldc);
+  R *c22 = c21 + n2;
+
+  // X holds an m2 x k2 sum of A quadrants and later the m2 x n2 product P1.
+  R *x = work;
+  R *y = x + (m2 * std::max(k2, n2));
+  R *next = y + (k2 * n2);
+  const R plus(1);
+  const R minus(-1);
+
+  strassen_combine(m2, k2, a11, lda, a21, lda, minus, x, k2);  // S3 = A11 - A21
+  strassen_combine(k2, n2, b22, ldb, b12, ldb, minus, y, n2);  // T3 = B22 - B12
+  strassen_recurse(m2, k2, n2, x, k2, y, n2, c21, ldc, next, crossover);  // P7
+  strassen_combine(m2, k2, a21, lda, a22, lda, plus, x, k2);   // S1 = A21 + A22
+  strassen_combine(k2, n2, b12, ldb, b11, ldb, minus, y, n2);  // T1 = B12 - B11
+  strassen_recurse(m2, k2, n2, x, k2, y, n2, c22, ldc, next, crossover);  // P5
+  strassen_combine(k2, n2, b22, ldb, y, n2, minus, y, n2);     // T2 = B22 - T1
+  strassen_combine(m2, k2, x, k2, a11, lda, minus, x, k2);     // S2 = S1 - A11
+  strassen_recurse(m2, k2, n2, x, k2, y, n2, c12, ldc, next, crossover);  // P6
+  strassen_combine(m2, k2, a12, lda, x, k2, minus, x, k2);     // S4 = A12 - S2
+  strassen_recurse(m2, k2, n2, x, k2, b22, ldb, c11, ldc, next, crossover);  // P3
+  strassen_recurse(m2, k2, n2, a11, lda, b11, ldb, x, n2, next, crossover);  // P1
+  strassen_combine(m2, n2, x, n2, c12, ldc, plus, c12, ldc);     // U2 = P1 + P6
+  strassen_combine(m2, n2, c12, ldc, c21, ldc, plus, c21, ldc);  // U3 = U2 + P7
+  strassen_combine(m2, n2, c12, ldc, c22, ldc, plus, c12, ldc);  // U4 = U2 + P5
+  strassen_combine(m2, n2, c21, ldc, c22, ldc, plus, c22, ldc);  // C22 = U3 + P5
+  strassen_combine(m2, n2, c12, ldc, c11, ldc, plus, c12, ldc);  // C12 = U4 + P3
+  strassen_combine(k2, n2, y, n2, b21, ldb, minus, y, n2);       // T4 = T2 - B21
+  strassen_recurse(m2, k2, n2, a22, lda, y, n2, c11, ldc, next, crossover);  // P4
+  strassen_combine(m2, n2, c21, ldc, c11, ldc, minus, c21, ldc);  // C21 = U3 - P4
+  strassen_recurse(m2, k2, n2, a12, lda, b21, ldb, c11, ldc, next, crossover);  // P2
+  strassen_combine(m2, n2, x, n2, c11, ldc, plus, c11, ldc);  // C11 = P1 + P2
+
+  // Dynamic peeling: the odd row, column and inner index go through GEMM.
+  if (k != 2 * k2) {
+    strassen_base(2 * m2, 1, 2 * n2, a + (2 * k2), lda, b + (2 * k2 * ldb), ldb, plus,
+                  c, ldc);
+  }
+  if (n != 2 * n2) {
+    strassen_base(2 * m2, k, 1, a, lda, b + (2 * n2), ldb, R(0), c + (2 * n2), ldc);
+  }
+  if (m != 2 * m2) {
+    strassen_base(1, k, n, a + (2 * m2 * lda), lda, b, ldb, R(0), c + (2 * m2 * ldc),
+                  ldc);
+  }
+}
+}  // namespace detail
+
+/**
+ * @brief Multiplies two matrices with the Strassen-Winograd algorithm.
+ * @details Recurses while every dimension exceeds `crossover`, then falls back to the
+ * same blocked GEMM (or vendor BLAS) as `operator*`. All recursion levels share a
+ * single workspace of about (m * k + k * n) / 3 elements allocated up front.
+ * @attention Opt-in. Pays off only for large products, roughly 4096 and up with a
+ * fast base case. Floating-point results satisfy a norm-wise error bound that grows
+ * by about a factor of 12 per level, instead of the element-wise bound of classical
+ * multiplication.
+ * @tparam T Numeric type of A.
+ * @tparam U Numeric type of B.
+ * @param A Left operand (m x k).
+ * @param B Right operand (k x n).
+ * @param crossover Sub-products with any dimension at or below this size are handed
+ * to GEMM.
+ * @return Matrix of the common, promoted type.
+ * @throws std::invalid_argument if inner dimensions do not match or crossover is zero.
+ */
+template <Numeric T, Numeric U>
+[[nodiscard]] auto strassen_multiply(const Matrix<T> &A, const Matrix<U> &B,
+                                     size_t crossover = STRASSEN_CROSSOVER) {
+  if (A.column_count() != B.row_count()) {
+    throw std::invalid_argument(
+        "Matrix inner dimensions do not match for multiplication!");
+  }
+  if (crossover == 0) {
+    throw std::invalid_argument("Strassen crossover must be positive!");
+  }
+  using R = std::common_type_t<T, U>;
+
+  const size_t m = A.row_count();
+  const size_t k = A.column_count();
+  const size_t n = B.column_count();
+  Matrix<R> result(m, n, util::uninitialized);
+  util::AlignedVector<R> work(detail::strassen_workspace(m, k, n, crossover));
+  detail::strassen_recurse(m, k, n, A.data(), k, B.data(), n, result.data(), n,
+                           work.data(), crossover);
+  return result;
+}
+
+}  // namespace maf::math
+#endif
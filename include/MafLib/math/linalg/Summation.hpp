@@ -0,0 +1,196 @@
+#ifndef SUMMATION_H
+#define SUMMATION_H
+#pragma once
+#include "MafLib/main/GlobalHeader.hpp"
+#include "MafLib/utility/Math.hpp"
+
+/**
+ * @file Summation.hpp
+ * @brief The summation engine behind dot products, norms, sums and means.
+ *
+ * A single `omp simd reduction` accumulator is latency-bound on its chain of adds and
+ * its rounding error grows linearly with n. The kernels below instead cut the range
+ * into blocks of SUM_BLOCK elements, sum every block into SUM_LANES explicit
+ * accumulator lanes and merge the block sums pairwise through a binary counter. The
+ * lanes are an array, not a property of the vectorizer, so the error bound of about
+ * (SUM_BLOCK / SUM_LANES + log2 n) ulp instead of n ulp holds at every optimization
+ * level. Vectorized, the lanes fill SUM_CHAINS or more independent registers that
+ * hide the latency of the adds.
+ *
+ * Summation::Compensated instead carries a Kahan-Babuska correction per lane, so the
+ * error no longer depends on n, at two to three times the cost. The correction
+ * terms are algebraically zero: under -ffast-math (-fassociative-math) GCC folds
+ * them away and the result degrades to the lane sum. Clang keeps them, since the
+ * kernels disable reassociation locally.
+ *
+ * Long ranges are split across threads like every other linear kernel; the thread
+ * partials are added in thread order, so a result only depends on the thread count.
+ */
+namespace maf::math {
+using namespace maf::util;
+
+/** @brief Summation algorithm of the reduction kernels. */
+enum class Summation : uint8 { Pairwise, Compensated };
+
+namespace kernels {
+namespace detail {
+/** @brief Elements summed by the lanes before a block sum joins the pairwise merge. */
+inline constexpr size_t SUM_BLOCK = 1024;
+
+/** @brief Independent accumulator registers of a block sum (of 8 lanes each). */
+inline constexpr size_t SUM_CHAINS = 4;
+
+/** @brief Accumulator lanes of a block sum; each adds SUM_BLOCK / SUM_LANES terms. */
+inline constexpr size_t SUM_LANES = SUM_CHAINS * 8;
+
+/**
+ * @brief Sum of term(i) over [lo, hi), hi - lo <= SUM_BLOCK.
+ * @details Term i is added to lane i % SUM_LANES, and the lanes are folded pairwise
+ * at the end. The inner loop over the lanes is what gets vectorized, so every
+ * register of lanes is a chain of vector adds independent of the others. term is
+ * taken by value: with a local copy the compiler can prove it does not alias the
+ * accumulators and keeps them in registers.
+ */
+template <typename A, typename Term>
+[[nodiscard]] A block_sum(size_t lo, size_t hi, Term term) noexcept {
+  A lanes[SUM_LANES];
+  std::fill(std::begin(lanes), std::end(lanes), A(0));
+  const size_t full = lo + ((hi - lo) / SUM_LANES * SUM_LANES);
+  for (size_t i = lo; i < full; i += SUM_LANES) {
+#pragma omp simd
+    for (size_t j = 0; j < SUM_LANES; ++j) {
+      lanes[j] += term(i + j);
+    }
+  }
+  for (size_t i = full; i < hi; ++i) {
+    lanes[i - full] += term(i);
+  }
+  for (size_t width = SUM_LANES / 2; width > 0; width /= 2) {
+    for (size_t j = 0; j < width; ++j) {
+      lanes[j] += lanes[j + width];
+    }
+  }
+  return lanes[0];
+}
+
+/** @brief Sum of term(i) over [lo, hi): block sums merged like a binary counter. */
+template <typename A, typename Term>
+[[nodiscard]] A pairwise_sum(size_t lo, size_t hi, const Term &term) noexcept {
+  // level[d] holds the sum of 2^d consecutive blocks while bit d of `filled` is set.
+  A level[64];
+  uint64 filled = 0;
+  for (size_t b = lo; b < hi; b += SUM_BLOCK) {
+    A carry = block_sum<A>(b, std::min(hi, b + SUM_BLOCK), term);
+    size_t d = 0;
+    for (; (filled >> d) & 1U; ++d) {
+      carry = level[d] + carry;
+    }
+    filled = (filled & ~((uint64(1) << d) - 1)) | (uint64(1) << d);
+    level[d] = carry;
+  }
+  A result(0);
+  for (size_t d = 0; d < 64; ++d) {
+    if ((filled >> d) & 1U) {
+      result = level[d] + result;
+    }
+  }
+  return result;
+}
+
+/** @brief sum += x, with the rounding error of the addition added to compensation. */
+template <typename A>
+inline void compensated_add(A &sum, A &compensation, A x) noexcept {
+#if defined(__clang__)
+#pragma clang fp reassociate(off)
+#endif
+  const A total = sum + x;
+  const A virtual_x = total - sum;
+  compensation += (sum - (total - virtual_x)) + (x - virtual_x);
+  sum = total;
+}
+
+/**
+ * @brief Sum of term(i) over [lo, hi) with a Kahan-Babuska correction per SIMD lane.
+ * @details Chains and lanes are split as in block_sum; the partial sums and their
+ * corrections are folded with one more compensated pass.
+ */
+template <typename A, typename Term>
+[[nodiscard]] A compensated_sum(size_t lo, size_t hi, Term term) noexcept {
+  const size_t m = (hi - lo) / 2;
+  const size_t l1 = lo + m;
+  A s0(0);
+  A s1(0);
+  A c0(0);
+  A c1(0);
+#pragma omp simd reduction(+ : s0, s1, c0, c1)
+  for (size_t i = 0; i < m; ++i) {
+    compensated_add(s0, c0, static_cast<A>(term(lo + i)));
+    compensated_add(s1, c1, static_cast<A>(term(l1 + i)));
+  }
+  for (size_t i = l1 + m; i < hi; ++i) {
+    compensated_add(s1, c1, static_cast<A>(term(i)));
+  }
+  A correction = c0 + c1;
+  compensated_add(s0, correction, s1);
+  return s0 + correction;
+}
+}  // namespace detail
+
+#pragma mark summation
+//=============================================================================
+// SUMMATION
+//=============================================================================
+/**
+ * @brief Sum of term(i) for i in [0, n), accumulated in A.
+ * @details The range is split across threads once n exceeds tuning().omp_linear_limit.
+ * Integer accumulators are exact, so they always use the pairwise kernel.
+ */
+template <typename A, Summation S = Summation::Pairwise, typename Term>
+[[nodiscard]] A sum_terms(size_t n, Term &&term) {
+  return exec::parallel_reduce(
+      0, n, linear_split(), A(0),
+      [&](size_t lo, size_t hi) {
+        if constexpr (S == Summation::Compensated && std::is_floating_point_v<A>) {
+          return detail::compensated_sum<A>(lo, hi, term);
+        } else {
+          return detail::pairwise_sum<A>(lo, hi, term);
+        }
+      },
+      std::plus<A>());
+}
+
+/** @brief x[0] + x[incx] + ... + x[(n - 1) * incx], accumulated in A. */
+template <typename A, Summation S = Summation::Pairwise, typename T>
+[[nodiscard]] A sum_n(size_t n, const T *x, size_t incx) {
+  if (incx == 1) {
+    return sum_terms<A, S>(n, [x](size_t i) { return static_cast<A>(x[i]); });
+  }
+  return sum_terms<A, S>(n, [=](size_t i) { return static_cast<A>(x[i * incx]); });
+}
+
+/** @brief Sum of the squares of n strided elements, accumulated in A. */
+template <typename A, Summation S = Summation::Pairwise, typename T>
+[[nodiscard]] A sum_squares_n(size_t n, const T *x, size_t incx) {
+  auto square = [](A v) { return v * v; };
+  if (incx == 1) {
+    return sum_terms<A, S>(n, [=](size_t i) { return square(static_cast<A>(x[i])); });
+  }
+  return sum_terms<A, S>(
+      n, [=](size_t i) { return square(static_cast<A>(x[i * incx])); });
+}
+
+/** @brief Dot product of two strided sequences of n elements, accumulated in A. */
+template <typename A, Summation S = Summation::Pairwise, typename T, typename U>
+[[nodiscard]] A dot_n(size_t n, const T *x, size_t incx, const U *y, size_t incy) {
+  if (incx == 1 && incy == 1) {
+    return sum_terms<A, S>(
+        n, [=](size_t i) { return static_cast<A>(x[i]) * static_cast<A>(y[i]); });
+  }
+  return sum_terms<A, S>(n, [=](size_t i) {
+    return static_cast<A>(x[i * incx]) * static_cast<A>(y[i * incy]);
+  });
+}
+}  // namespace kernels
+}  // namespace maf::math
+
+#endif
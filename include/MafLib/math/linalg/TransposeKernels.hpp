@@ -0,0 +1,321 @@
+#ifndef TRANSPOSE_KERNELS_H
+#define TRANSPOSE_KERNELS_H
+#pragma once
+#include "MafLib/main/GlobalHeader.hpp"
+#include "MafLib/utility/Hardware.hpp"
+#include "MafLib/utility/Math.hpp"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @file TransposeKernels.hpp
+ * @brief Cache-oblivious out-of-place and in-place matrix transposes.
+ *
+ * The out-of-place transpose halves the longer dimension until a block fits in a
+ * LEAF x LEAF tile, so every level of the memory hierarchy is used well without
+ * knowing its size. Leaves are transposed 8 x 8 at a time in vector registers and,
+ * when the output is larger than the last level cache, written with non-temporal
+ * stores that bypass it.
+ *
+ * In-place transposes swap mirrored tiles for square matrices and follow the
+ * permutation cycles of the index map for rectangular ones, which needs one bit of
+ * scratch per element instead of a second copy of the matrix.
+ *
+ * More information:
+ * https://en.wikipedia.org/wiki/In-place_matrix_transposition
+ */
+namespace maf::math::kernels {
+using namespace maf::util;
+
+namespace detail {
+/** @brief Edge of the register-transposed tiles. */
+inline constexpr size_t TRANSPOSE_TILE = 8;
+/** @brief Recursion stops once both dimensions of a block are at most this. */
+inline constexpr size_t TRANSPOSE_LEAF = 32;
+
+#pragma mark register_transposes
+//=============================================================================
+// REGISTER TRANSPOSES
+//=============================================================================
+/** @brief True if T is transposed 8 x 8 in vector registers. */
+template <typename T>
+inline constexpr bool has_register_transpose =
+#if defined(__AVX__)
+    std::is_arithmetic_v<T> && (sizeof(T) == 4 || sizeof(T) == 8);
+#else
+    false;
+#endif
+
+#if defined(__AVX__)
+template <bool Stream>
+inline void store_row(float *p, __m256 v) {
+  if constexpr (Stream) {
+    _mm256_stream_ps(p, v);
+  } else {
+    _mm256_storeu_ps(p, v);
+  }
+}
+
+template <bool Stream>
+inline void store_row(double *p, __m256d v) {
+  if constexpr (Stream) {
+    _mm256_stream_pd(p, v);
+  } else {
+    _mm256_storeu_pd(p, v);
+  }
+}
+
+/** @brief dst = src^T for an 8 x 8 block of 4-byte elements. */
+template <bool Stream>
+inline void transpose_8x8(const float *src, size_t lds, float *dst, size_t ldd) {
+  __m256 r[8];
+  for (size_t i = 0; i < 8; ++i) {
+    r[i] = _mm256_loadu_ps(src + (i * lds));
+  }
+  __m256 t[8];
+  for (size_t i = 0; i < 8; i += 2) {
+    t[i] = _mm256_unpacklo_ps(r[i], r[i + 1]);
+    t[i + 1] = _mm256_unpackhi_ps(r[i], r[i + 1]);
+  }
+  __m256 s[8];
+  for (size_t h = 0; h < 8; h += 4) {
+    s[h] = _mm256_shuffle_ps(t[h], t[h + 2], _MM_SHUFFLE(1, 0, 1, 0));
+    s[h + 1] = _mm256_shuffle_ps(t[h], t[h + 2], _MM_SHUFFLE(3, 2, 3, 2));
+    s[h + 2] = _mm256_shuffle_ps(t[h + 1], t[h + 3], _MM_SHUFFLE(1, 0, 1, 0));
+    s[h + 3] = _mm256_shuffle_ps(t[h + 1], t[h + 3], _MM_SHUFFLE(3, 2, 3, 2));
+  }
+  for (size_t i = 0; i < 4; ++i) {
+    store_row<Stream>(dst + (i * ldd), _mm256_permute2f128_ps(s[i], s[i + 4], 0x20));
+    store_row<Stream>(dst + ((i + 4) * ldd),
+                      _mm256_permute2f128_ps(s[i], s[i + 4], 0x31));
+  }
+}
+
+/** @brief dst = src^T for a 4 x 4 block of 8-byte elements. */
+template <bool Stream>
+inline void transpose_4x4(const double *src, size_t lds, double *dst, size_t ldd) {
+  const __m256d r0 = _mm256_loadu_pd(src);
+  const __m256d r1 = _mm256_loadu_pd(src + lds);
+  const __m256d r2 = _mm256_loadu_pd(src + (2 * lds));
+  const __m256d r3 = _mm256_loadu_pd(src + (3 * lds));
+  const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+  const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+  const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+  const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+  store_row<Stream>(dst, _mm256_permute2f128_pd(t0, t2, 0x20));
+  store_row<Stream>(dst + ldd, _mm256_permute2f128_pd(t1, t3, 0x20));
+  store_row<Stream>(dst + (2 * ldd), _mm256_permute2f128_pd(t0, t2, 0x31));
+  store_row<Stream>(dst + (3 * ldd), _mm256_permute2f128_pd(t1, t3, 0x31));
+}
+
+/** @brief dst = src^T for an 8 x 8 block of 8-byte elements. */
+template <bool Stream>
+inline void transpose_8x8(const double *src, size_t lds, double *dst, size_t ldd) {
+  transpose_4x4<Stream>(src, lds, dst, ldd);
+  transpose_4x4<Stream>(src + 4, lds, dst + (4 * ldd), ldd);
+  transpose_4x4<Stream>(src + (4 * lds), lds, dst + 4, ldd);
+  transpose_4x4<Stream>(src + (4 * lds) + 4, lds, dst + (4 * ldd) + 4, ldd);
+}
+#endif
+
+/** @brief dst = src^T for an 8 x 8 block; other 4- and 8-byte types are moved as
+ * float or double bit patterns. */
+template <bool Stream, typename T>
+  requires(has_register_transpose<T>)
+inline void register_transpose(const T *src, size_t lds, T *dst, size_t ldd) {
+#if defined(__AVX__)
+  using Lane = std::conditional_t<sizeof(T) == 4, float, double>;
+  // The AVX load and store intrinsics may alias any type.
+  transpose_8x8<Stream>(reinterpret_cast<const Lane *>(src), lds,
+                        reinterpret_cast<Lane *>(dst), ldd);
+#endif
+}
+
+#pragma mark recursion
+//=============================================================================
+// CACHE-OBLIVIOUS RECURSION
+//=============================================================================
+/** @brief Transposes a block of at most LEAF x LEAF; dst is cols x rows. */
+template <bool Stream, typename T>
+void transpose_leaf(size_t rows, size_t cols, const T *src, size_t lds, T *dst,
+                    size_t ldd) {
+  size_t rows_tiled = 0;
+  size_t cols_tiled = 0;
+  if constexpr (has_register_transpose<T>) {
+    rows_tiled = rows - (rows % TRANSPOSE_TILE);
+    cols_tiled = cols - (cols % TRANSPOSE_TILE);
+    // Walk along rows of dst so consecutive stores complete whole cache lines.
+    for (size_t j = 0; j < cols_tiled; j += TRANSPOSE_TILE) {
+      for (size_t i = 0; i < rows_tiled; i += TRANSPOSE_TILE) {
+        register_transpose<Stream>(src + (i * lds) + j, lds, dst + (j * ldd) + i, ldd);
+      }
+    }
+  }
+  for (size_t j = cols_tiled; j < cols; ++j) {
+    T *out = dst + (j * ldd);
+    for (size_t i = 0; i < rows; ++i) {
+      out[i] = src[(i * lds) + j];
+    }
+  }
+  for (size_t j = 0; j < cols_tiled; ++j) {
+    T *out = dst + (j * ldd);
+    for (size_t i = rows_tiled; i < rows; ++i) {
+      out[i] = src[(i * lds) + j];
+    }
+  }
+}
+
+/** @brief Halves the longer side at a multiple of the tile until a leaf remains. */
+template <bool Stream, typename T>
+void transpose_recurse(size_t rows, size_t cols, const T *src, size_t lds, T *dst,
+                       size_t ldd) {
+  if (rows <= TRANSPOSE_LEAF && cols <= TRANSPOSE_LEAF) {
+    transpose_leaf<Stream>(rows, cols, src, lds, dst, ldd);
+    return;
+  }
+  if (rows >= cols) {
+    const size_t half = (rows / (2 * TRANSPOSE_TILE)) * TRANSPOSE_TILE;
+    transpose_recurse<Stream>(half, cols, src, lds, dst, ldd);
+    transpose_recurse<Stream>(rows - half, cols, src + (half * lds), lds, dst + half,
+                              ldd);
+  } else {
+    const size_t half = (cols / (2 * TRANSPOSE_TILE)) * TRANSPOSE_TILE;
+    transpose_recurse<Stream>(rows, half, src, lds, dst, ldd);
+    transpose_recurse<Stream>(rows, cols - half, src + half, lds, dst + (half * ldd),
+                              ldd);
+  }
+}
+
+/**
+ * @brief Transposes in column strips of src (row strips of dst), one per work item.
+ * @details Strip boundaries are multiples of the tile, so aligned output stays
+ * aligned inside every strip.
+ */
+template <bool Stream, typename T>
+void transpose_strips(size_t rows, size_t cols, const T *src, size_t lds, T *dst,
+                      size_t ldd) {
+  const bool parallel = rows * cols >= tuning().omp_quadratic_limit;
+  const size_t strips = parallel ? 4 * exec::concurrency() : size_t{1};
+  size_t width = (cols + strips - 1) / strips;
+  width = ((width + TRANSPOSE_TILE - 1) / TRANSPOSE_TILE) * TRANSPOSE_TILE;
+  const size_t count = (cols + width - 1) / width;
+  const exec::Split split = exec::Split::only_if(parallel);
+
+  exec::parallel_for(0, count, split, [&](size_t lo, size_t hi) {
+    for (size_t s = lo; s < hi; ++s) {
+      const size_t j = s * width;
+      transpose_recurse<Stream>(rows, std::min(width, cols - j), src + j, lds,
+                                dst + (j * ldd), ldd);
+    }
+#if defined(__AVX__)
+    if constexpr (Stream) {
+      // Non-temporal stores are weakly ordered; publish them before the join.
+      _mm_sfence();
+    }
+#endif
+  });
+}
+}  // namespace detail
+
+#pragma mark transposes
+//=============================================================================
+// TRANSPOSES
+//=============================================================================
+/**
+ * @brief Out-of-place transpose, dst = src^T.
+ * @details src is rows x cols with row stride lds, dst is cols x rows with row stride
+ * ldd; the two must not overlap. Outputs larger than the last level cache are
+ * written with non-temporal stores when dst rows are 32-byte aligned.
+ */
+template <typename T>
+void transpose(size_t rows, size_t cols, const T *src, size_t lds, T *dst,
+               size_t ldd) {
+  if (rows == 0 || cols == 0) {
+    return;
+  }
+  if constexpr (detail::has_register_transpose<T>) {
+    const CacheSizes &cache = cache_sizes();
+    const size_t llc = (cache.l3 != 0) ? cache.l3 : cache.l2;
+    const bool aligned = reinterpret_cast<uintptr_t>(dst) % 32 == 0 &&
+                         (ldd * sizeof(T)) % 32 == 0;
+    if (aligned && rows * cols * sizeof(T) >= llc) {
+      detail::transpose_strips<true>(rows, cols, src, lds, dst, ldd);
+      return;
+    }
+  }
+  detail::transpose_strips<false>(rows, cols, src, lds, dst, ldd);
+}
+
+/**
+ * @brief In-place transpose of a square n x n block with row stride lda.
+ * @details Mirrored LEAF x LEAF tiles are exchanged through a small stack buffer,
+ * each through the register transpose.
+ */
+template <typename T>
+void transpose_square_in_place(size_t n, T *a, size_t lda) {
+  constexpr size_t B = detail::TRANSPOSE_LEAF;
+  const size_t blocks = (n + B - 1) / B;
+
+  // Row blocks shrink towards the bottom, so threads take them one at a time.
+  exec::Split split = quadratic_split(n * n);
+  split.grain = 1;
+  exec::parallel_for(0, blocks, split, [&](size_t lo, size_t hi) {
+    alignas(64) T buffer[B * B];
+    for (size_t bi = lo; bi < hi; ++bi) {
+      const size_t i = bi * B;
+      const size_t rows = std::min(B, n - i);
+      for (size_t j = i; j < n; j += B) {
+        const size_t cols = std::min(B, n - j);
+        T *upper = a + (i * lda) + j;
+        T *lower = a + (j * lda) + i;
+        // buffer = upper^T, then upper = lower^T, then lower = buffer.
+        detail::transpose_leaf<false>(rows, cols, upper, lda, buffer, B);
+        if (i != j) {
+          detail::transpose_leaf<false>(cols, rows, lower, lda, upper, lda);
+        }
+        for (size_t r = 0; r < cols; ++r) {
+          std::copy_n(buffer + (r * B), rows, lower + (r * lda));
+        }
+      }
+    }
+  });
+}
+
+/**
+ * @brief In-place transpose of a contiguous row-major rows x cols matrix.
+ * @details Square matrices use transpose_square_in_place. Otherwise the element at
+ * index k moves to (k mod cols) * rows + k / cols; every cycle of that permutation
+ * is followed once, using one bit per element to mark moved positions.
+ */
+template <typename T>
+void transpose_in_place(size_t rows, size_t cols, T *a) {
+  if (rows == cols) {
+    transpose_square_in_place(rows, a, cols);
+    return;
+  }
+  if (rows <= 1 || cols <= 1) {
+    return;  // A single row or column has the same layout as its transpose.
+  }
+
+  const size_t size = rows * cols;
+  std::vector<bool> moved(size, false);
+  // The first and last elements are fixed points.
+  for (size_t start = 1; start + 1 < size; ++start) {
+    if (moved[start]) {
+      continue;
+    }
+    T carry = std::move(a[start]);
+    size_t k = start;
+    do {
+      const size_t next = ((k % cols) * rows) + (k / cols);
+      std::swap(a[next], carry);
+      moved[next] = true;
+      k = next;
+    } while (k != start);
+  }
+}
+
+}  // namespace maf::math::kernels
+#endif
@@ -1,10 +1,13 @@
 #ifndef VECTOR_H
 #define VECTOR_H
 #pragma once
-#include "AccelerateWrappers/AccelerateWrapper.hpp"
+#include "BlasWrappers/BlasWrapper.hpp"
 #include "LinAlg.hpp"
 #include "MafLib/main/GlobalHeader.hpp"
 #include "MafLib/utility/Math.hpp"
+#include "MafLib/utility/Memory.hpp"
+#include "Summation.hpp"
+#include "VectorizedMath.hpp"
 
 namespace maf::math {
 using namespace maf::util;
@@ -30,6 +33,11 @@ class Vector {
  public:
   /** @brief The numeric type of the vector's elements. */
   using value_type = T;
+  /** @brief Allocator of the 64-byte aligned element storage; fixed like
+   * Matrix::allocator_type. */
+  using allocator_type = util::AlignedAllocator<T>;
+  /** @brief Contiguous element storage. */
+  using storage_type = std::vector<T, allocator_type>;
 
   // --- Constructors ---
 
@@ -40,13 +48,21 @@ class Vector {
   Vector() : _orientation(COLUMN) {}
 
   /**
-   * @brief Constructs an uninitialized vector of a given size.
+   * @brief Constructs a zero-filled vector of a given size.
    * @param size The number of elements in the vector.
    * @param orientation The vector's orientation (default: COLUMN).
    * @throws std::invalid_argument if size is zero.
    */
   Vector(size_t size, Orientation orientation = COLUMN);
 
+  /**
+   * @brief Constructs a vector of a given size without initializing elements.
+   * @param size The number of elements in the vector.
+   * @param orientation The vector's orientation (default: COLUMN).
+   * @throws std::invalid_argument if size is zero.
+   */
+  Vector(size_t size, util::uninitialized_t, Orientation orientation = COLUMN);
+
   /**
    * @brief Constructs from a raw data pointer.
    * @details Elements are COPIED from the data pointer.
@@ -60,6 +76,8 @@ class Vector {
 
   /**
    * @brief Constructs from a std::vector by copying its data.
+   * @details The elements are copied into aligned storage, also from an rvalue; pass
+   * a storage_type to adopt a buffer without copying.
    * @param size The number of elements. Must match data.size().
    * @param data The std::vector to copy from.
    * @param orientation The vector's orientation (default: COLUMN).
@@ -70,14 +88,14 @@ class Vector {
   Vector(size_t size, const std::vector<U> &data, Orientation orientation = COLUMN);
 
   /**
-   * @brief Constructs from a std::vector by moving its data.
+   * @brief Adopts aligned storage without copying it.
    * @param size The number of elements. Must match data.size().
-   * @param data The std::vector to move from (r-value).
+   * @param data The storage to take over (r-value).
    * @param orientation The vector's orientation (default: COLUMN).
    * @throws std::invalid_argument if size is zero or data size
    * mismatches.
    */
-  Vector(size_t size, std::vector<T> &&data, Orientation orientation = COLUMN);
+  Vector(size_t size, storage_type &&data, Orientation orientation = COLUMN);
 
   /**
    * @brief Constructs from a std::array by copying its data.
@@ -98,6 +116,13 @@ class Vector {
   template <Numeric U>
   [[nodiscard]] Vector(const Vector<U> &other);
 
+  /**
+   * @brief Evaluates an element-wise expression (see Expressions.hpp) in one pass.
+   * @tparam E A vector expression, e.g. `lazy(x) * 2.0 + y`.
+   */
+  template <VectorExpression E>
+  Vector(const E &expression);
+
   // --- Iterators ---
   /** @brief Returns an iterator to the beginning. */
   [[nodiscard]] auto begin() noexcept { return _data.begin(); }
@@ -145,18 +170,18 @@ class Vector {
   [[nodiscard]] T *data() noexcept { return _data.data(); }
 
   /**
-   * @brief Gets a const reference to the underlying std::vector data
+   * @brief Gets a const reference to the underlying aligned std::vector data
    * store.
-   * @return const std::vector<T>&
+   * @return const storage_type&
    */
-  [[nodiscard]] const std::vector<T> &data_vector() const noexcept { return _data; }
+  [[nodiscard]] const storage_type &data_vector() const noexcept { return _data; }
 
   /**
-   * @brief Gets a mutable reference to the underlying std::vector
+   * @brief Gets a mutable reference to the underlying aligned std::vector
    * data store.
-   * @return std::vector<T>&
+   * @return storage_type&
    */
-  [[nodiscard]] std::vector<T> &data_vector() noexcept { return _data; }
+  [[nodiscard]] storage_type &data_vector() noexcept { return _data; }
 
   /** @brief Gets the number of elements in the vector. */
   [[nodiscard]] size_t size() const noexcept { return _data.size(); }
@@ -255,6 +280,29 @@ class Vector {
    * this one. */
   [[nodiscard]] Vector<T> transposed() const noexcept;
 
+  /**
+   * @brief Applies f to every element and returns the results as a new vector.
+   * @details SIMD-vectorized and parallelized above tuning().omp_linear_limit when f is
+   * a maf::math::vmath function object or wrapped in vmath::vectorized(); any other f
+   * is called in order on the calling thread.
+   * @return `Vector<R>` with the same orientation, where R is the type returned by f.
+   */
+  template <std::invocable<const T &> F>
+  [[nodiscard]] auto map(F f) const;
+
+  /**
+   * @brief Combines this vector with another element by element: f(a[i], b[i]).
+   * @return `Vector<R>` with the same orientation, where R is the type returned by f.
+   * @throws std::invalid_argument if dimensions or orientations do not
+   * match.
+   */
+  template <Numeric U, std::invocable<const T &, const U &> F>
+  [[nodiscard]] auto zip_map(const Vector<U> &other, F f) const;
+
+  /** @brief Replaces every element x with f(x); the result is converted back to T. */
+  template <std::invocable<const T &> F>
+  Vector &apply_inplace(F f);
+
   // --- Operators ---
 
   /**
@@ -351,6 +399,28 @@ class Vector {
   template <Numeric U>
   auto operator-=(const U &scalar) noexcept;
 
+  /**
+   * @brief Evaluates an element-wise expression into this vector.
+   * @details Reuses the existing buffer when the size matches and takes the
+   * orientation of the expression. The expression may reference this vector.
+   */
+  template <VectorExpression E>
+  Vector<T> &operator=(const E &expression);
+
+  /**
+   * @brief Adds an element-wise expression to this vector in one pass.
+   * @throws std::invalid_argument if dimensions or orientations do not match.
+   */
+  template <VectorExpression E>
+  Vector<T> &operator+=(const E &expression);
+
+  /**
+   * @brief Subtracts an element-wise expression from this vector in one pass.
+   * @throws std::invalid_argument if dimensions or orientations do not match.
+   */
+  template <VectorExpression E>
+  Vector<T> &operator-=(const E &expression);
+
   /**
    * @brief Element-wise scalar multiplication (Vector * scalar).
    * @tparam U An arithmetic scalar type.
@@ -463,28 +533,24 @@ class Vector {
   Orientation _orientation;
 
   /** @brief Internal contiguous storage for the vector elements. */
-  std::vector<T> _data;
+  storage_type _data;
 
   /**
    * @brief Internal helper to invert the sign of all elements in-place.
    */
   void _invert_sign() {
-    if (_data.size() > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-      for (size_t i = 0; i < _data.size(); ++i) {
-        _data[i] = -_data[i];
-      }
-    } else {
+    exec::parallel_for(0, _data.size(), linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-      for (size_t i = 0; i < _data.size(); ++i) {
+      for (size_t i = lo; i < hi; ++i) {
         _data[i] = -_data[i];
       }
-    }
+    });
   }
 };
 
 }  // namespace maf::math
 
+#include "Expressions.hpp"
 #include "VectorCheckers.hpp"
 #include "VectorConstructors.hpp"
 #include "VectorMethods.hpp"
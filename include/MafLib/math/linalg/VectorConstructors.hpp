@@ -11,13 +11,24 @@
  * should not be included directly anywhere else.
  */
 namespace maf::math {
-// Constructs an uninitialized vector of size size.
+// Constructs a zero-filled vector of size size.
 template <Numeric T>
 Vector<T>::Vector(size_t size, Orientation orientation) : _orientation(orientation) {
     if (size == 0) {
         throw std::invalid_argument("Vector size must be greater than zero.");
     }
     _data.resize(size);
+    util::parallel_fill(_data.data(), size, T(0));
+}
+
+// Constructs a vector of size size without initializing elements.
+template <Numeric T>
+Vector<T>::Vector(size_t size, util::uninitialized_t, Orientation orientation)
+    : _orientation(orientation) {
+    if (size == 0) {
+        throw std::invalid_argument("Vector size must be greater than zero.");
+    }
+    _data.resize(size);  // Default-initialized by the allocator
 }
 
 // Constructs a vector from a raw data pointer.
@@ -47,12 +58,12 @@ Vector<T>::Vector(size_t size, const std::vector<U>& data, Orientation orientati
     if (data.size() != size) {
         throw std::invalid_argument("Data size does not match vector size.");
     }
-    _data = data;
+    _data.assign(data.begin(), data.end());
 }
 
-// Constructs from a std::vector, move constructor
+// Adopts aligned storage without copying it.
 template <Numeric T>
-Vector<T>::Vector(size_t size, std::vector<T>&& data, Orientation orientation)
+Vector<T>::Vector(size_t size, storage_type&& data, Orientation orientation)
     : _orientation(orientation) {
     if (size == 0) {
         throw std::invalid_argument("Vector size must be greater than zero.");
@@ -85,7 +96,15 @@ template <Numeric T>
 template <Numeric U>
 Vector<T>::Vector(const Vector<U>& other)
     : _orientation(other.orientation()),
-      _data(other.data().begin(), other.data().end()) {}
+      _data(other.begin(), other.end()) {}
+
+// Evaluates an element-wise expression in one pass.
+template <Numeric T>
+template <VectorExpression E>
+Vector<T>::Vector(const E& expression) : _orientation(expression.shape().orientation) {
+    _data.resize(expression.shape().size());
+    expr::assign<expr::AssignOp::Assign>(_data.data(), expression);
+}
 
 }  // namespace maf::math
 
@@ -7,35 +7,17 @@ namespace maf::math {
 // Inplace fill
 template <Numeric T>
 void Vector<T>::fill(T value) noexcept {
-    if (_data.size() > OMP_LINEAR_LIMIT) {
-        #pragma omp parallel for
-        for (size_t i = 0; i < _data.size(); ++i) {
-            _data[i] = value;
-        }
-    } else {
-        for (size_t i = 0; i < _data.size(); ++i) {
-            _data[i] = value;
-        }
-    }
+    exec::parallel_for(0, _data.size(), linear_split(), [&](size_t lo, size_t hi) {
+        std::fill(_data.begin() + lo, _data.begin() + hi, value);
+    });
 }
 
 // L2 Norm
 template <Numeric T>
 [[nodiscard]] T Vector<T>::norm() const noexcept {
-    T sum = 0.0;
-    size_t n = _data.size();
-    if (n > OMP_LINEAR_LIMIT) {
-        #pragma omp parallel for reduction(+:sum)
-        for (size_t i = 0; i < n; ++i) {
-            sum += _data[i] * _data[i];
-        }
-    } else {
-        #pragma omp simd
-        for (size_t i = 0; i < n; ++i) {
-            sum += _data[i] * _data[i];
-        }
-    }
-    return std::sqrt(sum);
+    using R = accumulation_t<T>;
+    R sum = kernels::sum_squares_n<R>(_data.size(), _data.data(), 1);
+    return static_cast<T>(std::sqrt(sum));
 }
 
 // Inplace normalize with L2 norm
@@ -49,17 +31,12 @@ void Vector<T>::normalize() {
     T norm_inv = T(1) / norm;
     size_t n = _data.size();
 
-    if (n > OMP_LINEAR_LIMIT) {
-        #pragma omp parallel for
-        for (size_t i = 0; i < n; ++i) {
-            _data[i] *= norm_inv;
-        }
-    } else {
+    exec::parallel_for(0, n, linear_split(), [&](size_t lo, size_t hi) {
         #pragma omp simd
-        for (size_t i = 0; i < n; ++i) {
+        for (size_t i = lo; i < hi; ++i) {
             _data[i] *= norm_inv;
         }
-    }
+    });
 }
 
 // Inplace transpose
@@ -71,8 +48,38 @@ void Vector<T>::transpose() noexcept {
 // Creates new transposed vector
 template <Numeric T>
 [[nodiscard]] Vector<T> Vector<T>::transposed() const noexcept {
-    Orientation new_orientation = (_orientation == COLUMN) ? ROW : COLUMN;
-    return Vector<T>(this->size(), _data, new_orientation);
+    Vector<T> result(*this);
+    result.transpose();
+    return result;
+}
+
+// Element-wise map into a new vector
+template <Numeric T>
+template <std::invocable<const T &> F>
+[[nodiscard]] auto Vector<T>::map(F f) const {
+    Vector<map_result_t<F, T>> result(size(), util::uninitialized, _orientation);
+    kernels::map_n(size(), _data.data(), 1, result.data(), 1, f);
+    return result;
+}
+
+// Element-wise combination of two vectors
+template <Numeric T>
+template <Numeric U, std::invocable<const T &, const U &> F>
+[[nodiscard]] auto Vector<T>::zip_map(const Vector<U> &other, F f) const {
+    if (_orientation != other.orientation() || size() != other.size()) {
+        throw std::invalid_argument("Vectors must be same orientation and size!");
+    }
+    Vector<map_result_t<F, T, U>> result(size(), util::uninitialized, _orientation);
+    kernels::zip_map_n(size(), _data.data(), 1, other.data(), 1, result.data(), 1, f);
+    return result;
+}
+
+// Inplace element-wise map
+template <Numeric T>
+template <std::invocable<const T &> F>
+Vector<T> &Vector<T>::apply_inplace(F f) {
+    kernels::map_n(size(), _data.data(), 1, _data.data(), 1, f);
+    return *this;
 }
 
 }  // namespace maf::math
@@ -36,18 +36,13 @@ template <Numeric U>
   }
 
   size_t n = _data.size();
-  Vector<R> result(n, _orientation);
-  if (n > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < n; ++i) {
-      result[i] = static_cast<R>(_data[i]) + static_cast<R>(other[i]);
-    }
-  } else {
+  Vector<R> result(n, util::uninitialized, _orientation);
+  exec::parallel_for(0, n, linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < n; ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       result[i] = static_cast<R>(_data[i]) + static_cast<R>(other[i]);
     }
-  }
+  });
   return result;
 }
 
@@ -60,18 +55,13 @@ template <Numeric U>
   R r_scalar = static_cast<R>(scalar);
   size_t n = _data.size();
 
-  Vector<R> result(n, _orientation);
-  if (n > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < n; ++i) {
-      result[i] = static_cast<R>(_data[i]) + r_scalar;
-    }
-  } else {
+  Vector<R> result(n, util::uninitialized, _orientation);
+  exec::parallel_for(0, n, linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < n; ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       result[i] = static_cast<R>(_data[i]) + r_scalar;
     }
-  }
+  });
   return result;
 }
 
@@ -96,17 +86,12 @@ auto Vector<T>::operator+=(const Vector<U> &other) {
   }
 
   size_t n = _data.size();
-  if (n > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < n; ++i) {
-      _data[i] += static_cast<T>(other[i]);
-    }
-  } else {
+  exec::parallel_for(0, n, linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < n; ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       _data[i] += static_cast<T>(other[i]);
     }
-  }
+  });
   return *this;
 }
 
@@ -119,17 +104,12 @@ auto Vector<T>::operator+=(const U &scalar) noexcept {
   R r_scalar = static_cast<R>(scalar);
   size_t n = _data.size();
 
-  if (n > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < n; ++i) {
-      _data[i] += r_scalar;
-    }
-  } else {
+  exec::parallel_for(0, n, linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < n; ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       _data[i] += r_scalar;
     }
-  }
+  });
   return *this;
 }
 
@@ -144,18 +124,13 @@ template <Numeric U>
   }
 
   size_t n = _data.size();
-  Vector<R> result(n, _orientation);
-  if (n > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < n; ++i) {
-      result[i] = static_cast<R>(_data[i]) - static_cast<R>(other[i]);
-    }
-  } else {
+  Vector<R> result(n, util::uninitialized, _orientation);
+  exec::parallel_for(0, n, linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < n; ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       result[i] = static_cast<R>(_data[i]) - static_cast<R>(other[i]);
     }
-  }
+  });
   return result;
 }
 
@@ -168,18 +143,13 @@ template <Numeric U>
   R r_scalar = static_cast<R>(scalar);
   size_t n = _data.size();
 
-  Vector<R> result(n, _orientation);
-  if (n > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < n; ++i) {
-      result[i] = static_cast<R>(_data[i]) - r_scalar;
-    }
-  } else {
+  Vector<R> result(n, util::uninitialized, _orientation);
+  exec::parallel_for(0, n, linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < n; ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       result[i] = static_cast<R>(_data[i]) - r_scalar;
     }
-  }
+  });
   return result;
 }
 
@@ -197,18 +167,13 @@ template <Numeric T, Numeric U>
   R r_scalar = static_cast<R>(scalar);
   size_t n = vec.size();
 
-  Vector<R> result(n, vec.orientation());
-  if (n > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < n; ++i) {
-      result[i] = r_scalar - static_cast<R>(vec[i]);
-    }
-  } else {
+  Vector<R> result(n, util::uninitialized, vec.orientation());
+  exec::parallel_for(0, n, linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < n; ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       result[i] = r_scalar - static_cast<R>(vec[i]);
     }
-  }
+  });
   return result;
 }
 
@@ -221,17 +186,12 @@ auto Vector<T>::operator-=(const Vector<U> &other) {
   }
 
   size_t n = _data.size();
-  if (n > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < n; ++i) {
-      _data[i] -= static_cast<T>(other[i]);
-    }
-  } else {
+  exec::parallel_for(0, n, linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < n; ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       _data[i] -= static_cast<T>(other[i]);
     }
-  }
+  });
   return *this;
 }
 
@@ -244,17 +204,54 @@ auto Vector<T>::operator-=(const U &scalar) noexcept {
   R r_scalar = static_cast<R>(scalar);
   size_t n = _data.size();
 
-  if (n > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < n; ++i) {
-      _data[i] -= r_scalar;
-    }
-  } else {
+  exec::parallel_for(0, n, linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < n; ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       _data[i] -= r_scalar;
     }
+  });
+  return *this;
+}
+
+// Evaluate an element-wise expression into this vector
+template <Numeric T>
+template <VectorExpression E>
+Vector<T> &Vector<T>::operator=(const E &expression) {
+  const expr::VectorShape shape = expression.shape();
+  if (shape.size() != _data.size()) {
+    // Operands are still alive, only this buffer is replaced.
+    storage_type data;
+    data.resize(shape.size());
+    expr::assign<expr::AssignOp::Assign>(data.data(), expression);
+    _data = std::move(data);
+  } else {
+    expr::assign<expr::AssignOp::Assign>(_data.data(), expression);
+  }
+  _orientation = shape.orientation;
+  return *this;
+}
+
+// Add an element-wise expression to this vector
+template <Numeric T>
+template <VectorExpression E>
+Vector<T> &Vector<T>::operator+=(const E &expression) {
+  if (_orientation != expression.shape().orientation ||
+      _data.size() != expression.shape().size()) {
+    throw std::invalid_argument("Vectors must be same orientation and size!");
+  }
+  expr::assign<expr::AssignOp::AddAssign>(_data.data(), expression);
+  return *this;
+}
+
+// Subtract an element-wise expression from this vector
+template <Numeric T>
+template <VectorExpression E>
+Vector<T> &Vector<T>::operator-=(const E &expression) {
+  if (_orientation != expression.shape().orientation ||
+      _data.size() != expression.shape().size()) {
+    throw std::invalid_argument("Vectors must be same orientation and size!");
   }
+  expr::assign<expr::AssignOp::SubAssign>(_data.data(), expression);
   return *this;
 }
 
@@ -267,18 +264,13 @@ template <Numeric U>
   R r_scalar = static_cast<R>(scalar);
   size_t n = _data.size();
 
-  Vector<R> result(n, _orientation);
-  if (n > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < n; ++i) {
-      result[i] = static_cast<R>(_data[i]) * r_scalar;
-    }
-  } else {
+  Vector<R> result(n, util::uninitialized, _orientation);
+  exec::parallel_for(0, n, linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < n; ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       result[i] = static_cast<R>(_data[i]) * r_scalar;
     }
-  }
+  });
   return result;
 }
 
@@ -303,17 +295,12 @@ auto Vector<T>::operator*=(const U &scalar) noexcept {
   R r_scalar = static_cast<R>(scalar);
   size_t n = _data.size();
 
-  if (n > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < n; ++i) {
-      _data[i] *= r_scalar;
-    }
-  } else {
+  exec::parallel_for(0, n, linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < n; ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       _data[i] *= r_scalar;
     }
-  }
+  });
   return *this;
 }
 
@@ -326,31 +313,16 @@ template <Numeric U>
     throw std::invalid_argument("Vectors must be of same size!");
   }
 
-#if defined(__APPLE__) && defined(ACCELERATE_AVAILABLE)
-  if constexpr (std::is_same_v<T, U>) {
-    if constexpr (std::is_same_v<T, double>) {
-      return acc::ddot(_data, other.data());
-    } else if constexpr (std::is_same_v<T, float>) {
-      return acc::sdot(_data, other.data());
-    }
+#if defined(MAF_BLAS_AVAILABLE)
+  if constexpr (std::is_same_v<T, U> && blas::supports<T>) {
+    return blas::dot(n, _data.data(), 1, other.data(), 1);
   }
 #endif
 
-  using R = std::common_type_t<T, U>;
+  // 16-bit floats accumulate and return in float.
+  using R = accumulation_t<std::common_type_t<T, U>>;
 
-  R result(0);
-  if (n > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for reduction(+ : result)
-    for (size_t i = 0; i < n; ++i) {
-      result += static_cast<R>(_data[i]) * static_cast<R>(other[i]);
-    }
-  } else {
-#pragma omp simd reduction(+ : result)
-    for (size_t i = 0; i < n; ++i) {
-      result += static_cast<R>(_data[i]) * static_cast<R>(other[i]);
-    }
-  }
-  return result;
+  return kernels::dot_n<R>(n, _data.data(), 1, other.data(), 1);
 }
 
 // Vector * Vector -> Scalar
@@ -385,24 +357,16 @@ template <Numeric U>
   }
   switch (_orientation) {
     case COLUMN: {
-      Matrix<R> result(n, m);
-      if (n * m > OMP_QUADRATIC_LIMIT) {
-#pragma omp parallel for
-        for (size_t i = 0; i < n; ++i) {
-          for (size_t j = 0; j < m; ++j) {
-            result.data()[(i * m) + j] =
-                static_cast<R>(_data[i]) * static_cast<R>(other[j]);
-          }
-        }
-      } else {
-        for (size_t i = 0; i < n; ++i) {
+      Matrix<R> result(n, m, util::uninitialized);
+      exec::parallel_for(0, n, quadratic_split(n * m), [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
 #pragma omp simd
           for (size_t j = 0; j < m; ++j) {
             result.data()[(i * m) + j] =
                 static_cast<R>(_data[i]) * static_cast<R>(other[j]);
           }
         }
-      }
+      });
 
       return result;
     }
@@ -438,36 +402,37 @@ template <Numeric U>
         "Did you mean Matrix * Vector?");
   }
 
-#if defined(__APPLE__) && defined(ACCELERATE_AVAILABLE)
-  if constexpr (std::is_same_v<R, float>) {
-    return Vector<R>(r,
-                     acc::sgevmm(m, r, util::convert_if_needed<R>(other.data_vector()),
-                                 util::convert_if_needed<R>(_data)),
-                     ROW);
-
-  } else if constexpr (std::is_same_v<R, double>) {
-    return Vector<R>(r,
-                     acc::dgevmm(m, r, util::convert_if_needed<R>(other.data_vector()),
-                                 util::convert_if_needed<R>(_data)),
-                     ROW);
+#if defined(MAF_BLAS_AVAILABLE)
+  if constexpr (std::is_same_v<T, R> && std::is_same_v<U, R> && blas::supports<R>) {
+    // x^T * A == A^T * x
+    Vector<R> result(r, util::uninitialized, ROW);
+    blas::gemv(blas::Trans::Trans, m, r, R(1), other.data(), r, _data.data(), 1, R(0),
+               result.data(), 1);
+    return result;
   }
 #endif
 
-  Vector<R> result(r, std::vector<R>(r), ROW);
-  if (n * m >= OMP_QUADRATIC_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < r; ++i) {
-      for (size_t j = 0; j < n; ++j) {
-        result[i] += _data[j] * other.at(j, i);
-      }
-    }
-  } else {
-    for (size_t i = 0; i < r; ++i) {
+  // Row-wise axpy keeps the reads of A contiguous; mixed types are converted on the
+  // fly. Threads own disjoint column blocks of the result, sized to stay in L1.
+  constexpr size_t COLUMN_BLOCK = 512;
+  Vector<R> result(r, ROW);
+  R *y = result.data();
+  const U *a = other.data();
+  const size_t blocks = (r + COLUMN_BLOCK - 1) / COLUMN_BLOCK;
+  exec::parallel_for(0, blocks, quadratic_split(n * r), [&](size_t b0, size_t b1) {
+    for (size_t block = b0; block < b1; ++block) {
+      const size_t begin = block * COLUMN_BLOCK;
+      const size_t end = std::min(begin + COLUMN_BLOCK, r);
       for (size_t j = 0; j < n; ++j) {
-        result[i] += _data[j] * other.at(j, i);
+        const R x_j = static_cast<R>(_data[j]);
+        const U *row = a + (j * r);
+#pragma omp simd
+        for (size_t i = begin; i < end; ++i) {
+          y[i] += x_j * static_cast<R>(row[i]);
+        }
       }
     }
-  }
+  });
   return result;
 }
 
@@ -482,18 +447,13 @@ template <Numeric U>
   R r_scalar_inv = R(1) / static_cast<R>(scalar);
   size_t n = _data.size();
 
-  Vector<R> result(n, _orientation);
-  if (n > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < n; ++i) {
-      result[i] = static_cast<R>(_data[i]) * r_scalar_inv;
-    }
-  } else {
+  Vector<R> result(n, util::uninitialized, _orientation);
+  exec::parallel_for(0, n, linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < n; ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       result[i] = static_cast<R>(_data[i]) * r_scalar_inv;
     }
-  }
+  });
   return result;
 }
 
@@ -513,18 +473,13 @@ template <Numeric T, Numeric U>
   R r_scalar = static_cast<R>(scalar);
   size_t n = vec.size();
 
-  Vector<R> result(n, vec.orientation());
-  if (n > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < n; ++i) {
-      result[i] = r_scalar / static_cast<R>(vec[i]);
-    }
-  } else {
+  Vector<R> result(n, util::uninitialized, vec.orientation());
+  exec::parallel_for(0, n, linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-    for (size_t i = 0; i < n; ++i) {
+    for (size_t i = lo; i < hi; ++i) {
       result[i] = r_scalar / static_cast<R>(vec[i]);
     }
-  }
+  });
   return result;
 }
 
@@ -538,31 +493,21 @@ auto Vector<T>::operator/=(const U &scalar) noexcept {
   if constexpr (std::is_floating_point_v<R>) {
     R r_scalar_inv = R(1) / static_cast<R>(scalar);
 
-    if (n > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-      for (size_t i = 0; i < n; ++i) {
-        _data[i] *= r_scalar_inv;
-      }
-    } else {
+    exec::parallel_for(0, n, linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-      for (size_t i = 0; i < n; ++i) {
+      for (size_t i = lo; i < hi; ++i) {
         _data[i] *= r_scalar_inv;
       }
-    }
+    });
   } else {
     R r_scalar = static_cast<R>(scalar);
 
-    if (n > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for
-      for (size_t i = 0; i < n; ++i) {
-        _data[i] /= r_scalar;
-      }
-    } else {
+    exec::parallel_for(0, n, linear_split(), [&](size_t lo, size_t hi) {
 #pragma omp simd
-      for (size_t i = 0; i < n; ++i) {
+      for (size_t i = lo; i < hi; ++i) {
         _data[i] /= r_scalar;
       }
-    }
+    });
   }
   return *this;
 }
@@ -33,21 +33,14 @@ auto operator*(V &x, T &A) {
         "Inner dimensions do not match for Vector-Matrix multiplication!");
   }
 
-  using T_type = typename T::value_type;
-  using V_type = typename V::value_type;
-
-  if constexpr (std::is_same_v<V, VectorView<V_type>> &&
-                std::is_same_v<T, MatrixView<T_type>>) {
+  if constexpr (VectorViewType<V> && MatrixViewType<T>) {
     return kernels::gemv(kernels::OP::Trans, A, x);
-  } else if constexpr (std::is_same_v<V, VectorView<V_type>>) {
-    return kernels::gemv(kernels::OP::Trans,
-                         A.view(0, 0, A.row_count(), A.column_count()), x);
-  } else if constexpr (std::is_same_v<T, MatrixView<T_type>>) {
+  } else if constexpr (VectorViewType<V>) {
+    return kernels::gemv(kernels::OP::Trans, A.view(), x);
+  } else if constexpr (MatrixViewType<T>) {
     return kernels::gemv(kernels::OP::Trans, A, x.view(0, x.size()));
   } else {
-    return kernels::gemv(kernels::OP::Trans,
-                         A.view(0, 0, A.row_count(), A.column_count()),
-                         x.view(0, x.size()));
+    return kernels::gemv(kernels::OP::Trans, A.view(), x.view(0, x.size()));
   }
 }
 
@@ -70,8 +63,6 @@ auto operator*(const V &x, const T &y) {
     throw std::invalid_argument("Dimensions do not match!");
   }
 
-  using T_type = typename T::value_type;
-  using V_type = typename V::value_type;
   if (x.orientation() == y.orientation() || x.orientation() == COLUMN) {
     throw std::invalid_argument(
         "Invalid multiplication: Vectors must be of different orientations (row x "
@@ -80,12 +71,11 @@ auto operator*(const V &x, const T &y) {
         "orientations.");
   }
 
-  if constexpr (std::is_same_v<V, VectorView<V_type>> &&
-                std::is_same_v<T, VectorView<T_type>>) {
+  if constexpr (VectorViewType<V> && VectorViewType<T>) {
     return kernels::dot(x, y);
-  } else if constexpr (std::is_same_v<V, VectorView<V_type>>) {
+  } else if constexpr (VectorViewType<V>) {
     return kernels::dot(x, y.view(0, y.size()));
-  } else if constexpr (std::is_same_v<T, VectorView<T_type>>) {
+  } else if constexpr (VectorViewType<T>) {
     return kernels::dot(x.view(0, x.size()), y);
   } else {
     return kernels::dot(x.view(0, x.size()), y.view(0, y.size()));
@@ -1,23 +1,132 @@
 #ifndef VIEW_KERNELS_H
 #define VIEW_KERNELS_H
 #pragma once
-#include "AccelerateWrappers/AccelerateWrapper.hpp"
+#include "BlasWrappers/BlasWrapper.hpp"
 #include "Matrix.hpp"
 #include "MatrixView.hpp"
+#include "MafLib/utility/Memory.hpp"
 #include "Vector.hpp"
 #include "VectorView.hpp"
 
 namespace maf::math::kernels {
 enum class OP : uint8 { NoTrans, Trans };
+/** @brief Triangle of a symmetric or triangular matrix that is referenced. */
+enum class UPLO : uint8 { Upper, Lower };
+/** @brief Whether a triangular matrix has an implicit unit diagonal. */
+enum class DIAG : uint8 { NonUnit, Unit };
 
 namespace detail {
-template <Numeric T, Numeric U, Numeric R = std::common_type_t<T, U>>
-void no_trans_gemv(const MatrixView<T> &A, const VectorView<U> &x, Vector<R> &y);
+/** @brief Rows handled together by the level-2 kernels; x/y are streamed once per
+ * group instead of once per row. */
+inline constexpr size_t LEVEL2_ROW_UNROLL = 4;
 
-template <Numeric T, Numeric U, Numeric R = std::common_type_t<T, U>>
-void trans_gemv(const VectorView<T> &x, const MatrixView<U> &A, Vector<R> &y);
+template <typename R, Numeric U>
+const R *contiguous(const VectorView<U> &x, util::AlignedVector<R> &buffer);
+
+template <Numeric T>
+MatrixView<const std::remove_const_t<T>> row_contiguous(
+    const MatrixView<T> &A, bool &transposed,
+    util::AlignedVector<std::remove_const_t<T>> &buffer);
+
+template <Numeric T>
+size_t leading_dimension(const MatrixView<T> &A) noexcept;
+
+[[nodiscard]] constexpr OP flip(OP op) noexcept {
+  return (op == OP::Trans) ? OP::NoTrans : OP::Trans;
+}
+
+[[nodiscard]] constexpr UPLO flip(UPLO uplo) noexcept {
+  return (uplo == UPLO::Upper) ? UPLO::Lower : UPLO::Upper;
+}
+
+template <typename R, Numeric V>
+void scale_store(size_t n, R alpha, const R *acc, R beta, VectorView<V> &y);
+
+template <typename R, Numeric T>
+void no_trans_gemv(const MatrixView<T> &A, const R *x, R *acc);
+
+template <typename R, Numeric T>
+void trans_gemv(const MatrixView<T> &A, const R *x, R *acc);
+
+template <typename R, Numeric T>
+void symv(UPLO uplo, const MatrixView<T> &A, const R *x, R *acc);
+
+template <typename R, Numeric T>
+void trsv(UPLO uplo, OP trans, DIAG diag, const MatrixView<T> &A, R *x);
+
+template <typename R, Numeric T>
+void trsm(UPLO uplo, DIAG diag, const MatrixView<T> &A, MatrixView<R> B);
 }  // namespace detail
 
+#pragma mark level2
+//=============================================================================
+// LEVEL 2
+//=============================================================================
+/** @brief General matrix-vector multiplication (GEMV) into a caller-owned view.
+ * Computes y = alpha * op(A) * x + beta * y without allocating the result. All
+ * operands may be strided sub-views.
+ * @tparam T Numeric type of matrix A.
+ * @tparam U Numeric type of vector x.
+ * @tparam V Numeric type of vector y.
+ *
+ * @attention If all three types are the same floating-point type, the function will
+ * attempt to use the optimized BLAS gemv if available. Otherwise it falls back to
+ * row-oriented kernels that read A with unit stride for both op(A) = A and A^T.
+ * A view with contiguous columns (column-major, or a transposed view) is read as its
+ * transpose with the opposite op; only a view with no unit stride at all is packed.
+ * @attention y must not overlap A or x.
+ *
+ * @param trans Specifies whether to transpose matrix A.
+ * @param alpha The scalar multiplier of op(A) * x.
+ * @param A The input matrix.
+ * @param x The input vector.
+ * @param beta The scalar multiplier of y. When zero, y is not read.
+ * @param y The output vector, updated in-place.
+ * @throws std::invalid_argument if dimensions of op(A), x and y do not match.
+ */
+template <Numeric T, Numeric U, Numeric V>
+  requires(!std::is_const_v<V>)
+void gemv(OP trans, double alpha, const MatrixView<T> &A, const VectorView<U> &x,
+          double beta, VectorView<V> y) {
+  using T_value_type = std::remove_cvref_t<T>;
+  using U_value_type = std::remove_cvref_t<U>;
+  using R = accumulation_t<std::common_type_t<T_value_type, U_value_type, V>>;
+
+  const bool transposed = trans == OP::Trans;
+  const size_t in_size = transposed ? A.row_count() : A.column_count();
+  const size_t out_size = transposed ? A.column_count() : A.row_count();
+  if (x.size() != in_size || y.size() != out_size) {
+    throw std::invalid_argument("Dimensions do not match for gemv!");
+  }
+
+  bool flipped = false;
+  util::AlignedVector<T_value_type> a_buffer;
+  const auto Ar = detail::row_contiguous(A, flipped, a_buffer);
+  const bool read_rows_as_columns = transposed != flipped;
+
+#if defined(MAF_BLAS_AVAILABLE)
+  if constexpr (std::is_same_v<T_value_type, R> && std::is_same_v<U_value_type, R> &&
+                std::is_same_v<V, R> && blas::supports<R>) {
+    blas::gemv(read_rows_as_columns ? blas::Trans::Trans : blas::Trans::NoTrans,
+               Ar.row_count(), Ar.column_count(), static_cast<R>(alpha), Ar.data(),
+               detail::leading_dimension(Ar), x.data(), x.get_increment(),
+               static_cast<R>(beta), y.data(), y.get_increment());
+    return;
+  }
+#endif
+
+  util::AlignedVector<R> x_buffer;
+  util::AlignedVector<R> acc(out_size);
+  const R *xp = detail::contiguous<R>(x, x_buffer);
+  if (read_rows_as_columns) {
+    detail::trans_gemv(Ar, xp, acc.data());
+  } else {
+    detail::no_trans_gemv(Ar, xp, acc.data());
+  }
+  detail::scale_store(out_size, static_cast<R>(alpha), acc.data(),
+                      static_cast<R>(beta), y);
+}
+
 /** @brief General matrix-vector multiplication (GEMV).
  * @tparam T Numeric type of matrix A.
  * @tparam U Numeric type of vector x.
@@ -30,6 +139,7 @@ void trans_gemv(const VectorView<T> &x, const MatrixView<U> &A, Vector<R> &y);
  * @param A The input matrix.
  * @param x The input vector.
  * @return The resulting vector y = A * x or y = A^T * x.
+ * @throws std::invalid_argument if dimensions of op(A) and x do not match.
  */
 template <Numeric T, Numeric U>
 auto gemv(OP trans, const MatrixView<T> &A, const VectorView<U> &x) {
@@ -38,85 +148,384 @@ auto gemv(OP trans, const MatrixView<T> &A, const VectorView<U> &x) {
   using R = std::common_type_t<T_value_type, U_value_type>;
 
   size_t out_size = (trans == OP::NoTrans) ? A.row_count() : A.column_count();
-  Vector<R> y(out_size, (trans == OP::NoTrans) ? COLUMN : ROW);
-
-#if defined(__APPLE__) && defined(ACCELERATE_AVAILABLE)
-  if constexpr (std::is_same_v<T_value_type, float> &&
-                std::is_same_v<U_value_type, float>) {
-    // https://developer.apple.com/documentation/accelerate/cblas_sgemv(_:_:_:_:_:_:_:_:_:_:_:_:)?language=objc
-    CBLAS_TRANSPOSE blas_trans = (trans == OP::NoTrans) ? CblasNoTrans : CblasTrans;
-    cblas_sgemv(CblasRowMajor, blas_trans, (int)A.row_count(), (int)A.column_count(),
-                1.0F, A.data(), (int)A.get_stride(), x.data(), (int)x.get_increment(),
-                0.0F, y.data(), 1);
-    return y;
-  } else if constexpr (std::is_same_v<T_value_type, double> &&
-                       std::is_same_v<U_value_type, double>) {
-    // https://developer.apple.com/documentation/accelerate/cblas_dgemv(_:_:_:_:_:_:_:_:_:_:_:_:)?language=objc
-    CBLAS_TRANSPOSE blas_trans = (trans == OP::NoTrans) ? CblasNoTrans : CblasTrans;
-    cblas_dgemv(CblasRowMajor, blas_trans, (int)A.row_count(), (int)A.column_count(),
-                1.0, A.data(), (int)A.get_stride(), x.data(), (int)x.get_increment(),
-                0.0, y.data(), 1);
-    return y;
-  }
-#endif
-
-  if (trans == OP::NoTrans) {
-    detail::no_trans_gemv(A, x, y);
-
-  } else {
-    detail::trans_gemv(x, A, y);
-  }
+  Vector<R> y(out_size, util::uninitialized, (trans == OP::NoTrans) ? COLUMN : ROW);
+  gemv(trans, 1.0, A, x, 0.0, VectorView<R>(y.data(), out_size, y.orientation()));
   return y;
 }
 
-/** @brief General rank-1 update (GER).
+/** @brief General rank-1 update (GER), A = A + alpha * x * y^T.
  * @tparam T Numeric type of matrix A.
- * @tparam U Numeric type of vectors x and y.
+ * @tparam U Numeric type of vector x.
+ * @tparam W Numeric type of vector y.
  *
- * @attention If types of VectorView and MatrixView are the same and are floating-point
- * types, the function will attempt to use optimized BLAS routines if available
- * Otherwise, it will fall back to a manual implementation.
+ * @attention If all types are the same and are floating-point types, the function
+ * will attempt to use optimized BLAS routines if available. Otherwise, it will fall
+ * back to a manual implementation that packs y once and updates each row of A with a
+ * single vectorized axpy. A view with contiguous columns is updated as A^T += y * x^T.
  *
- * @param A The input matrix to be updated in-place.
+ * @param A The input matrix to be updated in-place. Taken by value so that sub-views
+ * can be passed directly.
  * @param x The first input vector.
  * @param y The second input vector.
  * @param alpha The scalar multiplier for the rank-1 update (default is 1.0).
+ * @throws std::invalid_argument if dimensions of A, x and y do not match.
  */
-template <Numeric T, Numeric U>
-void ger(MatrixView<T> &A, const VectorView<U> &x, const VectorView<U> &y,
+template <Numeric T, Numeric U, Numeric W>
+  requires(!std::is_const_v<T>)
+void ger(MatrixView<T> A, const VectorView<U> &x, const VectorView<W> &y,
          double alpha = 1.0) {
+  using U_value_type = std::remove_cvref_t<U>;
+  using W_value_type = std::remove_cvref_t<W>;
+  using R = accumulation_t<std::common_type_t<T, U_value_type, W_value_type>>;
+
+  const size_t m = A.row_count();
+  const size_t n = A.column_count();
+  if (x.size() != m || y.size() != n) {
+    throw std::invalid_argument("Dimensions do not match for ger!");
+  }
+  if (A.column_stride() != 1) {
+    if (A.row_stride() == 1) {
+      ger(A.transposed_view(), y, x, alpha);
+      return;
+    }
+    const R a = static_cast<R>(alpha);
+    for (size_t i = 0; i < m; ++i) {
+      const R axi = a * static_cast<R>(x[i]);
+      for (size_t j = 0; j < n; ++j) {
+        A[i, j] = static_cast<T>(static_cast<R>(A[i, j]) + (axi * static_cast<R>(y[j])));
+      }
+    }
+    return;
+  }
+
+#if defined(MAF_BLAS_AVAILABLE)
+  if constexpr (std::is_same_v<T, R> && std::is_same_v<U_value_type, R> &&
+                std::is_same_v<W_value_type, R> && blas::supports<R>) {
+    blas::ger(m, n, static_cast<R>(alpha), x.data(), x.get_increment(), y.data(),
+              y.get_increment(), A.data(), detail::leading_dimension(A));
+    return;
+  }
+#endif
+
+  util::AlignedVector<R> y_buffer;
+  const R *yp = detail::contiguous<R>(y, y_buffer);
+  const R a = static_cast<R>(alpha);
+
+  exec::parallel_for(0, m, quadratic_split(m * n), [&](size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; ++i) {
+      const R axi = a * static_cast<R>(x[i]);
+      if (axi == R(0)) {
+        continue;
+      }
+      T *row = A[i];
+#pragma omp simd
+      for (size_t j = 0; j < n; ++j) {
+        row[j] = static_cast<T>(static_cast<R>(row[j]) + (axi * yp[j]));
+      }
+    }
+  });
+}
+
+/** @brief Symmetric matrix-vector multiplication (SYMV) into a caller-owned view.
+ * Computes y = alpha * A * x + beta * y where only the uplo triangle (including the
+ * diagonal) of the square matrix A is read.
+ * @tparam T Numeric type of matrix A.
+ * @tparam U Numeric type of vector x.
+ * @tparam V Numeric type of vector y.
+ *
+ * @attention If all three types are the same floating-point type, the function will
+ * attempt to use the optimized BLAS symv if available. Otherwise each row of the
+ * referenced triangle is read once and contributes both a dot product and an axpy.
+ * A view with contiguous columns is read as A^T, whose opposite triangle holds A.
+ * @attention y must not overlap A or x.
+ *
+ * @param uplo Triangle of A holding the matrix.
+ * @param alpha The scalar multiplier of A * x.
+ * @param A The symmetric input matrix.
+ * @param x The input vector.
+ * @param beta The scalar multiplier of y. When zero, y is not read.
+ * @param y The output vector, updated in-place.
+ * @throws std::invalid_argument if A is not square or dimensions do not match.
+ */
+template <Numeric T, Numeric U, Numeric V>
+  requires(!std::is_const_v<V>)
+void symv(UPLO uplo, double alpha, const MatrixView<T> &A, const VectorView<U> &x,
+          double beta, VectorView<V> y) {
   using T_value_type = std::remove_cvref_t<T>;
   using U_value_type = std::remove_cvref_t<U>;
-  using R = std::common_type_t<T_value_type, U_value_type>;
+  using R = accumulation_t<std::common_type_t<T_value_type, U_value_type, V>>;
+
+  const size_t n = A.row_count();
+  if (A.column_count() != n) {
+    throw std::invalid_argument("Matrix must be square for symv!");
+  }
+  if (x.size() != n || y.size() != n) {
+    throw std::invalid_argument("Dimensions do not match for symv!");
+  }
 
-#if defined(__APPLE__) && defined(ACCELERATE_AVAILABLE)
-  if constexpr (std::is_same_v<T_value_type, float> &&
-                std::is_same_v<U_value_type, float>) {
-    cblas_sger(CblasRowMajor, (int)A.row_count(), (int)A.column_count(), alpha,
-               x.data(), (int)x.get_increment(), y.data(), (int)y.get_increment(),
-               A.data(), (int)A.get_stride());
+  bool flipped = false;
+  util::AlignedVector<T_value_type> a_buffer;
+  const auto Ar = detail::row_contiguous(A, flipped, a_buffer);
+  const UPLO stored = flipped ? detail::flip(uplo) : uplo;
+
+#if defined(MAF_BLAS_AVAILABLE)
+  if constexpr (std::is_same_v<T_value_type, R> && std::is_same_v<U_value_type, R> &&
+                std::is_same_v<V, R> && blas::supports<R>) {
+    blas::symv(stored == UPLO::Upper ? blas::Uplo::Upper : blas::Uplo::Lower, n,
+               static_cast<R>(alpha), Ar.data(), detail::leading_dimension(Ar),
+               x.data(), x.get_increment(), static_cast<R>(beta), y.data(),
+               y.get_increment());
     return;
-  } else if constexpr (std::is_same_v<T_value_type, double> &&
-                       std::is_same_v<U_value_type, double>) {
-    cblas_dger(CblasRowMajor, (int)A.row_count(), (int)A.column_count(), alpha,
-               x.data(), (int)x.get_increment(), y.data(), (int)y.get_increment(),
-               A.data(), (int)A.get_stride());
+  }
+#endif
+
+  util::AlignedVector<R> x_buffer;
+  util::AlignedVector<R> acc(n);
+  const R *xp = detail::contiguous<R>(x, x_buffer);
+  detail::symv(stored, Ar, xp, acc.data());
+  detail::scale_store(n, static_cast<R>(alpha), acc.data(), static_cast<R>(beta), y);
+}
+
+/** @brief Triangular solve (TRSV), x = op(A)^-1 * x.
+ * @tparam T Numeric type of matrix A.
+ * @tparam V Numeric type of vector x.
+ *
+ * @attention If both types are the same floating-point type, the function will
+ * attempt to use the optimized BLAS trsv if available. Otherwise it substitutes row
+ * by row, so A is always read with unit stride; a view with contiguous columns is
+ * solved as the opposite triangle of A^T with the opposite op. Like BLAS, no
+ * singularity check is performed; a zero on the diagonal yields infinities.
+ *
+ * @param uplo Triangle of A holding the matrix.
+ * @param trans Specifies whether to solve with A or A^T.
+ * @param diag Whether the diagonal of A is implicitly one.
+ * @param A The square triangular matrix.
+ * @param x The right-hand side, overwritten with the solution.
+ * @throws std::invalid_argument if A is not square or dimensions do not match.
+ */
+template <Numeric T, Numeric V>
+  requires(!std::is_const_v<V>)
+void trsv(UPLO uplo, OP trans, DIAG diag, const MatrixView<T> &A, VectorView<V> x) {
+  using T_value_type = std::remove_cvref_t<T>;
+  using R = accumulation_t<std::common_type_t<T_value_type, V>>;
+
+  const size_t n = A.row_count();
+  if (A.column_count() != n) {
+    throw std::invalid_argument("Matrix must be square for trsv!");
+  }
+  if (x.size() != n) {
+    throw std::invalid_argument("Dimensions do not match for trsv!");
+  }
+
+  bool flipped = false;
+  util::AlignedVector<T_value_type> a_buffer;
+  const auto Ar = detail::row_contiguous(A, flipped, a_buffer);
+  const UPLO stored = flipped ? detail::flip(uplo) : uplo;
+  const OP op = flipped ? detail::flip(trans) : trans;
+
+#if defined(MAF_BLAS_AVAILABLE)
+  if constexpr (std::is_same_v<T_value_type, R> && std::is_same_v<V, R> &&
+                blas::supports<R>) {
+    blas::trsv(stored == UPLO::Upper ? blas::Uplo::Upper : blas::Uplo::Lower,
+               op == OP::Trans ? blas::Trans::Trans : blas::Trans::NoTrans,
+               diag == DIAG::Unit ? blas::Diag::Unit : blas::Diag::NonUnit, n,
+               Ar.data(), detail::leading_dimension(Ar), x.data(), x.get_increment());
     return;
   }
 #endif
 
-  if (A.row_count() * A.column_count() >= OMP_QUADRATIC_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < A.row_count(); ++i) {
-      for (size_t j = 0; j < A.column_count(); ++j) {
-        A[i][j] += static_cast<R>(alpha) * static_cast<R>(x[i]) * static_cast<R>(y[j]);
+  if constexpr (std::is_same_v<V, R>) {
+    if (x.get_increment() == 1) {
+      detail::trsv(stored, op, diag, Ar, x.data());
+      return;
+    }
+  }
+  util::AlignedVector<R> buffer(n);
+  for (size_t i = 0; i < n; ++i) {
+    buffer[i] = static_cast<R>(x[i]);
+  }
+  detail::trsv(stored, op, diag, Ar, buffer.data());
+  for (size_t i = 0; i < n; ++i) {
+    x[i] = static_cast<V>(buffer[i]);
+  }
+}
+
+#pragma mark level3
+//=============================================================================
+// LEVEL 3
+//=============================================================================
+/** @brief General matrix-matrix multiplication (GEMM) into a caller-owned view.
+ * Computes C = alpha * op(A) * op(B) + beta * C without allocating. Any operand may
+ * be a strided sub-block of a larger matrix.
+ * @tparam T Numeric type of matrix A.
+ * @tparam U Numeric type of matrix B.
+ * @tparam V Numeric type of matrix C.
+ *
+ * @attention If all three types are the same floating-point type, the function will
+ * attempt to use the optimized BLAS gemm if available. Otherwise it falls back to the
+ * packed GEMM engine, accumulating in the common type of T, U and V. BLAS is used
+ * whenever every operand has a unit row or column stride: a column-contiguous A or B
+ * is passed as its transpose with the opposite op, and a column-contiguous C is
+ * computed as C^T = op(B)^T * op(A)^T. The packed engine reads any strides directly.
+ * @attention C must not overlap A or B.
+ *
+ * @param trans_a Specifies whether to transpose matrix A.
+ * @param trans_b Specifies whether to transpose matrix B.
+ * @param alpha The scalar multiplier of op(A) * op(B).
+ * @param A The first input matrix.
+ * @param B The second input matrix.
+ * @param beta The scalar multiplier of C. When zero, C is not read.
+ * @param C The output matrix, updated in-place. Taken by value so that sub-views can
+ * be passed directly.
+ * @throws std::invalid_argument if dimensions of op(A), op(B) and C do not match.
+ */
+template <Numeric T, Numeric U, Numeric V>
+  requires(!std::is_const_v<V>)
+void gemm(OP trans_a, OP trans_b, double alpha, const MatrixView<T> &A,
+          const MatrixView<U> &B, double beta, MatrixView<V> C) {
+  using T_value_type = std::remove_cvref_t<T>;
+  using U_value_type = std::remove_cvref_t<U>;
+  using R = accumulation_t<std::common_type_t<T_value_type, U_value_type, V>>;
+
+  const bool a_trans = trans_a == OP::Trans;
+  const bool b_trans = trans_b == OP::Trans;
+  const size_t m = a_trans ? A.column_count() : A.row_count();
+  const size_t k = a_trans ? A.row_count() : A.column_count();
+  const size_t n = b_trans ? B.row_count() : B.column_count();
+  if ((b_trans ? B.column_count() : B.row_count()) != k || C.row_count() != m ||
+      C.column_count() != n) {
+    throw std::invalid_argument("Matrix dimensions do not match for gemm!");
+  }
+
+#if defined(MAF_BLAS_AVAILABLE)
+  if constexpr (std::is_same_v<T_value_type, R> && std::is_same_v<U_value_type, R> &&
+                std::is_same_v<V, R> && blas::supports<R>) {
+    const bool unit_a = A.column_stride() == 1 || A.row_stride() == 1;
+    const bool unit_b = B.column_stride() == 1 || B.row_stride() == 1;
+    const bool unit_c = C.column_stride() == 1 || C.row_stride() == 1;
+    if (unit_a && unit_b && unit_c) {
+      // A view with contiguous columns is its transpose with contiguous rows.
+      const auto as_rows = [](const auto &X, OP op) {
+        const bool flip = X.column_stride() != 1;
+        return std::pair(flip ? X.transposed_view() : X, flip ? detail::flip(op) : op);
+      };
+      const auto to_blas = [](OP op) {
+        return (op == OP::Trans) ? blas::Trans::Trans : blas::Trans::NoTrans;
+      };
+      if (C.column_stride() == 1) {
+        const auto [Ar, op_a] = as_rows(A, trans_a);
+        const auto [Br, op_b] = as_rows(B, trans_b);
+        blas::gemm(to_blas(op_a), to_blas(op_b), m, n, k, static_cast<R>(alpha),
+                   Ar.data(), detail::leading_dimension(Ar), Br.data(),
+                   detail::leading_dimension(Br), static_cast<R>(beta), C.data(),
+                   detail::leading_dimension(C));
+      } else {
+        // C^T = op(B)^T * op(A)^T, and C^T has contiguous rows.
+        auto Ct = C.transposed_view();
+        const auto [Br, op_b] = as_rows(B, detail::flip(trans_b));
+        const auto [Ar, op_a] = as_rows(A, detail::flip(trans_a));
+        blas::gemm(to_blas(op_b), to_blas(op_a), n, m, k, static_cast<R>(alpha),
+                   Br.data(), detail::leading_dimension(Br), Ar.data(),
+                   detail::leading_dimension(Ar), static_cast<R>(beta), Ct.data(),
+                   detail::leading_dimension(Ct));
       }
+      return;
     }
+  }
+#endif
+
+  // A transpose is the same storage read with row and column strides swapped.
+  const size_t rsa = a_trans ? A.column_stride() : A.row_stride();
+  const size_t csa = a_trans ? A.row_stride() : A.column_stride();
+  const size_t rsb = b_trans ? B.column_stride() : B.row_stride();
+  const size_t csb = b_trans ? B.row_stride() : B.column_stride();
+  packed_gemm<T_value_type, U_value_type, V, R>(
+      m, n, k, static_cast<R>(alpha), A.data(), rsa, csa, B.data(), rsb, csb,
+      static_cast<R>(beta), C.data(), C.row_stride(), C.column_stride());
+}
+
+/**
+ * @brief Solves op(A) * X = B for X, overwriting B (TRSM, left side).
+ * @details Without a vendor BLAS the triangle is split in halves recursively: one
+ * half is solved, the other half of B is updated by a single GEMM and then solved,
+ * so all but O(n * TRSM_BLOCK * p) of the work runs in the GEMM engine. The blocks
+ * on the diagonal are solved by substitution in parallel over the columns of B.
+ *
+ * @param uplo Triangle of A holding the matrix.
+ * @param trans Specifies whether to solve with A or A^T.
+ * @param diag Whether the diagonal of A is implicitly one.
+ * @param A The square triangular matrix.
+ * @param B The right-hand sides, one per column, overwritten with the solutions. Taken
+ * by value so that sub-views can be passed directly.
+ * @throws std::invalid_argument if A is not square or dimensions do not match.
+ */
+template <Numeric T, Numeric V>
+  requires(!std::is_const_v<V>)
+void trsm(UPLO uplo, OP trans, DIAG diag, const MatrixView<T> &A, MatrixView<V> B) {
+  using T_value_type = std::remove_cvref_t<T>;
+  using R = accumulation_t<std::common_type_t<T_value_type, V>>;
+
+  const size_t n = A.row_count();
+  const size_t p = B.column_count();
+  if (A.column_count() != n) {
+    throw std::invalid_argument("Matrix must be square for trsm!");
+  }
+  if (B.row_count() != n) {
+    throw std::invalid_argument("Dimensions do not match for trsm!");
+  }
+  if (n == 0 || p == 0) {
+    return;
+  }
+
+  bool flipped = false;
+  util::AlignedVector<T_value_type> a_buffer;
+  const auto Ar = detail::row_contiguous(A, flipped, a_buffer);
+  const UPLO stored = flipped ? detail::flip(uplo) : uplo;
+  const OP op = flipped ? detail::flip(trans) : trans;
+
+#if defined(MAF_BLAS_AVAILABLE)
+  if constexpr (std::is_same_v<T_value_type, R> && std::is_same_v<V, R> &&
+                blas::supports<R>) {
+    if (B.column_stride() == 1 || B.row_stride() == 1) {
+      const auto to_blas = [](OP o) {
+        return (o == OP::Trans) ? blas::Trans::Trans : blas::Trans::NoTrans;
+      };
+      const blas::Uplo blas_uplo =
+          (stored == UPLO::Upper) ? blas::Uplo::Upper : blas::Uplo::Lower;
+      const blas::Diag blas_diag =
+          (diag == DIAG::Unit) ? blas::Diag::Unit : blas::Diag::NonUnit;
+      if (B.column_stride() == 1) {
+        blas::trsm(blas::Side::Left, blas_uplo, to_blas(op), blas_diag, n, p, R(1),
+                   Ar.data(), detail::leading_dimension(Ar), B.data(),
+                   detail::leading_dimension(B));
+      } else {
+        // X^T * op(A)^T = B^T, and B^T has contiguous rows.
+        auto Bt = B.transposed_view();
+        blas::trsm(blas::Side::Right, blas_uplo, to_blas(detail::flip(op)), blas_diag,
+                   p, n, R(1), Ar.data(), detail::leading_dimension(Ar), Bt.data(),
+                   detail::leading_dimension(Bt));
+      }
+      return;
+    }
+  }
+#endif
+
+  // A^T is the same storage read with swapped strides, in the opposite triangle.
+  const auto At = (op == OP::Trans) ? Ar.transposed_view() : Ar;
+  const UPLO solved = (op == OP::Trans) ? detail::flip(stored) : stored;
+  if constexpr (std::is_same_v<V, R>) {
+    detail::trsm(solved, diag, At, B);
   } else {
-    for (size_t i = 0; i < A.row_count(); ++i) {
-#pragma omp simd
-      for (size_t j = 0; j < A.column_count(); ++j) {
-        A[i][j] += static_cast<R>(alpha) * static_cast<R>(x[i]) * static_cast<R>(y[j]);
+    Matrix<R> buffer(n, p, util::uninitialized);
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = 0; j < p; ++j) {
+        buffer[i, j] = static_cast<R>(B[i, j]);
+      }
+    }
+    detail::trsm(solved, diag, At, buffer.view());
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = 0; j < p; ++j) {
+        B[i, j] = static_cast<V>(buffer[i, j]);
       }
     }
   }
@@ -136,37 +545,22 @@ template <Numeric T, Numeric U>
 auto dot(const VectorView<T> &x, const VectorView<U> &y) {
   using T_value_type = std::remove_cvref_t<T>;
   using U_value_type = std::remove_cvref_t<U>;
-  using R = std::common_type_t<T_value_type, U_value_type>;
+  using R = accumulation_t<std::common_type_t<T_value_type, U_value_type>>;
 
   size_t n = x.size();
   if (n != y.size()) {
     throw std::invalid_argument("Vectors must be of same size for dot product!");
   }
 
-#if defined(__APPLE__) && defined(ACCELERATE_AVAILABLE)
-  if constexpr (std::is_same_v<T_value_type, float> &&
-                std::is_same_v<U_value_type, float>) {
-    return cblas_sdot((int)n, x.data(), (int)x.get_increment(), y.data(),
-                      (int)y.get_increment());
-  } else if constexpr (std::is_same_v<T_value_type, double> &&
-                       std::is_same_v<U_value_type, double>) {
-    return cblas_ddot((int)n, x.data(), (int)x.get_increment(), y.data(),
-                      (int)y.get_increment());
+#if defined(MAF_BLAS_AVAILABLE)
+  if constexpr (std::is_same_v<T_value_type, R> && std::is_same_v<U_value_type, R> &&
+                blas::supports<R>) {
+    return blas::dot(n, x.data(), x.get_increment(), y.data(), y.get_increment());
   }
 #endif
 
-  R result(0);
-  if (n > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for reduction(+ : result)
-    for (size_t i = 0; i < n; ++i) {
-      result += static_cast<R>(x[i]) * static_cast<R>(y[i]);
-    }
-  } else {
-#pragma omp simd reduction(+ : result)
-    for (size_t i = 0; i < n; ++i) {
-      result += static_cast<R>(x[i]) * static_cast<R>(y[i]);
-    }
-  }
+  return kernels::dot_n<R>(n, x.data(), x.get_increment(), y.data(),
+                           y.get_increment());
 }
 
 /** @brief Computes the outer product of two vectors.
@@ -183,74 +577,444 @@ auto outer(const VectorView<T> &x, const VectorView<U> &y) {
   using U_value_type = std::remove_cvref_t<U>;
   using R = std::common_type_t<T_value_type, U_value_type>;
 
-  Matrix<R> result(x.size(), y.size());
-  if (x.size() * y.size() >= OMP_QUADRATIC_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < x.size(); ++i) {
-      for (size_t j = 0; j < y.size(); ++j) {
-        result[i][j] = static_cast<R>(x[i]) * static_cast<R>(y[j]);
-      }
-    }
-  } else {
-    for (size_t i = 0; i < x.size(); ++i) {
+  Matrix<R> result(x.size(), y.size(), util::uninitialized);
+  const exec::Split split = quadratic_split(x.size() * y.size());
+  exec::parallel_for(0, x.size(), split, [&](size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; ++i) {
 #pragma omp simd
       for (size_t j = 0; j < y.size(); ++j) {
         result[i][j] = static_cast<R>(x[i]) * static_cast<R>(y[j]);
       }
     }
+  });
+  return result;
+}
+
+#pragma mark elementwise
+//=============================================================================
+// ELEMENT-WISE
+//=============================================================================
+/**
+ * @brief Applies f to every element of a view of any strides.
+ * @details Column-major views are traversed by columns. Only the function objects from
+ * maf::math::vmath and callables wrapped in vmath::vectorized() are vectorized and
+ * parallelized; any other f runs in that order on the calling thread.
+ * @return A row-major `Matrix<R>` where R is the type returned by f.
+ */
+template <Numeric T, typename F>
+  requires std::invocable<F &, const std::remove_const_t<T> &>
+auto map(const MatrixView<T> &A, F f) {
+  using R = map_result_t<F, std::remove_const_t<T>>;
+  const size_t n = A.column_count();
+  Matrix<R> result(A.row_count(), n, util::uninitialized);
+  map_2d(A.row_count(), n, A.data(), A.row_stride(), A.column_stride(), result.data(),
+         n, 1, f);
+  return result;
+}
+
+/**
+ * @brief Combines two views element by element: f(A[i, j], B[i, j]).
+ * @return A row-major `Matrix<R>` where R is the type returned by f.
+ * @throws std::invalid_argument if the dimensions do not match.
+ */
+template <Numeric T, Numeric U, typename F>
+  requires std::invocable<F &, const std::remove_const_t<T> &,
+                          const std::remove_const_t<U> &>
+auto zip_map(const MatrixView<T> &A, const MatrixView<U> &B, F f) {
+  if (A.row_count() != B.row_count() || A.column_count() != B.column_count()) {
+    throw std::invalid_argument("Views have to be of same dimensions for zip_map!");
+  }
+  using R = map_result_t<F, std::remove_const_t<T>, std::remove_const_t<U>>;
+  const size_t n = A.column_count();
+  Matrix<R> result(A.row_count(), n, util::uninitialized);
+  zip_map_2d(A.row_count(), n, A.data(), A.row_stride(), A.column_stride(), B.data(),
+             B.row_stride(), B.column_stride(), result.data(), n, 1, f);
+  return result;
+}
+
+/** @brief Replaces every element x of a mutable view with f(x). */
+template <Numeric T, std::invocable<const T &> F>
+  requires(!std::is_const_v<T>)
+void apply_inplace(MatrixView<T> A, F f) {
+  map_2d(A.row_count(), A.column_count(), A.data(), A.row_stride(), A.column_stride(),
+         A.data(), A.row_stride(), A.column_stride(), f);
+}
+
+/**
+ * @brief Applies f to every element of a vector view.
+ * @return `Vector<R>` with the orientation of x, where R is the type returned by f.
+ */
+template <Numeric T, typename F>
+  requires std::invocable<F &, const std::remove_const_t<T> &>
+auto map(const VectorView<T> &x, F f) {
+  using R = map_result_t<F, std::remove_const_t<T>>;
+  Vector<R> result(x.size(), util::uninitialized, x.orientation());
+  map_n(x.size(), x.data(), x.get_increment(), result.data(), 1, f);
+  return result;
+}
+
+/**
+ * @brief Combines two vector views element by element: f(x[i], y[i]).
+ * @return `Vector<R>` with the orientation of x, where R is the type returned by f.
+ * @throws std::invalid_argument if the sizes do not match.
+ */
+template <Numeric T, Numeric U, typename F>
+  requires std::invocable<F &, const std::remove_const_t<T> &,
+                          const std::remove_const_t<U> &>
+auto zip_map(const VectorView<T> &x, const VectorView<U> &y, F f) {
+  if (x.size() != y.size()) {
+    throw std::invalid_argument("Vectors must be of same size for zip_map!");
   }
+  using R = map_result_t<F, std::remove_const_t<T>, std::remove_const_t<U>>;
+  Vector<R> result(x.size(), util::uninitialized, x.orientation());
+  zip_map_n(x.size(), x.data(), x.get_increment(), y.data(), y.get_increment(),
+            result.data(), 1, f);
   return result;
 }
 
+/** @brief Replaces every element x of a mutable vector view with f(x). */
+template <Numeric T, std::invocable<const T &> F>
+  requires(!std::is_const_v<T>)
+void apply_inplace(VectorView<T> x, F f) {
+  map_n(x.size(), x.data(), x.get_increment(), x.data(), x.get_increment(), f);
+}
+
 // Implementations
 namespace detail {
-template <Numeric T, Numeric U, Numeric R>
-void no_trans_gemv(const MatrixView<T> &A, const VectorView<U> &x, Vector<R> &y) {
-  // Dimensions are checked higher up the calls.
-  if (A.row_count() * A.column_count() >= OMP_QUADRATIC_LIMIT) {
-#pragma omp parallel for
-    for (size_t i = 0; i < A.row_count(); ++i) {
-      auto row = A.row_span(i);
-      R sum = 0;
-#pragma omp simd
-      for (size_t j = 0; j < A.column_count(); ++j) {
-        sum += static_cast<R>(row[j]) * static_cast<R>(x[j]);
-      }
-      y[i] = sum;
+/** @brief Returns x as contiguous R values: the view's own storage when it already is,
+ * otherwise a copy made into buffer. */
+template <typename R, Numeric U>
+const R *contiguous(const VectorView<U> &x, util::AlignedVector<R> &buffer) {
+  if constexpr (std::is_same_v<std::remove_cvref_t<U>, R>) {
+    if (x.get_increment() == 1) {
+      return x.data();
+    }
+  }
+  buffer.resize(x.size());
+  for (size_t i = 0; i < x.size(); ++i) {
+    buffer[i] = static_cast<R>(x[i]);
+  }
+  return buffer.data();
+}
+
+/**
+ * @brief Returns a view of A with unit column stride: A itself when its rows are
+ * contiguous, A^T (setting transposed) when its columns are, and otherwise a
+ * row-major copy made into buffer.
+ */
+template <Numeric T>
+MatrixView<const std::remove_const_t<T>> row_contiguous(
+    const MatrixView<T> &A, bool &transposed,
+    util::AlignedVector<std::remove_const_t<T>> &buffer) {
+  using value_type = std::remove_const_t<T>;
+  transposed = false;
+  if (A.column_stride() == 1) {
+    return A;
+  }
+  if (A.row_stride() == 1) {
+    transposed = true;
+    return A.transposed_view();
+  }
+  const size_t m = A.row_count();
+  const size_t n = A.column_count();
+  buffer.resize(m * n);
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      buffer[(i * n) + j] = A[i, j];
+    }
+  }
+  return MatrixView<const value_type>(buffer.data(), m, n, n);
+}
+
+/** @brief BLAS leading dimension of a view with unit column stride. A single row may
+ * carry any row stride, but BLAS still requires it to cover the columns. */
+template <Numeric T>
+size_t leading_dimension(const MatrixView<T> &A) noexcept {
+  return (A.row_count() > 1) ? A.row_stride()
+                             : std::max<size_t>({A.row_stride(), A.column_count(), 1});
+}
+
+/** @brief y = alpha * acc + beta * y, without reading y when beta is zero. */
+template <typename R, Numeric V>
+void scale_store(size_t n, R alpha, const R *acc, R beta, VectorView<V> &y) {
+  if (beta == R(0)) {
+    for (size_t i = 0; i < n; ++i) {
+      y[i] = static_cast<V>(alpha * acc[i]);
     }
   } else {
-    for (size_t i = 0; i < A.row_count(); ++i) {
-      auto row = A.row_span(i);
-      R sum = 0;
+    for (size_t i = 0; i < n; ++i) {
+      y[i] = static_cast<V>((alpha * acc[i]) + (beta * static_cast<R>(y[i])));
+    }
+  }
+}
+
+/**
+ * @brief acc[0, n) = sum of row_update over all row groups.
+ * @details Row updates scatter into the whole of acc, so when run in parallel every
+ * thread accumulates into a private partial vector and the partials are summed
+ * afterwards. Groups are taken one at a time, which also balances triangular work.
+ */
+template <typename R, typename RowUpdate>
+void accumulate_rows(size_t groups, size_t n, bool parallel, R *acc,
+                     RowUpdate &&row_update) {
+  std::fill_n(acc, n, R(0));
+  const size_t threads = parallel ? std::min(exec::concurrency(), groups) : 1;
+  if (threads <= 1) {
+    for (size_t g = 0; g < groups; ++g) {
+      row_update(g, acc);
+    }
+    return;
+  }
+
+  util::AlignedVector<R> partial(threads * n, R(0));
+  exec::parallel_for(0, groups, {.grain = 1}, [&](size_t t, size_t g0, size_t g1) {
+    for (size_t g = g0; g < g1; ++g) {
+      row_update(g, partial.data() + (t * n));
+    }
+  });
+  exec::parallel_for(0, n, linear_split(threads * n), [&](size_t lo, size_t hi) {
+    for (size_t j = lo; j < hi; ++j) {
+      R sum(0);
+      for (size_t t = 0; t < threads; ++t) {
+        sum += partial[(t * n) + j];
+      }
+      acc[j] = sum;
+    }
+  });
+}
+
+template <typename R, Numeric T>
+void no_trans_gemv(const MatrixView<T> &A, const R *x, R *acc) {
+  constexpr size_t U = LEVEL2_ROW_UNROLL;
+  const size_t m = A.row_count();
+  const size_t n = A.column_count();
+  const size_t groups = (m + U - 1) / U;
+
+  // Four independent dot products share every load of x.
+  exec::parallel_for(0, groups, quadratic_split(m * n), [&](size_t g0, size_t g1) {
+    for (size_t g = g0; g < g1; ++g) {
+      const size_t i = g * U;
+      if (i + U <= m) {
+        const auto *r0 = A[i];
+        const auto *r1 = A[i + 1];
+        const auto *r2 = A[i + 2];
+        const auto *r3 = A[i + 3];
+        R s0(0);
+        R s1(0);
+        R s2(0);
+        R s3(0);
+#pragma omp simd reduction(+ : s0, s1, s2, s3)
+        for (size_t j = 0; j < n; ++j) {
+          s0 += static_cast<R>(r0[j]) * x[j];
+          s1 += static_cast<R>(r1[j]) * x[j];
+          s2 += static_cast<R>(r2[j]) * x[j];
+          s3 += static_cast<R>(r3[j]) * x[j];
+        }
+        acc[i] = s0;
+        acc[i + 1] = s1;
+        acc[i + 2] = s2;
+        acc[i + 3] = s3;
+      } else {
+        for (size_t r = i; r < m; ++r) {
+          const auto *row = A[r];
+          R sum(0);
+#pragma omp simd reduction(+ : sum)
+          for (size_t j = 0; j < n; ++j) {
+            sum += static_cast<R>(row[j]) * x[j];
+          }
+          acc[r] = sum;
+        }
+      }
+    }
+  });
+}
+
+template <typename R, Numeric T>
+void trans_gemv(const MatrixView<T> &A, const R *x, R *acc) {
+  constexpr size_t U = LEVEL2_ROW_UNROLL;
+  const size_t m = A.row_count();
+  const size_t n = A.column_count();
+
+  // A^T * x is a sum of scaled rows of A; four rows are folded into each pass over
+  // the accumulator so it is read and written a quarter as often.
+  accumulate_rows((m + U - 1) / U, n, m * n >= tuning().omp_quadratic_limit, acc,
+                  [&](size_t g, R *out) {
+                    const size_t i = g * U;
+                    if (i + U <= m) {
+                      const auto *r0 = A[i];
+                      const auto *r1 = A[i + 1];
+                      const auto *r2 = A[i + 2];
+                      const auto *r3 = A[i + 3];
+                      const R x0 = x[i];
+                      const R x1 = x[i + 1];
+                      const R x2 = x[i + 2];
+                      const R x3 = x[i + 3];
 #pragma omp simd
-      for (size_t j = 0; j < A.column_count(); ++j) {
-        sum += static_cast<R>(row[j]) * static_cast<R>(x[j]);
+                      for (size_t j = 0; j < n; ++j) {
+                        out[j] += (x0 * static_cast<R>(r0[j])) +
+                                  (x1 * static_cast<R>(r1[j])) +
+                                  (x2 * static_cast<R>(r2[j])) +
+                                  (x3 * static_cast<R>(r3[j]));
+                      }
+                    } else {
+                      for (size_t r = i; r < m; ++r) {
+                        const auto *row = A[r];
+                        const R xr = x[r];
+#pragma omp simd
+                        for (size_t j = 0; j < n; ++j) {
+                          out[j] += xr * static_cast<R>(row[j]);
+                        }
+                      }
+                    }
+                  });
+}
+
+template <typename R, Numeric T>
+void symv(UPLO uplo, const MatrixView<T> &A, const R *x, R *acc) {
+  const size_t n = A.row_count();
+  const bool lower = uplo == UPLO::Lower;
+
+  // Row i of the stored triangle is both row i and column i of A: it contributes a
+  // dot product to y[i] and an axpy with x[i] to the mirrored entries.
+  const bool parallel = n * n >= tuning().omp_quadratic_limit;
+  accumulate_rows(n, n, parallel, acc, [&](size_t i, R *out) {
+    const auto *row = A[i];
+    const size_t begin = lower ? 0 : i + 1;
+    const size_t end = lower ? i : n;
+    const R xi = x[i];
+    R sum = static_cast<R>(row[i]) * xi;
+#pragma omp simd reduction(+ : sum)
+    for (size_t j = begin; j < end; ++j) {
+      const R a = static_cast<R>(row[j]);
+      sum += a * x[j];
+      out[j] += a * xi;
+    }
+    out[i] += sum;
+  });
+}
+
+template <typename R, Numeric T>
+void trsv(UPLO uplo, OP trans, DIAG diag, const MatrixView<T> &A, R *x) {
+  const size_t n = A.row_count();
+  const bool unit = diag == DIAG::Unit;
+
+  if (trans == OP::NoTrans) {
+    // Dot-product substitution along the rows of the triangle.
+    const bool lower = uplo == UPLO::Lower;
+    for (size_t t = 0; t < n; ++t) {
+      const size_t i = lower ? t : (n - 1) - t;
+      const auto *row = A[i];
+      const size_t begin = lower ? 0 : i + 1;
+      const size_t end = lower ? i : n;
+      R sum(0);
+#pragma omp simd reduction(+ : sum)
+      for (size_t j = begin; j < end; ++j) {
+        sum += static_cast<R>(row[j]) * x[j];
       }
-      y[i] = sum;
+      x[i] = unit ? x[i] - sum : (x[i] - sum) / static_cast<R>(row[i]);
+    }
+    return;
+  }
+
+  // Row i of A is column i of A^T, so solving with A^T eliminates x[i] from the rest
+  // of the system with an axpy along that row.
+  const bool forward = uplo == UPLO::Upper;
+  for (size_t t = 0; t < n; ++t) {
+    const size_t i = forward ? t : (n - 1) - t;
+    const auto *row = A[i];
+    if (!unit) {
+      x[i] /= static_cast<R>(row[i]);
+    }
+    const R xi = x[i];
+    const size_t begin = forward ? i + 1 : 0;
+    const size_t end = forward ? n : i;
+#pragma omp simd
+    for (size_t j = begin; j < end; ++j) {
+      x[j] -= static_cast<R>(row[j]) * xi;
     }
   }
 }
 
-template <Numeric T, Numeric U, Numeric R>
-void trans_gemv(const VectorView<T> &x, const MatrixView<U> &A, Vector<R> &y) {
-  // Dimensions are checked higher up the calls.
-  if (A.row_count() * A.column_count() >= OMP_QUADRATIC_LIMIT) {
-#pragma omp parallel for
-    for (size_t j = 0; j < A.column_count(); ++j) {
-      R sum = 0;
-      for (size_t i = 0; i < A.row_count(); ++i) {
-        sum += static_cast<R>(x[i]) * static_cast<R>(A[i][j]);
+/** @brief Order of the diagonal blocks that trsm solves by substitution. */
+inline constexpr size_t TRSM_BLOCK = 64;
+
+/** @brief A^-1 * B by substitution, in parallel over the columns of B. */
+template <typename R, Numeric T>
+void trsm_block(bool lower, bool unit, const MatrixView<T> &A, MatrixView<R> B) {
+  const size_t n = A.row_count();
+  const size_t p = B.column_count();
+  const size_t rs = B.row_stride();
+  const size_t cs = B.column_stride();
+  R *b = B.data();
+  exec::parallel_for(0, p, quadratic_split(n * p), [&](size_t lo, size_t hi) {
+    if (cs == 1) {
+      // Contiguous rows: eliminate the solved rows from row i across the columns.
+      for (size_t t = 0; t < n; ++t) {
+        const size_t i = lower ? t : (n - 1) - t;
+        R *row_i = b + (i * rs);
+        const size_t begin = lower ? 0 : i + 1;
+        const size_t end = lower ? i : n;
+        for (size_t k = begin; k < end; ++k) {
+          const R a = static_cast<R>(A[i, k]);
+          const R *row_k = b + (k * rs);
+#pragma omp simd
+          for (size_t j = lo; j < hi; ++j) {
+            row_i[j] -= a * row_k[j];
+          }
+        }
+        if (!unit) {
+          const R diagonal = static_cast<R>(A[i, i]);
+#pragma omp simd
+          for (size_t j = lo; j < hi; ++j) {
+            row_i[j] /= diagonal;
+          }
+        }
       }
-      y[j] = sum;
+      return;
     }
-  } else {
-    for (size_t j = 0; j < A.column_count(); ++j) {
-      R sum = 0;
-      for (size_t i = 0; i < A.row_count(); ++i) {
-        sum += static_cast<R>(x[i]) * static_cast<R>(A[i][j]);
+    // Otherwise every column is a strided trsv.
+    for (size_t j = lo; j < hi; ++j) {
+      R *x = b + (j * cs);
+      for (size_t t = 0; t < n; ++t) {
+        const size_t i = lower ? t : (n - 1) - t;
+        const size_t begin = lower ? 0 : i + 1;
+        const size_t end = lower ? i : n;
+        R sum(0);
+        for (size_t k = begin; k < end; ++k) {
+          sum += static_cast<R>(A[i, k]) * x[k * rs];
+        }
+        const R rest = x[i * rs] - sum;
+        x[i * rs] = unit ? rest : rest / static_cast<R>(A[i, i]);
       }
-      y[j] = sum;
     }
+  });
+}
+
+/** @brief A^-1 * B for a triangular A, split recursively around one GEMM. */
+template <typename R, Numeric T>
+void trsm(UPLO uplo, DIAG diag, const MatrixView<T> &A, MatrixView<R> B) {
+  const size_t n = A.row_count();
+  const size_t p = B.column_count();
+  const bool lower = uplo == UPLO::Lower;
+  if (n <= TRSM_BLOCK) {
+    trsm_block(lower, diag == DIAG::Unit, A, B);
+    return;
+  }
+  // [A_11, A_12]   [B_1]
+  // [A_21, A_22] , [B_2], with A_12 = 0 (lower) or A_21 = 0 (upper)
+  const size_t h = n / 2;
+  const auto A11 = A.view(0, 0, h, h);
+  const auto A22 = A.view(h, h, n - h, n - h);
+  auto B1 = B.view(0, 0, h, p);
+  auto B2 = B.view(h, 0, n - h, p);
+  if (lower) {
+    trsm(uplo, diag, A11, B1);
+    kernels::gemm(OP::NoTrans, OP::NoTrans, -1.0, A.view(h, 0, n - h, h), B1, 1.0, B2);
+    trsm(uplo, diag, A22, B2);
+  } else {
+    trsm(uplo, diag, A22, B2);
+    kernels::gemm(OP::NoTrans, OP::NoTrans, -1.0, A.view(0, h, h, n - h), B2, 1.0, B1);
+    trsm(uplo, diag, A11, B1);
   }
 }
 }  // namespace detail
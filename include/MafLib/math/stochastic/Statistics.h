@@ -6,12 +6,10 @@
 namespace maf::math {
 
 /// Calculates the unbiased estimator of expected value aka mean.
+/// Summed pairwise in double, see kernels::sum_terms.
 template <typename T>
 double mean(const Vector<T> &data) {
-    double sum = 0.;
-    for (const T &value : data) {
-        sum += value;
-    }
+    double sum = kernels::sum_n<double>(data.size(), data.data(), 1);
     return sum / data.size();
 }
 
@@ -25,10 +23,11 @@ double covariance(const Vector<T> &x, const Vector<T> &y) {
 
     double mean_x = mean(x);
     double mean_y = mean(y);
-    double cov = 0.0;
-    for (size_t i = 0; i < n; ++i) {
-        cov += (x.at(i) - mean_x) * (y.at(i) - mean_y);
-    }
+    const T *px = x.data();
+    const T *py = y.data();
+    double cov = kernels::sum_terms<double>(n, [=](size_t i) {
+        return (px[i] - mean_x) * (py[i] - mean_y);
+    });
     return cov / (n - 1);
 }
 
@@ -43,10 +42,11 @@ double covariance(const std::vector<T> &x,
     if (n != y.size()) {
         throw std::invalid_argument("Dimension mismatch.");
     }
-    double cov = 0.0;
-    for (size_t i = 0; i < n; ++i) {
-        cov += (x.at(i) - mean_x) * (y.at(i) - mean_y);
-    }
+    const T *px = x.data();
+    const T *py = y.data();
+    double cov = kernels::sum_terms<double>(n, [=](size_t i) {
+        return (px[i] - mean_x) * (py[i] - mean_y);
+    });
     return cov / (n - 1);
 }
 
@@ -4,10 +4,16 @@
 #include "MafLib/main/GlobalHeader.hpp"
 
 namespace maf::util {
-template <typename To, typename From>
-static std::vector<To> convert_if_needed(const std::vector<From> &src) {
+/**
+ * @brief Returns src as a std::vector<To>.
+ * @details When From is already To, src itself is returned by const reference and
+ * nothing is copied; otherwise a converted copy is returned by value. Bind the result
+ * with `const auto &` to keep the no-copy case free.
+ */
+template <typename To, typename From, typename Alloc>
+[[nodiscard]] decltype(auto) convert_if_needed(const std::vector<From, Alloc> &src) {
   if constexpr (std::is_same_v<To, From>) {
-    return src;
+    return (src);
   } else {
     std::vector<To> dst;
     dst.reserve(src.size());
@@ -0,0 +1,349 @@
+#ifndef UTIL_HALF_H
+#define UTIL_HALF_H
+#pragma once
+#include <bit>
+
+#include "MafLib/main/GlobalHeader.hpp"
+
+#if defined(__F16C__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @file Half.hpp
+ * @brief 16-bit floating-point storage types: IEEE binary16 (`fp16`) and bfloat16
+ * (`bf16`).
+ *
+ * Both types are storage formats: they convert implicitly to float, every arithmetic
+ * expression is evaluated in float, and a float result is rounded (to nearest, ties
+ * to even) when it is stored back. `Matrix<bf16>` and `Matrix<fp16>` therefore halve
+ * memory footprint and bandwidth, while the GEMM, GEMV and dot kernels accumulate in
+ * float (see `util::accumulation_t`).
+ *
+ * Scalar conversions are branch-free bit manipulations that round to nearest even
+ * on the full range, subnormals included, and auto-vectorize inside kernel loops.
+ * Bulk conversions (`util::convert_n`) use F16C / AVX-512 and AVX512-BF16
+ * instructions when the target supports them and give the same bits as the scalar
+ * ones (NaN payloads aside). The AVX512-BF16 instruction flushes subnormal inputs
+ * to zero, so those lanes are rounded in software.
+ */
+namespace maf::util {
+namespace detail {
+/** @brief binary16 bits to float, exact. */
+[[nodiscard]] constexpr float fp16_to_float(uint16 h) noexcept {
+  const uint32 magnitude = static_cast<uint32>(h & 0x7fffU) << 13;
+  const uint32 exponent = magnitude & 0x0f800000U;
+  // Rebias the exponent; infinities and NaNs move to the float maximum exponent and
+  // subnormals are renormalized by subtracting 2^-14.
+  const float normal = std::bit_cast<float>(magnitude + 0x38000000U);
+  const float special = std::bit_cast<float>(magnitude + 0x70000000U);
+  const float subnormal =
+      std::bit_cast<float>(magnitude + 0x38800000U) - 6.103515625e-05F;
+  const float value =
+      (exponent == 0x0f800000U) ? special : ((exponent == 0) ? subnormal : normal);
+  return std::bit_cast<float>(std::bit_cast<uint32>(value) |
+                              (static_cast<uint32>(h & 0x8000U) << 16));
+}
+
+/** @brief float to binary16 bits, rounded to nearest even; NaNs become quiet NaNs. */
+[[nodiscard]] constexpr uint16 float_to_fp16(float f) noexcept {
+  const uint32 bits = std::bit_cast<uint32>(f);
+  const uint32 sign = (bits >> 16) & 0x8000U;
+  const uint32 x = bits & 0x7fffffffU;
+  // Rebias and round on the 13 dropped mantissa bits.
+  const uint32 normal = (x + 0xc8000fffU + ((x >> 13) & 1U)) >> 13;
+  // Below 2^-14 the float adder rounds the mantissa into place for us.
+  const uint32 subnormal =
+      std::bit_cast<uint32>(std::bit_cast<float>(x) + 0.5F) - 0x3f000000U;
+  const uint32 special = (x > 0x7f800000U) ? 0x7e00U : 0x7c00U;
+  const uint32 h =
+      (x >= 0x47800000U) ? special : ((x < 0x38800000U) ? subnormal : normal);
+  return static_cast<uint16>(sign | h);
+}
+
+/** @brief bfloat16 bits to float, exact. */
+[[nodiscard]] constexpr float bf16_to_float(uint16 b) noexcept {
+  return std::bit_cast<float>(static_cast<uint32>(b) << 16);
+}
+
+/** @brief float to bfloat16 bits, rounded to nearest even; NaNs stay quiet NaNs. */
+[[nodiscard]] constexpr uint16 float_to_bf16(float f) noexcept {
+  const uint32 bits = std::bit_cast<uint32>(f);
+  const uint32 rounded = (bits + 0x7fffU + ((bits >> 16) & 1U)) >> 16;
+  const uint32 quiet_nan = (bits >> 16) | 0x0040U;
+  return static_cast<uint16>(((bits & 0x7fffffffU) > 0x7f800000U) ? quiet_nan
+                                                                    : rounded);
+}
+}  // namespace detail
+
+struct fp16;
+struct bf16;
+
+/** @brief 16-bit floating-point storage types. */
+template <typename T>
+concept ReducedFloat =
+    std::same_as<std::remove_cv_t<T>, fp16> || std::same_as<std::remove_cv_t<T>, bf16>;
+
+/**
+ * @brief IEEE 754 binary16: 1 sign, 5 exponent and 10 mantissa bits.
+ * @details Range +-65504, about 3.3 decimal digits.
+ */
+struct fp16 {
+  /** @brief The raw binary16 encoding. */
+  uint16 bits;
+
+  fp16() = default;
+
+  /** @brief Rounds an arithmetic value to the nearest binary16. */
+  template <typename U>
+    requires std::is_arithmetic_v<U>
+  constexpr fp16(U value) noexcept
+      : bits(detail::float_to_fp16(static_cast<float>(value))) {}
+
+  /** @brief Converts a bfloat16 value; rounds its mantissa. */
+  explicit constexpr fp16(bf16 value) noexcept;
+
+  /** @brief Wraps a raw binary16 encoding. */
+  [[nodiscard]] static constexpr fp16 from_bits(uint16 raw) noexcept {
+    fp16 result;
+    result.bits = raw;
+    return result;
+  }
+
+  /** @brief Widens to float exactly. */
+  constexpr operator float() const noexcept {
+    return detail::fp16_to_float(bits);
+  }
+
+  constexpr fp16 &operator+=(float value) noexcept { return *this = *this + value; }
+  constexpr fp16 &operator-=(float value) noexcept { return *this = *this - value; }
+  constexpr fp16 &operator*=(float value) noexcept { return *this = *this * value; }
+  constexpr fp16 &operator/=(float value) noexcept { return *this = *this / value; }
+};
+
+/**
+ * @brief bfloat16: the upper half of a float (1 sign, 8 exponent, 7 mantissa bits).
+ * @details Same range as float, about 2.4 decimal digits.
+ */
+struct bf16 {
+  /** @brief The raw bfloat16 encoding. */
+  uint16 bits;
+
+  bf16() = default;
+
+  /** @brief Rounds an arithmetic value to the nearest bfloat16. */
+  template <typename U>
+    requires std::is_arithmetic_v<U>
+  constexpr bf16(U value) noexcept
+      : bits(detail::float_to_bf16(static_cast<float>(value))) {}
+
+  /** @brief Converts a binary16 value; rounds its mantissa. */
+  explicit constexpr bf16(fp16 value) noexcept : bf16(static_cast<float>(value)) {}
+
+  /** @brief Wraps a raw bfloat16 encoding. */
+  [[nodiscard]] static constexpr bf16 from_bits(uint16 raw) noexcept {
+    bf16 result;
+    result.bits = raw;
+    return result;
+  }
+
+  /** @brief Widens to float exactly. */
+  constexpr operator float() const noexcept {
+    return detail::bf16_to_float(bits);
+  }
+
+  constexpr bf16 &operator+=(float value) noexcept { return *this = *this + value; }
+  constexpr bf16 &operator-=(float value) noexcept { return *this = *this - value; }
+  constexpr bf16 &operator*=(float value) noexcept { return *this = *this * value; }
+  constexpr bf16 &operator/=(float value) noexcept { return *this = *this / value; }
+};
+
+constexpr fp16::fp16(bf16 value) noexcept : fp16(static_cast<float>(value)) {}
+
+static_assert(sizeof(fp16) == 2 && std::is_trivially_copyable_v<fp16>);
+static_assert(sizeof(bf16) == 2 && std::is_trivially_copyable_v<bf16>);
+
+#pragma mark conversions
+//=============================================================================
+// BULK CONVERSIONS
+//=============================================================================
+/** @brief out[i] = static_cast<To>(in[i]) for i in [0, n). */
+template <typename From, typename To>
+void convert_n(const From *in, size_t n, To *out) noexcept {
+#pragma omp simd
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = static_cast<To>(in[i]);
+  }
+}
+
+/** @brief Widens n binary16 values; F16C / AVX-512 when available. */
+inline void convert_n(const fp16 *in, size_t n, float *out) noexcept {
+  size_t i = 0;
+#if defined(__AVX512F__)
+  for (; i + 16 <= n; i += 16) {
+    const __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+    _mm512_storeu_ps(out + i, _mm512_cvtph_ps(h));
+  }
+#elif defined(__F16C__)
+  for (; i + 8 <= n; i += 8) {
+    const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+    _mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+  }
+#endif
+  for (; i < n; ++i) {
+    out[i] = in[i];
+  }
+}
+
+/** @brief Rounds n floats to binary16; F16C / AVX-512 when available. */
+inline void convert_n(const float *in, size_t n, fp16 *out) noexcept {
+  size_t i = 0;
+#if defined(__AVX512F__)
+  for (; i + 16 <= n; i += 16) {
+    const __m256i h = _mm512_cvtps_ph(_mm512_loadu_ps(in + i),
+                                      _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), h);
+  }
+#elif defined(__F16C__)
+  for (; i + 8 <= n; i += 8) {
+    const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i),
+                                      _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), h);
+  }
+#endif
+  for (; i < n; ++i) {
+    out[i] = in[i];
+  }
+}
+
+/** @brief Widens n bfloat16 values (a 16-bit shift, vectorized). */
+inline void convert_n(const bf16 *in, size_t n, float *out) noexcept {
+#pragma omp simd
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = in[i];
+  }
+}
+
+/** @brief Rounds n floats to bfloat16; AVX512-BF16 when available. */
+inline void convert_n(const float *in, size_t n, bf16 *out) noexcept {
+  size_t i = 0;
+#if defined(__AVX512BF16__)
+  const __m512i exponent = _mm512_set1_epi32(0x7f800000);
+  const __m512i mantissa = _mm512_set1_epi32(0x007fffff);
+  for (; i + 16 <= n; i += 16) {
+    const __m512 x = _mm512_loadu_ps(in + i);
+    const __m256bh b = _mm512_cvtneps_pbh(x);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i),
+                        reinterpret_cast<__m256i>(b));
+    // The instruction flushes subnormal inputs to zero; round those lanes in scalar.
+    const __m512i bits = _mm512_castps_si512(x);
+    const __mmask16 subnormal = _mm512_testn_epi32_mask(bits, exponent) &
+                                _mm512_test_epi32_mask(bits, mantissa);
+    for (uint32 lanes = subnormal; lanes != 0; lanes &= lanes - 1) {
+      const size_t j = i + static_cast<size_t>(std::countr_zero(lanes));
+      out[j] = in[j];
+    }
+  }
+#endif
+#pragma omp simd
+  for (size_t j = i; j < n; ++j) {
+    out[j] = in[j];
+  }
+}
+}  // namespace maf::util
+
+#pragma mark std
+//=============================================================================
+// STANDARD LIBRARY TRAITS
+//=============================================================================
+/** @brief A 16-bit float combined with an integer stays 16-bit; with a wider float it
+ * widens to that float. */
+template <maf::util::ReducedFloat H, typename U>
+  requires std::is_arithmetic_v<U>
+struct std::common_type<H, U> {
+  using type = std::conditional_t<std::is_floating_point_v<U>,
+                                  std::common_type_t<float, U>, H>;
+};
+
+template <typename U, maf::util::ReducedFloat H>
+  requires std::is_arithmetic_v<U>
+struct std::common_type<U, H> : std::common_type<H, U> {};
+
+/** @brief binary16 and bfloat16 have no common 16-bit format. */
+template <>
+struct std::common_type<maf::util::fp16, maf::util::bf16> {
+  using type = float;
+};
+
+template <>
+struct std::common_type<maf::util::bf16, maf::util::fp16> {
+  using type = float;
+};
+
+template <>
+class std::numeric_limits<maf::util::fp16> {
+  using fp16 = maf::util::fp16;
+
+ public:
+  static constexpr bool is_specialized = true;
+  static constexpr bool is_signed = true;
+  static constexpr bool is_integer = false;
+  static constexpr bool is_exact = false;
+  static constexpr bool has_infinity = true;
+  static constexpr bool has_quiet_NaN = true;
+  static constexpr bool has_signaling_NaN = true;
+  static constexpr bool is_iec559 = true;
+  static constexpr bool is_bounded = true;
+  static constexpr float_round_style round_style = round_to_nearest;
+  static constexpr int radix = 2;
+  static constexpr int digits = 11;
+  static constexpr int digits10 = 3;
+  static constexpr int max_digits10 = 5;
+  static constexpr int min_exponent = -13;
+  static constexpr int max_exponent = 16;
+
+  static constexpr fp16 min() noexcept { return fp16::from_bits(0x0400); }
+  static constexpr fp16 max() noexcept { return fp16::from_bits(0x7bff); }
+  static constexpr fp16 lowest() noexcept { return fp16::from_bits(0xfbff); }
+  static constexpr fp16 epsilon() noexcept { return fp16::from_bits(0x1400); }
+  static constexpr fp16 round_error() noexcept { return fp16::from_bits(0x3800); }
+  static constexpr fp16 infinity() noexcept { return fp16::from_bits(0x7c00); }
+  static constexpr fp16 quiet_NaN() noexcept { return fp16::from_bits(0x7e00); }
+  static constexpr fp16 signaling_NaN() noexcept { return fp16::from_bits(0x7d00); }
+  static constexpr fp16 denorm_min() noexcept { return fp16::from_bits(0x0001); }
+};
+
+template <>
+class std::numeric_limits<maf::util::bf16> {
+  using bf16 = maf::util::bf16;
+
+ public:
+  static constexpr bool is_specialized = true;
+  static constexpr bool is_signed = true;
+  static constexpr bool is_integer = false;
+  static constexpr bool is_exact = false;
+  static constexpr bool has_infinity = true;
+  static constexpr bool has_quiet_NaN = true;
+  static constexpr bool has_signaling_NaN = true;
+  static constexpr bool is_iec559 = false;
+  static constexpr bool is_bounded = true;
+  static constexpr float_round_style round_style = round_to_nearest;
+  static constexpr int radix = 2;
+  static constexpr int digits = 8;
+  static constexpr int digits10 = 2;
+  static constexpr int max_digits10 = 4;
+  static constexpr int min_exponent = -125;
+  static constexpr int max_exponent = 128;
+
+  static constexpr bf16 min() noexcept { return bf16::from_bits(0x0080); }
+  static constexpr bf16 max() noexcept { return bf16::from_bits(0x7f7f); }
+  static constexpr bf16 lowest() noexcept { return bf16::from_bits(0xff7f); }
+  static constexpr bf16 epsilon() noexcept { return bf16::from_bits(0x3c00); }
+  static constexpr bf16 round_error() noexcept { return bf16::from_bits(0x3f00); }
+  static constexpr bf16 infinity() noexcept { return bf16::from_bits(0x7f80); }
+  static constexpr bf16 quiet_NaN() noexcept { return bf16::from_bits(0x7fc0); }
+  static constexpr bf16 signaling_NaN() noexcept { return bf16::from_bits(0x7fa0); }
+  static constexpr bf16 denorm_min() noexcept { return bf16::from_bits(0x0001); }
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef UTIL_HARDWARE_H
+#define UTIL_HARDWARE_H
+#pragma once
+#include "MafLib/main/GlobalHeader.hpp"
+
+#if defined(__APPLE__)
+#include <sys/sysctl.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace maf::util {
+/** @brief Data cache sizes (in bytes) of the host CPU. */
+struct CacheSizes {
+  size_t l1d;  // Per-core L1 data cache
+  size_t l2;   // Per-core (or per-cluster) L2 cache
+  size_t l3;   // Shared last level cache (0 if not present)
+};
+
+namespace detail {
+/** @brief Conservative defaults used when the OS can not be queried. */
+inline static constexpr CacheSizes DEFAULT_CACHE_SIZES{32UL * 1024UL, 512UL * 1024UL,
+                                                       8UL * 1024UL * 1024UL};
+
+[[nodiscard]] inline CacheSizes query_cache_sizes() {
+  CacheSizes sizes = DEFAULT_CACHE_SIZES;
+#if defined(__APPLE__)
+  auto query = [](const char *name, size_t &out) {
+    int64 value = 0;
+    size_t len = sizeof(value);
+    if (sysctlbyname(name, &value, &len, nullptr, 0) == 0 && value > 0) {
+      out = static_cast<size_t>(value);
+    }
+  };
+  query("hw.l1dcachesize", sizes.l1d);
+  query("hw.l2cachesize", sizes.l2);
+  query("hw.l3cachesize", sizes.l3);
+#elif defined(__linux__) && defined(_SC_LEVEL1_DCACHE_SIZE)
+  auto query = [](int name, size_t &out) {
+    const long value = sysconf(name);
+    if (value > 0) {
+      out = static_cast<size_t>(value);
+    }
+  };
+  query(_SC_LEVEL1_DCACHE_SIZE, sizes.l1d);
+  query(_SC_LEVEL2_CACHE_SIZE, sizes.l2);
+  query(_SC_LEVEL3_CACHE_SIZE, sizes.l3);
+#endif
+  return sizes;
+}
+}  // namespace detail
+
+/**
+ * @brief Returns the data cache sizes of the host CPU.
+ * @details Queried once from the operating system (sysconf on Linux, sysctl on
+ * macOS) and cached; falls back to conservative defaults when unavailable.
+ */
+[[nodiscard]] inline const CacheSizes &cache_sizes() {
+  static const CacheSizes sizes = detail::query_cache_sizes();
+  return sizes;
+}
+
+}  // namespace maf::util
+
+#endif
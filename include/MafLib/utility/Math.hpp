@@ -1,16 +1,23 @@
 #ifndef UTIL_MATH_H
 #define UTIL_MATH_H
 #pragma once
+#include "MafLib/exec/Execution.hpp"
 #include "MafLib/main/GlobalHeader.hpp"
+#include "MafLib/utility/Half.hpp"
+#include "MafLib/utility/Tuning.hpp"
 
 namespace maf::util {
 #pragma mark concepts
 //=============================================================================
 // CONCEPTS
 //=============================================================================
-/** @brief Concept for numeric types. */
+/** @brief Concept for numeric types: arithmetic types and the 16-bit floats. */
 template <typename T>
-concept Numeric = std::is_arithmetic_v<T>;
+concept Numeric = std::is_arithmetic_v<T> || ReducedFloat<T>;
+
+/** @brief Type kernels accumulate T in: float for 16-bit floats, T otherwise. */
+template <typename T>
+using accumulation_t = std::conditional_t<ReducedFloat<T>, float, T>;
 
 #pragma mark enums
 //=============================================================================
@@ -19,18 +26,21 @@ concept Numeric = std::is_arithmetic_v<T>;
 /** @brief Specifies if the vector behaves as a row or column vector. */
 enum Orientation : uint8 { ROW, COLUMN };
 
+/** @brief Storage order of a dense matrix: rows or columns are contiguous. */
+enum class Layout : uint8 { RowMajor, ColMajor };
+
+/** @brief What a matrix reduction collapses: each row (Rows) or each column (Columns). */
+enum class Axis : uint8 { Rows, Columns };
+
+/** @brief The layout whose storage of A^T is identical to the storage of A. */
+[[nodiscard]] constexpr Layout transposed_layout(Layout layout) noexcept {
+  return (layout == Layout::RowMajor) ? Layout::ColMajor : Layout::RowMajor;
+}
+
 #pragma mark constants
 //=============================================================================
 // CONSTANTS
 //=============================================================================
-/*** @brief Constant used as OMP lower bound for linear algorithms. */
-inline static constexpr size_t OMP_LINEAR_LIMIT = 500000UL;
-/*** @brief Constant used as OMP lower bound for quadratic algorithms. */
-inline static constexpr size_t OMP_QUADRATIC_LIMIT = 500UL * 500UL;
-/*** @brief Constant used as OMP lower bound for cubic algorithms. */
-inline static constexpr size_t OMP_CUBIC_LIMIT = 50UL * 50UL;
-/** @brief Block size used in block algorithms. */
-inline static constexpr uint8 BLOCK_SIZE = 16;
 /** @brief Precision for floating point number string conversion. */
 inline static constexpr uint8 FLOAT_PRECISION = 5;
 /** @brief Epsilon value for floating point comparisons. */
@@ -55,8 +65,23 @@ template <typename T, typename U>
   return std::abs(static_cast<R>(v1) - static_cast<R>(v2)) < epsilon;
 }
 
-/** @brief Parallel loop helper that uses OpenMP for large iterations and falls back to
- * a regular loop for smaller sizes.
+/** @brief Loop split of linear kernels: serial up to the linear parallel cutoff. */
+[[nodiscard]] inline exec::Split linear_split() {
+  return {.serial_limit = tuning().omp_linear_limit};
+}
+
+/** @brief Loop split of linear kernels over lines of `elements` entries in total. */
+[[nodiscard]] inline exec::Split linear_split(size_t elements) {
+  return exec::Split::only_if(elements > tuning().omp_linear_limit);
+}
+
+/** @brief Loop split of level-2 kernels touching `elements` matrix entries. */
+[[nodiscard]] inline exec::Split quadratic_split(size_t elements) {
+  return exec::Split::only_if(elements >= tuning().omp_quadratic_limit);
+}
+
+/** @brief Parallel loop helper that runs large iterations on the current execution
+ * context (see exec/Execution.hpp) and falls back to a regular loop for smaller sizes.
  *  @tparam F A callable type that takes a size_t index as an argument.
  *  @param n The number of iterations to perform.
  *  @param fn The function to call for each iteration, which should accept a size_t
@@ -64,20 +89,15 @@ template <typename T, typename U>
  */
 template <std::invocable<size_t> F>
 inline void omp_loop(size_t n, const F &fn) {
-  if (n > OMP_LINEAR_LIMIT) {
-#pragma omp parallel for default(none) shared(fn, n)
-    for (size_t i = 0; i < n; ++i) {
+  exec::parallel_for(0, n, linear_split(), [&fn](size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; ++i) {
       fn(i);
     }
-  } else {
-    for (size_t i = 0; i < n; ++i) {
-      fn(i);
-    }
-  }
+  });
 }
 
-/** @brief Parallel loop helper that uses OpenMP for large iterations and falls back to
- * a regular loop for smaller sizes.
+/** @brief Parallel loop helper that runs large iterations on the current execution
+ * context and falls back to a regular loop for smaller sizes.
  *  @tparam F A callable type that takes a size_t index as an argument.
  *  @param n The number of iterations to perform.
  *  @param m The number of iterations to perform in the inner loop (used to determine if
@@ -87,16 +107,11 @@ inline void omp_loop(size_t n, const F &fn) {
  */
 template <std::invocable<size_t> F>
 inline void omp_loop(size_t n, size_t m, const F &fn) {
-  if (n * m >= OMP_QUADRATIC_LIMIT) {
-#pragma omp parallel for default(none) shared(fn, n, m)
-    for (size_t i = 0; i < n; ++i) {
-      fn(i);
-    }
-  } else {
-    for (size_t i = 0; i < n; ++i) {
+  exec::parallel_for(0, n, quadratic_split(n * m), [&fn](size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; ++i) {
       fn(i);
     }
-  }
+  });
 }
 
 }  // namespace maf::util
@@ -0,0 +1,412 @@
+#ifndef UTIL_MEMORY_H
+#define UTIL_MEMORY_H
+#pragma once
+#include <bit>
+#include <charconv>
+#include <fstream>
+#include <new>
+
+#include "MafLib/exec/Execution.hpp"
+#include "MafLib/main/GlobalHeader.hpp"
+#include "MafLib/utility/Tuning.hpp"
+
+#if defined(__linux__) && __has_include(<linux/mempolicy.h>)
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define MAF_HAS_MBIND 1
+#endif
+
+namespace maf::util {
+#pragma mark constants
+//=============================================================================
+// CONSTANTS
+//=============================================================================
+/** @brief Alignment of Matrix/Vector storage: one cache line, one AVX-512 register. */
+inline static constexpr size_t DEFAULT_ALIGNMENT = 64;
+
+/** @brief Tag selecting constructors that leave elements uninitialized. */
+struct uninitialized_t {
+  explicit uninitialized_t() = default;
+};
+inline constexpr uninitialized_t uninitialized{};
+
+#pragma mark placement
+//=============================================================================
+// NUMA PLACEMENT
+//=============================================================================
+/** @brief Where the pages of large Matrix/Vector buffers are placed on NUMA hosts. */
+enum class Placement : uint8 {
+  FirstTouch,  // Node of the thread that first writes a page (the OS default)
+  Interleave,  // Round-robin over all memory nodes
+  Node,        // Preferably one node, falling back to others when it is full
+};
+
+struct PlacementPolicy {
+  Placement placement = Placement::FirstTouch;
+  /** @brief Node of Placement::Node; -1 selects the node of the allocating thread. */
+  int node = -1;
+};
+
+/** @brief Buffers below this size keep the default placement. */
+inline static constexpr size_t PLACEMENT_MIN_BYTES = 2UL * 1024UL * 1024UL;
+
+namespace detail {
+inline constinit PlacementPolicy default_placement{};
+
+inline const PlacementPolicy *&scoped_placement() noexcept {
+  thread_local const PlacementPolicy *policy = nullptr;
+  return policy;
+}
+
+/** @brief Bit mask of the online memory nodes (bit 0 only when unknown). */
+[[nodiscard]] inline uint64 query_online_nodes() {
+  uint64 mask = 0;
+  std::ifstream in("/sys/devices/system/node/online");
+  std::string list;
+  if (in && std::getline(in, list)) {
+    // Comma-separated ranges such as "0-1,4".
+    for (const auto range : std::views::split(std::string_view(list), ',')) {
+      const std::string_view text(range.begin(), range.end());
+      const size_t dash = text.find('-');
+      unsigned first = 0;
+      unsigned last = 0;
+      std::from_chars(text.data(), text.data() + text.size(), first);
+      last = first;
+      if (dash != std::string_view::npos) {
+        std::from_chars(text.data() + dash + 1, text.data() + text.size(), last);
+      }
+      for (unsigned node = first; node <= last && node < 64; ++node) {
+        mask |= uint64{1} << node;
+      }
+    }
+  }
+  return (mask == 0) ? 1 : mask;
+}
+
+[[nodiscard]] inline uint64 online_nodes() {
+  static const uint64 mask = query_online_nodes();
+  return mask;
+}
+
+/**
+ * @brief Applies policy to the whole pages of [block, block + bytes).
+ * @details Placement is a hint: failures (no NUMA support, invalid node) are ignored
+ * and the pages keep the first-touch default.
+ */
+inline void apply_placement(void *block, size_t bytes,
+                            const PlacementPolicy &policy) noexcept {
+#if defined(MAF_HAS_MBIND)
+  if (policy.placement == Placement::FirstTouch) {
+    return;
+  }
+  const auto page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  const uintptr_t begin = (reinterpret_cast<uintptr_t>(block) + page - 1) & ~(page - 1);
+  const uintptr_t end = (reinterpret_cast<uintptr_t>(block) + bytes) & ~(page - 1);
+  if (begin >= end) {
+    return;
+  }
+  unsigned long mask = 0;
+  int mode = MPOL_PREFERRED;
+  if (policy.placement == Placement::Interleave) {
+    mask = online_nodes();
+    if (std::popcount(mask) < 2) {
+      return;
+    }
+    mode = MPOL_INTERLEAVE;
+  } else if (policy.node >= 0 && policy.node < 64) {
+    mask = 1UL << policy.node;
+  }
+  // An empty mask with MPOL_PREFERRED places pages on the allocating thread's node.
+  syscall(SYS_mbind, begin, end - begin, mode, (mask != 0) ? &mask : nullptr,
+          (mask != 0) ? (sizeof(mask) * 8) + 1 : 0, MPOL_MF_MOVE);
+#else
+  (void)block;
+  (void)bytes;
+  (void)policy;
+#endif
+}
+}  // namespace detail
+
+/** @brief Number of online NUMA memory nodes (1 when unknown or not Linux). */
+[[nodiscard]] inline size_t numa_node_count() {
+  return static_cast<size_t>(std::popcount(detail::online_nodes()));
+}
+
+/** @brief Placement of buffers allocated on this thread (see ScopedPlacement). */
+[[nodiscard]] inline PlacementPolicy placement() noexcept {
+  const PlacementPolicy *scoped = detail::scoped_placement();
+  return (scoped != nullptr) ? *scoped : detail::default_placement;
+}
+
+/**
+ * @brief Replaces the process default placement.
+ * @attention Not synchronized; call it before other threads allocate.
+ */
+inline void set_placement(const PlacementPolicy &policy) noexcept {
+  detail::default_placement = policy;
+}
+
+/**
+ * @brief Applies a placement to buffers allocated on this thread in the scope.
+ * @details Only fresh buffers of at least PLACEMENT_MIN_BYTES are placed; blocks
+ * recycled by a PoolScope keep the pages they already have.
+ */
+class ScopedPlacement {
+ public:
+  explicit ScopedPlacement(const PlacementPolicy &policy) noexcept
+      : _policy(policy),
+        _previous(std::exchange(detail::scoped_placement(), &_policy)) {}
+  ScopedPlacement(const ScopedPlacement &) = delete;
+  ScopedPlacement &operator=(const ScopedPlacement &) = delete;
+  ~ScopedPlacement() { detail::scoped_placement() = _previous; }
+
+ private:
+  PlacementPolicy _policy;
+  const PlacementPolicy *_previous;
+};
+
+/**
+ * @brief data[0, n) = value, split like the element-wise kernels.
+ * @details Each thread writes the contiguous range the element-wise kernels later
+ * give it (and, for row-major GEMM outputs, roughly its rows), so with first-touch
+ * placement the pages land on the node of the thread that processes them.
+ */
+template <typename T>
+void parallel_fill(T *data, size_t n, const T &value) {
+  const exec::Split split{.serial_limit = tuning().omp_linear_limit};
+  exec::parallel_for(0, n, split, [&](size_t lo, size_t hi) {
+    std::fill(data + lo, data + hi, value);
+  });
+}
+
+namespace detail {
+#pragma mark pool
+//=============================================================================
+// THREAD-LOCAL BLOCK POOL
+//=============================================================================
+// Requests are rounded up to size classes with four steps per power of two (at most
+// 25% slack), so any freed block can serve any later request of the same class.
+inline static constexpr size_t POOL_MIN_BYTES = 64;
+inline static constexpr size_t POOL_MAX_BYTES = 256UL * 1024UL * 1024UL;
+inline static constexpr size_t POOL_MAX_CACHED_BYTES = 512UL * 1024UL * 1024UL;
+inline static constexpr size_t POOL_CLASS_COUNT =
+    1 + (4 * (std::bit_width(POOL_MAX_BYTES) - std::bit_width(POOL_MIN_BYTES)));
+
+[[nodiscard]] constexpr size_t pool_class_index(size_t bytes) noexcept {
+  if (bytes <= POOL_MIN_BYTES) {
+    return 0;
+  }
+  const size_t e = std::bit_width(bytes - 1) - 1;  // 2^e < bytes <= 2^(e+1)
+  const size_t step = (size_t{1} << e) / 4;
+  const size_t m = (bytes - (size_t{1} << e) + step - 1) / step;  // 1..4
+  return 1 + ((e - (std::bit_width(POOL_MIN_BYTES) - 1)) * 4) + (m - 1);
+}
+
+[[nodiscard]] constexpr size_t pool_class_size(size_t index) noexcept {
+  if (index == 0) {
+    return POOL_MIN_BYTES;
+  }
+  const size_t e = (std::bit_width(POOL_MIN_BYTES) - 1) + ((index - 1) / 4);
+  const size_t m = ((index - 1) % 4) + 1;
+  return (size_t{1} << e) + (m * ((size_t{1} << e) / 4));
+}
+
+static_assert(pool_class_size(pool_class_index(POOL_MAX_BYTES)) == POOL_MAX_BYTES);
+static_assert(pool_class_index(POOL_MAX_BYTES) < POOL_CLASS_COUNT);
+
+/** @brief Per-thread cache of freed blocks, alive while a PoolScope is alive. */
+class BlockPool {
+ public:
+  BlockPool() = default;
+  BlockPool(const BlockPool &) = delete;
+  BlockPool &operator=(const BlockPool &) = delete;
+  ~BlockPool() {
+    for (auto &list : _free) {
+      for (void *block : list) {
+        ::operator delete(block, std::align_val_t{DEFAULT_ALIGNMENT});
+      }
+    }
+  }
+
+  [[nodiscard]] void *pop(size_t index) noexcept {
+    auto &list = _free[index];
+    if (list.empty()) {
+      return nullptr;
+    }
+    void *block = list.back();
+    list.pop_back();
+    _cached_bytes -= pool_class_size(index);
+    return block;
+  }
+
+  [[nodiscard]] bool push(size_t index, void *block) noexcept {
+    const size_t bytes = pool_class_size(index);
+    if (_cached_bytes + bytes > POOL_MAX_CACHED_BYTES) {
+      return false;
+    }
+    try {
+      _free[index].push_back(block);
+    } catch (...) {
+      return false;
+    }
+    _cached_bytes += bytes;
+    return true;
+  }
+
+  size_t depth = 0;
+
+ private:
+  size_t _cached_bytes = 0;
+  std::array<std::vector<void *>, POOL_CLASS_COUNT> _free{};
+};
+
+// A plain pointer keeps the thread_local trivially destructible, so buffers freed
+// during static destruction never touch a destroyed pool.
+[[nodiscard]] inline BlockPool *&current_pool() noexcept {
+  thread_local BlockPool *pool = nullptr;
+  return pool;
+}
+
+/** @brief Fresh block of `bytes`, placed by the current PlacementPolicy when large. */
+[[nodiscard]] inline void *placed_allocate(size_t bytes, size_t alignment) {
+  void *block = ::operator new(bytes, std::align_val_t{alignment});
+  if (bytes >= PLACEMENT_MIN_BYTES) {
+    apply_placement(block, bytes, placement());
+  }
+  return block;
+}
+
+[[nodiscard]] inline void *aligned_allocate(size_t bytes, size_t alignment) {
+  if (alignment != DEFAULT_ALIGNMENT || bytes > POOL_MAX_BYTES) {
+    return placed_allocate(bytes, alignment);
+  }
+  const size_t index = pool_class_index(bytes);
+  if (BlockPool *pool = current_pool()) {
+    if (void *block = pool->pop(index)) {
+      return block;
+    }
+  }
+  return placed_allocate(pool_class_size(index), alignment);
+}
+
+inline void aligned_deallocate(void *block, size_t bytes, size_t alignment) noexcept {
+  if (alignment == DEFAULT_ALIGNMENT && bytes <= POOL_MAX_BYTES) {
+    BlockPool *pool = current_pool();
+    if (pool != nullptr && pool->push(pool_class_index(bytes), block)) {
+      return;
+    }
+  }
+  ::operator delete(block, std::align_val_t{alignment});
+}
+}  // namespace detail
+
+#pragma mark allocators
+//=============================================================================
+// ALLOCATORS
+//=============================================================================
+/**
+ * @brief Standard allocator returning Alignment-aligned storage.
+ *
+ * Value-less construction default-initializes, so `std::vector::resize(n)` leaves
+ * arithmetic elements uninitialized; callers that need zeros ask for them. Allocations
+ * with the default alignment are served from the thread-local block pool while a
+ * PoolScope is alive on the calling thread.
+ *
+ * @tparam T Element type.
+ * @tparam Alignment Power of two, at least alignof(T).
+ */
+template <typename T, size_t Alignment = DEFAULT_ALIGNMENT>
+class AlignedAllocator {
+  static_assert(std::has_single_bit(Alignment) && Alignment >= alignof(T),
+                "Alignment must be a power of two and at least alignof(T)!");
+
+ public:
+  using value_type = T;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using propagate_on_container_move_assignment = std::true_type;
+  using is_always_equal = std::true_type;
+
+  template <typename U>
+  struct rebind {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  constexpr AlignedAllocator() noexcept = default;
+
+  template <typename U>
+  constexpr AlignedAllocator(const AlignedAllocator<U, Alignment> & /*other*/) noexcept {}
+
+  [[nodiscard]] T *allocate(size_t n) {
+    if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    return static_cast<T *>(detail::aligned_allocate(n * sizeof(T), Alignment));
+  }
+
+  void deallocate(T *block, size_t n) noexcept {
+    detail::aligned_deallocate(block, n * sizeof(T), Alignment);
+  }
+
+  template <typename U>
+  void construct(U *p) noexcept(std::is_nothrow_default_constructible_v<U>) {
+    ::new (static_cast<void *>(p)) U;
+  }
+
+  template <typename U, typename... Args>
+  void construct(U *p, Args &&...args) {
+    ::new (static_cast<void *>(p)) U(std::forward<Args>(args)...);
+  }
+
+  template <typename U>
+  [[nodiscard]] friend constexpr bool operator==(
+      const AlignedAllocator & /*lhs*/,
+      const AlignedAllocator<U, Alignment> & /*rhs*/) noexcept {
+    return true;
+  }
+};
+
+/** @brief Contiguous, DEFAULT_ALIGNMENT-aligned storage used by Matrix and Vector. */
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+/**
+ * @brief Enables block reuse for Matrix/Vector storage on the calling thread.
+ *
+ * While a scope is alive, buffers freed on this thread are cached by size class and
+ * handed out again instead of going back to the system allocator, so loops that
+ * create many short-lived matrices of similar size stop calling malloc. Scopes nest;
+ * the cache is released when the outermost scope ends. Blocks may outlive the scope
+ * and may be freed on any thread.
+ *
+ * @code
+ * util::PoolScope pool;
+ * for (const auto &sample : samples) {
+ *   auto cov = (sample.transposed() * sample) / n;  // reuses the previous buffers
+ * }
+ * @endcode
+ */
+class PoolScope {
+ public:
+  PoolScope() {
+    detail::BlockPool *&pool = detail::current_pool();
+    if (pool == nullptr) {
+      pool = new detail::BlockPool();
+    }
+    ++pool->depth;
+  }
+  PoolScope(const PoolScope &) = delete;
+  PoolScope &operator=(const PoolScope &) = delete;
+  ~PoolScope() {
+    detail::BlockPool *&pool = detail::current_pool();
+    if (--pool->depth == 0) {
+      delete pool;
+      pool = nullptr;
+    }
+  }
+};
+
+}  // namespace maf::util
+
+#endif
@@ -0,0 +1,308 @@
+#ifndef UTIL_TUNING_H
+#define UTIL_TUNING_H
+#pragma once
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+
+#include "MafLib/main/GlobalHeader.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+/**
+ * @file Tuning.hpp
+ * @brief Runtime block sizes and OpenMP parallel cutoffs shared by all kernels.
+ *
+ * Kernels read their thresholds from `util::tuning()` instead of compile-time
+ * constants. The active profile starts at the compile-time defaults below and is
+ * replaced on first use by the profile file of the host, if one exists:
+ *
+ * - `$MAF_TUNING_FILE`, or
+ * - `$XDG_CACHE_HOME/maflib/tuning-<hostname>.conf` (`~/.cache/...` when unset).
+ *
+ * Profiles are written by `math::autotune()` (math/linalg/Autotune.hpp), which
+ * micro-benchmarks the host, or by the `Autotune` benchmark executable. When no
+ * profile exists and `MAF_AUTOTUNE=1` is set, the first kernel call runs the
+ * autotuner and persists its result. The file is plain `key = value` lines. A
+ * profile that can not be read or saved leaves the defaults active and is reported
+ * by tuning_error() instead of an exception from the kernel that triggered it.
+ *
+ * @attention The profile is process-global and not synchronized. Call set_tuning()
+ * (or trigger the first-use autotuning) before kernels run on other threads.
+ */
+namespace maf::util {
+#pragma mark defaults
+//=============================================================================
+// DEFAULTS
+//=============================================================================
+/*** @brief Default OMP lower bound for linear algorithms. */
+inline static constexpr size_t OMP_LINEAR_LIMIT = 500000UL;
+/*** @brief Default OMP lower bound for quadratic algorithms. */
+inline static constexpr size_t OMP_QUADRATIC_LIMIT = 500UL * 500UL;
+/*** @brief Default OMP lower bound for cubic algorithms. */
+inline static constexpr size_t OMP_CUBIC_LIMIT = 50UL * 50UL;
+/** @brief Default block size used in block algorithms. */
+inline static constexpr uint8 BLOCK_SIZE = 16;
+/** @brief Default tile order of the tiled Cholesky factorization. */
+inline static constexpr size_t CHOLESKY_TILE = 128;
+
+/**
+ * @brief Block sizes and parallel cutoffs read by the kernels at runtime.
+ * @details A kernel runs in parallel when its problem size exceeds the limit of its
+ * complexity class. Cubic kernels (GEMM) compare multiply-adds against
+ * `50 * omp_cubic_limit`, i.e. 50^3 by default.
+ */
+struct TuningProfile {
+  /** @brief Elements above which element-wise and reduction loops run in parallel. */
+  size_t omp_linear_limit = OMP_LINEAR_LIMIT;
+  /** @brief Matrix elements above which level-2 kernels run in parallel. */
+  size_t omp_quadratic_limit = OMP_QUADRATIC_LIMIT;
+  /** @brief Parallel cutoff of cubic kernels (see above). */
+  size_t omp_cubic_limit = OMP_CUBIC_LIMIT;
+  /** @brief Widest panel the built-in LU factorization factors element by element. */
+  size_t block_size = BLOCK_SIZE;
+  /** @brief Remaining rows above which LU panel and update loops run in parallel. */
+  size_t lu_parallel_limit = 256;
+  /** @brief Tile order of the built-in tiled Cholesky factorization. */
+  size_t cholesky_tile = CHOLESKY_TILE;
+  /** @brief Matrix order above which the Cholesky tile tasks run in parallel. */
+  size_t cholesky_parallel_limit = 1000;
+
+  bool operator==(const TuningProfile &) const = default;
+};
+
+namespace detail {
+/** @brief Profile file key of a field. */
+struct TuningField {
+  std::string_view key;
+  size_t TuningProfile::*member;
+};
+
+inline constexpr std::array<TuningField, 7> TUNING_FIELDS{{
+    {"omp_linear_limit", &TuningProfile::omp_linear_limit},
+    {"omp_quadratic_limit", &TuningProfile::omp_quadratic_limit},
+    {"omp_cubic_limit", &TuningProfile::omp_cubic_limit},
+    {"block_size", &TuningProfile::block_size},
+    {"lu_parallel_limit", &TuningProfile::lu_parallel_limit},
+    {"cholesky_tile", &TuningProfile::cholesky_tile},
+    {"cholesky_parallel_limit", &TuningProfile::cholesky_parallel_limit},
+}};
+
+inline void validate(const TuningProfile &profile) {
+  if (profile.block_size == 0) {
+    throw std::invalid_argument("Tuning block_size must be positive!");
+  }
+  if (profile.cholesky_tile == 0) {
+    throw std::invalid_argument("Tuning cholesky_tile must be positive!");
+  }
+}
+
+/** @brief Strips blanks from both ends. */
+[[nodiscard]] inline std::string_view trim(std::string_view text) noexcept {
+  const size_t first = text.find_first_not_of(" \t\r");
+  if (first == std::string_view::npos) {
+    return {};
+  }
+  return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+}
+}  // namespace detail
+
+#pragma mark files
+//=============================================================================
+// PROFILE FILES
+//=============================================================================
+/**
+ * @brief Reads a profile written by save_tuning().
+ * @details Blank lines and `#` comments are skipped and unknown keys are ignored, so
+ * older builds can read newer profiles. Missing keys keep their defaults.
+ * @throws std::runtime_error if the file can not be opened.
+ * @throws std::invalid_argument if a line is not `key = unsigned integer` or the
+ * resulting profile is invalid.
+ */
+[[nodiscard]] inline TuningProfile load_tuning(const std::filesystem::path &path) {
+  std::ifstream in(path);
+  if (!in) {
+    throw std::runtime_error("Could not open tuning profile " + path.string() + "!");
+  }
+
+  TuningProfile profile;
+  std::string line;
+  while (std::getline(in, line)) {
+    const std::string_view text =
+        detail::trim(std::string_view(line).substr(0, line.find('#')));
+    if (text.empty()) {
+      continue;
+    }
+    const size_t eq = text.find('=');
+    if (eq == std::string_view::npos) {
+      throw std::invalid_argument("Malformed tuning profile line: " + line);
+    }
+    const std::string_view key = detail::trim(text.substr(0, eq));
+    const std::string_view value = detail::trim(text.substr(eq + 1));
+    const auto *field =
+        std::ranges::find(detail::TUNING_FIELDS, key, &detail::TuningField::key);
+    if (field == detail::TUNING_FIELDS.end()) {
+      continue;
+    }
+    size_t parsed = 0;
+    const auto [end, error] =
+        std::from_chars(value.data(), value.data() + value.size(), parsed);
+    if (error != std::errc() || end != value.data() + value.size()) {
+      throw std::invalid_argument("Malformed tuning profile value: " + line);
+    }
+    profile.*(field->member) = parsed;
+  }
+  detail::validate(profile);
+  return profile;
+}
+
+/**
+ * @brief Writes a profile as `key = value` lines, creating parent directories.
+ * @throws std::runtime_error if the file can not be written.
+ */
+inline void save_tuning(const TuningProfile &profile,
+                        const std::filesystem::path &path) {
+  std::error_code error;
+  if (path.has_parent_path()) {
+    std::filesystem::create_directories(path.parent_path(), error);
+  }
+  std::ofstream out(path);
+  if (!out) {
+    throw std::runtime_error("Could not write tuning profile " + path.string() + "!");
+  }
+  out << "# MafLib tuning profile (" << omp_get_max_threads() << " threads)\n";
+  for (const auto &field : detail::TUNING_FIELDS) {
+    out << field.key << " = " << profile.*(field.member) << '\n';
+  }
+  if (!out) {
+    throw std::runtime_error("Could not write tuning profile " + path.string() + "!");
+  }
+}
+
+/**
+ * @brief Profile file of this host: `$MAF_TUNING_FILE`, or
+ * `<cache dir>/maflib/tuning-<hostname>.conf`.
+ * @details The host name keeps nodes that share a home directory apart.
+ */
+[[nodiscard]] inline std::filesystem::path default_tuning_path() {
+  if (const char *file = std::getenv("MAF_TUNING_FILE"); file != nullptr && *file) {
+    return file;
+  }
+
+  std::filesystem::path dir;
+  if (const char *cache = std::getenv("XDG_CACHE_HOME"); cache != nullptr && *cache) {
+    dir = cache;
+  } else if (const char *home = std::getenv("HOME"); home != nullptr && *home) {
+    dir = std::filesystem::path(home) / ".cache";
+  } else {
+    dir = std::filesystem::temp_directory_path();
+  }
+
+  std::string host = "local";
+#if defined(__unix__) || defined(__APPLE__)
+  std::array<char, 256> name{};
+  if (gethostname(name.data(), name.size() - 1) == 0 && name[0] != '\0') {
+    host = name.data();
+  }
+#endif
+  return dir / "maflib" / ("tuning-" + host + ".conf");
+}
+
+#pragma mark active profile
+//=============================================================================
+// ACTIVE PROFILE
+//=============================================================================
+namespace detail {
+inline constinit TuningProfile active_tuning{};
+inline std::atomic<bool> tuning_ready{false};
+/** @brief Set while the first-use autotuner runs, see initialize_tuning(). */
+inline std::atomic<bool> tuning_in_progress{false};
+inline std::string tuning_failure;
+
+/** @brief Benchmarks the host; registered by math/linalg/Autotune.hpp. */
+inline TuningProfile (*autotuner)() = nullptr;
+
+[[nodiscard]] inline bool autotune_requested() noexcept {
+  const char *flag = std::getenv("MAF_AUTOTUNE");
+  return flag != nullptr && *flag != '\0' && std::string_view(flag) != "0";
+}
+
+/**
+ * @brief Loads the host profile, or autotunes when requested and none exists.
+ * @details The profile is published only once it is complete. While the autotuner
+ * runs, the kernels it times (on any thread) return at once and read the trial
+ * profiles it installs, instead of waiting for the lock their caller holds.
+ */
+inline void initialize_tuning() {
+  if (tuning_in_progress.load(std::memory_order_acquire)) {
+    return;
+  }
+  static std::mutex mutex;
+  const std::scoped_lock lock(mutex);
+  if (tuning_ready.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  TuningProfile profile;
+  try {
+    const std::filesystem::path path = default_tuning_path();
+    std::error_code error;
+    if (std::filesystem::exists(path, error)) {
+      profile = load_tuning(path);
+    } else if (autotuner != nullptr && autotune_requested()) {
+      struct InProgress {
+        InProgress() { tuning_in_progress.store(true, std::memory_order_release); }
+        ~InProgress() { tuning_in_progress.store(false, std::memory_order_release); }
+      } in_progress;
+      profile = autotuner();
+      save_tuning(profile, path);
+    }
+  } catch (const std::exception &e) {
+    tuning_failure = e.what();
+  }
+  active_tuning = profile;
+  tuning_ready.store(true, std::memory_order_release);
+}
+}  // namespace detail
+
+/**
+ * @brief The active tuning profile.
+ * @details The first call loads the host profile (see the file comment); later
+ * calls are a single atomic load.
+ */
+[[nodiscard]] inline const TuningProfile &tuning() {
+  if (!detail::tuning_ready.load(std::memory_order_acquire)) [[unlikely]] {
+    detail::initialize_tuning();
+  }
+  return detail::active_tuning;
+}
+
+/**
+ * @brief The error met while loading the host profile (the defaults stay active) or
+ * saving the autotuned one (which is active); empty when none occurred.
+ */
+[[nodiscard]] inline std::string_view tuning_error() {
+  (void)tuning();
+  return detail::tuning_failure;
+}
+
+/**
+ * @brief Replaces the active profile; the host profile file is no longer loaded.
+ * @details The trial profiles of the first-use autotuner are not published as the
+ * final profile.
+ * @throws std::invalid_argument if block_size or cholesky_tile is zero.
+ */
+inline void set_tuning(const TuningProfile &profile) {
+  detail::validate(profile);
+  detail::active_tuning = profile;
+  if (!detail::tuning_in_progress.load(std::memory_order_acquire)) {
+    detail::tuning_ready.store(true, std::memory_order_release);
+  }
+}
+
+}  // namespace maf::util
+
+#endif
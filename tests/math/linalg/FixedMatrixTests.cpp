@@ -0,0 +1,153 @@
+#include "ITest.hpp"
+#include "MafLib/main/GlobalHeader.hpp"
+#include "MafLib/math/linalg/FixedMatrix.hpp"
+#include "MafLib/math/linalg/Matrix.hpp"
+#include "MafLib/math/linalg/MatrixCheckers.hpp"
+#include "MafLib/math/linalg/Vector.hpp"
+#include "MafLib/math/linalg/ViewKernels.hpp"
+#include "MafLib/utility/Math.hpp"
+
+namespace maf::test {
+
+using namespace maf;
+using namespace maf::math;
+using namespace maf::util;
+
+class FixedMatrixTests : public ITest {
+ private:
+  //=============================================================================
+  // CONSTRUCTORS & ACCESS TESTS
+  //=============================================================================
+  void should_construct_zero_filled_and_from_values() {
+    constexpr FixedMatrix<int, 2, 3> zeros;
+    static_assert(zeros[1, 2] == 0);
+    ASSERT_TRUE(zeros.size() == 6);
+
+    constexpr FixedMatrix<double, 2, 2> A(1, 2, 3, 4);
+    static_assert(A[1, 0] == 3.0);
+    ASSERT_TRUE(A.at(0, 1) == 2.0);
+    ASSERT_THROW(A.at(2, 0), std::out_of_range);
+
+    constexpr FixedVector<float, 3> v(1, 2, 3);
+    static_assert(v[2] == 3.0f);
+    ASSERT_THROW(v.at(3), std::out_of_range);
+  }
+
+  void should_convert_to_and_from_dynamic_types() {
+    Matrix<double> M(2, 3, {1.0, 2.0, 3.0, 4.0, 5.0, 6.0});
+    FixedMatrix<double, 2, 3> F(M);
+    ASSERT_TRUE((F[1, 2] == 6.0));
+    ASSERT_TRUE(F.to_matrix() == M);
+    ASSERT_THROW((FixedMatrix<double, 3, 2>(M)), std::invalid_argument);
+
+    FixedMatrix<double, 2, 2> block(M.view(0, 1, 2, 2));
+    ASSERT_TRUE((block[1, 1] == 6.0));
+
+    Vector<int> v(3, std::vector<int>{7, 8, 9});
+    FixedVector<int, 3> fv(v);
+    ASSERT_TRUE(fv[1] == 8);
+    ASSERT_TRUE(fv.to_vector() == v);
+    ASSERT_THROW((FixedVector<int, 2>(v)), std::invalid_argument);
+
+    // Views let fixed types feed the dynamic kernels.
+    auto y = kernels::gemv(kernels::OP::NoTrans, F.view(), fv.view());
+    ASSERT_TRUE(y[0] == 1.0 * 7 + 2.0 * 8 + 3.0 * 9);
+  }
+
+  //=============================================================================
+  // ARITHMETIC TESTS
+  //=============================================================================
+  void should_multiply_and_promote_types() {
+    constexpr FixedMatrix<int, 2, 3> A(1, 2, 3, 4, 5, 6);
+    constexpr FixedMatrix<double, 3, 2> B(1.0, 0.5, 0.0, 1.0, 2.0, 0.0);
+    using Fixed2x2 = FixedMatrix<double, 2, 2>;
+    using Fixed2x3 = FixedMatrix<double, 2, 3>;
+    constexpr auto C = A * B;
+    ASSERT_SAME_TYPE(C, Fixed2x2);
+    static_assert(C[0, 0] == 7.0 && C[0, 1] == 2.5 && C[1, 0] == 16.0);
+
+    const auto dynamic = A.to_matrix() * B.to_matrix();
+    ASSERT_TRUE(loosely_equal(Fixed2x2(dynamic), C));
+
+    constexpr auto y = A * FixedVector<int, 3>(1, 1, 1);
+    static_assert(y == FixedVector<int, 2>(6, 15));
+
+    constexpr auto half = A / 2;
+    ASSERT_SAME_TYPE(half, Fixed2x3);
+    static_assert(half[0, 0] == 0.5);
+
+    constexpr auto S = (A + A) - (2 * A);
+    static_assert(S == FixedMatrix<int, 2, 3>());
+    static_assert(A.transposed()[2, 1] == 6);
+  }
+
+  void should_compute_vector_products() {
+    constexpr FixedVector<double, 3> x(1, 0, 0);
+    constexpr FixedVector<double, 3> y(0, 1, 0);
+    static_assert(x.cross(y) == FixedVector<double, 3>(0, 0, 1));
+    static_assert(x.dot(y) == 0.0);
+    static_assert(FixedVector<int, 2>(3, 4).norm() == 5.0);
+    ASSERT_TRUE(is_close((x + y).norm(), std::sqrt(2.0)));
+  }
+
+  //=============================================================================
+  // DECOMPOSITION TESTS
+  //=============================================================================
+  void should_compute_determinant_and_inverse_for_small_sizes() {
+    constexpr FixedMatrix<int, 2, 2> A2(4, 7, 2, 6);
+    static_assert(A2.determinant() == 10.0);
+    constexpr auto inv2 = A2.inverted();
+    ASSERT_TRUE(loosely_equal(A2 * inv2, FixedMatrix<double, 2, 2>::identity()));
+
+    constexpr FixedMatrix<double, 3, 3> A3(2, 0, 1, 1, 3, 2, 1, 1, 2);
+    static_assert(A3.determinant() == 6.0);
+    ASSERT_TRUE(loosely_equal(A3 * A3.inverted(), FixedMatrix<double, 3, 3>::identity()));
+
+    FixedMatrix<double, 5, 5> A5;
+    for (size_t i = 0; i < 5; ++i) {
+      for (size_t j = 0; j < 5; ++j) {
+        A5[i, j] = (i == j) ? 10.0 : static_cast<double>(i + (2 * j)) / 7.0;
+      }
+    }
+    ASSERT_TRUE(is_close(A5.determinant(), A5.to_matrix().determinant(), 1e-6));
+    ASSERT_TRUE(loosely_equal(A5.inverted() * A5, FixedMatrix<double, 5, 5>::identity()));
+
+    constexpr FixedMatrix<double, 4, 4> singular(1, 2, 3, 4, 2, 4, 6, 8, 0, 1, 0, 1, 1,
+                                                 0, 1, 0);
+    ASSERT_TRUE(singular.determinant() == 0.0);
+    ASSERT_THROW(singular.inverted(), std::runtime_error);
+    ASSERT_THROW((FixedMatrix<int, 2, 2>(1, 2, 2, 4).inverted()), std::runtime_error);
+  }
+
+  void should_solve_with_lu_and_cholesky() {
+    constexpr FixedMatrix<double, 3, 3> A(4, 12, -16, 12, 37, -43, -16, -43, 98);
+    constexpr auto L = cholesky(A);
+    static_assert(L[0, 0] == 2.0 && L[1, 0] == 6.0 && L[2, 2] == 3.0);
+    ASSERT_TRUE(loosely_equal(L * L.transposed(), A));
+
+    constexpr FixedVector<double, 3> b(1, 2, 3);
+    const auto x_lu = solve(A, b);
+    const auto x_spd = solve<true>(A, b);
+    ASSERT_TRUE((x_lu - x_spd).norm() < 1e-9);
+    const auto residual = (A * x_lu) - b;
+    ASSERT_TRUE(residual.norm() < 1e-9);
+
+    ASSERT_THROW(cholesky(FixedMatrix<double, 2, 2>(1, 2, 3, 4)), std::invalid_argument);
+    ASSERT_THROW(cholesky(FixedMatrix<double, 2, 2>(1, 2, 2, 1)), std::invalid_argument);
+    ASSERT_THROW(solve(FixedMatrix<int, 2, 2>(1, 2, 2, 4), FixedVector<int, 2>(1, 1)),
+                 std::runtime_error);
+  }
+
+ public:
+  int run_all_tests() override {
+    should_construct_zero_filled_and_from_values();
+    should_convert_to_and_from_dynamic_types();
+    should_multiply_and_promote_types();
+    should_compute_vector_products();
+    should_compute_determinant_and_inverse_for_small_sizes();
+    should_solve_with_lu_and_cholesky();
+    return 0;
+  }
+};
+
+}  // namespace maf::test
@@ -1,3 +1,4 @@
+#include "FixedMatrixTests.cpp"
 #include "MafLib/main/GlobalHeader.hpp"
 #include "MatrixTests.cpp"
 #include "VectorTests.cpp"
@@ -20,5 +21,10 @@ int main() {
   view_tests.run_all_tests();
   view_tests.print_summary();
 
+  std::cout << "\n=== Running FixedMatrix tests ===" << std::endl;
+  auto fixed_matrix_tests = maf::test::FixedMatrixTests();
+  fixed_matrix_tests.run_all_tests();
+  fixed_matrix_tests.print_summary();
+
   return 0;
 }
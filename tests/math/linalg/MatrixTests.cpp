@@ -27,6 +27,60 @@ class MatrixTests : public ITest {
     ASSERT_TRUE(m.size() == 4);
   }
 
+  void should_allocate_aligned_storage_and_reuse_it_in_pool_scope() {
+    math::Matrix<double> zeros(3, 5);
+    ASSERT_TRUE(reinterpret_cast<uintptr_t>(zeros.data()) % DEFAULT_ALIGNMENT == 0);
+    for (size_t i = 0; i < zeros.size(); ++i) {
+      ASSERT_TRUE(zeros.data()[i] == 0.0);
+    }
+
+    math::Matrix<float> raw(7, 3, uninitialized);
+    ASSERT_TRUE(raw.row_count() == 7 && raw.column_count() == 3);
+    ASSERT_TRUE(reinterpret_cast<uintptr_t>(raw.data()) % DEFAULT_ALIGNMENT == 0);
+
+    PoolScope pool;
+    const double *first = nullptr;
+    {
+      math::Matrix<double> tmp(16, 16, uninitialized);
+      first = tmp.data();
+    }
+    math::Matrix<double> reused(16, 16);
+    ASSERT_TRUE(reused.data() == first);
+    ASSERT_TRUE(reused.at(15, 15) == 0.0);
+  }
+
+  void should_zero_large_buffers_under_every_placement() {
+    ASSERT_TRUE(numa_node_count() >= 1);
+    const TuningProfile saved = tuning();
+    TuningProfile eager = saved;
+    eager.omp_linear_limit = 0;  // Zero in parallel even for this size.
+    set_tuning(eager);
+
+    for (const PlacementPolicy &policy :
+         {PlacementPolicy{}, PlacementPolicy{.placement = Placement::Interleave},
+          PlacementPolicy{.placement = Placement::Node, .node = 0},
+          PlacementPolicy{.placement = Placement::Node}}) {
+      const ScopedPlacement scope(policy);
+      ASSERT_TRUE(placement().placement == policy.placement);
+      math::Matrix<double> a(512, 1024);
+      ASSERT_TRUE(std::ranges::all_of(std::span(a.data(), a.size()),
+                                      [](double x) { return x == 0.0; }));
+      math::Vector<float> v(1UL << 20);
+      ASSERT_TRUE(v[0] == 0.0F && v[v.size() - 1] == 0.0F);
+#if defined(MAF_HAS_MBIND)
+      if (policy.placement == Placement::Node && policy.node == 0) {
+        int mode = -1;
+        unsigned long nodes = 0;
+        const long status = syscall(SYS_get_mempolicy, &mode, &nodes, 65,
+                                    a.data() + (a.size() / 2), MPOL_F_ADDR);
+        ASSERT_TRUE(status != 0 || (mode == MPOL_PREFERRED && nodes == 1));
+      }
+#endif
+    }
+    ASSERT_TRUE(placement().placement == Placement::FirstTouch);
+    set_tuning(saved);
+  }
+
   void should_throw_if_constructed_with_zero_dimensions() {
     bool thrown = false;
     try {
@@ -328,6 +382,207 @@ class MatrixTests : public ITest {
     ASSERT_TRUE(is_close(c.at(1, 1), 12.0f));
   }
 
+  //=============================================================================
+  // ELEMENT-WISE MAP TESTS
+  //=============================================================================
+  void should_map_zip_map_and_apply_inplace() {
+    math::Matrix<int> a(2, 3, {1, 2, 3, 4, 5, 6});
+    auto half = a.map([](int x) { return x / 2.0; });
+    ASSERT_SAME_TYPE(half, math::Matrix<double>);
+    ASSERT_TRUE(half.at(1, 2) == 3.0 && half.at(0, 0) == 0.5);
+
+    math::Matrix<float> b(2, 3, {6, 5, 4, 3, 2, 1});
+    auto diff = a.zip_map(b, [](int x, float y) { return x - y; });
+    ASSERT_SAME_TYPE(diff, math::Matrix<float>);
+    ASSERT_TRUE(diff.at(0, 0) == -5.0F && diff.at(1, 2) == 5.0F);
+    ASSERT_THROW(a.zip_map(math::Matrix<int>(3, 2), [](int x, int y) { return x * y; }),
+                 std::invalid_argument);
+
+    a.apply_inplace([](int x) { return x * x; }).apply_inplace([](int x) { return -x; });
+    ASSERT_TRUE(a.at(1, 1) == -25);
+
+    math::Matrix<double, Layout::ColMajor> c(2, 2, {1, 3, 2, 4});
+    using ColMatrix = math::Matrix<double, Layout::ColMajor>;
+    auto e = c.map(math::vmath::exp);
+    ASSERT_SAME_TYPE(e, ColMatrix);
+    ASSERT_TRUE(is_close(e.at(0, 1), std::exp(2.0), 1e-14));
+    ASSERT_TRUE(is_close(e.at(1, 0), std::exp(3.0), 1e-13));
+
+    // Large enough to take the parallel path.
+    math::Matrix<float> big(800, 800);
+    big.fill(0.5F);
+    big.apply_inplace(math::vmath::tanh);
+    ASSERT_TRUE(is_close(big.at(799, 799), std::tanh(0.5F), 1e-7));
+    ASSERT_TRUE(is_close(big.at(0, 0), std::tanh(0.5F), 1e-7));
+
+    // A stateful callable is not vectorized and sees the elements in storage order.
+    int count = 0;
+    auto order = big.map([&count](float) { return count++; });
+    ASSERT_TRUE(count == 640000 && order.at(0, 1) == 1 && order.at(799, 799) == 639999);
+    ColMatrix col_big(300, 300);
+    count = 0;
+    col_big.apply_inplace([&count](double) { return count++; });
+    ASSERT_TRUE(col_big.at(1, 0) == 1.0 && col_big.at(0, 1) == 300.0);
+
+    static_assert(math::kernels::Vectorizable<decltype(math::vmath::exp)>);
+    auto square = math::vmath::vectorized([](float x) { return x * x; });
+    static_assert(math::kernels::Vectorizable<decltype(square)>);
+    static_assert(!math::kernels::Vectorizable<decltype([](float x) { return x; })>);
+    auto squares = big.map(square);
+    ASSERT_TRUE(is_close(squares.at(799, 0), big.at(799, 0) * big.at(799, 0), 1e-7));
+  }
+
+  template <typename T, typename F, typename G>
+  void check_ulp(F vm, G ref, T lo, T hi, T max_ulp) {
+    // The reference and the ULP are evaluated in long double, and the arguments are
+    // stored first so that both functions see the same rounded x. Under -ffast-math a
+    // T loop may use the less accurate libmvec functions and flush the ULP of tiny
+    // results to zero.
+    constexpr int N = 20000;
+    std::vector<T> xs(N + 1);
+    for (int k = 0; k <= N; ++k) {
+      xs[k] = lo + ((hi - lo) * static_cast<T>(k) / N);
+    }
+    long double worst = 0;
+    for (const T x : xs) {
+      const long double expected = ref(static_cast<long double>(x));
+      const T rounded = std::abs(static_cast<T>(expected));
+      const T next = std::nextafter(rounded, std::numeric_limits<T>::max());
+      const long double ulp = static_cast<long double>(next) - rounded;
+      const long double error = std::abs(static_cast<long double>(vm(x)) - expected);
+      worst = std::max(worst, error / ulp);
+    }
+    ASSERT_TRUE(worst <= max_ulp);
+  }
+
+  template <typename T>
+  void check_vectorized_math() {
+    using math::vmath::erf;
+    using math::vmath::exp;
+    using math::vmath::log;
+    using math::vmath::tanh;
+    using L = long double;
+    check_ulp<T>(exp, [](L x) { return std::exp(x); }, T(-80), T(80), T(2));
+    check_ulp<T>(log, [](L x) { return std::log(x); }, T(1e-30), T(1e3), T(2));
+    check_ulp<T>(tanh, [](L x) { return std::tanh(x); }, T(-10), T(10), T(2));
+    check_ulp<T>(erf, [](L x) { return std::erf(x); }, T(-7), T(7), T(2));
+
+    // inf and NaN are compared on their bits, so that the checks also hold in builds
+    // with -ffast-math, which folds std::isnan and comparisons with inf.
+    using math::vmath::detail::is_nan;
+    using Bits = math::vmath::detail::bits_t<T>;
+    auto same = [](T a, T b) {
+      return std::bit_cast<Bits>(a) == std::bit_cast<Bits>(b);
+    };
+    const T inf = math::vmath::detail::infinity<T>();
+    const T nan = math::vmath::detail::quiet_nan<T>();
+    ASSERT_TRUE(exp(-inf) == T(0) && same(exp(inf), inf) && same(exp(T(1000)), inf));
+    ASSERT_TRUE(same(log(T(0)), -inf) && same(log(inf), inf) && is_nan(log(T(-1))));
+    ASSERT_TRUE(log(std::numeric_limits<T>::denorm_min()) < T(-100));
+    ASSERT_TRUE(tanh(inf) == T(1) && tanh(-inf) == T(-1));
+    ASSERT_TRUE(erf(inf) == T(1) && erf(-inf) == T(-1) && erf(T(0)) == T(0));
+    ASSERT_TRUE(is_nan(exp(nan)) && is_nan(log(nan)) && is_nan(tanh(nan)) &&
+                is_nan(erf(nan)));
+  }
+
+  void should_evaluate_vectorized_math_within_ulp_bounds() {
+    check_vectorized_math<double>();
+    check_vectorized_math<float>();
+    ASSERT_SAME_TYPE(math::vmath::sqrt(4), double);
+    ASSERT_TRUE(math::vmath::sqrt(4) == 2.0);
+  }
+
+  //=============================================================================
+  // REDUCTION & BROADCASTING TESTS
+  //=============================================================================
+  void should_reduce_rows_and_columns() {
+    // 1 5 3
+    // 4 2 6
+    math::Matrix<int> a(2, 3, {1, 5, 3, 4, 2, 6});
+    math::Matrix<int, Layout::ColMajor> c(a);
+    for (const auto &s : {math::sum(a, Axis::Rows), math::sum(c, Axis::Rows)}) {
+      ASSERT_TRUE(s.orientation() == math::COLUMN && s.size() == 2);
+      ASSERT_TRUE(s[0] == 9 && s[1] == 12);
+    }
+    for (const auto &s : {math::sum(a, Axis::Columns), math::sum(c, Axis::Columns)}) {
+      ASSERT_TRUE(s.orientation() == math::ROW && s.size() == 3);
+      ASSERT_TRUE(s[0] == 5 && s[1] == 7 && s[2] == 9);
+    }
+
+    auto mean = math::mean(a, Axis::Columns);
+    ASSERT_SAME_TYPE(mean, math::Vector<double>);
+    ASSERT_TRUE(mean[0] == 2.5 && mean[2] == 4.5);
+    ASSERT_TRUE(math::min(c, Axis::Rows)[1] == 2 && math::max(a, Axis::Columns)[1] == 5);
+    ASSERT_TRUE(math::argmax(a, Axis::Rows)[0] == 1 && math::argmax(c, Axis::Rows)[1] == 2);
+    ASSERT_TRUE(math::argmin(a, Axis::Columns)[1] == 1 &&
+                math::argmin(c, Axis::Columns)[2] == 0);
+
+    // Ties resolve to the first index; views of any strides are accepted.
+    math::Matrix<double> t(3, 2, {7, 7, 1, 9, 9, 0});
+    auto first = math::argmax(t.transposed_view(), Axis::Rows);
+    ASSERT_TRUE(first[0] == 2 && first[1] == 1);
+    ASSERT_TRUE(math::argmax(t, Axis::Rows)[0] == 0);
+    auto norms = math::norm(t.view(1, 0, 2, 2), Axis::Columns);
+    ASSERT_TRUE(is_close(norms[0], std::sqrt(82.0)) && norms[1] == 9.0);
+    ASSERT_TRUE(math::sum(t.view(0, 1, 3, 1), Axis::Columns)[0] == 16.0);
+  }
+
+  void should_reduce_large_matrices_along_both_axes() {
+    const size_t m = 1100;
+    const size_t n = 700;
+    math::Matrix<float> a(m, n, uninitialized);
+    for (size_t i = 0; i < m; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        a.at(i, j) = static_cast<float>((i + (2 * j)) % 17);
+      }
+    }
+    a.at(1000, 650) = 50.0F;
+    a.at(3, 650) = -1.0F;
+
+    auto cols = math::sum(a, Axis::Columns);
+    auto rows = math::sum(a, Axis::Rows);
+    auto col_max = math::argmax(a, Axis::Columns);
+    auto col_min = math::argmin(a, Axis::Columns);
+    for (size_t j : {size_t{0}, size_t{333}, n - 1}) {
+      double expected = 0.0;
+      for (size_t i = 0; i < m; ++i) {
+        expected += a.at(i, j);
+      }
+      ASSERT_TRUE(cols[j] == static_cast<float>(expected));
+    }
+    double row_sum = 0.0;
+    for (size_t j = 0; j < n; ++j) {
+      row_sum += a.at(17, j);
+    }
+    ASSERT_TRUE(rows[17] == static_cast<float>(row_sum));
+    ASSERT_TRUE(col_max[650] == 1000 && col_min[650] == 3);
+    ASSERT_TRUE(math::max(a, Axis::Columns)[650] == 50.0F);
+  }
+
+  void should_broadcast_vectors_across_matrices() {
+    math::Matrix<double> a(2, 3, {1, 2, 3, 4, 5, 6});
+    math::Vector<double> row(3, std::vector<double>{1, 2, 3}, math::ROW);
+    math::Vector<int> col(2, std::vector<int>{10, 20}, math::COLUMN);
+
+    auto centered = a - math::mean(a, Axis::Columns);
+    ASSERT_TRUE(centered.at(0, 0) == -1.5 && centered.at(1, 2) == 1.5);
+    auto shifted = col + a;
+    ASSERT_TRUE(shifted.at(0, 2) == 13.0 && shifted.at(1, 0) == 24.0);
+    auto scaled = math::broadcast(a, col, std::multiplies<>());
+    ASSERT_TRUE(scaled.at(0, 1) == 20.0 && scaled.at(1, 2) == 120.0);
+
+    math::Matrix<double, Layout::ColMajor> c(a);
+    c -= row;
+    ASSERT_TRUE(c.at(0, 0) == 0.0 && c.at(1, 2) == 3.0);
+    c += col;
+    ASSERT_TRUE(c.at(1, 1) == 23.0);
+    math::broadcast_inplace(c, row, [](double x, double y) { return x / y; });
+    ASSERT_TRUE(c.at(1, 1) == 11.5);
+
+    ASSERT_THROW(a - col.transposed(), std::invalid_argument);
+    ASSERT_THROW(a += row.transposed(), std::invalid_argument);
+  }
+
   void should_fill_matrix_with_value() {
     math::Matrix<int> m(2, 3);
     m.fill(9);
@@ -370,6 +625,505 @@ class MatrixTests : public ITest {
     ASSERT_TRUE(t.at(0, 1) == 4);
   }
 
+  template <typename T>
+  static bool is_transpose_of(const math::Matrix<T> &t, const math::Matrix<T> &m) {
+    if (t.row_count() != m.column_count() || t.column_count() != m.row_count()) {
+      return false;
+    }
+    for (size_t i = 0; i < m.row_count(); ++i) {
+      for (size_t j = 0; j < m.column_count(); ++j) {
+        if (t.at(j, i) != m.at(i, j)) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  template <typename T>
+  void check_transposes(size_t rows, size_t cols) {
+    auto m = random_matrix<T>(rows, cols, static_cast<uint32>(rows * cols));
+    ASSERT_TRUE(is_transpose_of(m.transposed(), m));
+    auto in_place = m;
+    in_place.transpose();
+    ASSERT_TRUE(is_transpose_of(in_place, m));
+  }
+
+  void should_transpose_all_shapes_in_and_out_of_place() {
+    // Tile remainders, single rows and columns, tall, wide and square shapes.
+    for (auto [rows, cols] : {std::pair<size_t, size_t>{1, 1}, {1, 17}, {19, 1},
+                              {8, 8}, {37, 53}, {64, 40}, {301, 129}, {67, 67},
+                              {1000, 37}}) {
+      check_transposes<double>(rows, cols);
+      check_transposes<float>(rows, cols);
+      check_transposes<int>(rows, cols);
+      check_transposes<int8>(rows, cols);
+    }
+  }
+
+  void should_transpose_with_streaming_stores() {
+    // The streaming path normally only runs for outputs larger than the LLC.
+    auto m = random_matrix<double>(203, 517, 50);
+    math::Matrix<double> t(517, 203);
+    math::Matrix<double> padded(517, 208);
+    math::kernels::detail::transpose_strips<true>(203, 517, m.data(), 517,
+                                                  padded.data(), 208);
+    for (size_t i = 0; i < 517; ++i) {
+      std::copy_n(padded[i], 203, t[i]);
+    }
+    ASSERT_TRUE(is_transpose_of(t, m));
+
+    auto f = random_matrix<float>(96, 72, 51);
+    math::Matrix<float> ft(72, 96);
+    math::kernels::detail::transpose_strips<true>(96, 72, f.data(), 72, ft.data(), 96);
+    ASSERT_TRUE(is_transpose_of(ft, f));
+  }
+
+  void should_store_column_major_matrices_by_columns() {
+    using ColMatrix = math::Matrix<int, math::Layout::ColMajor>;
+    ColMatrix m(2, 3, {1, 4, 2, 5, 3, 6});
+    ASSERT_TRUE(m.at(0, 1) == 2);
+    ASSERT_TRUE(m.at(1, 0) == 4);
+    ASSERT_TRUE((m[1, 2] == 6));
+    ASSERT_TRUE(m.leading_dimension() == 2);
+    ASSERT_TRUE(m.row_stride() == 1);
+    ASSERT_TRUE(m.column_stride() == 2);
+    ASSERT_TRUE(m.column_span(2)[1] == 6);
+    ASSERT_THROW((void)m.column_span(3), std::out_of_range);
+    ASSERT_THROW((void)m.at(2, 0), std::out_of_range);
+
+    ColMatrix nested(2, 3, std::vector<std::vector<int>>{{1, 2, 3}, {4, 5, 6}});
+    ASSERT_TRUE(nested == m);
+
+    // Element-wise arithmetic runs over the storage of matching layouts.
+    ColMatrix doubled = m + m;
+    ASSERT_TRUE(doubled.at(1, 2) == 12);
+    ASSERT_TRUE((m * 3).at(0, 1) == 6);
+    ASSERT_TRUE(math::loosely_equal(m, math::Matrix<int>(2, 3, {1, 2, 3, 4, 5, 6})));
+  }
+
+  void should_convert_and_reinterpret_between_layouts() {
+    auto m = random_matrix<double>(37, 53, 60);
+    math::Matrix<double, math::Layout::ColMajor> col(m);
+    ASSERT_TRUE(math::loosely_equal(col, m));
+    ASSERT_TRUE(math::Matrix<double>(col) == m);
+
+    // A row-major matrix and its column-major transpose share one buffer.
+    auto copy = m;
+    const double *storage = copy.data();
+    using ColMatrix = math::Matrix<double, math::Layout::ColMajor>;
+    auto t = std::move(copy).reinterpret_transposed();
+    ASSERT_SAME_TYPE(t, ColMatrix);
+    ASSERT_TRUE(t.data() == storage);
+    ASSERT_TRUE(copy.size() == 0);
+    ASSERT_TRUE(t.row_count() == 53);
+    ASSERT_TRUE(math::loosely_equal(t, m.transposed()));
+
+    // Transposes keep the layout of the column-major matrix.
+    ASSERT_TRUE(math::loosely_equal(col.transposed(), m.transposed()));
+    col.transpose();
+    ASSERT_TRUE(math::loosely_equal(col, m.transposed()));
+  }
+
+  //=============================================================================
+  // HALF-PRECISION TESTS
+  //=============================================================================
+  void should_round_half_precision_to_nearest_even() {
+    // 1 + 2^-8 lies halfway between two bfloat16 values and ties to the even one.
+    ASSERT_TRUE(bf16(1.00390625F).bits == 0x3f80);
+    ASSERT_TRUE(bf16(1.01171875F).bits == 0x3f82);
+    ASSERT_TRUE(fp16(1.0F + 0x1p-11F).bits == 0x3c00);
+    ASSERT_TRUE(fp16(65504.0F).bits == 0x7bff && fp16(65520.0F).bits == 0x7c00);
+    ASSERT_TRUE(fp16(0x1p-24F).bits == 0x0001);
+    ASSERT_TRUE(float(fp16::from_bits(0x0001)) == 0x1p-24F);
+    ASSERT_TRUE(float(bf16(-3.5)) == -3.5F && float(fp16(2048)) == 2048.0F);
+    ASSERT_TRUE(std::isnan(float(fp16(std::numeric_limits<float>::quiet_NaN()))));
+    ASSERT_TRUE(std::isinf(float(bf16(std::numeric_limits<float>::infinity()))));
+    ASSERT_TRUE(float(std::numeric_limits<fp16>::max()) == 65504.0F);
+    ASSERT_TRUE(float(std::numeric_limits<bf16>::epsilon()) == 0x1p-7F);
+    ASSERT_TRUE(float(std::numeric_limits<fp16>::lowest()) == -65504.0F);
+
+    std::vector<float> wide(1000);
+    for (size_t i = 0; i < wide.size(); ++i) {
+      wide[i] = static_cast<float>(i) * 0.37F - 150.0F;
+    }
+    // Float subnormals, which the AVX512-BF16 instruction would flush to zero.
+    wide[17] = 0x1.fep-127F;
+    wide[18] = -0x1.0p-140F;
+    wide[19] = std::numeric_limits<float>::denorm_min();
+    std::vector<fp16> h(wide.size());
+    std::vector<bf16> b(wide.size());
+    std::vector<float> back(wide.size());
+    convert_n(wide.data(), wide.size(), h.data());
+    convert_n(wide.data(), wide.size(), b.data());
+    bool bulk_matches_scalar = true;
+    for (size_t i = 0; i < wide.size(); ++i) {
+      bulk_matches_scalar = bulk_matches_scalar && h[i].bits == fp16(wide[i]).bits &&
+                            b[i].bits == bf16(wide[i]).bits;
+    }
+    convert_n(h.data(), h.size(), back.data());
+    for (size_t i = 0; i < wide.size(); ++i) {
+      bulk_matches_scalar = bulk_matches_scalar && back[i] == float(h[i]);
+    }
+    ASSERT_TRUE(bulk_matches_scalar);
+  }
+
+  void should_multiply_half_precision_matrices_with_float_accumulation() {
+    const size_t n = 96;
+    math::Matrix<float> af(n, n, uninitialized);
+    math::Matrix<float> bf(n, n, uninitialized);
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        af.at(i, j) = static_cast<float>((i + (3 * j)) % 7) - 3.0F;
+        bf.at(i, j) = static_cast<float>(((2 * i) + j) % 5) * 0.5F;
+      }
+    }
+    // Small integers and halves are exact in both 16-bit formats.
+    const auto a = af.cast<bf16>();
+    const auto b = bf.cast<bf16>();
+    ASSERT_SAME_TYPE(a, math::Matrix<bf16>);
+    ASSERT_TRUE(math::loosely_equal(a.cast<float>(), af));
+
+    const auto c = a * b;
+    const auto expected = af * bf;
+    ASSERT_SAME_TYPE(c, math::Matrix<bf16>);
+    bool rounded_once = true;
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        rounded_once = rounded_once && c.at(i, j).bits == bf16(expected.at(i, j)).bits;
+      }
+    }
+    ASSERT_TRUE(rounded_once);
+
+    const auto h = af.cast<fp16>();
+    math::Vector<fp16> x(n, uninitialized);
+    math::Vector<float> xf(n, uninitialized);
+    for (size_t i = 0; i < n; ++i) {
+      xf[i] = static_cast<float>(i % 4);
+      x[i] = xf[i];
+    }
+    const auto y = h * x;
+    const auto y_expected = af * xf;
+    ASSERT_SAME_TYPE(y, math::Vector<fp16>);
+    bool gemv_matches = true;
+    for (size_t i = 0; i < n; ++i) {
+      gemv_matches = gemv_matches && float(y[i]) == y_expected[i];
+    }
+    ASSERT_TRUE(gemv_matches);
+  }
+
+  void should_reduce_half_precision_in_float() {
+    // 4096 ones: a bfloat16 accumulator would stop growing at 256.
+    math::Matrix<bf16> a(2, 4096, uninitialized);
+    a.fill(bf16(1));
+    auto sums = math::sum(a, Axis::Rows);
+    ASSERT_SAME_TYPE(sums, math::Vector<bf16>);
+    ASSERT_TRUE(float(sums[0]) == 4096.0F && float(sums[1]) == 4096.0F);
+    a.at(1, 17) = bf16(-2);
+    ASSERT_TRUE(math::argmin(a, Axis::Rows)[1] == 17);
+    ASSERT_TRUE(math::mean(a, Axis::Columns)[17] == -0.5F);
+  }
+
+  void should_sum_long_rows_pairwise() {
+    const size_t n = 1UL << 21;
+    math::Matrix<float> a(2, n, uninitialized);
+    a.fill(0.1F);
+    const long double expected = static_cast<long double>(n) * 0.1F;
+    const auto sums = math::sum(a, Axis::Rows);
+    const auto means = math::mean(a, Axis::Rows);
+    ASSERT_TRUE(std::abs(sums[1] - expected) / expected < 1e-6L);
+    ASSERT_TRUE(std::abs(means[0] - 0.1L) < 1e-7L);
+  }
+
+  //=============================================================================
+  // TUNING TESTS
+  //=============================================================================
+  void should_save_and_load_tuning_profiles() {
+    const auto path = std::filesystem::temp_directory_path() / "maf_tuning_test.conf";
+    TuningProfile profile;
+    profile.omp_linear_limit = 12345;
+    profile.block_size = 48;
+    profile.cholesky_tile = 96;
+    profile.cholesky_parallel_limit = 0;
+    save_tuning(profile, path);
+    ASSERT_TRUE(load_tuning(path) == profile);
+
+    {
+      std::ofstream out(path);
+      out << "# comment\n\n  block_size = 24  # trailing\nfuture_key = 7\n";
+    }
+    const TuningProfile partial = load_tuning(path);
+    ASSERT_TRUE(partial.block_size == 24);
+    ASSERT_TRUE(partial.omp_linear_limit == OMP_LINEAR_LIMIT);
+
+    {
+      std::ofstream out(path);
+      out << "block_size = 0\n";
+    }
+    ASSERT_THROW(load_tuning(path), std::invalid_argument);
+    {
+      std::ofstream out(path);
+      out << "omp_linear_limit = 12x\n";
+    }
+    ASSERT_THROW(load_tuning(path), std::invalid_argument);
+    std::filesystem::remove(path);
+    ASSERT_THROW(load_tuning(path), std::runtime_error);
+  }
+
+  void should_report_unreadable_host_profile_without_throwing() {
+#if defined(__unix__) || defined(__APPLE__)
+    const TuningProfile saved = tuning();
+    const auto path = std::filesystem::temp_directory_path() / "maf_tuning_bad.conf";
+    {
+      std::ofstream out(path);
+      out << "block_size = many\n";
+    }
+    const char *previous = std::getenv("MAF_TUNING_FILE");
+    const std::string restore = (previous != nullptr) ? previous : "";
+    setenv("MAF_TUNING_FILE", path.c_str(), 1);
+
+    // Load the host profile again, as on the first kernel call.
+    util::detail::tuning_ready.store(false);
+    ASSERT_TRUE(tuning() == TuningProfile{});
+    ASSERT_TRUE(tuning_error().find("many") != std::string_view::npos);
+
+    if (previous != nullptr) {
+      setenv("MAF_TUNING_FILE", restore.c_str(), 1);
+    } else {
+      unsetenv("MAF_TUNING_FILE");
+    }
+    std::filesystem::remove(path);
+    util::detail::tuning_failure.clear();
+    set_tuning(saved);
+#endif
+  }
+
+  void should_apply_tuning_profile_at_runtime() {
+    const TuningProfile saved = tuning();
+    const size_t n = 70;
+    math::Matrix<double> a(n, n, uninitialized);
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        a.at(i, j) = static_cast<double>((i * 7 + j * 3) % 11) + (i == j ? 40.0 : 0.0);
+      }
+    }
+    const math::Matrix<double> spd = a * a.transposed();
+    auto [p, l, u, s] = plu(a);
+    const auto chol = cholesky(spd);
+
+    // Odd panel widths and always-parallel loops must not change any result.
+    TuningProfile eager;
+    eager.omp_linear_limit = 0;
+    eager.omp_quadratic_limit = 0;
+    eager.omp_cubic_limit = 0;
+    eager.block_size = 7;
+    eager.lu_parallel_limit = 0;
+    eager.cholesky_tile = 20;  // Four tiles, the last one partial.
+    eager.cholesky_parallel_limit = 0;
+    set_tuning(eager);
+    ASSERT_TRUE(tuning() == eager);
+    auto [p2, l2, u2, s2] = plu(a);
+    ASSERT_TRUE(p == p2 && s == s2);
+    ASSERT_TRUE(math::loosely_equal(l, l2) && math::loosely_equal(u, u2));
+    ASSERT_TRUE(math::loosely_equal(cholesky(spd), chol));
+    ASSERT_TRUE(math::loosely_equal(a + a, a * 2.0));
+
+    TuningProfile invalid;
+    invalid.block_size = 0;
+    ASSERT_THROW(set_tuning(invalid), std::invalid_argument);
+    invalid = TuningProfile{};
+    invalid.cholesky_tile = 0;
+    ASSERT_THROW(set_tuning(invalid), std::invalid_argument);
+    set_tuning(saved);
+    ASSERT_TRUE(tuning() == saved);
+  }
+
+  void should_autotune_without_changing_active_profile() {
+    const TuningProfile saved = tuning();
+    const TuningProfile tuned = math::autotune();
+    ASSERT_TRUE(tuning() == saved);
+    ASSERT_TRUE(tuned.block_size >= 8 && tuned.block_size <= 128);
+    ASSERT_TRUE(tuned.cholesky_tile >= 32 && tuned.cholesky_tile <= 256);
+    if (omp_get_max_threads() == 1) {
+      ASSERT_TRUE(tuned.omp_linear_limit == OMP_LINEAR_LIMIT);
+    }
+  }
+
+  //=============================================================================
+  // EXECUTION CONTEXT TESTS
+  //=============================================================================
+  void should_run_parallel_loops_on_every_backend() {
+    exec::ThreadPool pool(3);
+    const size_t n = 10007;
+    for (const exec::Context &context :
+         {exec::Context::serial(), exec::Context::openmp(2), exec::Context::on(pool),
+          exec::Context::on(pool, 2)}) {
+      std::vector<int> visits(n, 0);
+      std::atomic<bool> valid_worker{true};
+      for (const exec::Split split : {exec::Split{}, exec::Split{.grain = 64}}) {
+        exec::parallel_for(context, 0, n, split,
+                           [&](size_t worker, size_t lo, size_t hi) {
+                             if (worker >= context.concurrency()) {
+                               valid_worker = false;
+                             }
+                             for (size_t i = lo; i < hi; ++i) {
+                               ++visits[i];
+                             }
+                           });
+        const size_t sum = exec::parallel_reduce(
+            context, 0, n, split, size_t{0},
+            [](size_t lo, size_t hi) {
+              size_t partial = 0;
+              for (size_t i = lo; i < hi; ++i) {
+                partial += i;
+              }
+              return partial;
+            },
+            std::plus<size_t>());
+        ASSERT_TRUE(sum == n * (n - 1) / 2);
+      }
+      ASSERT_TRUE(valid_worker.load());
+      ASSERT_TRUE(std::ranges::all_of(visits, [](int v) { return v == 2; }));
+    }
+    ASSERT_TRUE(exec::Context::on(pool).concurrency() == 4);
+    ASSERT_TRUE(exec::Context::on(pool, 2).concurrency() == 2);
+    ASSERT_TRUE(exec::Context::serial().concurrency() == 1);
+  }
+
+  void should_nest_tasks_and_propagate_exceptions() {
+    exec::ThreadPool pool(2);
+    // Every task waits on tasks of its own; waiting threads run queued work.
+    std::function<size_t(size_t)> fib = [&](size_t k) -> size_t {
+      if (k < 2) {
+        return k;
+      }
+      size_t a = 0;
+      exec::TaskGroup group(pool);
+      group.run([&] { a = fib(k - 1); });
+      const size_t b = fib(k - 2);
+      group.wait();
+      return a + b;
+    };
+    ASSERT_TRUE(fib(16) == 987);
+
+    // A group dies as soon as wait() returns; the last finishing task must be done
+    // with it by then.
+    std::atomic<size_t> finished{0};
+    for (size_t round = 0; round < 2000; ++round) {
+      exec::TaskGroup group(pool);
+      group.run([&] { ++finished; });
+      group.run([&] { ++finished; });
+      group.wait();
+    }
+    ASSERT_TRUE(finished == 4000);
+
+    {
+      const exec::ScopedContext scope(exec::Context::on(pool));
+      ASSERT_TRUE(exec::current().backend() == exec::Backend::Pool);
+      std::atomic<size_t> inner{0};
+      exec::parallel_for(0, 64, {.grain = 1}, [&](size_t lo, size_t hi) {
+        exec::parallel_for(0, 100, [&](size_t a, size_t b) {
+          inner += (hi - lo) * (b - a);
+        });
+      });
+      ASSERT_TRUE(inner == 6400);
+      ASSERT_THROW(exec::parallel_for(0, 1000, {.grain = 10},
+                                      [](size_t lo, size_t) {
+                                        if (lo == 500) {
+                                          throw std::runtime_error("task failed");
+                                        }
+                                      }),
+                   std::runtime_error);
+    }
+    ASSERT_TRUE(exec::current().backend() == exec::Backend::OpenMP);
+
+    exec::TaskGroup group(pool);
+    group.run([] { throw std::invalid_argument("task failed"); });
+    ASSERT_THROW(group.wait(), std::invalid_argument);
+  }
+
+  void should_run_task_graphs_in_dependency_order() {
+    exec::ThreadPool pool(3);
+    for (const exec::Context &context :
+         {exec::Context::serial(), exec::Context::openmp(3), exec::Context::on(pool)}) {
+      // A chain of layers: every task of layer l waits for its two parents in l - 1.
+      const size_t width = 8;
+      const size_t layers = 20;
+      std::vector<std::atomic<int>> done(width * layers);
+      std::atomic<bool> ordered{true};
+      exec::TaskGraph graph;
+      for (size_t l = 0; l < layers; ++l) {
+        for (size_t i = 0; i < width; ++i) {
+          const size_t id = (l * width) + i;
+          const size_t left = id - width;
+          const size_t right = ((l - 1) * width) + ((i + 1) % width);
+          auto task = [&, id, l, left, right] {
+            if (l > 0 && (done[left] == 0 || done[right] == 0)) {
+              ordered = false;
+            }
+            done[id] = 1;
+          };
+          if (l == 0) {
+            graph.add(task);
+          } else {
+            graph.add(task, {left, right});
+          }
+        }
+      }
+      graph.run(context);
+      ASSERT_TRUE(ordered.load());
+      ASSERT_TRUE(std::ranges::all_of(done, [](const auto &d) { return d == 1; }));
+    }
+
+    exec::TaskGraph failing;
+    const auto first = failing.add([] {});
+    failing.add([] { throw std::runtime_error("task failed"); }, {first});
+    failing.add([] {}, {first});
+    ASSERT_THROW(failing.run(exec::Context::on(pool)), std::runtime_error);
+    ASSERT_THROW(failing.add([] {}, {7}), std::invalid_argument);
+  }
+
+  void should_give_same_results_on_every_execution_context() {
+    const TuningProfile saved = tuning();
+    TuningProfile eager;
+    eager.omp_linear_limit = 0;
+    eager.omp_quadratic_limit = 0;
+    eager.omp_cubic_limit = 0;
+    eager.lu_parallel_limit = 0;
+    eager.cholesky_parallel_limit = 0;
+    set_tuning(eager);
+
+    const size_t n = 96;
+    math::Matrix<double> a(n, n, uninitialized);
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        a.at(i, j) = static_cast<double>((i * 5 + j * 3) % 13) + (i == j ? 50.0 : 0.0);
+      }
+    }
+    math::Vector<double> x(n);
+    x.fill(1.5);
+    const auto product = a * a;
+    const auto spd = a * a.transposed();
+    const auto chol = cholesky(spd);
+    const auto lu = plu(a);
+    const auto gemv = a * x;
+    const auto sums = math::sum(a, Axis::Columns);
+
+    exec::ThreadPool pool(3);
+    for (const exec::Context &context : {exec::Context::serial(),
+                                         exec::Context::on(pool, 2),
+                                         exec::Context::on(pool)}) {
+      const exec::ScopedContext scope(context);
+      ASSERT_TRUE(math::loosely_equal(a * a, product));
+      ASSERT_TRUE(math::loosely_equal(cholesky(spd), chol));
+      const auto lu2 = plu(a);
+      ASSERT_TRUE(lu2.P == lu.P && math::loosely_equal(lu2.U(), lu.U()));
+      ASSERT_TRUE(math::loosely_equal(a * x, gemv));
+      ASSERT_TRUE(math::loosely_equal(math::sum(a, Axis::Columns), sums));
+    }
+    set_tuning(saved);
+  }
+
   //=============================================================================
   // MATRIX OPERATORS TESTS
   //=============================================================================
@@ -609,6 +1363,52 @@ class MatrixTests : public ITest {
     ASSERT_TRUE(is_close(c.at(0, 0), 2.5f));
   }
 
+  void should_evaluate_lazy_expression_like_eager_operators() {
+    math::Matrix<int> a(2, 2, {1, 2, 3, 4});
+    math::Matrix<float> b(2, 2, {0.5f, 1.5f, 2.5f, 3.5f});
+    math::Matrix<double> c(2, 2, {3.0, 6.0, 9.0, 12.0});
+
+    auto eager = a * 2.0 + b - c / 3.0;
+    math::Matrix<double> fused = math::lazy(a) * 2.0 + b - math::lazy(c) / 3.0;
+    ASSERT_TRUE(math::loosely_equal(fused, eager));
+
+    auto promoted = math::eval(math::lazy(a) + b);
+    ASSERT_SAME_TYPE(promoted, math::Matrix<float>);
+    auto divided = math::eval(math::lazy(a) / 2);
+    ASSERT_SAME_TYPE(divided, math::Matrix<double>);
+    ASSERT_TRUE(is_close(divided.at(0, 0), 0.5));
+
+    auto negated = math::eval(-math::lazy(a) + 1);
+    ASSERT_SAME_TYPE(negated, math::Matrix<int>);
+    ASSERT_TRUE(negated.at(1, 1) == -3);
+
+    math::Matrix<double> wrong(2, 3);
+    ASSERT_THROW(math::eval(math::lazy(c) + wrong), std::invalid_argument);
+  }
+
+  void should_assign_lazy_expression_into_existing_buffer() {
+    math::Matrix<double> a(2, 2, {1.0, 2.0, 3.0, 4.0});
+    math::Matrix<double> b(2, 2, {1.0, 1.0, 1.0, 1.0});
+    const double *buffer = a.data();
+
+    a = math::lazy(a) * 2.0 - b;
+    ASSERT_TRUE(a.data() == buffer);
+    ASSERT_TRUE(is_close(a.at(0, 0), 1.0));
+    ASSERT_TRUE(is_close(a.at(1, 1), 7.0));
+
+    a += math::lazy(b) * 3.0;
+    ASSERT_TRUE(is_close(a.at(0, 1), 6.0));
+    a -= -math::lazy(b);
+    ASSERT_TRUE(is_close(a.at(1, 0), 9.0));
+
+    math::Matrix<double> c(3, 1);
+    ASSERT_THROW(a += math::lazy(c) * 2.0, std::invalid_argument);
+
+    c = math::lazy(a) + b;
+    ASSERT_TRUE(c.row_count() == 2 && c.column_count() == 2);
+    ASSERT_TRUE(is_close(c.at(1, 1), 12.0));
+  }
+
   void should_multiply_matrices() {
     math::Matrix<int> a(2, 3, {1, 2, 3, 4, 5, 6});
     math::Matrix<double> b(3, 2, {0.5, 1.5, -1.0, 2.0, 0.0, 1.0});
@@ -628,6 +1428,277 @@ class MatrixTests : public ITest {
     }
   }
 
+  template <typename TA, typename TB>
+  static auto naive_product(const math::Matrix<TA> &A, const math::Matrix<TB> &B) {
+    using R = std::common_type_t<TA, TB>;
+    math::Matrix<R> C(A.row_count(), B.column_count());
+    for (size_t i = 0; i < A.row_count(); ++i) {
+      for (size_t j = 0; j < B.column_count(); ++j) {
+        R sum = 0;
+        for (size_t k = 0; k < A.column_count(); ++k) {
+          sum += static_cast<R>(A.at(i, k)) * static_cast<R>(B.at(k, j));
+        }
+        C.at(i, j) = sum;
+      }
+    }
+    return C;
+  }
+
+  template <typename T>
+  static math::Matrix<T> random_matrix(size_t rows, size_t cols, uint32 seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> dis(-9, 9);
+    math::Matrix<T> result(rows, cols);
+    for (size_t i = 0; i < result.size(); ++i) {
+      result.data()[i] = static_cast<T>(dis(gen));
+    }
+    return result;
+  }
+
+  void should_multiply_matrices_with_sizes_not_multiple_of_tile() {
+    auto A = random_matrix<double>(67, 131, 1);
+    auto B = random_matrix<double>(131, 45, 2);
+    ASSERT_TRUE(math::loosely_equal(A * B, naive_product(A, B)));
+
+    auto Af = random_matrix<float>(131, 67, 3);
+    auto Bf = random_matrix<float>(67, 129, 4);
+    ASSERT_TRUE(math::loosely_equal(Af * Bf, naive_product(Af, Bf)));
+  }
+
+  template <typename TA, typename TB, math::Layout LA, math::Layout LB>
+  void check_product_layouts(size_t m, size_t k, size_t n, uint32 seed) {
+    auto A = random_matrix<TA>(m, k, seed);
+    auto B = random_matrix<TB>(k, n, seed + 1);
+    auto expected = naive_product(A, B);
+    auto C = math::Matrix<TA, LA>(A) * math::Matrix<TB, LB>(B);
+    ASSERT_TRUE(C.layout == LA);
+    ASSERT_TRUE(math::loosely_equal(C, expected));
+  }
+
+  template <typename TA, typename TB>
+  void check_product_layouts(size_t m, size_t k, size_t n, uint32 seed) {
+    using enum math::Layout;
+    check_product_layouts<TA, TB, ColMajor, RowMajor>(m, k, n, seed);
+    check_product_layouts<TA, TB, RowMajor, ColMajor>(m, k, n, seed);
+    check_product_layouts<TA, TB, ColMajor, ColMajor>(m, k, n, seed);
+  }
+
+  void should_multiply_matrices_of_any_layout() {
+    check_product_layouts<double, double>(67, 131, 45, 61);
+    check_product_layouts<float, float>(131, 67, 129, 62);
+    check_product_layouts<int, int>(33, 70, 21, 63);
+    check_product_layouts<int8, int8>(45, 301, 70, 64);
+    check_product_layouts<int, float>(90, 70, 110, 65);
+    check_product_layouts<float, double>(64, 96, 80, 66);
+  }
+
+  void should_multiply_column_major_matrix_by_vector() {
+    auto A = random_matrix<double>(1201, 37, 67);
+    math::Matrix<double, math::Layout::ColMajor> Ac(A);
+    math::Vector<double> x(37, std::vector<double>(37, 0.5));
+    ASSERT_TRUE(math::loosely_equal(Ac * x, A * x));
+
+    math::Matrix<int, math::Layout::ColMajor> Ai(A.cast<int>());
+    math::Vector<float> y(37, std::vector<float>(37, 2.0F));
+    ASSERT_TRUE(math::loosely_equal(Ai * y, A.cast<int>() * y));
+  }
+
+  void should_multiply_mixed_type_matrices_in_packed_gemm() {
+    auto A = random_matrix<int>(90, 70, 5);
+    auto B = random_matrix<float>(70, 110, 6);
+    auto C = A * B;
+    ASSERT_SAME_TYPE(C, math::Matrix<float>);
+    ASSERT_TRUE(math::loosely_equal(C, naive_product(A, B)));
+
+    auto D = random_matrix<float>(64, 96, 7);
+    auto E = random_matrix<double>(96, 80, 8);
+    auto F = D * E;
+    ASSERT_SAME_TYPE(F, math::Matrix<double>);
+    ASSERT_TRUE(math::loosely_equal(F, naive_product(D, E)));
+
+    // More than one conversion panel on either side.
+    auto G = random_matrix<double>(40, 50, 10);
+    auto H = random_matrix<float>(50, 300, 11);
+    ASSERT_TRUE(math::loosely_equal(G * H, naive_product(G, H)));
+    auto P = random_matrix<float>(300, 20, 12);
+    auto Q = random_matrix<double>(20, 30, 13);
+    ASSERT_TRUE(math::loosely_equal(P * Q, naive_product(P, Q)));
+
+    // Packing fills whole micro-panels, so the blocks must be multiples of the tile.
+    namespace detail = math::kernels::detail;
+    const auto &fb = detail::gemm_blocking<float>();
+    const auto &db = detail::gemm_blocking<double>();
+    ASSERT_TRUE(fb.mc % detail::gemm_tile<float>::MR == 0 &&
+                fb.nc % detail::gemm_tile<float>::NR == 0);
+    ASSERT_TRUE(db.mc % detail::gemm_tile<double>::MR == 0 &&
+                db.nc % detail::gemm_tile<double>::NR == 0);
+  }
+
+  void should_multiply_tall_skinny_matrices() {
+    auto A = random_matrix<double>(3000, 17, 9);
+    auto B = random_matrix<double>(17, 9, 10);
+    ASSERT_TRUE(math::loosely_equal(A * B, naive_product(A, B)));
+
+    auto C = random_matrix<double>(9, 2500, 11);
+    auto D = random_matrix<double>(2500, 13, 12);
+    ASSERT_TRUE(math::loosely_equal(C * D, naive_product(C, D)));
+  }
+
+  void should_multiply_integer_matrices_exactly() {
+    auto A = random_matrix<int>(50, 61, 13);
+    auto B = random_matrix<int>(61, 47, 14);
+    ASSERT_TRUE(A * B == naive_product(A, B));
+  }
+
+  // Largest |C - reference| relative to k * max|A| * max|B|, the scale of the
+  // norm-wise error bound fast multiplication satisfies.
+  template <typename T>
+  static double relative_product_error(const math::Matrix<T> &A,
+                                       const math::Matrix<T> &B,
+                                       const math::Matrix<T> &C) {
+    const auto reference =
+        naive_product(A.template cast<double>(), B.template cast<double>());
+    auto max_abs = [](const auto &M) {
+      double result = 0.0;
+      for (size_t i = 0; i < M.size(); ++i) {
+        result = std::max(result, std::abs(static_cast<double>(M.data()[i])));
+      }
+      return result;
+    };
+    const auto error = C.template cast<double>() - reference;
+    return max_abs(error) /
+           (static_cast<double>(A.column_count()) * max_abs(A) * max_abs(B));
+  }
+
+  template <typename T>
+  static math::Matrix<T> random_real_matrix(size_t rows, size_t cols, uint32 seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    math::Matrix<T> result(rows, cols, util::uninitialized);
+    for (size_t i = 0; i < result.size(); ++i) {
+      result.data()[i] = static_cast<T>(dis(gen));
+    }
+    return result;
+  }
+
+  void should_multiply_with_strassen_within_error_bound() {
+    // Three recursion levels on a power of two, and odd sizes on every axis.
+    auto A = random_real_matrix<double>(256, 256, 21);
+    auto B = random_real_matrix<double>(256, 256, 22);
+    ASSERT_TRUE(relative_product_error(A, B, math::strassen_multiply(A, B, 32)) < 1e-14);
+    auto C = random_real_matrix<double>(301, 257, 23);
+    auto D = random_real_matrix<double>(257, 199, 24);
+    ASSERT_TRUE(relative_product_error(C, D, math::strassen_multiply(C, D, 40)) < 1e-14);
+
+    auto Af = random_real_matrix<float>(256, 256, 25);
+    auto Bf = random_real_matrix<float>(256, 256, 26);
+    ASSERT_TRUE(relative_product_error(Af, Bf, math::strassen_multiply(Af, Bf, 32)) <
+                1e-5);
+    auto Cf = random_real_matrix<float>(301, 257, 27);
+    auto Df = random_real_matrix<float>(257, 199, 28);
+    ASSERT_TRUE(relative_product_error(Cf, Df, math::strassen_multiply(Cf, Df, 40)) <
+                1e-5);
+
+    // Below the crossover it is the ordinary product.
+    ASSERT_TRUE(math::strassen_multiply(C, D) == C * D);
+  }
+
+  void should_multiply_integer_and_mixed_matrices_with_strassen() {
+    auto A = random_matrix<int>(130, 97, 29);
+    auto B = random_matrix<int>(97, 71, 30);
+    ASSERT_TRUE(math::strassen_multiply(A, B, 16) == naive_product(A, B));
+
+    auto F = random_matrix<float>(97, 83, 31);
+    auto C = math::strassen_multiply(A, F, 20);
+    ASSERT_SAME_TYPE(C, math::Matrix<float>);
+    ASSERT_TRUE(math::loosely_equal(C, naive_product(A, F)));
+
+    ASSERT_THROW((void)math::strassen_multiply(A, A), std::invalid_argument);
+    ASSERT_THROW((void)math::strassen_multiply(A, B, 0), std::invalid_argument);
+  }
+
+  template <typename T>
+  static math::Matrix<T> random_full_range_matrix(size_t rows, size_t cols, uint32 seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> dis(std::numeric_limits<T>::min(),
+                                           std::numeric_limits<T>::max());
+    math::Matrix<T> result(rows, cols, util::uninitialized);
+    for (size_t i = 0; i < result.size(); ++i) {
+      result.data()[i] = static_cast<T>(dis(gen));
+    }
+    return result;
+  }
+
+  void should_multiply_small_integers_with_widened_accumulation() {
+    // Odd depth spanning several k blocks of the pairwise kernel.
+    auto A = random_full_range_matrix<int8>(45, 1601, 41);
+    auto B = random_full_range_matrix<int8>(1601, 70, 42);
+    auto C = math::widening_multiply(A, B);
+    ASSERT_SAME_TYPE(C, math::Matrix<int32>);
+    ASSERT_TRUE(C == naive_product(A.cast<int32>(), B.cast<int32>()));
+
+    auto U = random_full_range_matrix<uint8>(70, 33, 43);
+    auto D = math::widening_multiply(B, U);
+    ASSERT_TRUE(D == naive_product(B.cast<int32>(), U.cast<int32>()));
+
+    // operator* keeps the narrow type and wraps exactly like narrow accumulation.
+    ASSERT_TRUE(A * B == naive_product(A, B));
+
+    auto S = random_full_range_matrix<int16>(20, 100, 44);
+    auto T = random_full_range_matrix<int16>(100, 30, 45);
+    auto W = math::widening_multiply(S, T);
+    ASSERT_SAME_TYPE(W, math::Matrix<int64>);
+    ASSERT_TRUE(W == naive_product(S.cast<int64>(), T.cast<int64>()));
+
+    ASSERT_THROW((void)math::widening_multiply(A, A), std::invalid_argument);
+  }
+
+  void should_dequantize_with_row_and_column_scales() {
+    const size_t m = 300;
+    const size_t k = 200;
+    const size_t n = 150;
+    auto X = random_real_matrix<float>(m, k, 46);
+    auto Y = random_real_matrix<float>(k, n, 47);
+
+    // Symmetric int8 quantization, one scale per row of X and per column of Y.
+    math::Matrix<int8> Xq(m, k);
+    math::Matrix<int8> Yq(k, n);
+    math::Vector<float> row_scales(m);
+    math::Vector<float> col_scales(n);
+    for (size_t i = 0; i < m; ++i) {
+      float max_abs = 0.0F;
+      for (size_t p = 0; p < k; ++p) {
+        max_abs = std::max(max_abs, std::abs(X.at(i, p)));
+      }
+      row_scales[i] = max_abs / 127.0F;
+      for (size_t p = 0; p < k; ++p) {
+        Xq.at(i, p) = static_cast<int8>(std::lround(X.at(i, p) / row_scales[i]));
+      }
+    }
+    for (size_t j = 0; j < n; ++j) {
+      float max_abs = 0.0F;
+      for (size_t p = 0; p < k; ++p) {
+        max_abs = std::max(max_abs, std::abs(Y.at(p, j)));
+      }
+      col_scales[j] = max_abs / 127.0F;
+      for (size_t p = 0; p < k; ++p) {
+        Yq.at(p, j) = static_cast<int8>(std::lround(Y.at(p, j) / col_scales[j]));
+      }
+    }
+
+    auto Z = math::quantized_multiply(Xq, Yq, row_scales, col_scales);
+    ASSERT_SAME_TYPE(Z, math::Matrix<float>);
+    // Quantization error only; the integer accumulation itself is exact.
+    ASSERT_TRUE(relative_product_error(X, Y, Z) < 1e-2);
+    const auto exact = math::widening_multiply(Xq, Yq);
+    ASSERT_TRUE(is_close(Z.at(7, 9),
+                         row_scales[7] * col_scales[9] * static_cast<float>(exact.at(7, 9)),
+                         1e-3));
+
+    ASSERT_THROW((void)math::quantized_multiply(Xq, Yq, col_scales, col_scales),
+                 std::invalid_argument);
+  }
+
   void should_multiply_matrix_and_vector() {
     math::Matrix<float> m(2, 3, {1.0, 0.5, -2.0, 4.0, 1.0, 3.0});
     math::Vector<int> v(3, std::vector<int>{2, 4, 6}, math::COLUMN);
@@ -645,6 +1716,41 @@ class MatrixTests : public ITest {
     }
   }
 
+  void should_multiply_mixed_type_matrix_and_vectors() {
+    // Large enough to take the parallel path of both products.
+    auto A = random_matrix<float>(600, 700, 9);
+    math::Vector<double> x(700, math::COLUMN);
+    math::Vector<int> y(600, math::ROW);
+    for (size_t i = 0; i < 700; ++i) {
+      x[i] = 0.25 * static_cast<double>(i % 9);
+    }
+    for (size_t i = 0; i < 600; ++i) {
+      y[i] = static_cast<int>(i % 5) - 2;
+    }
+
+    auto Ax = A * x;
+    auto yA = y * A;
+    ASSERT_SAME_TYPE(Ax, math::Vector<double>);
+    ASSERT_SAME_TYPE(yA, math::Vector<float>);
+
+    bool ok = true;
+    for (size_t i = 0; i < 600; ++i) {
+      double sum = 0.0;
+      for (size_t j = 0; j < 700; ++j) {
+        sum += static_cast<double>(A[i][j]) * x[j];
+      }
+      ok = ok && is_close(Ax[i], sum, 1e-9);
+    }
+    for (size_t j = 0; j < 700; ++j) {
+      double sum = 0.0;
+      for (size_t i = 0; i < 600; ++i) {
+        sum += y[i] * static_cast<double>(A[i][j]);
+      }
+      ok = ok && is_close(yA[j], sum, 1e-2);
+    }
+    ASSERT_TRUE(ok);
+  }
+
   void matmul_time_test() {
     const size_t n = 1024;
     math::Matrix<double> A(n, n);
@@ -681,6 +1787,51 @@ class MatrixTests : public ITest {
     ASSERT_TRUE(math::loosely_equal(C, D));
   }
 
+  void integer_gemm_time_test() {
+    const size_t n = 1024;
+    auto A = random_full_range_matrix<int8>(n, n, 48);
+    auto B = random_full_range_matrix<int8>(n, n, 49);
+    auto Af = A.cast<float>();
+    auto Bf = B.cast<float>();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    auto C = math::widening_multiply(A, B);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> int8_elapsed = end - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    auto Cf = Af * Bf;
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> float_elapsed = end - start;
+
+    const double ops = 2.0 * n * n * n;
+    std::cout << "INT8->INT32 GEMM elapsed time:" << int8_elapsed.count()
+              << " seconds, " << (ops / int8_elapsed.count()) / 1e9 << " GOPS\n";
+    std::cout << "FLOAT GEMM elapsed time:" << float_elapsed.count() << " seconds, "
+              << (ops / float_elapsed.count()) / 1e9 << " GFLOPS\n";
+    // Every partial sum stays below 2^24, so the float product is exact too.
+    ASSERT_TRUE(C.cast<float>() == Cf);
+  }
+
+  void transpose_time_test() {
+    auto A = random_matrix<double>(4096, 2048, 52);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    auto T = A.transposed();
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = end - start;
+    std::cout << "TRANSPOSED (double, 4096x2048) elapsed time:" << elapsed.count()
+              << " seconds.\n";
+
+    start = std::chrono::high_resolution_clock::now();
+    A.transpose();
+    end = std::chrono::high_resolution_clock::now();
+    elapsed = end - start;
+    std::cout << "TRANSPOSE in-place (double, 4096x2048) elapsed time:"
+              << elapsed.count() << " seconds.\n";
+    ASSERT_TRUE(A == T);
+  }
+
   //=============================================================================
   // MATRIX PLU TESTS
   //=============================================================================
@@ -781,6 +1932,85 @@ class MatrixTests : public ITest {
     ASSERT_TRUE(loosely_equal(PA, LU));
   }
 
+  void should_store_plu_factors_packed_in_place() {
+    const TuningProfile saved = tuning();
+    TuningProfile narrow = saved;
+    narrow.block_size = 5;  // Several levels of recursion at n = 150.
+    set_tuning(narrow);
+    const size_t n = 150;
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    math::Matrix<double> A(n, n, uninitialized);
+    std::ranges::generate(std::span(A.data(), A.size()), [&] { return dis(gen); });
+
+    const auto lu = plu(A);
+    const auto L = lu.L();
+    const auto U = lu.U();
+    ASSERT_TRUE(lu.size() == n);
+    bool unpacked = true;
+    for (size_t i = 0; i < n; ++i) {
+      unpacked = unpacked && L.at(i, i) == 1.0;
+      for (size_t j = 0; j < n; ++j) {
+        const double packed = lu.packed().at(i, j);
+        const bool lower = L.at(i, j) == packed && U.at(i, j) == 0.0;
+        const bool upper = U.at(i, j) == packed && (j == i || L.at(i, j) == 0.0);
+        unpacked = unpacked && (j < i ? lower : upper);
+      }
+    }
+    ASSERT_TRUE(unpacked);
+    ASSERT_TRUE(math::loosely_equal(math::permutation_matrix<double>(lu.P) * A, L * U));
+    set_tuning(saved);
+
+    auto [P, L2, U2, sign] = plu(A);
+    ASSERT_TRUE(P == lu.P && sign == lu.sign);
+    ASSERT_TRUE(math::loosely_equal(math::permutation_matrix<double>(P) * A, L2 * U2));
+  }
+
+  void should_solve_with_a_reusable_lu_factorization() {
+    const size_t n = 150;
+    const size_t p = 7;
+    auto A = random_real_matrix<double>(n, n, 31);
+    auto B = random_real_matrix<double>(n, p, 32);
+    const math::Matrix<double, math::Layout::ColMajor> Bc(B);
+
+    math::LUFactorization<double> lu(A);
+    const auto X = lu.solve(B);
+    ASSERT_TRUE(X.row_count() == n && X.column_count() == p);
+    ASSERT_TRUE(math::loosely_equal(A * X, B, 1e-9));
+    ASSERT_TRUE(math::loosely_equal(math::Matrix<double>(lu.solve(Bc)), X, 1e-12));
+    math::Vector<double> b(n, util::uninitialized);
+    for (size_t i = 0; i < n; ++i) {
+      b[i] = B.at(i, 2);
+    }
+    const auto x = lu.solve(b);
+    bool column = true;
+    for (size_t i = 0; i < n; ++i) {
+      column = column && is_close(x[i], X.at(i, 2), 1e-12);
+    }
+    ASSERT_TRUE(column);
+    // The determinant is far beyond 1, so compare it relative to its magnitude.
+    const double det = A.determinant();
+    ASSERT_TRUE(std::abs(lu.determinant() - det) <= 1e-9 * std::abs(det));
+
+    // A refit of the same order keeps the storage of the factors.
+    const double *storage = lu.packed().data();
+    auto A2 = random_real_matrix<double>(n, n, 33);
+    lu.factor(A2);
+    ASSERT_TRUE(lu.packed().data() == storage);
+    ASSERT_TRUE(math::loosely_equal(A2 * lu.solve(B), B, 1e-9));
+
+    // A column-major A is factored into the same row-major factors.
+    const math::Matrix<double, math::Layout::ColMajor> A2c(A2);
+    math::LUFactorization<double> lu_c(A2c);
+    ASSERT_TRUE(math::loosely_equal(lu_c.packed(), lu.packed(), 1e-12));
+    ASSERT_TRUE(plu(A2c).P == lu.permutation());
+    ASSERT_TRUE(math::loosely_equal(plu<float>(A2c).packed(), lu.packed(), 1e-4));
+
+    ASSERT_THROW(lu.solve(math::Matrix<double>(n + 1, 2)), std::invalid_argument);
+    ASSERT_THROW(lu.factor(math::Matrix<double>(3, 3)), std::runtime_error);
+    ASSERT_THROW(lu.factor(math::Matrix<double>(3, 4)), std::invalid_argument);
+  }
+
   void plu_time_test() {
     const size_t n = 1000;
     math::Matrix<double> A(n, n);
@@ -956,6 +2186,87 @@ class MatrixTests : public ITest {
     ASSERT_TRUE(math::loosely_equal(L, expectedL));
   }
 
+  void should_factor_tiled_cholesky_on_every_context() {
+    // Three tiles per dimension, the last one partial.
+    const size_t n = 300;
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    math::Matrix<double> b(n, n, uninitialized);
+    std::ranges::generate(std::span(b.data(), b.size()), [&] { return dis(gen); });
+    math::Matrix<double> a = b * b.transposed();
+    for (size_t i = 0; i < n; ++i) {
+      a.at(i, i) += static_cast<double>(n);
+    }
+    math::Matrix<double> indefinite(a);
+    indefinite.at(n - 1, n - 1) = -1.0;
+
+    const TuningProfile saved = tuning();
+    TuningProfile eager = saved;
+    eager.cholesky_parallel_limit = 0;
+    set_tuning(eager);
+    exec::ThreadPool pool(3);
+    const auto serial = cholesky(a);
+    ASSERT_TRUE(math::loosely_equal(serial * serial.transposed(), a));
+    bool lower = true;
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = i + 1; j < n; ++j) {
+        lower = lower && serial.at(i, j) == 0.0;
+      }
+    }
+    ASSERT_TRUE(lower);
+    for (const exec::Context &context :
+         {exec::Context::openmp(3), exec::Context::on(pool)}) {
+      const exec::ScopedContext scope(context);
+      ASSERT_TRUE(math::loosely_equal(cholesky(a), serial));
+      ASSERT_THROW((void)cholesky(indefinite), std::invalid_argument);
+    }
+    set_tuning(saved);
+  }
+
+  void should_solve_with_a_reusable_cholesky_factorization() {
+    const size_t n = 300;
+    auto b = random_real_matrix<double>(n, n, 41);
+    math::Matrix<double> a = b * b.transposed();
+    for (size_t i = 0; i < n; ++i) {
+      a.at(i, i) += static_cast<double>(n);
+    }
+    const auto B = random_real_matrix<double>(n, 5, 42);
+
+    const TuningProfile saved = tuning();
+    TuningProfile eager = saved;
+    eager.cholesky_parallel_limit = 0;
+    set_tuning(eager);
+    math::CholeskyFactorization<double> chol(a);
+    ASSERT_TRUE(math::loosely_equal(chol.L(), cholesky(a)));
+    const auto X = chol.solve(B);
+    ASSERT_TRUE(math::loosely_equal(a * X, B, 1e-9));
+
+    const double *storage = chol.L().data();
+    for (size_t i = 0; i < n; ++i) {
+      a.at(i, i) += 1.0;
+    }
+    chol.factor(a);
+    ASSERT_TRUE(chol.L().data() == storage);
+    ASSERT_TRUE(math::loosely_equal(a * chol.solve(B), B, 1e-9));
+
+    // Either layout is accepted; cholesky() returns L in the layout of A.
+    using ColMatrix = math::Matrix<double, math::Layout::ColMajor>;
+    const ColMatrix ac(a);
+    math::CholeskyFactorization<double> chol_c(ac);
+    ASSERT_TRUE(math::loosely_equal(chol_c.L(), chol.L(), 1e-12));
+    const auto Lc = cholesky(ac);
+    ASSERT_SAME_TYPE(Lc, ColMatrix);
+    ASSERT_TRUE(math::loosely_equal(math::Matrix<double>(Lc), chol.L(), 1e-12));
+    ASSERT_TRUE(math::loosely_equal(math::Matrix<float>(cholesky<float>(ac)),
+                                    chol.L().cast<float>(), 1e-4));
+    set_tuning(saved);
+
+    math::Vector<double> rhs(n, util::uninitialized);
+    rhs.fill(1.0);
+    ASSERT_TRUE(math::loosely_equal(a * chol.solve(rhs), rhs, 1e-9));
+    ASSERT_THROW(chol.solve(math::Matrix<double>(n - 1, 2)), std::invalid_argument);
+  }
+
   void cholesky_time_test() {
     const size_t n = 1000;
     std::mt19937 gen(std::random_device{}());
@@ -1351,6 +2662,162 @@ class MatrixTests : public ITest {
     ASSERT_TRUE(loosely_equal(Q * R, A));
   }
 
+  template <math::Layout L>
+  void check_qr_layout(size_t m, size_t n, bool full_Q, bool full_R) {
+    auto A = random_real_matrix<double>(m, n, static_cast<uint32>((m * 31) + n));
+    math::Matrix<double, L> A_layout(A);
+    using Result = math::Matrix<double, L>;
+    auto [Q, R] = math::QR_decompostion(A_layout, full_Q, full_R);
+    ASSERT_SAME_TYPE(Q, Result);
+    ASSERT_TRUE(Q.row_count() == m);
+    ASSERT_TRUE(Q.column_count() == (full_Q ? m : std::min(m, n)));
+    ASSERT_TRUE(R.row_count() == (full_R ? m : std::min(m, n)));
+    if (Q.column_count() == R.row_count()) {
+      ASSERT_TRUE(math::loosely_equal(Q * R, A, 1e-10));
+    }
+    bool upper = true;
+    for (size_t i = 0; i < R.row_count(); ++i) {
+      for (size_t j = 0; j < std::min(i, n); ++j) {
+        upper = upper && R.at(i, j) == 0.0;
+      }
+    }
+    ASSERT_TRUE(upper);
+    ASSERT_TRUE(math::loosely_equal(
+        Q.transposed() * Q, math::identity_matrix<double>(Q.column_count()), 1e-10));
+  }
+
+  void should_decompose_qr_in_the_layout_of_the_input() {
+    for (auto [m, n] : {std::pair<size_t, size_t>{9, 9}, {40, 7}, {7, 40}, {1, 5},
+                        {5, 1}, {101, 70}, {70, 101}}) {
+      for (bool full_Q : {false, true}) {
+        for (bool full_R : {false, true}) {
+          check_qr_layout<math::Layout::RowMajor>(m, n, full_Q, full_R);
+          check_qr_layout<math::Layout::ColMajor>(m, n, full_Q, full_R);
+        }
+      }
+    }
+  }
+
+  void should_apply_q_of_a_blocked_qr_without_forming_it() {
+    const size_t m = 150;
+    const size_t n = 70;
+    auto A = random_real_matrix<double>(m, n, 71);
+    const auto f = math::qr(A);
+    ASSERT_TRUE(f.packed().row_count() == m);
+    ASSERT_TRUE(f.tau().size() == n);
+
+    // Q^T A = R, and Q undoes it.
+    math::Matrix<double> C(A);
+    f.apply_qt(C);
+    ASSERT_TRUE(math::loosely_equal(C, f.R(true), 1e-10));
+    f.apply_q(C);
+    ASSERT_TRUE(math::loosely_equal(C, A, 1e-10));
+
+    // A column-major operand and a strided vector see the same Q.
+    math::Matrix<double, math::Layout::ColMajor> Cc(A);
+    f.apply_qt(Cc);
+    ASSERT_TRUE(math::loosely_equal(math::Matrix<double>(Cc), f.R(true), 1e-10));
+    math::Matrix<double> B(A);
+    f.apply_qt(B.column_view(3));
+    const auto R = f.R(true);
+    bool same = true;
+    for (size_t i = 0; i < m; ++i) {
+      same = same && std::abs(B.at(i, 3) - R.at(i, 3)) < 1e-10;
+    }
+    ASSERT_TRUE(same);
+
+    // The least-squares residual is orthogonal to the columns of A.
+    math::Vector<double> b(m, util::uninitialized);
+    for (size_t i = 0; i < m; ++i) {
+      b[i] = std::sin(static_cast<double>(i));
+    }
+    const auto x = f.solve(b);
+    ASSERT_TRUE(x.size() == n);
+    const auto gradient = A.transposed() * ((A * x) - b);
+    double largest = 0.0;
+    for (size_t j = 0; j < n; ++j) {
+      largest = std::max(largest, std::abs(gradient[j]));
+    }
+    ASSERT_TRUE(largest < 1e-10);
+
+    ASSERT_THROW((void)f.solve(math::Vector<double>(n)), std::invalid_argument);
+    ASSERT_THROW((void)math::qr(A.transposed()).solve(math::Vector<double>(n)),
+                 std::invalid_argument);
+    math::Matrix<double> D(m, n);
+    ASSERT_THROW((void)math::qr(D).solve(b), std::runtime_error);
+  }
+
+  void should_factor_tall_matrices_with_tsqr() {
+    const size_t m = 1000;
+    const size_t n = 12;
+    auto A = random_real_matrix<double>(m, n, 73);
+    math::Vector<double> b(m, util::uninitialized);
+    for (size_t i = 0; i < m; ++i) {
+      b[i] = std::cos(static_cast<double>(i));
+    }
+    const auto x = math::qr(A).solve(b);
+
+    exec::ThreadPool pool(3);
+    const exec::ScopedContext scope(exec::Context::on(pool));
+    const math::Matrix<double, math::Layout::ColMajor> Ac(A);
+    for (size_t leaves : {1, 2, 5, 8}) {
+      const auto f = math::tsqr(Ac, leaves);
+      ASSERT_TRUE(f.leaf_count() == leaves);
+      const auto Q = f.Q();
+      const auto R = f.R();
+      ASSERT_TRUE(math::loosely_equal(Q * R, A, 1e-10));
+      const auto I = math::identity_matrix<double>(n);
+      ASSERT_TRUE(math::loosely_equal(Q.transposed() * Q, I, 1e-10));
+
+      math::Matrix<double> C(A);
+      f.apply_qt(C);
+      ASSERT_TRUE(math::loosely_equal(C, f.R(true), 1e-10));
+      f.apply_q(C);
+      ASSERT_TRUE(math::loosely_equal(C, A, 1e-10));
+      ASSERT_TRUE(math::loosely_equal(f.solve(b), x, 1e-10));
+    }
+    ASSERT_TRUE(math::tsqr(A, 2000).leaf_count() == m / n);
+    ASSERT_THROW((void)math::tsqr(A.transposed()), std::invalid_argument);
+  }
+
+  void should_solve_many_least_squares_systems_with_one_qr() {
+    const size_t m = 120;
+    const size_t n = 70;
+    const size_t p = 6;
+    auto A = random_real_matrix<double>(m, n, 51);
+    auto B = random_real_matrix<double>(m, p, 52);
+    auto f = math::qr(A);
+    const auto X = f.solve(B);
+    ASSERT_TRUE(X.row_count() == n && X.column_count() == p);
+    // The residuals are orthogonal to the columns of A.
+    ASSERT_TRUE(math::loosely_equal(A.transposed() * (A * X - B),
+                                    math::Matrix<double>(n, p), 1e-9));
+
+    // A caller-owned workspace, and a refit that keeps the storage.
+    util::AlignedVector<double> work(f.workspace_size(p));
+    const double *storage = f.packed().data();
+    f.factor(math::Matrix<double, math::Layout::ColMajor>(A));
+    ASSERT_TRUE(f.packed().data() == storage);
+    math::Matrix<double> Y(B);
+    f.solve_inplace(Y.view(), work);
+    bool same = true;
+    for (size_t j = 0; j < p; ++j) {
+      math::Vector<double> b(m, util::uninitialized);
+      for (size_t i = 0; i < m; ++i) {
+        b[i] = B.at(i, j);
+      }
+      const auto x = f.solve(b);
+      for (size_t i = 0; i < n; ++i) {
+        same = same && is_close(Y.at(i, j), x[i], 1e-10) &&
+               is_close(X.at(i, j), x[i], 1e-10);
+      }
+    }
+    ASSERT_TRUE(same);
+    ASSERT_THROW(f.solve(math::Matrix<double>(m - 1, p)), std::invalid_argument);
+    ASSERT_THROW(math::qr(A.transposed()).solve(B.transposed()),
+                 std::invalid_argument);
+  }
+
   void should_qr_promote_int_matrix_to_double_result_and_reconstruct() {
     math::Matrix<int> A(4, 3, {1, 2, 3, 4, 5, 6, 7, 8, 9, 1, -1, 2});
     auto qr = math::QR_decompostion(A);
@@ -1592,6 +3059,8 @@ class MatrixTests : public ITest {
   int run_all_tests() override {
     should_construct_empty_matrix_with_zero_rows_and_columns();
     should_construct_empty_matrix_of_given_size();
+    should_allocate_aligned_storage_and_reuse_it_in_pool_scope();
+    should_zero_large_buffers_under_every_placement();
     should_throw_if_constructed_with_zero_dimensions();
     should_construct_from_raw_data();
     should_throw_if_raw_data_is_null();
@@ -1619,10 +3088,31 @@ class MatrixTests : public ITest {
     should_cast_large_matrix_efficiently();
     should_allow_chaining_cast_with_operations();
     should_cast_after_matrix_operations();
+    should_map_zip_map_and_apply_inplace();
+    should_evaluate_vectorized_math_within_ulp_bounds();
+    should_reduce_rows_and_columns();
+    should_reduce_large_matrices_along_both_axes();
+    should_broadcast_vectors_across_matrices();
+    should_round_half_precision_to_nearest_even();
+    should_multiply_half_precision_matrices_with_float_accumulation();
+    should_reduce_half_precision_in_float();
+    should_sum_long_rows_pairwise();
+    should_save_and_load_tuning_profiles();
+    should_report_unreadable_host_profile_without_throwing();
+    should_apply_tuning_profile_at_runtime();
+    should_autotune_without_changing_active_profile();
+    should_run_parallel_loops_on_every_backend();
+    should_nest_tasks_and_propagate_exceptions();
+    should_run_task_graphs_in_dependency_order();
+    should_give_same_results_on_every_execution_context();
     should_fill_matrix_with_value();
     should_make_identity_matrix();
     should_transpose_square_matrix_in_place();
     should_return_transposed_copy_for_non_square_matrix();
+    should_transpose_all_shapes_in_and_out_of_place();
+    should_transpose_with_streaming_stores();
+    should_store_column_major_matrices_by_columns();
+    should_convert_and_reinterpret_between_layouts();
     should_check_equality_between_identical_matrices();
     should_not_be_equal_if_any_element_differs();
     should_correctly_perform_unary_minus();
@@ -1638,15 +3128,32 @@ class MatrixTests : public ITest {
     should_multiply_assign_scalar();
     should_divide_matrix_and_scalar();
     should_divide_assign_scalar();
+    should_evaluate_lazy_expression_like_eager_operators();
+    should_assign_lazy_expression_into_existing_buffer();
     should_multiply_matrices();
+    should_multiply_matrices_with_sizes_not_multiple_of_tile();
+    should_multiply_matrices_of_any_layout();
+    should_multiply_column_major_matrix_by_vector();
+    should_multiply_mixed_type_matrices_in_packed_gemm();
+    should_multiply_tall_skinny_matrices();
+    should_multiply_integer_matrices_exactly();
+    should_multiply_with_strassen_within_error_bound();
+    should_multiply_integer_and_mixed_matrices_with_strassen();
+    should_multiply_small_integers_with_widened_accumulation();
+    should_dequantize_with_row_and_column_scales();
     should_multiply_matrix_and_vector();
+    should_multiply_mixed_type_matrix_and_vectors();
     matmul_time_test();
+    integer_gemm_time_test();
+    transpose_time_test();
     should_throw_if_plu_called_on_non_square_matrix();
     should_throw_for_singular_matrix();
     should_correctly_perform_plu_decomposition_on_small_matrix();
     should_correctly_handle_identity_matrix_in_plu();
     should_correctly_decompose_upper_triangular_matrix();
     should_correctly_handle_negative_pivots_in_plu();
+    should_store_plu_factors_packed_in_place();
+    should_solve_with_a_reusable_lu_factorization();
     plu_time_test();
     should_decompose_identity_matrix();
     should_decompose_known_small_matrix();
@@ -1662,6 +3169,8 @@ class MatrixTests : public ITest {
     should_explicitly_convert_float_to_double_in_cholesky();
     should_handle_int_identity_matrix_in_cholesky();
     should_handle_diagonal_int_matrix_in_cholesky();
+    should_factor_tiled_cholesky_on_every_context();
+    should_solve_with_a_reusable_cholesky_factorization();
     cholesky_time_test();
     should_compute_determinant_of_1x1_matrix();
     should_compute_determinant_of_2x2_matrix();
@@ -1702,6 +3211,10 @@ class MatrixTests : public ITest {
     should_decompose_wide_fullq_true_fullr_false();
     should_decompose_wide_fullq_false_fullr_true();
     should_decompose_wide_fullq_true_fullr_true();
+    should_decompose_qr_in_the_layout_of_the_input();
+    should_apply_q_of_a_blocked_qr_without_forming_it();
+    should_factor_tall_matrices_with_tsqr();
+    should_solve_many_least_squares_systems_with_one_qr();
     should_qr_promote_int_matrix_to_double_result_and_reconstruct();
     should_qr_work_with_float_input();
     should_decompose_1x1_matrix();
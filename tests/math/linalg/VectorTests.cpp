@@ -32,6 +32,16 @@ class VectorTests : public ITest {
     ASSERT_TRUE(v_row.orientation() == math::ROW);
   }
 
+  void should_construct_uninitialized_aligned_vector() {
+    math::Vector<float> v(9, uninitialized, math::ROW);
+    ASSERT_TRUE(v.size() == 9);
+    ASSERT_TRUE(v.orientation() == math::ROW);
+    ASSERT_TRUE(reinterpret_cast<uintptr_t>(v.data()) % DEFAULT_ALIGNMENT == 0);
+
+    math::Vector<int> zeros(4);
+    ASSERT_TRUE(zeros[0] == 0 && zeros[3] == 0);
+  }
+
   void should_throw_if_constructed_with_zero_size() {
     bool thrown = false;
     try {
@@ -93,6 +103,16 @@ class VectorTests : public ITest {
     ASSERT_TRUE(v[1] == 10);
   }
 
+  void should_adopt_aligned_storage_without_copying() {
+    math::Vector<double>::storage_type storage(4);
+    storage[2] = 7.0;
+    const double *buffer = storage.data();
+    math::Vector<double> v(4, std::move(storage), math::ROW);
+    ASSERT_TRUE(v.data() == buffer && v[2] == 7.0 && v.orientation() == math::ROW);
+    ASSERT_THROW(math::Vector<double>(3, math::Vector<double>::storage_type(2)),
+                 std::invalid_argument);
+  }
+
   void should_throw_if_std_vector_move_size_mismatch() {
     std::vector<int> data = {1, 2};
     bool thrown = false;
@@ -245,6 +265,26 @@ class VectorTests : public ITest {
     ASSERT_TRUE(v_row.size() == 3);
   }
 
+  void should_map_zip_map_and_apply_inplace() {
+    math::Vector<double> v(3, std::vector<double>{1, 4, 9}, math::ROW);
+    auto r = v.map(math::vmath::sqrt);
+    ASSERT_TRUE(r.orientation() == math::ROW);
+    ASSERT_TRUE(r[0] == 1.0 && r[1] == 2.0 && r[2] == 3.0);
+
+    auto floors = v.map([](double x) { return static_cast<int>(x / 2); });
+    ASSERT_SAME_TYPE(floors, math::Vector<int>);
+    ASSERT_TRUE(floors[2] == 4);
+
+    math::Vector<double> w(3, std::vector<double>{1, 2, 3}, math::ROW);
+    auto q = v.zip_map(w, [](double a, double b) { return a / b; });
+    ASSERT_TRUE(q[1] == 2.0 && q[2] == 3.0);
+    ASSERT_THROW(v.zip_map(w.transposed(), [](double a, double b) { return a / b; }),
+                 std::invalid_argument);
+
+    w.apply_inplace(math::vmath::log);
+    ASSERT_TRUE(w[0] == 0.0 && is_close(w[2], std::log(3.0), 1e-15));
+  }
+
   //=============================================================================
   // VECTOR OPERATORS TESTS
   //=============================================================================
@@ -418,6 +458,26 @@ class VectorTests : public ITest {
     ASSERT_TRUE(is_close(v2[1], 3.0f));
   }
 
+  void should_evaluate_lazy_vector_expression() {
+    math::Vector<float> x(3, std::vector<float>{1.0f, 2.0f, 3.0f}, math::ROW);
+    math::Vector<int> y(3, std::vector<int>{1, 1, 1}, math::ROW);
+
+    math::Vector<double> z = math::lazy(x) * 2.0 - y;
+    ASSERT_TRUE(z.orientation() == math::ROW);
+    ASSERT_TRUE(is_close(z[0], 1.0));
+    ASSERT_TRUE(is_close(z[2], 5.0));
+
+    auto w = math::eval(math::lazy(y) / 2);
+    ASSERT_SAME_TYPE(w, math::Vector<double>);
+    ASSERT_TRUE(is_close(w[1], 0.5));
+
+    z -= math::lazy(y) * 1.0;
+    ASSERT_TRUE(is_close(z[1], 2.0));
+
+    math::Vector<int> column(3, std::vector<int>{1, 1, 1}, math::COLUMN);
+    ASSERT_THROW(math::eval(math::lazy(x) + column), std::invalid_argument);
+  }
+
   void should_calculate_dot_product() {
     math::Vector<int> v1(3);
     v1[0] = 1;
@@ -439,6 +499,56 @@ class VectorTests : public ITest {
     ASSERT_TRUE(thrown);
   }
 
+  void should_accumulate_half_precision_dot_product_in_float() {
+    // 3000 products of 1: a bfloat16 running sum would stall at 256.
+    math::Vector<bf16> a(3000, uninitialized, math::ROW);
+    math::Vector<bf16> b(3000, uninitialized);
+    std::fill_n(a.data(), a.size(), bf16(1));
+    std::fill_n(b.data(), b.size(), bf16(1));
+    const auto result = a.dot_product(b);
+    ASSERT_SAME_TYPE(result, float);
+    ASSERT_TRUE(result == 3000.0F && a * b == 3000.0F);
+  }
+
+  void should_sum_long_float_vectors_pairwise() {
+    // A single float accumulator of 2^22 tenths is off by several percent.
+    const size_t n = 1UL << 22;
+    math::Vector<float> x(n, uninitialized);
+    math::Vector<float> ones(n, uninitialized);
+    x.fill(0.1F);
+    ones.fill(1.0F);
+    const long double expected = static_cast<long double>(n) * 0.1F;
+    auto relative_error = [&](long double value) {
+      return std::abs(value - expected) / expected;
+    };
+    // Called directly: Vector<float>::dot_product may go to a vendor BLAS.
+    ASSERT_TRUE(relative_error(math::kernels::dot_n<float>(n, x.data(), 1, ones.data(),
+                                                           1)) < 1e-6L);
+    ASSERT_TRUE(relative_error(math::kernels::sum_n<float>(n, x.data(), 1)) < 1e-6L);
+    ASSERT_TRUE(relative_error(2 * math::kernels::sum_n<float>(n / 2, x.data(), 2)) <
+                1e-6L);
+    const long double norm = x.norm();
+    ASSERT_TRUE(std::abs((norm * norm) - (expected * 0.1F)) / (expected * 0.1F) <
+                1e-6L);
+  }
+
+  void should_sum_with_compensation() {
+    // The ones next to 1e16 are below its rounding error in every lane.
+    const size_t n = 4096;
+    math::Vector<double> x(n, uninitialized);
+    x.fill(1.0);
+    x[0] = 1e16;
+    x[n - 1] = -1e16;
+    const double exact = static_cast<double>(n - 2);
+    const double pairwise = math::kernels::sum_n<double>(n, x.data(), 1);
+    ASSERT_TRUE(std::abs(pairwise - exact) > 16.0);
+#if !defined(__FAST_MATH__) || defined(__clang__)
+    const double compensated =
+        math::kernels::sum_n<double, math::Summation::Compensated>(n, x.data(), 1);
+    ASSERT_TRUE(std::abs(compensated - exact) <= 4.0);
+#endif
+  }
+
   void should_calculate_outer_product() {
     math::Vector<int> v_col(2, math::COLUMN);
     v_col[0] = 1;
@@ -502,6 +612,7 @@ class VectorTests : public ITest {
   int run_all_tests() override {
     should_construct_empty_vector_with_zero_size();
     should_construct_vector_of_given_size();
+    should_construct_uninitialized_aligned_vector();
     should_throw_if_constructed_with_zero_size();
     should_construct_from_raw_data();
     should_throw_if_raw_data_constructor_has_zero_size();
@@ -509,6 +620,7 @@ class VectorTests : public ITest {
     should_throw_if_std_vector_copy_size_mismatch();
     should_construct_from_std_vector_move();
     should_throw_if_std_vector_move_size_mismatch();
+    should_adopt_aligned_storage_without_copying();
     should_construct_from_std_array();
     should_throw_if_std_array_size_mismatch();
     should_access_elements_with_at_and_operator();
@@ -520,6 +632,7 @@ class VectorTests : public ITest {
     should_normalize_vector_in_place();
     should_transpose_vector_in_place();
     should_return_transposed_copy();
+    should_map_zip_map_and_apply_inplace();
     should_check_equality();
     should_perform_unary_minus();
     should_add_two_vectors();
@@ -530,7 +643,11 @@ class VectorTests : public ITest {
     should_multiply_vector_by_scalar_and_assign();
     should_divide_vector_by_scalar();
     should_divide_vector_by_scalar_and_assign();
+    should_evaluate_lazy_vector_expression();
     should_calculate_dot_product();
+    should_accumulate_half_precision_dot_product_in_float();
+    should_sum_long_float_vectors_pairwise();
+    should_sum_with_compensation();
     should_calculate_outer_product();
     should_multiply_row_vector_and_matrix();
     return 0;
@@ -6,6 +6,7 @@
 #include "MafLib/math/linalg/Vector.hpp"
 #include "MafLib/math/linalg/VectorView.hpp"
 #include "MafLib/math/linalg/VectorViewOperators.hpp"
+#include "MafLib/math/linalg/ViewKernels.hpp"
 #include "MafLib/utility/Math.hpp"
 
 namespace maf::test {
@@ -121,6 +122,66 @@ class ViewTests : public ITest {
     ASSERT_TRUE(thrown);
   }
 
+  void should_view_transposes_columns_and_diagonals_without_copying() {
+    Matrix<int> m(3, 4, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12});
+
+    auto t = m.transposed_view();
+    ASSERT_TRUE(t.row_count() == 4 && t.column_count() == 3);
+    ASSERT_TRUE(t.row_stride() == 1 && t.column_stride() == 4);
+    ASSERT_TRUE(t.data() == m.data());
+    ASSERT_TRUE((t[1, 2] == 10 && t.at(3, 0) == 4));
+    t.at(2, 1) = -7;
+    ASSERT_TRUE(m.at(1, 2) == -7);
+
+    // Sub-views of a transpose keep both strides.
+    auto block = t.view(1, 1, 2, 2);
+    ASSERT_TRUE((block[0, 0] == 6 && block[1, 0] == -7 && block[1, 1] == 11));
+    ASSERT_TRUE(block.transposed_view().at(0, 1) == -7);
+
+    auto column = m.column_view(2);
+    ASSERT_TRUE(column.size() == 3 && column.get_increment() == 4);
+    ASSERT_TRUE(column.orientation() == COLUMN);
+    ASSERT_TRUE(column[0] == 3 && column[1] == -7 && column[2] == 11);
+    auto row = t.row_view(0);
+    ASSERT_TRUE(row.orientation() == ROW && row.get_increment() == 4);
+    ASSERT_TRUE(row[0] == 1 && row[1] == 5 && row[2] == 9);
+    auto diagonal = m.diagonal_view();
+    ASSERT_TRUE(diagonal.size() == 3 && diagonal.get_increment() == 5);
+    ASSERT_TRUE(diagonal[0] == 1 && diagonal[1] == 6 && diagonal[2] == 11);
+
+    ASSERT_THROW(t.row_span(0), std::logic_error);
+    ASSERT_THROW(m.column_view(4), std::out_of_range);
+    ASSERT_THROW(t.view(0, 0, 5, 1), std::out_of_range);
+  }
+
+  void should_view_const_and_column_major_matrices() {
+    const Matrix<double> m(2, 3, {1, 2, 3, 4, 5, 6});
+    auto cv = m.view();
+    ASSERT_SAME_TYPE(cv, MatrixView<const double>);
+    ASSERT_SAME_TYPE(m.transposed_view(), MatrixView<const double>);
+    ASSERT_SAME_TYPE(m.column_view(0), VectorView<const double>);
+    ASSERT_TRUE(cv.at(1, 2) == 6.0 && m.view(1, 1, 1, 2).at(0, 1) == 6.0);
+
+    // A mutable view converts to a read-only one.
+    Matrix<double> w(2, 2, {1, 2, 3, 4});
+    MatrixView<const double> ro = w.view();
+    ASSERT_TRUE(ro.at(1, 0) == 3.0);
+    ASSERT_TRUE(MatrixViewType<MatrixView<const double>>);
+    ASSERT_TRUE(VectorViewType<VectorView<const double>>);
+
+    Matrix<double, Layout::ColMajor> c(2, 3, {1, 4, 2, 5, 3, 6});
+    auto v = c.view();
+    ASSERT_TRUE(v.is_column_major() && !v.is_row_major());
+    ASSERT_TRUE((v[0, 2] == 3.0 && v[1, 0] == 4.0 && v.at(1, 2) == 6.0));
+    ASSERT_TRUE(c.row_view(1).get_increment() == 2 && c.row_view(1)[2] == 6.0);
+    ASSERT_TRUE(c.transposed_view().is_row_major());
+
+    // Read-only views flow through the operators.
+    Vector<double> x(3, std::vector<double>{1, 1, 1});
+    auto y = cv * x;
+    ASSERT_TRUE(y[0] == 6.0 && y[1] == 15.0);
+  }
+
   //=============================================================================
   // MATRIX & VECTOR VIEW OPERATORS TESTS
   //=============================================================================
@@ -677,6 +738,509 @@ class ViewTests : public ITest {
     ASSERT_TRUE(is_close(res.at(1), 20.0 * 1.0 + 21.0 * 2.0 + 22.0 * 3.0));
   }
 
+  //=============================================================================
+  // LEVEL 2 KERNEL TESTS
+  //=============================================================================
+  template <typename T, typename U, typename V>
+  void check_gemv_on_sub_blocks(kernels::OP trans, size_t M, size_t N) {
+    const bool t = trans == kernels::OP::Trans;
+    const size_t in = t ? M : N;
+    const size_t out = t ? N : M;
+
+    // M is not a multiple of the row unroll, x and y are strided.
+    Matrix<T> a_parent(M + 2, N + 3);
+    for (size_t i = 0; i < a_parent.size(); ++i) {
+      a_parent.data()[i] = static_cast<T>(static_cast<int>(i % 7) - 3);
+    }
+    Vector<U> x_parent(2 * in);
+    for (size_t i = 0; i < x_parent.size(); ++i) {
+      x_parent[i] = static_cast<U>(static_cast<int>(i % 5) - 2);
+    }
+    Vector<V> y_parent(3 * out);
+    y_parent.fill(V(1));
+
+    auto A = a_parent.view(1, 2, M, N);
+    auto x = x_parent.view(0, in, 2);
+    kernels::gemv(trans, 2.0, A, x, 0.5, y_parent.view(0, out, 3));
+
+    bool ok = true;
+    for (size_t i = 0; i < out; ++i) {
+      double sum = 0.0;
+      for (size_t p = 0; p < in; ++p) {
+        sum += static_cast<double>(t ? A[p][i] : A[i][p]) * static_cast<double>(x[p]);
+      }
+      ok = ok && is_close(y_parent[3 * i], (2.0 * sum) + 0.5, 1e-3);
+      // Gaps between strided elements are untouched.
+      ok = ok && y_parent[(3 * i) + 1] == V(1);
+    }
+    ASSERT_TRUE(ok);
+  }
+
+  void should_compute_gemv_into_strided_views() {
+    for (auto trans : {kernels::OP::NoTrans, kernels::OP::Trans}) {
+      check_gemv_on_sub_blocks<double, double, double>(trans, 23, 17);
+      check_gemv_on_sub_blocks<float, float, float>(trans, 23, 17);
+      check_gemv_on_sub_blocks<int, double, float>(trans, 23, 17);
+      check_gemv_on_sub_blocks<int, float, double>(trans, 601, 503);
+    }
+  }
+
+  void should_apply_rank_one_update_to_strided_view() {
+    Matrix<double> a_parent(6, 7);
+    a_parent.fill(1.0);
+    Vector<int> x(4, std::vector<int>{1, 2, 3, 4});
+    Vector<float> y_parent(9, std::vector<float>{1, 9, 2, 9, 3, 9, 4, 9, 5});
+    kernels::ger(a_parent.view(1, 1, 4, 5), x.view(0, 4), y_parent.view(0, 5, 2), -2.0);
+
+    bool ok = a_parent.at(0, 0) == 1.0 && a_parent.at(5, 6) == 1.0;
+    for (size_t i = 0; i < 4; ++i) {
+      for (size_t j = 0; j < 5; ++j) {
+        ok = ok && a_parent.at(i + 1, j + 1) == 1.0 - (2.0 * double(i + 1) * double(j + 1));
+      }
+    }
+    ASSERT_TRUE(ok);
+  }
+
+  void should_compute_symv_from_one_triangle() {
+    constexpr size_t N = 19;
+    Matrix<double> full(N, N);
+    for (size_t i = 0; i < N; ++i) {
+      for (size_t j = 0; j <= i; ++j) {
+        full[i][j] = full[j][i] = static_cast<double>((i * 3 + j) % 11) - 5.0;
+      }
+    }
+    Vector<double> x_parent(2 * N);
+    for (size_t i = 0; i < x_parent.size(); ++i) {
+      x_parent[i] = static_cast<double>(i % 4) + 0.5;
+    }
+    auto x = x_parent.view(0, N, 2);
+    const auto expected = kernels::gemv(kernels::OP::NoTrans, full.view(0, 0, N, N), x);
+
+    for (auto uplo : {kernels::UPLO::Lower, kernels::UPLO::Upper}) {
+      // Poison the triangle that must not be read.
+      Matrix<double> stored = full;
+      for (size_t i = 0; i < N; ++i) {
+        for (size_t j = 0; j < N; ++j) {
+          if (uplo == kernels::UPLO::Lower ? j > i : j < i) {
+            stored[i][j] = 1e6;
+          }
+        }
+      }
+      Vector<double> y_parent(2 * N);
+      y_parent.fill(2.0);
+      kernels::symv(uplo, 1.0, stored.view(0, 0, N, N), x, -1.0,
+                    y_parent.view(0, N, 2));
+      Vector<float> y_float(N);
+      kernels::symv(uplo, 1.0, stored.view(0, 0, N, N), x, 0.0, y_float.view(0, N));
+
+      bool ok = true;
+      for (size_t i = 0; i < N; ++i) {
+        ok = ok && is_close(y_parent[2 * i], expected[i] - 2.0, 1e-9) &&
+             is_close(static_cast<double>(y_float[i]), expected[i], 1e-4);
+      }
+      ASSERT_TRUE(ok);
+    }
+  }
+
+  template <typename T>
+  void check_trsv(kernels::UPLO uplo, kernels::OP trans, kernels::DIAG diag) {
+    constexpr size_t N = 13;
+    const bool lower = uplo == kernels::UPLO::Lower;
+    const bool t = trans == kernels::OP::Trans;
+    const bool unit = diag == kernels::DIAG::Unit;
+
+    // Triangle with a dominant diagonal; the other triangle and, for unit solves, the
+    // diagonal hold values that must be ignored.
+    Matrix<T> A(N, N);
+    for (size_t i = 0; i < N; ++i) {
+      for (size_t j = 0; j < N; ++j) {
+        if (i == j) {
+          A[i][j] = unit ? T(100) : static_cast<T>(4 + (i % 3));
+        } else if (lower ? j < i : j > i) {
+          A[i][j] = static_cast<T>(static_cast<int>((i + (2 * j)) % 5) - 2) / T(4);
+        } else {
+          A[i][j] = T(1000);
+        }
+      }
+    }
+    auto effective = [&](size_t i, size_t j) -> double {
+      const size_t r = t ? j : i;
+      const size_t c = t ? i : j;
+      if (r == c) {
+        return unit ? 1.0 : static_cast<double>(A[r][c]);
+      }
+      return (lower ? c < r : c > r) ? static_cast<double>(A[r][c]) : 0.0;
+    };
+
+    std::vector<double> solution(N);
+    Vector<T> b_parent(3 * N);
+    b_parent.fill(T(-7));
+    for (size_t i = 0; i < N; ++i) {
+      solution[i] = static_cast<double>(i % 4) - 1.5;
+    }
+    for (size_t i = 0; i < N; ++i) {
+      double sum = 0.0;
+      for (size_t j = 0; j < N; ++j) {
+        sum += effective(i, j) * solution[j];
+      }
+      b_parent[3 * i] = static_cast<T>(sum);
+    }
+
+    kernels::trsv(uplo, trans, diag, A.view(0, 0, N, N),
+                  b_parent.view(0, N, 3));
+    bool ok = true;
+    for (size_t i = 0; i < N; ++i) {
+      ok = ok && is_close(static_cast<double>(b_parent[3 * i]), solution[i], 1e-4) &&
+           b_parent[(3 * i) + 1] == T(-7);
+    }
+    ASSERT_TRUE(ok);
+  }
+
+  void should_solve_triangular_systems_in_all_modes() {
+    for (auto uplo : {kernels::UPLO::Lower, kernels::UPLO::Upper}) {
+      for (auto trans : {kernels::OP::NoTrans, kernels::OP::Trans}) {
+        for (auto diag : {kernels::DIAG::NonUnit, kernels::DIAG::Unit}) {
+          check_trsv<double>(uplo, trans, diag);
+          check_trsv<float>(uplo, trans, diag);
+        }
+      }
+    }
+
+    // Contiguous, same-type right-hand side is solved without a copy.
+    Matrix<double> L(2, 2, {2.0, 0.0, 1.0, 4.0});
+    Vector<double> b(2, std::vector<double>{2.0, 9.0});
+    kernels::trsv(kernels::UPLO::Lower, kernels::OP::NoTrans, kernels::DIAG::NonUnit,
+                  L.view(0, 0, 2, 2), b.view(0, 2));
+    ASSERT_TRUE(b[0] == 1.0 && b[1] == 2.0);
+  }
+
+  template <typename T>
+  void check_trsm(kernels::UPLO uplo, kernels::OP trans, kernels::DIAG diag) {
+    // More than one recursion block of the blocked solve.
+    constexpr size_t N = 150;
+    constexpr size_t P = 9;
+    const bool lower = uplo == kernels::UPLO::Lower;
+    Matrix<T> A(N, N);
+    for (size_t i = 0; i < N; ++i) {
+      for (size_t j = 0; j < N; ++j) {
+        if (i == j) {
+          A[i, j] = static_cast<T>(2 + (i % 3));
+        } else if (lower ? j < i : j > i) {
+          A[i, j] = static_cast<T>(static_cast<int>((i + (2 * j)) % 5) - 2) / T(N);
+        } else {
+          A[i, j] = T(1000);
+        }
+      }
+    }
+    // The same right-hand sides row-major, column-major and every other column.
+    Matrix<T> rows(N, P);
+    Matrix<T, Layout::ColMajor> cols(N, P);
+    Matrix<T> wide(N, 2 * P);
+    for (size_t i = 0; i < N; ++i) {
+      for (size_t j = 0; j < P; ++j) {
+        rows[i, j] = cols[i, j] = wide[i, 2 * j] =
+            static_cast<T>(static_cast<int>((i * 7 + j * 3) % 11) - 5);
+      }
+    }
+    Matrix<T> expected(rows);
+    for (size_t j = 0; j < P; ++j) {
+      Vector<T> x(N, util::uninitialized);
+      for (size_t i = 0; i < N; ++i) x[i] = rows[i, j];
+      kernels::trsv(uplo, trans, diag, A.view(), x.view(0, N));
+      for (size_t i = 0; i < N; ++i) expected[i, j] = x[i];
+    }
+
+    kernels::trsm(uplo, trans, diag, A.view(), rows.view());
+    kernels::trsm(uplo, trans, diag, A.view(), cols.view());
+    kernels::trsm(uplo, trans, diag, A.view(),
+                  MatrixView<T>(wide.data(), N, P, 2 * P, 2));
+    const double tol = std::is_same_v<T, float> ? 1e-4 : 1e-10;
+    bool ok = true;
+    for (size_t i = 0; i < N; ++i) {
+      for (size_t j = 0; j < P; ++j) {
+        const auto e = static_cast<double>(expected[i, j]);
+        ok = ok && is_close(static_cast<double>(rows[i, j]), e, tol) &&
+             is_close(static_cast<double>(cols[i, j]), e, tol) &&
+             is_close(static_cast<double>(wide[i, 2 * j]), e, tol) &&
+             wide[i, (2 * j) + 1] == T(0);
+      }
+    }
+    ASSERT_TRUE(ok);
+  }
+
+  void should_solve_triangular_systems_with_many_right_hand_sides() {
+    for (auto uplo : {kernels::UPLO::Lower, kernels::UPLO::Upper}) {
+      for (auto trans : {kernels::OP::NoTrans, kernels::OP::Trans}) {
+        for (auto diag : {kernels::DIAG::NonUnit, kernels::DIAG::Unit}) {
+          check_trsm<double>(uplo, trans, diag);
+          check_trsm<float>(uplo, trans, diag);
+        }
+      }
+    }
+    Matrix<double> A(3, 3);
+    Matrix<double> B(4, 2);
+    ASSERT_THROW(kernels::trsm(kernels::UPLO::Lower, kernels::OP::NoTrans,
+                               kernels::DIAG::Unit, A.view(), B.view()),
+                 std::invalid_argument);
+  }
+
+  template <typename T>
+  void check_level2_on_strides() {
+    constexpr size_t M = 19;
+    constexpr size_t N = 13;
+    // The same M x N values as a row-major block, a column-major block (transposed
+    // view of its transpose) and a view that skips every other column.
+    Matrix<T> rows(M, N);
+    Matrix<T> wide(M, 2 * N);
+    Matrix<T, Layout::ColMajor> cols(M, N);
+    for (size_t i = 0; i < M; ++i) {
+      for (size_t j = 0; j < N; ++j) {
+        const T v = static_cast<T>(static_cast<int>((i * 5 + j * 3) % 9) - 4);
+        rows[i, j] = cols[i, j] = wide[i, 2 * j] = v;
+      }
+    }
+    const MatrixView<T> layouts[] = {
+        cols.view(), MatrixView<T>(wide.data(), M, N, 2 * N, 2),
+        rows.transposed_view().transposed_view()};
+    Vector<T> x(N);
+    Vector<T> xt(M, util::uninitialized, ROW);
+    for (size_t i = 0; i < N; ++i) x[i] = static_cast<T>(i % 4) - T(1);
+    for (size_t i = 0; i < M; ++i) xt[i] = static_cast<T>(i % 3) - T(1);
+    const auto y_ref = kernels::gemv(kernels::OP::NoTrans, rows.view(), x.view(0, N));
+    const auto yt_ref = kernels::gemv(kernels::OP::Trans, rows.view(), xt.view(0, M));
+
+    bool ok = true;
+    for (const auto &A : layouts) {
+      const auto y = kernels::gemv(kernels::OP::NoTrans, A, x.view(0, N));
+      const auto yt = kernels::gemv(kernels::OP::Trans, A, xt.view(0, M));
+      ok = ok && y == y_ref && yt == yt_ref;
+      // op(A^T) reads the same storage with the opposite op.
+      ok = ok && kernels::gemv(kernels::OP::Trans, A.transposed_view(), x.view(0, N)) ==
+                     y_ref.transposed();
+    }
+    ASSERT_TRUE(ok);
+
+    // Rank-1 update through a column-major and a general strided view.
+    Vector<T> u(M);
+    u.fill(T(1));
+    kernels::ger(cols.view(), u.view(0, M), x.view(0, N), 2.0);
+    kernels::ger(MatrixView<T>(wide.data(), M, N, 2 * N, 2), u.view(0, M), x.view(0, N),
+                 2.0);
+    kernels::ger(rows.view(), u.view(0, M), x.view(0, N), 2.0);
+    for (size_t i = 0; i < M; ++i) {
+      for (size_t j = 0; j < N; ++j) {
+        ok = ok && cols.at(i, j) == rows.at(i, j) && wide.at(i, 2 * j) == rows.at(i, j);
+      }
+    }
+    ASSERT_TRUE(ok);
+
+    // Square column-major triangles for symv and trsv.
+    constexpr size_t K = 11;
+    Matrix<T> sym(K, K);
+    for (size_t i = 0; i < K; ++i) {
+      for (size_t j = 0; j < K; ++j) {
+        sym[i, j] = (i == j) ? T(8) : ((i > j) ? T(1) : T(100));
+      }
+    }
+    const Matrix<T, Layout::ColMajor> sym_cols(sym);
+    Vector<T> b(K, std::vector<T>(K, T(1)));
+    Vector<T> y_rows(K);
+    Vector<T> y_cols(K);
+    kernels::symv(kernels::UPLO::Lower, 1.0, sym.view(), b.view(0, K), 0.0,
+                  y_rows.view(0, K));
+    kernels::symv(kernels::UPLO::Lower, 1.0, sym_cols.view(), b.view(0, K), 0.0,
+                  y_cols.view(0, K));
+    ASSERT_TRUE(y_rows == y_cols);
+    for (auto trans : {kernels::OP::NoTrans, kernels::OP::Trans}) {
+      Vector<T> s_rows = b;
+      Vector<T> s_cols = b;
+      kernels::trsv(kernels::UPLO::Lower, trans, kernels::DIAG::NonUnit, sym.view(),
+                    s_rows.view(0, K));
+      kernels::trsv(kernels::UPLO::Lower, trans, kernels::DIAG::NonUnit,
+                    sym_cols.view(), s_cols.view(0, K));
+      ASSERT_TRUE(loosely_equal(s_rows, s_cols));
+    }
+  }
+
+  void should_pick_unit_stride_paths_for_any_view() {
+    check_level2_on_strides<double>();
+    check_level2_on_strides<float>();
+    check_level2_on_strides<int>();
+  }
+
+  void should_throw_if_level2_dimensions_mismatch() {
+    Matrix<double> A(3, 4);
+    Vector<double> x(3);
+    Vector<double> y(3);
+    ASSERT_THROW(kernels::gemv(kernels::OP::NoTrans, 1.0, A.view(0, 0, 3, 4),
+                               x.view(0, 3), 0.0, y.view(0, 3)),
+                 std::invalid_argument);
+    ASSERT_THROW(kernels::gemv(kernels::OP::NoTrans, A.view(0, 0, 3, 4), x.view(0, 3)),
+                 std::invalid_argument);
+    ASSERT_THROW(kernels::ger(A.view(0, 0, 3, 4), x.view(0, 3), y.view(0, 3)),
+                 std::invalid_argument);
+    ASSERT_THROW(kernels::symv(kernels::UPLO::Lower, 1.0, A.view(0, 0, 3, 4),
+                               x.view(0, 3), 0.0, y.view(0, 3)),
+                 std::invalid_argument);
+    ASSERT_THROW(kernels::trsv(kernels::UPLO::Upper, kernels::OP::NoTrans,
+                               kernels::DIAG::NonUnit, A.view(0, 0, 3, 3),
+                               x.view(0, 2)),
+                 std::invalid_argument);
+  }
+
+  //=============================================================================
+  // GEMM KERNEL TESTS
+  //=============================================================================
+  template <typename T, typename U, typename V>
+  void check_gemm_on_sub_blocks(kernels::OP trans_a, kernels::OP trans_b) {
+    const bool at = trans_a == kernels::OP::Trans;
+    const bool bt = trans_b == kernels::OP::Trans;
+    constexpr size_t M = 37;
+    constexpr size_t N = 29;
+    constexpr size_t K = 41;
+
+    // Operands live inside larger matrices, so every view is strided.
+    Matrix<T> a_parent(at ? K + 3 : M + 3, at ? M + 5 : K + 5);
+    Matrix<U> b_parent(bt ? N + 2 : K + 2, bt ? K + 4 : N + 4);
+    Matrix<V> c_parent(M + 1, N + 6);
+    for (size_t i = 0; i < a_parent.size(); ++i) {
+      a_parent.data()[i] = static_cast<T>(static_cast<int>(i % 7) - 3);
+    }
+    for (size_t i = 0; i < b_parent.size(); ++i) {
+      b_parent.data()[i] = static_cast<U>(static_cast<int>(i % 5) - 2);
+    }
+    c_parent.fill(V(1));
+
+    auto A = a_parent.view(1, 2, at ? K : M, at ? M : K);
+    auto B = b_parent.view(2, 1, bt ? N : K, bt ? K : N);
+    Matrix<V> expected = c_parent;
+    kernels::gemm(trans_a, trans_b, 2.0, A, B, 0.5, c_parent.view(1, 3, M, N));
+
+    bool ok = true;
+    for (size_t i = 0; i < M; ++i) {
+      for (size_t j = 0; j < N; ++j) {
+        double sum = 0.0;
+        for (size_t p = 0; p < K; ++p) {
+          sum += static_cast<double>(at ? A[p][i] : A[i][p]) *
+                 static_cast<double>(bt ? B[j][p] : B[p][j]);
+        }
+        ok = ok && is_close(c_parent.at(i + 1, j + 3), (2.0 * sum) + 0.5, 1e-3);
+      }
+    }
+    // Elements outside the target block are untouched.
+    ok = ok && c_parent.at(0, 0) == expected.at(0, 0) &&
+         c_parent.at(M, N + 5) == expected.at(M, N + 5);
+    ASSERT_TRUE(ok);
+  }
+
+  void should_compute_gemm_into_strided_views() {
+    for (auto trans_a : {kernels::OP::NoTrans, kernels::OP::Trans}) {
+      for (auto trans_b : {kernels::OP::NoTrans, kernels::OP::Trans}) {
+        check_gemm_on_sub_blocks<double, double, double>(trans_a, trans_b);
+        check_gemm_on_sub_blocks<float, float, float>(trans_a, trans_b);
+        check_gemm_on_sub_blocks<int, double, float>(trans_a, trans_b);
+      }
+    }
+  }
+
+  template <typename T>
+  void check_gemm_on_layouts() {
+    constexpr size_t M = 23;
+    constexpr size_t N = 17;
+    constexpr size_t K = 31;
+    Matrix<T> a(M, K);
+    Matrix<T> b(K, N);
+    for (size_t i = 0; i < a.size(); ++i) {
+      a.data()[i] = static_cast<T>(static_cast<int>(i % 7) - 3);
+    }
+    for (size_t i = 0; i < b.size(); ++i) {
+      b.data()[i] = static_cast<T>(static_cast<int>(i % 5) - 2);
+    }
+    Matrix<T> expected(M, N);
+    kernels::gemm(kernels::OP::NoTrans, kernels::OP::NoTrans, 1.0, a.view(), b.view(),
+                  0.0, expected.view());
+
+    const Matrix<T, Layout::ColMajor> a_cols(a);
+    const Matrix<T, Layout::ColMajor> b_cols(b);
+    // Every combination of row- and column-contiguous operands, plus a C that has
+    // neither unit stride.
+    Matrix<T> c_rows(M, N);
+    Matrix<T, Layout::ColMajor> c_cols(M, N);
+    Matrix<T> c_wide(M, 3 * N);
+    kernels::gemm(kernels::OP::NoTrans, kernels::OP::NoTrans, 1.0, a_cols.view(),
+                  b.view(), 0.0, c_rows.view());
+    kernels::gemm(kernels::OP::NoTrans, kernels::OP::NoTrans, 1.0, a.view(),
+                  b_cols.view(), 0.0, c_cols.view());
+    kernels::gemm(kernels::OP::Trans, kernels::OP::Trans, 1.0,
+                  a_cols.transposed_view(), b.transposed_view(), 0.0,
+                  MatrixView<T>(c_wide.data(), M, N, 3 * N, 3));
+
+    bool ok = true;
+    for (size_t i = 0; i < M; ++i) {
+      for (size_t j = 0; j < N; ++j) {
+        ok = ok && c_rows.at(i, j) == expected.at(i, j) &&
+             c_cols.at(i, j) == expected.at(i, j) &&
+             c_wide.at(i, 3 * j) == expected.at(i, j) && c_wide.at(i, (3 * j) + 1) == T(0);
+      }
+    }
+    ASSERT_TRUE(ok);
+  }
+
+  void should_compute_gemm_on_transposed_and_column_major_views() {
+    check_gemm_on_layouts<double>();
+    check_gemm_on_layouts<float>();
+    check_gemm_on_layouts<int>();
+  }
+
+  void should_throw_if_gemm_dimensions_mismatch() {
+    Matrix<double> A(3, 4);
+    Matrix<double> B(3, 2);
+    Matrix<double> C(3, 2);
+    ASSERT_THROW(kernels::gemm(kernels::OP::NoTrans, kernels::OP::NoTrans, 1.0,
+                               A.view(0, 0, 3, 4), B.view(0, 0, 3, 2), 0.0,
+                               C.view(0, 0, 3, 2)),
+                 std::invalid_argument);
+  }
+
+  //=============================================================================
+  // ELEMENT-WISE KERNEL TESTS
+  //=============================================================================
+
+  void should_map_and_zip_map_strided_views() {
+    Matrix<double> m(3, 4, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12});
+    auto sq = kernels::map(m.view(1, 1, 2, 3), [](double x) { return x * x; });
+    ASSERT_TRUE(sq.row_count() == 2 && sq.column_count() == 3);
+    ASSERT_TRUE(sq.at(0, 0) == 36.0 && sq.at(1, 2) == 144.0);
+
+    // Transposed (column-contiguous) view, result in row-major order of the view.
+    auto t = kernels::map(m.transposed_view(), [](double x) { return int(x) % 5; });
+    ASSERT_SAME_TYPE(t, Matrix<int>);
+    ASSERT_TRUE(t.row_count() == 4 && t.at(0, 1) == 0 && t.at(3, 2) == 2);
+
+    Matrix<double, Layout::ColMajor> c(3, 4, {1, 5, 9, 2, 6, 10, 3, 7, 11, 4, 8, 12});
+    auto sum = kernels::zip_map(m.view(), c.view(),
+                                [](double a, double b) { return a + b; });
+    ASSERT_TRUE(sum.at(2, 3) == 24.0 && sum.at(1, 0) == 10.0);
+    ASSERT_THROW(kernels::zip_map(m.view(0, 0, 2, 2), c.view(),
+                                  [](double a, double b) { return a + b; }),
+                 std::invalid_argument);
+
+    // In place on a column of a strided block.
+    kernels::apply_inplace(m.column_view(2), [](double x) { return -x; });
+    ASSERT_TRUE(m.at(0, 2) == -3.0 && m.at(2, 2) == -11.0 && m.at(2, 3) == 12.0);
+    kernels::apply_inplace(c.view(1, 1, 2, 2), vmath::log);
+    ASSERT_TRUE(is_close(c.at(1, 1), std::log(6.0), 1e-15));
+    ASSERT_TRUE(c.at(0, 1) == 2.0 && c.at(1, 3) == 8.0);
+
+    Vector<float> v(4, std::vector<float>{1, 2, 3, 4}, ROW);
+    auto e = kernels::map(v.view(0, 2, 2), vmath::exp);
+    ASSERT_TRUE(e.size() == 2 && e.orientation() == ROW);
+    ASSERT_TRUE(is_close(e[1], std::exp(3.0F), 1e-5));
+    auto z = kernels::zip_map(v.view(0, 2, 2), v.view(1, 2, 2),
+                              [](float a, float b) { return a * b; });
+    ASSERT_TRUE(z[0] == 2.0F && z[1] == 12.0F);
+  }
+
   static void gemv_time_test() {
     std::cout << "OMP threads: " << omp_get_max_threads() << "\n";
     constexpr size_t N = 4096;
@@ -902,6 +1466,8 @@ class ViewTests : public ITest {
     should_construct_matrix_view_and_access_elements();
     should_modify_original_matrix_through_view();
     should_throw_on_matrix_view_out_of_bounds();
+    should_view_transposes_columns_and_diagonals_without_copying();
+    should_view_const_and_column_major_matrices();
     should_compute_matrix_view_times_vector_view();
     should_compute_matrix_view_times_vector_view_with_type_promotion();
     should_compute_vector_view_times_matrix_view();
@@ -913,6 +1479,17 @@ class ViewTests : public ITest {
     should_compute_weird_submatrix_times_strided_vector_with_type_promotion();
     should_compute_weird_submatrix_times_strided_vector_blas_float_path();
     should_compute_weird_submatrix_times_strided_vector_blas_double_path();
+    should_compute_gemv_into_strided_views();
+    should_apply_rank_one_update_to_strided_view();
+    should_compute_symv_from_one_triangle();
+    should_solve_triangular_systems_in_all_modes();
+    should_solve_triangular_systems_with_many_right_hand_sides();
+    should_pick_unit_stride_paths_for_any_view();
+    should_throw_if_level2_dimensions_mismatch();
+    should_compute_gemm_into_strided_views();
+    should_compute_gemm_on_transposed_and_column_major_views();
+    should_throw_if_gemm_dimensions_mismatch();
+    should_map_and_zip_map_strided_views();
     gemv_time_test();
     return 0;
   }